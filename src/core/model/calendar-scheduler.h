@@ -109,6 +109,7 @@ public:
   virtual Scheduler::Event PeekNext (void) const;
   virtual Scheduler::Event RemoveNext (void);
   virtual void Remove (const Scheduler::Event &ev);
+  virtual void RemoveCancelled (std::vector<Scheduler::Event> &removed);
 
 private:
   /** Double the number of buckets if necessary. */
@@ -25,10 +25,18 @@
 
 #include "ptr.h"
 #include "pointer.h"
+#include "double.h"
+#include "uinteger.h"
+#include "boolean.h"
+#include "string.h"
 #include "assert.h"
 #include "log.h"
 
+#include <chrono>
 #include <cmath>
+#include <fstream>
+#include <iostream>
+#include <vector>
 
 
 /**
@@ -53,6 +61,33 @@ DefaultSimulatorImpl::GetTypeId (void)
     .SetParent<SimulatorImpl> ()
     .SetGroupName ("Core")
     .AddConstructor<DefaultSimulatorImpl> ()
+    .AddAttribute ("CompactionThreshold",
+                   "Fraction of cancelled events in the event list above which "
+                   "they are removed from it. A value of zero disables the "
+                   "removal: cancelled events then stay in the event list "
+                   "until they are reached.",
+                   DoubleValue (0.5),
+                   MakeDoubleAccessor (&DefaultSimulatorImpl::m_compactionThreshold),
+                   MakeDoubleChecker<double> (0, 1))
+    .AddAttribute ("CompactionMinEvents",
+                   "Minimum number of cancelled events in the event list "
+                   "before they are removed from it.",
+                   UintegerValue (1024),
+                   MakeUintegerAccessor (&DefaultSimulatorImpl::m_compactionMinEvents),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("EventProfiling",
+                   "Record the wall-clock time and the number of invocations "
+                   "of each type of event and of each context, and report them "
+                   "when the simulator is destroyed.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&DefaultSimulatorImpl::m_eventProfiling),
+                   MakeBooleanChecker ())
+    .AddAttribute ("EventProfilingOutput",
+                   "The file the event profile is written to. "
+                   "The profile is written to the standard error if empty.",
+                   StringValue (""),
+                   MakeStringAccessor (&DefaultSimulatorImpl::m_eventProfilingOutput),
+                   MakeStringChecker ())
   ;
   return tid;
 }
@@ -71,7 +106,9 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   m_currentTs = 0;
   m_currentContext = Simulator::NO_CONTEXT;
   m_unscheduledEvents = 0;
+  m_cancelledEvents = 0;
   m_eventCount = 0;
+  m_eventProfiling = false;
   m_eventsWithContextEmpty = true;
   m_main = SystemThread::Self ();
 }
@@ -109,6 +146,24 @@ DefaultSimulatorImpl::Destroy ()
           ev->Invoke ();
         }
     }
+
+  if (m_eventProfiling)
+    {
+      if (m_eventProfilingOutput.empty ())
+        {
+          m_eventProfiler.Report (std::clog);
+        }
+      else
+        {
+          std::ofstream os (m_eventProfilingOutput.c_str ());
+          if (!os.is_open ())
+            {
+              NS_LOG_ERROR ("Can't open " << m_eventProfilingOutput);
+              return;
+            }
+          m_eventProfiler.Report (os);
+        }
+    }
 }
 
 void
@@ -143,12 +198,28 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
   NS_ASSERT (next.key.m_ts >= m_currentTs);
   m_unscheduledEvents--;
   m_eventCount++;
+  bool cancelled = next.impl->IsCancelled ();
+  if (cancelled)
+    {
+      m_cancelledEvents--;
+    }
 
   NS_LOG_LOGIC ("handle " << next.key.m_ts);
   m_currentTs = next.key.m_ts;
   m_currentContext = next.key.m_context;
   m_currentUid = next.key.m_uid;
-  next.impl->Invoke ();
+  if (m_eventProfiling && !cancelled)
+    {
+      auto start = std::chrono::steady_clock::now ();
+      next.impl->Invoke ();
+      auto wallTime = std::chrono::steady_clock::now () - start;
+      m_eventProfiler.Record (next.impl, next.key.m_context,
+                              std::chrono::duration_cast<std::chrono::nanoseconds> (wallTime).count ());
+    }
+  else
+    {
+      next.impl->Invoke ();
+    }
   next.impl->Unref ();
 
   ProcessEventsWithContext ();
@@ -364,9 +435,36 @@ DefaultSimulatorImpl::Cancel (const EventId &id)
   if (!IsExpired (id))
     {
       id.PeekEventImpl ()->Cancel ();
+      // destroy events and events not scheduled by this simulator
+      // (e.g., TimerWheel events) are not in the event list
+      if (id.GetUid () >= 4 && id.GetUid () < m_uid)
+        {
+          m_cancelledEvents++;
+          if (m_compactionThreshold > 0
+              && m_cancelledEvents >= m_compactionMinEvents
+              && m_cancelledEvents > m_compactionThreshold * m_unscheduledEvents)
+            {
+              RemoveCancelled ();
+            }
+        }
     }
 }
 
+void
+DefaultSimulatorImpl::RemoveCancelled (void)
+{
+  NS_LOG_FUNCTION (this << m_cancelledEvents << m_unscheduledEvents);
+  std::vector<Scheduler::Event> removed;
+  m_events->RemoveCancelled (removed);
+  NS_ASSERT (removed.size () == m_cancelledEvents);
+  for (std::vector<Scheduler::Event>::const_iterator i = removed.begin (); i != removed.end (); i++)
+    {
+      i->impl->Unref ();
+    }
+  m_unscheduledEvents -= removed.size ();
+  m_cancelledEvents -= removed.size ();
+}
+
 bool
 DefaultSimulatorImpl::IsExpired (const EventId &id) const
 {
@@ -418,4 +516,22 @@ DefaultSimulatorImpl::GetEventCount (void) const
   return m_eventCount;
 }
 
+uint32_t
+DefaultSimulatorImpl::GetPendingEventCount (void) const
+{
+  return m_unscheduledEvents - m_cancelledEvents;
+}
+
+uint32_t
+DefaultSimulatorImpl::GetCancelledEventCount (void) const
+{
+  return m_cancelledEvents;
+}
+
+const EventProfiler &
+DefaultSimulatorImpl::GetEventProfiler (void) const
+{
+  return m_eventProfiler;
+}
+
 } // namespace ns3
@@ -28,6 +28,7 @@
 #include "system-mutex.h"
 
 #include "ptr.h"
+#include "event-profiler.h"
 
 #include <list>
 
@@ -78,10 +79,21 @@ public:
   virtual uint32_t GetSystemId (void) const;
   virtual uint32_t GetContext (void) const;
   virtual uint64_t GetEventCount (void) const;
+  virtual uint32_t GetPendingEventCount (void) const;
+  virtual uint32_t GetCancelledEventCount (void) const;
+
+  /**
+   * \returns The profile of the events invoked so far, which is only
+   *          recorded when the EventProfiling attribute is set.
+   */
+  const EventProfiler & GetEventProfiler (void) const;
 
 private:
   virtual void DoDispose (void);
 
+  /** Remove the cancelled events from the event list. */
+  void RemoveCancelled (void);
+
   /** Process the next event. */
   void ProcessOneEvent (void);
   /** Move events from a different context into the main event queue. */
@@ -133,6 +145,22 @@ private:
    *  not counting the Destroy events; this is used for validation
    */
   int m_unscheduledEvents;
+  /** Number of cancelled events in the event list. */
+  uint32_t m_cancelledEvents;
+  /**
+   * Fraction of cancelled events in the event list above which
+   * they are removed from it.
+   */
+  double m_compactionThreshold;
+  /** Minimum number of cancelled events to remove them from the event list. */
+  uint32_t m_compactionMinEvents;
+
+  /** Whether the wall-clock time of the events is recorded. */
+  bool m_eventProfiling;
+  /** The file the event profile is written to, or empty for std::clog. */
+  std::string m_eventProfilingOutput;
+  /** The profile of the events. */
+  EventProfiler m_eventProfiler;
 
   /** Main execution thread. */
   SystemThread::ThreadId m_main;
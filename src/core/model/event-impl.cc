@@ -66,4 +66,17 @@ EventImpl::IsCancelled (void)
   return m_cancel;
 }
 
+EventImpl::FunctionKey
+EventImpl::GetFunctionKey (void) const
+{
+  FunctionKey key = {{0, 0}};
+  return key;
+}
+
+const EventImpl *
+EventImpl::GetInvokedEvent (void) const
+{
+  return this;
+}
+
 } // namespace ns3
@@ -21,6 +21,9 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <array>
+#include <cstring>
+#include <algorithm>
 #include "simple-ref-count.h"
 
 /**
@@ -66,7 +69,35 @@ public:
    */
   bool IsCancelled (void);
 
+  /** The bytes of a pointer to a function or to a member function. */
+  typedef std::array<uint64_t, 2> FunctionKey;
+
+  /**
+   * Identify the function invoked by this event.
+   *
+   * Events of the same type may invoke different functions with the
+   * same signature, e.g., two methods of a class: EventProfiler reports
+   * them separately thanks to this key.
+   *
+   * \returns The bytes of the pointer to the function invoked, zero if
+   *          this type of event does not record it.
+   */
+  virtual FunctionKey GetFunctionKey (void) const;
+  /**
+   * \returns The event invoked by this event: this event, unless it only
+   *          wraps another one.
+   */
+  virtual const EventImpl * GetInvokedEvent (void) const;
+
 protected:
+  /**
+   * \tparam F \deduced The type of the function pointer.
+   * \param [in] function A pointer to a function or to a member function.
+   * \returns The bytes of the pointer, zero padded.
+   */
+  template <typename F>
+  static FunctionKey MakeFunctionKey (F function);
+
   /**
    * Implementation for Invoke().
    *
@@ -79,6 +110,15 @@ private:
   bool m_cancel;  /**< Has this event been cancelled. */
 };
 
+template <typename F>
+EventImpl::FunctionKey
+EventImpl::MakeFunctionKey (F function)
+{
+  FunctionKey key = {{0, 0}};
+  std::memcpy (key.data (), &function, std::min (sizeof (F), sizeof (FunctionKey)));
+  return key;
+}
+
 } // namespace ns3
 
 #endif /* EVENT_IMPL_H */
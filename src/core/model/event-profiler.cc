@@ -0,0 +1,250 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "event-profiler.h"
+#include "event-impl.h"
+#include "simulator.h"
+#include "log.h"
+#include "ns3/core-config.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#if (__GNUC__ >= 3)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+#ifdef HAVE_DLFCN_H
+#include <dlfcn.h>
+#endif
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("EventProfiler");
+
+/**
+ * \ingroup simulator
+ * Demangle a C++ name.
+ * \param [in] name The mangled name.
+ * \returns The demangled name, \p name if it cannot be demangled.
+ */
+static std::string
+Demangle (const std::string &name)
+{
+#if (__GNUC__ >= 3)
+  int status;
+  char *demangled = abi::__cxa_demangle (name.c_str (), NULL, NULL, &status);
+  std::string result = (status == 0) ? demangled : name;
+  std::free (demangled);
+  return result;
+#else
+  return name;
+#endif
+}
+
+EventProfiler::EventProfiler ()
+  : m_count (0),
+    m_wallTime (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+EventProfiler::Record (const EventImpl *event, uint32_t context, int64_t wallTime)
+{
+  const EventImpl *invoked = event->GetInvokedEvent ();
+  EventKey key = {std::type_index (typeid (*invoked)), invoked->GetFunctionKey ()};
+  Counters &type = m_types[key];
+  type.count++;
+  type.wallTime += wallTime;
+  Counters &ctx = m_contexts[context];
+  ctx.count++;
+  ctx.wallTime += wallTime;
+  m_count++;
+  m_wallTime += wallTime;
+}
+
+void
+EventProfiler::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_types.clear ();
+  m_contexts.clear ();
+  m_count = 0;
+  m_wallTime = 0;
+}
+
+void
+EventProfiler::Sort (std::vector<Stats> &stats)
+{
+  std::sort (stats.begin (), stats.end (),
+             [] (const Stats &a, const Stats &b)
+             {
+               return a.wallTime > b.wallTime
+                      || (a.wallTime == b.wallTime && a.name < b.name);
+             });
+}
+
+std::vector<EventProfiler::Stats>
+EventProfiler::GetEventTypeStats (void) const
+{
+  std::vector<Stats> stats;
+  for (const auto &type : m_types)
+    {
+      std::string name = GetEventTypeName (type.first.type);
+      if (type.first.function != EventImpl::FunctionKey ())
+        {
+          name += " " + GetFunctionName (type.first.function);
+        }
+      Stats s = {name, type.second.count, type.second.wallTime};
+      stats.push_back (s);
+    }
+  Sort (stats);
+  return stats;
+}
+
+std::vector<EventProfiler::Stats>
+EventProfiler::GetContextStats (void) const
+{
+  std::vector<Stats> stats;
+  for (const auto &ctx : m_contexts)
+    {
+      std::ostringstream oss;
+      if (ctx.first == Simulator::NO_CONTEXT)
+        {
+          oss << "none";
+        }
+      else
+        {
+          oss << ctx.first;
+        }
+      Stats s = {oss.str (), ctx.second.count, ctx.second.wallTime};
+      stats.push_back (s);
+    }
+  Sort (stats);
+  return stats;
+}
+
+std::string
+EventProfiler::GetEventTypeName (const std::type_index &type)
+{
+  std::string name = Demangle (type.name ());
+
+  // The events of MakeEvent are local classes of MakeEvent: only keep
+  // its template arguments, i.e., the function and argument types.
+  const std::string prefix = "ns3::MakeEvent<";
+  if (name.compare (0, prefix.size (), prefix) == 0)
+    {
+      int depth = 1;
+      for (std::size_t i = prefix.size (); i < name.size (); i++)
+        {
+          if (name[i] == '<')
+            {
+              depth++;
+            }
+          else if (name[i] == '>' && --depth == 0)
+            {
+              return name.substr (prefix.size (), i - prefix.size ());
+            }
+        }
+    }
+  return name;
+}
+
+std::string
+EventProfiler::GetFunctionName (const EventImpl::FunctionKey &function)
+{
+  // The first word is the address of a function, or of a non-virtual
+  // member function.
+  uintptr_t address = static_cast<uintptr_t> (function[0]);
+#ifdef HAVE_DLFCN_H
+  Dl_info info;
+  if (dladdr (reinterpret_cast<void *> (address), &info) != 0
+      && info.dli_sname != NULL
+      && reinterpret_cast<uintptr_t> (info.dli_saddr) == address)
+    {
+      return Demangle (info.dli_sname);
+    }
+#endif
+  std::ostringstream oss;
+  // In the Itanium C++ ABI, a pointer to a virtual member function holds
+  // one plus the offset of the function in the vtable.
+  if ((address & 1) != 0 && address < 0x10000)
+    {
+      oss << "virtual function " << (address - 1) / sizeof (void *);
+    }
+  else
+    {
+      oss << "function 0x" << std::hex << address;
+    }
+  return oss.str ();
+}
+
+std::size_t
+EventProfiler::EventKeyHash::operator() (const EventKey &key) const
+{
+  std::size_t hash = key.type.hash_code ();
+  for (uint64_t word : key.function)
+    {
+      hash = hash * 31 + std::hash<uint64_t> () (word);
+    }
+  return hash;
+}
+
+void
+EventProfiler::Report (std::ostream &os, uint32_t maxRows) const
+{
+  std::ios_base::fmtflags flags = os.flags ();
+  std::streamsize precision = os.precision ();
+  os << "Event profile: " << m_count << " events, "
+     << std::fixed << std::setprecision (3) << m_wallTime / 1e9 << " s" << std::endl;
+
+  std::vector<Stats> sections[2] = {GetEventTypeStats (), GetContextStats ()};
+  const char *titles[2] = {"event type", "context"};
+  for (uint32_t s = 0; s < 2; s++)
+    {
+      os << std::setw (12) << "count" << std::setw (14) << "total (ms)"
+         << std::setw (12) << "mean (us)" << std::setw (8) << "%"
+         << "  " << titles[s] << std::endl;
+      uint32_t rows = 0;
+      for (const Stats &stats : sections[s])
+        {
+          if (rows++ == maxRows)
+            {
+              os << std::setw (12) << "" << "  ... " << sections[s].size () - maxRows
+                 << " more" << std::endl;
+              break;
+            }
+          os << std::setw (12) << stats.count
+             << std::setw (14) << std::setprecision (3) << stats.wallTime / 1e6
+             << std::setw (12) << std::setprecision (3) << stats.wallTime / 1e3 / stats.count
+             << std::setw (8) << std::setprecision (1)
+             << (m_wallTime > 0 ? 100.0 * stats.wallTime / m_wallTime : 0.0)
+             << "  " << stats.name << std::endl;
+        }
+    }
+  os.flags (flags);
+  os.precision (precision);
+}
+
+} // namespace ns3
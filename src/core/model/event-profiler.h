@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include "event-impl.h"
+
+#include <stdint.h>
+#include <ostream>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ *
+ * \brief Aggregate the wall-clock time spent in each type of event.
+ *
+ * The simulator implementation times each event it invokes and records
+ * it with EventProfiler::Record. Events are aggregated by the dynamic
+ * type of their EventImpl and by the function they invoke. For the
+ * events created by MakeEvent (i.e., by all the Simulator::Schedule
+ * variants), the type is built from the signature of the function and
+ * the types of its arguments, and the function tells apart, e.g., the
+ * methods of a class with the same signature. Functions are named after
+ * their symbol when it can be found with dladdr. The events of the
+ * timer wheel are reported as the events they wrap. Events are also
+ * aggregated by the context (usually the node id) they run in.
+ *
+ * The DefaultSimulatorImpl profiles the event loop when its
+ * EventProfiling attribute is set, and prints the report when
+ * Simulator::Destroy is called.
+ */
+class EventProfiler
+{
+public:
+  /** Statistics of a set of events. */
+  struct Stats
+  {
+    std::string name;     //!< Event type and function, or context
+    uint64_t count;       //!< Number of events invoked
+    int64_t wallTime;     //!< Wall-clock time spent in the events, in nanoseconds
+  };
+
+  EventProfiler ();
+
+  /**
+   * Record the invocation of an event.
+   *
+   * \param [in] event The event invoked.
+   * \param [in] context The context the event was invoked in.
+   * \param [in] wallTime The wall-clock duration of the event, in nanoseconds.
+   */
+  void Record (const EventImpl *event, uint32_t context, int64_t wallTime);
+
+  /**
+   * \returns The statistics of each event type and function, by
+   *          decreasing wall-clock time.
+   */
+  std::vector<Stats> GetEventTypeStats (void) const;
+
+  /**
+   * \returns The statistics of each context, by decreasing wall-clock time.
+   */
+  std::vector<Stats> GetContextStats (void) const;
+
+  /**
+   * Print the statistics of the event types and the contexts.
+   *
+   * \param [in,out] os The output stream.
+   * \param [in] maxRows The maximum number of event types and
+   *             contexts to print.
+   */
+  void Report (std::ostream &os, uint32_t maxRows = 20) const;
+
+  /** Forget all the events recorded. */
+  void Clear (void);
+
+  /**
+   * Get a readable name for an event type.
+   *
+   * The names of the event types created by MakeEvent are reduced to
+   * the list of the template arguments of MakeEvent.
+   *
+   * \param [in] type The type of an event.
+   * \returns The demangled name of the type.
+   */
+  static std::string GetEventTypeName (const std::type_index &type);
+
+  /**
+   * Get a readable name for the function invoked by an event.
+   *
+   * \param [in] function The key of the function, see
+   *             EventImpl::GetFunctionKey.
+   * \returns The demangled name of the function symbol if it is found,
+   *          else its address or, for virtual member functions, its
+   *          vtable offset.
+   */
+  static std::string GetFunctionName (const EventImpl::FunctionKey &function);
+
+private:
+  /** Counters of a set of events. */
+  struct Counters
+  {
+    uint64_t count;     //!< Number of events invoked
+    int64_t wallTime;   //!< Wall-clock time spent in the events, in nanoseconds
+  };
+
+  /** An event type and the function its events invoke. */
+  struct EventKey
+  {
+    std::type_index type;             //!< The type of the events
+    EventImpl::FunctionKey function;  //!< The function invoked
+    /**
+     * \param [in] other Another key.
+     * \returns true if both keys are equal.
+     */
+    bool operator== (const EventKey &other) const
+    {
+      return type == other.type && function == other.function;
+    }
+  };
+
+  /** Hash of an EventKey. */
+  struct EventKeyHash
+  {
+    /**
+     * \param [in] key The key to hash.
+     * \returns The hash of the key.
+     */
+    std::size_t operator() (const EventKey &key) const;
+  };
+
+  /**
+   * Sort statistics by decreasing wall-clock time.
+   * \param [in,out] stats The statistics to sort.
+   */
+  static void Sort (std::vector<Stats> &stats);
+
+  /** Counters per event type and function. */
+  std::unordered_map<EventKey, Counters, EventKeyHash> m_types;
+  /** Counters per context. */
+  std::unordered_map<uint32_t, Counters> m_contexts;
+  /** Total number of events recorded. */
+  uint64_t m_count;
+  /** Total wall-clock time of the events recorded, in nanoseconds. */
+  int64_t m_wallTime;
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
@@ -51,6 +51,10 @@ EventImpl * MakeEvent (void (*f)(void))
     {
       (*m_function)();
     }
+    virtual FunctionKey GetFunctionKey (void) const
+    {
+      return MakeFunctionKey (m_function);
+    }
 
   private:
     F m_function;
@@ -374,6 +374,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)();
     }
+    virtual FunctionKey GetFunctionKey (void) const
+    {
+      return MakeFunctionKey (m_function);
+    }
     OBJ m_obj;
     MEM m_function;
   } *ev = new EventMemberImpl0 (obj, mem_ptr);
@@ -404,6 +408,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1);
     }
+    virtual FunctionKey GetFunctionKey (void) const
+    {
+      return MakeFunctionKey (m_function);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -435,6 +443,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2);
     }
+    virtual FunctionKey GetFunctionKey (void) const
+    {
+      return MakeFunctionKey (m_function);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -468,6 +480,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3);
     }
+    virtual FunctionKey GetFunctionKey (void) const
+    {
+      return MakeFunctionKey (m_function);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -503,6 +519,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3, T4 a4)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4);
     }
+    virtual FunctionKey GetFunctionKey (void) const
+    {
+      return MakeFunctionKey (m_function);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -541,6 +561,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj,
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
     }
+    virtual FunctionKey GetFunctionKey (void) const
+    {
+      return MakeFunctionKey (m_function);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -581,6 +605,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj,
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
     }
+    virtual FunctionKey GetFunctionKey (void) const
+    {
+      return MakeFunctionKey (m_function);
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -616,6 +644,10 @@ EventImpl * MakeEvent (void (*f)(U1), T1 a1)
     {
       (*m_function)(m_a1);
     }
+    virtual FunctionKey GetFunctionKey (void) const
+    {
+      return MakeFunctionKey (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
   } *ev = new EventFunctionImpl1 (f, a1);
@@ -646,6 +678,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2), T1 a1, T2 a2)
     {
       (*m_function)(m_a1, m_a2);
     }
+    virtual FunctionKey GetFunctionKey (void) const
+    {
+      return MakeFunctionKey (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -679,6 +715,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3), T1 a1, T2 a2, T3 a3)
     {
       (*m_function)(m_a1, m_a2, m_a3);
     }
+    virtual FunctionKey GetFunctionKey (void) const
+    {
+      return MakeFunctionKey (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -714,6 +754,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4), T1 a1, T2 a2, T3 a3, T4 a4)
     {
       (*m_function)(m_a1, m_a2, m_a3, m_a4);
     }
+    virtual FunctionKey GetFunctionKey (void) const
+    {
+      return MakeFunctionKey (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -751,6 +795,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5), T1 a1, T2 a2, T3 a3, T4 a4, T5
     {
       (*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
     }
+    virtual FunctionKey GetFunctionKey (void) const
+    {
+      return MakeFunctionKey (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -790,6 +838,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5,U6), T1 a1, T2 a2, T3 a3, T4 a4,
     {
       (*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
     }
+    virtual FunctionKey GetFunctionKey (void) const
+    {
+      return MakeFunctionKey (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
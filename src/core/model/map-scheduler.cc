@@ -109,4 +109,26 @@ MapScheduler::Remove (const Event &ev)
   m_list.erase (i);
 }
 
+void
+MapScheduler::RemoveCancelled (std::vector<Scheduler::Event> &removed)
+{
+  NS_LOG_FUNCTION (this);
+  EventMapI i = m_list.begin ();
+  while (i != m_list.end ())
+    {
+      if (i->second->IsCancelled ())
+        {
+          Event ev;
+          ev.impl = i->second;
+          ev.key = i->first;
+          removed.push_back (ev);
+          i = m_list.erase (i);
+        }
+      else
+        {
+          i++;
+        }
+    }
+}
+
 } // namespace ns3
@@ -79,6 +79,7 @@ public:
   virtual Scheduler::Event PeekNext (void) const;
   virtual Scheduler::Event RemoveNext (void);
   virtual void Remove (const Scheduler::Event &ev);
+  virtual void RemoveCancelled (std::vector<Scheduler::Event> &removed);
 
 private:
   /** Event list type: a Map from EventKey to EventImpl. */
@@ -111,4 +111,31 @@ PriorityQueueScheduler::Remove (const Scheduler::Event &ev)
   m_queue.remove (ev);
 }
 
+void
+PriorityQueueScheduler::EventPriorityQueue::RemoveCancelled (std::vector<Scheduler::Event> &removed)
+{
+  auto last = this->c.begin ();
+  for (auto it = this->c.begin (); it != this->c.end (); it++)
+    {
+      if (it->impl->IsCancelled ())
+        {
+          removed.push_back (*it);
+        }
+      else
+        {
+          *last = *it;
+          last++;
+        }
+    }
+  this->c.erase (last, this->c.end ());
+  std::make_heap (this->c.begin (), this->c.end (), this->comp);
+}
+
+void
+PriorityQueueScheduler::RemoveCancelled (std::vector<Scheduler::Event> &removed)
+{
+  NS_LOG_FUNCTION (this);
+  m_queue.RemoveCancelled (removed);
+}
+
 } // namespace ns3
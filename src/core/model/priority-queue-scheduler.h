@@ -81,6 +81,7 @@ public:
   virtual Scheduler::Event PeekNext (void) const;
   virtual Scheduler::Event RemoveNext (void);
   virtual void Remove (const Scheduler::Event &ev);
+  virtual void RemoveCancelled (std::vector<Scheduler::Event> &removed);
 
 private:
 
@@ -100,6 +101,11 @@ private:
      * \returns \c true if the event was found, false otherwise.
      */
     bool remove(const Scheduler::Event &ev);
+
+    /**
+     * \copydoc PriorityQueueScheduler::RemoveCancelled()
+     */
+    void RemoveCancelled (std::vector<Scheduler::Event> &removed);
     
   };  // class EventPriorityQueue
 
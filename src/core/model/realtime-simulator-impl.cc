@@ -90,6 +90,7 @@ RealtimeSimulatorImpl::RealtimeSimulatorImpl ()
   m_currentTs = 0;
   m_currentContext = Simulator::NO_CONTEXT;
   m_unscheduledEvents = 0;
+  m_cancelledEvents = 0;
   m_eventCount = 0;
 
   m_main = SystemThread::Self ();
@@ -332,6 +333,10 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
     next = m_events->RemoveNext ();
     m_unscheduledEvents--;
     m_eventCount++;
+    if (next.impl->IsCancelled ())
+      {
+        m_cancelledEvents--;
+      }
 
     //
     // We cannot make any assumption that "next" is the same event we originally waited
@@ -753,7 +758,14 @@ RealtimeSimulatorImpl::Cancel (const EventId &id)
 {
   if (IsExpired (id) == false)
     {
+      CriticalSection cs (m_mutex);
       id.PeekEventImpl ()->Cancel ();
+      // destroy events and events not scheduled by this simulator
+      // are not in the event list
+      if (id.GetUid () >= 4 && id.GetUid () < m_uid)
+        {
+          m_cancelledEvents++;
+        }
     }
 }
 
@@ -825,6 +837,20 @@ RealtimeSimulatorImpl::GetEventCount (void) const
   return m_eventCount;
 }
 
+uint32_t
+RealtimeSimulatorImpl::GetPendingEventCount (void) const
+{
+  CriticalSection cs (m_mutex);
+  return m_unscheduledEvents - m_cancelledEvents;
+}
+
+uint32_t
+RealtimeSimulatorImpl::GetCancelledEventCount (void) const
+{
+  CriticalSection cs (m_mutex);
+  return m_cancelledEvents;
+}
+
 void
 RealtimeSimulatorImpl::SetSynchronizationMode (enum SynchronizationMode mode)
 {
@@ -109,6 +109,8 @@ public:
   virtual uint32_t GetSystemId (void) const;
   virtual uint32_t GetContext (void) const;
   virtual uint64_t GetEventCount (void) const;
+  virtual uint32_t GetPendingEventCount (void) const;
+  virtual uint32_t GetCancelledEventCount (void) const;
 
   /** \copydoc ScheduleWithContext(uint32_t,const Time&,EventImpl*) */
   void ScheduleRealtimeWithContext (uint32_t context, const Time &delay, EventImpl *event);
@@ -196,6 +198,8 @@ private:
   Ptr<Scheduler> m_events;
   /**< Number of events in the event list. */
   int m_unscheduledEvents;
+  /**< Number of cancelled events in the event list. */
+  uint32_t m_cancelledEvents;
   /**< Unique id for the next event to be scheduled. */
   uint32_t m_uid;
   /**< Unique id of the current event. */
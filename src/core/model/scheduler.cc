@@ -19,6 +19,7 @@
  */
 
 #include "scheduler.h"
+#include "event-impl.h"
 #include "assert.h"
 #include "log.h"
 
@@ -49,4 +50,26 @@ Scheduler::GetTypeId (void)
   return tid;
 }
 
+void
+Scheduler::RemoveCancelled (std::vector<Event> &removed)
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<Event> events;
+  while (!IsEmpty ())
+    {
+      events.push_back (RemoveNext ());
+    }
+  for (std::vector<Event>::const_iterator i = events.begin (); i != events.end (); i++)
+    {
+      if (i->impl->IsCancelled ())
+        {
+          removed.push_back (*i);
+        }
+      else
+        {
+          Insert (*i);
+        }
+    }
+}
+
 } // namespace ns3
@@ -22,6 +22,7 @@
 #define SCHEDULER_H
 
 #include <stdint.h>
+#include <vector>
 #include "object.h"
 
 /**
@@ -151,6 +152,10 @@ class EventImpl;
  * calling EventId::Ref and SimpleRefCount::Unref at the right time.
  * Typically, EventId::Ref is called before Insert and SimpleRefCount::Unref is called
  * after a call to one of the Remove methods.
+ *
+ * Cancelled events can be purged from the event list in bulk with
+ * Scheduler::RemoveCancelled, which the simulator uses when they make up
+ * a large fraction of the event list.
  */
 class Scheduler : public Object
 {
@@ -224,6 +229,20 @@ public:
    * \param [in] ev The event to remove
    */
   virtual void Remove (const Event &ev) = 0;
+  /**
+   * Remove all the cancelled events from the event list.
+   *
+   * The order of the remaining events is preserved. As with the other
+   * Remove methods, the caller is responsible for releasing the
+   * removed events.
+   *
+   * The default implementation empties the event list and inserts back
+   * the events which are not cancelled; subclasses should filter their
+   * container in place instead.
+   *
+   * \param [out] removed The container the removed events are appended to.
+   */
+  virtual void RemoveCancelled (std::vector<Event> &removed);
 };
 
 /**
@@ -101,6 +101,10 @@ public:
   virtual uint32_t GetContext (void) const = 0;
   /** \copydoc Simulator::GetEventCount */
   virtual uint64_t GetEventCount (void) const = 0;
+  /** \copydoc Simulator::GetPendingEventCount */
+  virtual uint32_t GetPendingEventCount (void) const = 0;
+  /** \copydoc Simulator::GetCancelledEventCount */
+  virtual uint32_t GetCancelledEventCount (void) const = 0;
 
 };
 
@@ -308,6 +308,18 @@ Simulator::GetEventCount (void)
   return GetImpl ()->GetEventCount ();
 }
 
+uint32_t
+Simulator::GetPendingEventCount (void)
+{
+  return GetImpl ()->GetPendingEventCount ();
+}
+
+uint32_t
+Simulator::GetCancelledEventCount (void)
+{
+  return GetImpl ()->GetCancelledEventCount ();
+}
+
 uint32_t
 Simulator::GetSystemId (void)
 {
@@ -205,6 +205,25 @@ public:
    */
   static uint64_t GetEventCount (void);
 
+  /**
+   * Get the number of events in the event list which will be executed.
+   * \returns The number of scheduled events which have not been
+   *          executed nor cancelled yet, not counting the Destroy events.
+   */
+  static uint32_t GetPendingEventCount (void);
+
+  /**
+   * Get the number of cancelled events still held in the event list.
+   *
+   * Simulator::Cancel only marks an event as cancelled, which is
+   * then discarded when it reaches the head of the event list, or when
+   * the simulator purges the cancelled events from the event list
+   * (see the CompactionThreshold attribute of DefaultSimulatorImpl).
+   *
+   * \returns The number of cancelled events in the event list.
+   */
+  static uint32_t GetCancelledEventCount (void);
+
 
   /**
    * @name Schedule events (in the same context) to run at a future time.
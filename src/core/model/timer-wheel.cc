@@ -0,0 +1,392 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "timer-wheel.h"
+#include "simulator.h"
+#include "simulation-singleton.h"
+#include "global-value.h"
+#include "assert.h"
+#include "log.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup timer
+ * ns3::TimerWheel implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TimerWheel");
+
+/**
+ * \ingroup timer
+ * The duration of a tick of the timer wheel.
+ */
+static GlobalValue g_timerWheelGranularity ("TimerWheelGranularity",
+                                            "The duration of a tick of the timer wheel. "
+                                            "Timers using the wheel expire at the first tick "
+                                            "following their expiration time.",
+                                            TimeValue (MilliSeconds (1)),
+                                            MakeTimeChecker (TimeStep (1)));
+
+/**
+ * \ingroup timer
+ * The uid of the EventId of the timer wheel events.
+ *
+ * The simulator considers an event expired once it has been run,
+ * by comparing its uid with the uid of the current event. Wheel events
+ * are run by other simulator events, so their EventId carries the
+ * largest uid: they are running until their expiration time has
+ * passed, or they have been cancelled (which the wheel does when
+ * it runs them).
+ */
+static const uint32_t TIMER_WHEEL_UID = 0xffffffff;
+
+/**
+ * \ingroup timer
+ * An event held by the timer wheel, wrapping the event to invoke.
+ */
+class TimerWheel::WheelEvent : public EventImpl
+{
+public:
+  /**
+   * Constructor.
+   * \param [in] event The event to invoke, whose reference is taken.
+   */
+  WheelEvent (EventImpl *event)
+    : m_event (event)
+  {}
+  virtual ~WheelEvent ()
+  {
+    m_event->Unref ();
+  }
+  /**
+   * Mark this event expired then invoke the wrapped event,
+   * unless this event has been cancelled.
+   */
+  void Fire (void)
+  {
+    if (!IsCancelled ())
+      {
+        Cancel ();
+        Notify ();
+      }
+  }
+
+  virtual const EventImpl * GetInvokedEvent (void) const
+  {
+    return m_event->GetInvokedEvent ();
+  }
+
+protected:
+  virtual void Notify (void)
+  {
+    m_event->Invoke ();
+  }
+
+private:
+  EventImpl *m_event; //!< The event to invoke
+};
+
+/**
+ * \ingroup timer
+ * The simulator event firing an expired timer wheel event.
+ *
+ * The simulator does not hold the wheel events themselves, whose
+ * cancellation it does not track, but it reports the event they wrap
+ * to EventProfiler.
+ */
+class TimerWheel::FireEvent : public EventImpl
+{
+public:
+  /**
+   * Constructor.
+   * \param [in] event The wheel event to fire.
+   */
+  FireEvent (Ptr<WheelEvent> event)
+    : m_event (event)
+  {}
+  virtual const EventImpl * GetInvokedEvent (void) const
+  {
+    return m_event->GetInvokedEvent ();
+  }
+
+protected:
+  virtual void Notify (void)
+  {
+    m_event->Fire ();
+  }
+
+private:
+  Ptr<WheelEvent> m_event; //!< The wheel event to fire
+};
+
+
+TimerWheel::TimerWheel ()
+  : m_currentTick (0),
+    m_nextTick (0),
+    m_nEntries (0)
+{
+  NS_LOG_FUNCTION (this);
+  TimeValue granularity;
+  g_timerWheelGranularity.GetValue (granularity);
+  m_granularity = granularity.Get ().GetTimeStep ();
+  NS_ASSERT (m_granularity > 0);
+}
+
+TimerWheel::~TimerWheel ()
+{
+  NS_LOG_FUNCTION (this);
+  m_tickEvent.Cancel ();
+}
+
+EventId
+TimerWheel::Schedule (const Time &delay, EventImpl *event)
+{
+  return SimulationSingleton<TimerWheel>::Get ()->DoSchedule (delay, event);
+}
+
+Time
+TimerWheel::GetGranularity (void)
+{
+  return TimeStep (SimulationSingleton<TimerWheel>::Get ()->m_granularity);
+}
+
+uint32_t
+TimerWheel::GetNEvents (void)
+{
+  return SimulationSingleton<TimerWheel>::Get ()->m_nEntries;
+}
+
+uint64_t
+TimerWheel::TickCeil (const Time &time) const
+{
+  return (time.GetTimeStep () + m_granularity - 1) / m_granularity;
+}
+
+EventId
+TimerWheel::DoSchedule (const Time &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << delay << event);
+  NS_ASSERT_MSG (delay.IsPositive (), "TimerWheel::Schedule(): Negative delay");
+
+  Time now = Simulator::Now ();
+  Entry entry;
+  entry.event = Create<WheelEvent> (event);
+  entry.tick = TickCeil (now + delay);
+  entry.context = Simulator::GetContext ();
+
+  if (m_nEntries == 0)
+    {
+      // the wheel is empty: move it to the current time
+      m_currentTick = std::max (m_currentTick, TickCeil (now));
+    }
+  else
+    {
+      // the entries are placed relative to the current tick, which must
+      // not lag behind the current time
+      Advance (TickCeil (now));
+    }
+
+  if (entry.tick < m_currentTick)
+    {
+      // the slot of the current tick has already been processed
+      NS_ASSERT (TimeStep (entry.tick * m_granularity) == now);
+      Simulator::ScheduleNow (Create<FireEvent> (entry.event));
+      return EventId (entry.event, now.GetTimeStep (), entry.context, TIMER_WHEEL_UID);
+    }
+
+  m_nEntries++;
+  Wake (Insert (entry));
+  return EventId (entry.event, entry.tick * m_granularity, entry.context, TIMER_WHEEL_UID);
+}
+
+uint64_t
+TimerWheel::Insert (const Entry &entry)
+{
+  NS_ASSERT (entry.tick >= m_currentTick);
+  for (uint32_t level = 0; level < LEVELS; level++)
+    {
+      uint32_t shift = LEVEL_BITS * level;
+      if ((entry.tick >> (shift + LEVEL_BITS)) == (m_currentTick >> (shift + LEVEL_BITS)))
+        {
+          m_slots[level][(entry.tick >> shift) & SLOT_MASK].push_back (entry);
+          // the slot is processed at the first tick it covers
+          return (entry.tick >> shift) << shift;
+        }
+    }
+  m_overflow.push_back (entry);
+  return ((m_currentTick >> (LEVEL_BITS * LEVELS)) + 1) << (LEVEL_BITS * LEVELS);
+}
+
+void
+TimerWheel::Cascade (uint32_t level)
+{
+  NS_LOG_FUNCTION (this << level);
+  std::vector<Entry> entries;
+  if (level == LEVELS)
+    {
+      entries.swap (m_overflow);
+    }
+  else
+    {
+      entries.swap (m_slots[level][(m_currentTick >> (LEVEL_BITS * level)) & SLOT_MASK]);
+    }
+  for (std::vector<Entry>::const_iterator i = entries.begin (); i != entries.end (); i++)
+    {
+      if (i->event->IsCancelled ())
+        {
+          m_nEntries--;
+        }
+      else
+        {
+          Insert (*i);
+        }
+    }
+}
+
+void
+TimerWheel::CascadeCurrent (void)
+{
+  // Refill the lower levels when the digit of a level wraps around,
+  // starting from the highest one.
+  for (uint32_t level = LEVELS; level > 0; level--)
+    {
+      uint64_t mask = (static_cast<uint64_t> (1) << (LEVEL_BITS * level)) - 1;
+      if ((m_currentTick & mask) == 0)
+        {
+          Cascade (level);
+        }
+    }
+}
+
+void
+TimerWheel::Advance (uint64_t tick)
+{
+  NS_LOG_FUNCTION (this << tick);
+  // No entry expires before the pending wheel event, but the slots whose
+  // first tick is passed over must still be cascaded, one boundary of the
+  // highest level whose digit changes at a time.
+  NS_ASSERT (!m_tickEvent.IsRunning () || tick <= m_nextTick);
+  while (m_currentTick < tick)
+    {
+      uint32_t level = LEVELS;
+      while (level > 0 && (tick >> (LEVEL_BITS * level)) == (m_currentTick >> (LEVEL_BITS * level)))
+        {
+          level--;
+        }
+      if (level == 0)
+        {
+          m_currentTick = tick;
+          break;
+        }
+      uint32_t shift = LEVEL_BITS * level;
+      m_currentTick = ((m_currentTick >> shift) + 1) << shift;
+      CascadeCurrent ();
+    }
+}
+
+void
+TimerWheel::Tick (void)
+{
+  NS_LOG_FUNCTION (this << m_nextTick);
+  m_currentTick = m_nextTick;
+  CascadeCurrent ();
+
+  std::vector<Entry> expired;
+  expired.swap (m_slots[0][m_currentTick & SLOT_MASK]);
+  m_nEntries -= expired.size ();
+  for (std::vector<Entry>::const_iterator i = expired.begin (); i != expired.end (); i++)
+    {
+      NS_ASSERT (i->tick == m_currentTick);
+      if (!i->event->IsCancelled ())
+        {
+          Simulator::ScheduleWithContext (i->context, Time (0), new FireEvent (i->event));
+        }
+    }
+
+  m_currentTick++;
+  ScheduleTick ();
+}
+
+void
+TimerWheel::ScheduleTick (void)
+{
+  if (m_nEntries == 0)
+    {
+      return;
+    }
+
+  // Find the first slot to process at each level. The slot of the digit
+  // of the current tick has already been cascaded, unless the current
+  // tick is the first one it covers. Higher levels need not be looked at
+  // once a slot is found before the next wrap around of the level above.
+  uint64_t next = std::numeric_limits<uint64_t>::max ();
+  for (uint32_t level = 0; level <= LEVELS; level++)
+    {
+      uint32_t shift = LEVEL_BITS * level;
+      uint64_t mask = (static_cast<uint64_t> (1) << shift) - 1;
+      bool aligned = (m_currentTick & mask) == 0;
+      if (level == LEVELS)
+        {
+          if (!m_overflow.empty ())
+            {
+              next = std::min (next, aligned ? m_currentTick : (m_currentTick | mask) + 1);
+            }
+          break;
+        }
+      uint64_t digit = (m_currentTick >> shift) & SLOT_MASK;
+      uint64_t base = (m_currentTick >> (shift + LEVEL_BITS)) << (shift + LEVEL_BITS);
+      for (uint64_t slot = (level == 0 || aligned) ? digit : digit + 1; slot < SLOTS; slot++)
+        {
+          if (!m_slots[level][slot].empty ())
+            {
+              next = std::min (next, base | (slot << shift));
+              break;
+            }
+        }
+      uint64_t upperMask = (static_cast<uint64_t> (1) << (shift + LEVEL_BITS)) - 1;
+      if (next == m_currentTick
+          || (next != std::numeric_limits<uint64_t>::max () && (m_currentTick & upperMask) != 0))
+        {
+          break;
+        }
+    }
+  NS_ASSERT (next != std::numeric_limits<uint64_t>::max ());
+  Wake (next);
+}
+
+void
+TimerWheel::Wake (uint64_t tick)
+{
+  NS_ASSERT (tick >= TickCeil (Simulator::Now ()));
+  if (m_tickEvent.IsRunning ())
+    {
+      if (m_nextTick <= tick)
+        {
+          return;
+        }
+      m_tickEvent.Cancel ();
+    }
+  m_nextTick = tick;
+  m_tickEvent = Simulator::Schedule (TimeStep (tick * m_granularity) - Simulator::Now (),
+                                     &TimerWheel::Tick, this);
+}
+
+} // namespace ns3
@@ -0,0 +1,225 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include "event-id.h"
+#include "event-impl.h"
+#include "make-event.h"
+#include "nstime.h"
+#include "ptr.h"
+
+#include <vector>
+
+/**
+ * \file
+ * \ingroup timer
+ * ns3::TimerWheel declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup timer
+ * \brief A hierarchical timer wheel shared by all the timers of a simulation.
+ *
+ * Timers which are frequently cancelled and rescheduled (retransmission,
+ * delayed acknowledgment, route expiry...) normally insert one event in
+ * the simulator event list each time they are scheduled, and cancelled
+ * events stay in the event list until they are popped. The timer wheel
+ * keeps such timers out of the event list: it hashes them into slots of
+ * one tick (the "TimerWheelGranularity" global value, 1ms by default) and
+ * drives all of them with a single simulator event per non-empty tick.
+ * Only the timers which actually expire are handed back to the simulator,
+ * with the context they were scheduled in; cancelled timers are dropped
+ * when their slot is reached.
+ *
+ * The wheel has four levels of 256 slots; a timer is kept in the lowest
+ * level whose range covers its expiration tick, and moves to lower
+ * levels as time advances.
+ *
+ * The expiration time of a timer is rounded up to the next tick, so the
+ * timer wheel is opt-in: see Timer::SetUseTimerWheel,
+ * Watchdog::SetUseTimerWheel and the UseTimerWheel attribute of
+ * TcpSocketBase.
+ *
+ * The EventId returned by TimerWheel::Schedule supports IsRunning,
+ * IsExpired, Cancel and Simulator::GetDelayLeft. It must not be
+ * passed to Simulator::Remove, since the event is not in the
+ * simulator event list.
+ */
+class TimerWheel
+{
+public:
+  TimerWheel ();
+  ~TimerWheel ();
+
+  /**
+   * Schedule an event on the timer wheel of this simulation.
+   *
+   * \param [in] delay The relative expiration time of the event,
+   *             rounded up to the wheel granularity.
+   * \param [in] event The event to invoke at expiration.
+   * \returns The id of the event.
+   */
+  static EventId Schedule (const Time &delay, EventImpl *event);
+
+  /**
+   * Schedule a member function or functor on the timer wheel.
+   *
+   * \tparam FUNC \deduced Template type for the function to invoke.
+   * \tparam Ts \deduced Argument types.
+   * \param [in] delay The relative expiration time of the event.
+   * \param [in] f The function to invoke.
+   * \param [in] args Arguments to pass to MakeEvent.
+   * \returns The id of the event.
+   */
+  template <typename FUNC,
+            typename std::enable_if<!std::is_convertible<FUNC, EventImpl *>::value,int>::type = 0,
+            typename std::enable_if<!std::is_function<typename std::remove_pointer<FUNC>::type>::value,int>::type = 0,
+            typename... Ts>
+  static EventId Schedule (const Time &delay, FUNC f, Ts&&... args);
+
+  /**
+   * Schedule a function on the timer wheel.
+   *
+   * \tparam Us \deduced Formal function argument types.
+   * \tparam Ts \deduced Actual function argument types.
+   * \param [in] delay The relative expiration time of the event.
+   * \param [in] f The function to invoke.
+   * \param [in] args Arguments to pass to the invoked function.
+   * \returns The id of the event.
+   */
+  template <typename... Us, typename... Ts>
+  static EventId Schedule (const Time &delay, void (*f)(Us...), Ts&&... args);
+
+  /**
+   * \returns The duration of a tick of the timer wheel.
+   */
+  static Time GetGranularity (void);
+
+  /**
+   * \returns The number of events held by the timer wheel, including
+   *          the cancelled events whose slot has not been reached yet.
+   */
+  static uint32_t GetNEvents (void);
+
+private:
+  /** Number of levels of the wheel. */
+  static constexpr uint32_t LEVELS = 4;
+  /** Number of bits of the tick index handled by each level. */
+  static constexpr uint32_t LEVEL_BITS = 8;
+  /** Number of slots of each level. */
+  static constexpr uint32_t SLOTS = 1 << LEVEL_BITS;
+  /** Mask extracting a slot index. */
+  static constexpr uint32_t SLOT_MASK = SLOTS - 1;
+
+  class WheelEvent;
+  class FireEvent;
+
+  /** An event held by the wheel. */
+  struct Entry
+  {
+    Ptr<WheelEvent> event; //!< The event
+    uint64_t tick;         //!< The expiration tick
+    uint32_t context;      //!< The context the event was scheduled in
+  };
+
+  /**
+   * \param [in] delay The relative expiration time of the event.
+   * \param [in] event The event to invoke at expiration.
+   * \returns The id of the event.
+   */
+  EventId DoSchedule (const Time &delay, EventImpl *event);
+  /**
+   * Store an entry in the slot matching its expiration tick.
+   * \param [in] entry The entry.
+   * \returns The tick at which the slot of the entry must be processed.
+   */
+  uint64_t Insert (const Entry &entry);
+  /**
+   * Move the entries of a slot to the lower levels.
+   * \param [in] level The level of the slot.
+   */
+  void Cascade (uint32_t level);
+  /** Cascade the slots of the levels whose digit wraps around at the current tick. */
+  void CascadeCurrent (void);
+  /**
+   * Move the current tick forward, cascading the slots passed over.
+   * \param [in] tick The new current tick, no later than the pending tick.
+   */
+  void Advance (uint64_t tick);
+  /** Process the current tick, invoked by the wheel simulator event. */
+  void Tick (void);
+  /** Schedule the simulator event of the next tick to process, if any. */
+  void ScheduleTick (void);
+  /**
+   * Make sure the simulator event of the wheel runs no later than a tick.
+   * \param [in] tick The tick to process.
+   */
+  void Wake (uint64_t tick);
+  /**
+   * \param [in] time A simulation time.
+   * \returns The index of the first tick at or after \p time.
+   */
+  uint64_t TickCeil (const Time &time) const;
+
+  /** The slots of each level. */
+  std::vector<Entry> m_slots[LEVELS][SLOTS];
+  /** Entries too far in the future for the last level. */
+  std::vector<Entry> m_overflow;
+  /** All the ticks before this one have been processed. */
+  uint64_t m_currentTick;
+  /** The tick of the pending simulator event. */
+  uint64_t m_nextTick;
+  /** The pending simulator event. */
+  EventId m_tickEvent;
+  /** The duration of a tick, in time steps. */
+  int64_t m_granularity;
+  /** The number of entries held by the wheel. */
+  uint32_t m_nEntries;
+};
+
+} // namespace ns3
+
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3 {
+
+template <typename FUNC,
+          typename std::enable_if<!std::is_convertible<FUNC, EventImpl *>::value,int>::type,
+          typename std::enable_if<!std::is_function<typename std::remove_pointer<FUNC>::type>::value,int>::type,
+          typename... Ts>
+EventId
+TimerWheel::Schedule (const Time &delay, FUNC f, Ts&&... args)
+{
+  return Schedule (delay, MakeEvent (f, std::forward<Ts> (args)...));
+}
+
+template <typename... Us, typename... Ts>
+EventId
+TimerWheel::Schedule (const Time &delay, void (*f)(Us...), Ts&&... args)
+{
+  return Schedule (delay, MakeEvent (f, std::forward<Ts> (args)...));
+}
+
+} // namespace ns3
+
+#endif /* TIMER_WHEEL_H */
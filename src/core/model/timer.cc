@@ -18,6 +18,7 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "timer.h"
+#include "timer-wheel.h"
 #include "simulator.h"
 #include "simulation-singleton.h"
 #include "log.h"
@@ -66,7 +67,7 @@ Timer::~Timer ()
     }
   else if (m_flags & REMOVE_ON_DESTROY)
     {
-      m_event.Remove ();
+      DoRemove ();
     }
   delete m_impl;
 }
@@ -115,7 +116,7 @@ void
 Timer::Remove (void)
 {
   NS_LOG_FUNCTION (this);
-  m_event.Remove ();
+  DoRemove ();
 }
 bool
 Timer::IsExpired (void) const
@@ -170,7 +171,7 @@ Timer::Schedule (Time delay)
     {
       NS_FATAL_ERROR ("Event is still running while re-scheduling.");
     }
-  m_event = m_impl->Schedule (delay);
+  DoSchedule (delay);
 }
 
 void
@@ -185,7 +186,7 @@ Timer::Suspend (void)
     }
   else if (m_flags & REMOVE_ON_DESTROY)
     {
-      m_event.Remove ();
+      DoRemove ();
     } 
   m_flags |= TIMER_SUSPENDED;
 }
@@ -195,10 +196,54 @@ Timer::Resume (void)
 {
   NS_LOG_FUNCTION (this);
   NS_ASSERT (m_flags & TIMER_SUSPENDED);
-  m_event = m_impl->Schedule (m_delayLeft);
+  DoSchedule (m_delayLeft);
   m_flags &= ~TIMER_SUSPENDED;
 }
 
+void
+Timer::SetUseTimerWheel (bool useTimerWheel)
+{
+  NS_LOG_FUNCTION (this << useTimerWheel);
+  NS_ASSERT_MSG (!IsRunning () && !IsSuspended (),
+                 "Timer::SetUseTimerWheel(): the timer is scheduled");
+  if (useTimerWheel)
+    {
+      m_flags |= TIMER_WHEEL;
+    }
+  else
+    {
+      m_flags &= ~TIMER_WHEEL;
+    }
+}
+
+void
+Timer::DoSchedule (Time delay)
+{
+  NS_LOG_FUNCTION (this << delay);
+  if (m_flags & TIMER_WHEEL)
+    {
+      m_event = TimerWheel::Schedule (delay, &TimerImpl::Invoke, m_impl);
+    }
+  else
+    {
+      m_event = m_impl->Schedule (delay);
+    }
+}
+
+void
+Timer::DoRemove (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_flags & TIMER_WHEEL)
+    {
+      m_event.Cancel ();
+    }
+  else
+    {
+      m_event.Remove ();
+    }
+}
+
 
 } // namespace ns3
 
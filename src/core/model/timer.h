@@ -231,13 +231,43 @@ public:
    */
   void Resume (void);
 
+  /**
+   * \param [in] useTimerWheel whether this Timer is scheduled on the
+   * TimerWheel instead of the simulator event list.
+   *
+   * The timer wheel avoids inserting an event in the simulator event
+   * list every time the Timer is scheduled, which is useful for timers
+   * which are cancelled and rescheduled very often. The expiration is
+   * rounded up to the next tick of the wheel, and the arguments of the
+   * function are read when the Timer expires, rather than when it is
+   * scheduled, hence the function and arguments must not be changed
+   * while the Timer is running. Removing a Timer scheduled on the wheel
+   * cancels it.
+   *
+   * This must not be changed while the Timer is running or suspended.
+   */
+  void SetUseTimerWheel (bool useTimerWheel);
+
 private:
-  /** Internal bit marking the suspended state. */
+  /** Internal bits marking the suspended state and the use of the timer wheel. */
   enum InternalSuspended
   {
-    TIMER_SUSPENDED = (1 << 7)  /** Timer suspended. */
+    TIMER_SUSPENDED = (1 << 7), /** Timer suspended. */
+    TIMER_WHEEL = (1 << 8)      /** Timer scheduled on the TimerWheel. */
   };
 
+  /**
+   * Schedule the event of this Timer, either in the simulator
+   * or on the TimerWheel.
+   * \param [in] delay The relative expiration time.
+   */
+  void DoSchedule (Time delay);
+  /**
+   * Remove the event of this Timer, or cancel it if it has been
+   * scheduled on the TimerWheel.
+   */
+  void DoRemove (void);
+
   /**
    * Bitfield for Timer State, DestroyPolicy and InternalSuspended.
    *
@@ -18,6 +18,7 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "watchdog.h"
+#include "timer-wheel.h"
 #include "log.h"
 
 
@@ -34,7 +35,8 @@ NS_LOG_COMPONENT_DEFINE ("Watchdog");
 Watchdog::Watchdog ()
   : m_impl (0),
     m_event (),
-    m_end (MicroSeconds (0))
+    m_end (MicroSeconds (0)),
+    m_useTimerWheel (false)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -56,20 +58,42 @@ Watchdog::Ping (Time delay)
     {
       return;
     }
-  m_event = Simulator::Schedule (m_end - Now (), &Watchdog::Expire, this);
+  DoSchedule (m_end - Now ());
 }
 
 void
 Watchdog::Expire (void)
 {
   NS_LOG_FUNCTION (this);
-  if (m_end == Simulator::Now ())
+  // the timer wheel may expire the timer after m_end
+  if (m_end <= Simulator::Now ())
     {
       m_impl->Invoke ();
     }
   else
     {
-      m_event = Simulator::Schedule (m_end - Now (), &Watchdog::Expire, this);
+      DoSchedule (m_end - Now ());
+    }
+}
+
+void
+Watchdog::SetUseTimerWheel (bool useTimerWheel)
+{
+  NS_LOG_FUNCTION (this << useTimerWheel);
+  m_useTimerWheel = useTimerWheel;
+}
+
+void
+Watchdog::DoSchedule (Time delay)
+{
+  NS_LOG_FUNCTION (this << delay);
+  if (m_useTimerWheel)
+    {
+      m_event = TimerWheel::Schedule (delay, &Watchdog::Expire, this);
+    }
+  else
+    {
+      m_event = Simulator::Schedule (delay, &Watchdog::Expire, this);
     }
 }
 
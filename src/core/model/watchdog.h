@@ -109,9 +109,22 @@ public:
   void SetArguments (Ts&&... args);
   /**@}*/
 
+  /**
+   * \param [in] useTimerWheel whether this Watchdog is scheduled on the
+   * TimerWheel instead of the simulator event list.
+   *
+   * The expiration is then rounded up to the next tick of the wheel.
+   */
+  void SetUseTimerWheel (bool useTimerWheel);
+
 private:
   /** Internal callback invoked when the timer expires. */
   void Expire (void);
+  /**
+   * Schedule the expiration of the timer.
+   * \param [in] delay The relative expiration time.
+   */
+  void DoSchedule (Time delay);
   /**
    * The timer implementation, which contains the bound callback
    * function and arguments.
@@ -121,6 +134,8 @@ private:
   EventId m_event;
   /** The absolute time when the timer will expire. */
   Time m_end;
+  /** Whether the timer is scheduled on the TimerWheel. */
+  bool m_useTimerWheel;
 };
 
 } // namespace ns3
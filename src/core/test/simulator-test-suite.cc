@@ -24,6 +24,14 @@
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/timer-wheel.h"
+#include "ns3/core-config.h"
+
+#include <fstream>
+#include <vector>
 
 using namespace ns3;
 
@@ -465,6 +473,213 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class SimulatorCancelledEventsTestCase : public TestCase
+{
+public:
+  SimulatorCancelledEventsTestCase (ObjectFactory schedulerFactory);
+  virtual void DoRun (void);
+  void Event (void);
+  uint32_t m_nEvents;
+  Time m_last;
+  ObjectFactory m_schedulerFactory;
+};
+
+SimulatorCancelledEventsTestCase::SimulatorCancelledEventsTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check that cancelled events are removed from " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{}
+
+void
+SimulatorCancelledEventsTestCase::Event (void)
+{
+  NS_TEST_EXPECT_MSG_EQ ((Simulator::Now () >= m_last), true, "Events are out of order");
+  m_last = Simulator::Now ();
+  m_nEvents++;
+}
+
+void
+SimulatorCancelledEventsTestCase::DoRun (void)
+{
+  m_nEvents = 0;
+  m_last = Seconds (0);
+
+  Simulator::SetScheduler (m_schedulerFactory);
+
+  std::vector<EventId> events;
+  for (uint32_t i = 0; i < 3000; i++)
+    {
+      Time delay = MicroSeconds ((i * 7919) % 3000 + 1);
+      events.push_back (Simulator::Schedule (delay, &SimulatorCancelledEventsTestCase::Event, this));
+    }
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetPendingEventCount (), 3000, "All the events are pending");
+
+  // the cancelled events are removed once they are more than half of the
+  // event list (and at least CompactionMinEvents), i.e. at the 1501st Cancel
+  for (uint32_t i = 0; i < 3000; i++)
+    {
+      if (i % 3 != 0)
+        {
+          events[i].Cancel ();
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetPendingEventCount (), 1000, "Wrong number of pending events");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetCancelledEventCount (), 499, "Cancelled events were not removed");
+  NS_TEST_EXPECT_MSG_EQ (events[1].IsExpired (), true, "A removed event is expired");
+  NS_TEST_EXPECT_MSG_EQ (events[3].IsRunning (), true, "Event still scheduled");
+
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_nEvents, 1000, "Wrong number of events executed");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetPendingEventCount (), 0, "No more pending events");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetCancelledEventCount (), 0, "No more cancelled events");
+  Simulator::Destroy ();
+}
+
+class SimulatorEventProfilingTestCase : public TestCase
+{
+public:
+  SimulatorEventProfilingTestCase ();
+  virtual void DoRun (void);
+  void EventA (int a);
+  void EventB (void);
+};
+
+SimulatorEventProfilingTestCase::SimulatorEventProfilingTestCase ()
+  : TestCase ("Check the profile of the events")
+{}
+
+void
+SimulatorEventProfilingTestCase::EventA (int a)
+{
+  NS_UNUSED (a);
+}
+
+void
+SimulatorEventProfilingTestCase::EventB (void)
+{
+}
+
+void
+SimulatorEventProfilingTestCase::DoRun (void)
+{
+  Ptr<DefaultSimulatorImpl> impl = DynamicCast<DefaultSimulatorImpl> (Simulator::GetImplementation ());
+  if (impl == 0)
+    {
+      // the event profile is recorded by the default simulator implementation
+      Simulator::Destroy ();
+      return;
+    }
+  std::string output = CreateTempDirFilename ("event-profile.txt");
+  impl->SetAttribute ("EventProfiling", BooleanValue (true));
+  impl->SetAttribute ("EventProfilingOutput", StringValue (output));
+
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Simulator::ScheduleWithContext (1, MicroSeconds (i), &SimulatorEventProfilingTestCase::EventA, this, 0);
+    }
+  Simulator::ScheduleWithContext (2, MicroSeconds (1), &SimulatorEventProfilingTestCase::EventB, this);
+  Simulator::ScheduleWithContext (2, MicroSeconds (2), &SimulatorEventProfilingTestCase::EventB, this);
+  EventId cancelled = Simulator::Schedule (MicroSeconds (3), &SimulatorEventProfilingTestCase::EventB, this);
+  cancelled.Cancel ();
+  Simulator::Run ();
+
+  std::vector<EventProfiler::Stats> types = impl->GetEventProfiler ().GetEventTypeStats ();
+  NS_TEST_ASSERT_MSG_EQ (types.size (), 2, "Wrong number of event types");
+  uint64_t countA = 0;
+  for (const EventProfiler::Stats &stats : types)
+    {
+      NS_TEST_EXPECT_MSG_NE (stats.name.find ("SimulatorEventProfilingTestCase"), std::string::npos,
+                             "The event type does not name the class of the event");
+      if (stats.name.find ("(int)") != std::string::npos)
+        {
+          countA = stats.count;
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (countA, 3, "Wrong number of invocations of EventA");
+
+  std::vector<EventProfiler::Stats> contexts = impl->GetEventProfiler ().GetContextStats ();
+  NS_TEST_ASSERT_MSG_EQ (contexts.size (), 2, "Cancelled events are not profiled");
+  for (const EventProfiler::Stats &stats : contexts)
+    {
+      NS_TEST_EXPECT_MSG_EQ (stats.count, (stats.name == "1" ? 3 : 2),
+                             "Wrong number of events in context " << stats.name);
+    }
+
+  Simulator::Destroy ();
+  std::ifstream report (output.c_str ());
+  std::string line;
+  std::getline (report, line);
+  NS_TEST_EXPECT_MSG_EQ (line.find ("Event profile: 5 events"), 0, "Unexpected report " << line);
+}
+
+class SimulatorEventFunctionProfilingTestCase : public TestCase
+{
+public:
+  SimulatorEventFunctionProfilingTestCase ();
+  virtual void DoRun (void);
+  void EventB (void);
+  void EventC (void);
+};
+
+SimulatorEventFunctionProfilingTestCase::SimulatorEventFunctionProfilingTestCase ()
+  : TestCase ("Check that the events are profiled by the function they invoke")
+{}
+
+void
+SimulatorEventFunctionProfilingTestCase::EventB (void)
+{
+}
+
+void
+SimulatorEventFunctionProfilingTestCase::EventC (void)
+{
+}
+
+void
+SimulatorEventFunctionProfilingTestCase::DoRun (void)
+{
+  Ptr<DefaultSimulatorImpl> impl = DynamicCast<DefaultSimulatorImpl> (Simulator::GetImplementation ());
+  if (impl == 0)
+    {
+      Simulator::Destroy ();
+      return;
+    }
+  impl->SetAttribute ("EventProfiling", BooleanValue (true));
+  impl->SetAttribute ("EventProfilingOutput", StringValue (CreateTempDirFilename ("event-profile.txt")));
+
+  // EventB and EventC have the same signature, hence the same event type
+  Simulator::Schedule (MicroSeconds (1), &SimulatorEventFunctionProfilingTestCase::EventB, this);
+  Simulator::Schedule (MicroSeconds (2), &SimulatorEventFunctionProfilingTestCase::EventC, this);
+  Simulator::Schedule (MicroSeconds (3), &SimulatorEventFunctionProfilingTestCase::EventC, this);
+  // the timers of the wheel are reported as the event they invoke
+  TimerWheel::Schedule (MilliSeconds (5), &SimulatorEventFunctionProfilingTestCase::EventC, this);
+  Simulator::Run ();
+
+  std::vector<EventProfiler::Stats> types = impl->GetEventProfiler ().GetEventTypeStats ();
+  std::vector<EventProfiler::Stats> rows;
+  for (const EventProfiler::Stats &stats : types)
+    {
+      // skip the ticks of the timer wheel
+      if (stats.name.find ("SimulatorEventFunctionProfilingTestCase") != std::string::npos)
+        {
+          rows.push_back (stats);
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (rows.size (), 2, "EventB and EventC are not reported separately");
+  // the rows are sorted by decreasing wall-clock time
+  uint32_t b = (rows[0].count == 1) ? 0 : 1;
+  uint64_t countB = rows[b].count;
+  uint64_t countC = rows[1 - b].count;
+#ifdef HAVE_DLFCN_H
+  NS_TEST_EXPECT_MSG_NE (rows[b].name.find ("::EventB"), std::string::npos, "EventB not named in " << rows[b].name);
+  NS_TEST_EXPECT_MSG_NE (rows[1 - b].name.find ("::EventC"), std::string::npos, "EventC not named in " << rows[1 - b].name);
+#endif
+  NS_TEST_EXPECT_MSG_EQ (countB, 1, "Wrong number of invocations of EventB");
+  NS_TEST_EXPECT_MSG_EQ (countC, 3, "Wrong number of invocations of EventC");
+
+  Simulator::Destroy ();
+}
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -483,5 +698,18 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (PriorityQueueScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+
+    factory.SetTypeId (ListScheduler::GetTypeId ());
+    AddTestCase (new SimulatorCancelledEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (MapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorCancelledEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (HeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorCancelledEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (CalendarScheduler::GetTypeId ());
+    AddTestCase (new SimulatorCancelledEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (PriorityQueueScheduler::GetTypeId ());
+    AddTestCase (new SimulatorCancelledEventsTestCase (factory), TestCase::QUICK);
+    AddTestCase (new SimulatorEventProfilingTestCase (), TestCase::QUICK);
+    AddTestCase (new SimulatorEventFunctionProfilingTestCase (), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
@@ -0,0 +1,354 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/timer-wheel.h"
+#include "ns3/timer.h"
+#include "ns3/watchdog.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup timer
+ * \ingroup timer-tests
+ * TimerWheel test suite.
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup timer-tests
+ *  Check the expiration, cancellation and context of timer wheel events.
+ */
+class TimerWheelTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  TimerWheelTestCase ();
+  virtual void DoRun (void);
+  /**
+   * Record the expiration of an event.
+   * \param index The index of the event.
+   */
+  void Expire (uint32_t index);
+  /**
+   * Schedule an event on the wheel.
+   * \param delay The delay of the event.
+   * \param index The index of the event.
+   */
+  void Start (Time delay, uint32_t index);
+
+  std::vector<Time> m_expired;       //!< Expiration time of each event
+  std::vector<uint32_t> m_context;   //!< Context of each expired event
+  EventId m_now;                     //!< Event scheduled while its tick is processed
+};
+
+TimerWheelTestCase::TimerWheelTestCase ()
+  : TestCase ("Check the expiration of timer wheel events")
+{}
+
+void
+TimerWheelTestCase::Expire (uint32_t index)
+{
+  m_expired[index] = Simulator::Now ();
+  m_context[index] = Simulator::GetContext ();
+  if (index == 0)
+    {
+      // the tick of the current time has been processed
+      m_now = TimerWheel::Schedule (Time (0), &TimerWheelTestCase::Expire, this, 1);
+      NS_TEST_EXPECT_MSG_EQ (m_now.IsRunning (), true, "A scheduled event is running");
+    }
+  else if (index == 1)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_now.IsExpired (), true, "An event is expired while it runs");
+    }
+}
+
+void
+TimerWheelTestCase::Start (Time delay, uint32_t index)
+{
+  TimerWheel::Schedule (delay, &TimerWheelTestCase::Expire, this, index);
+}
+
+void
+TimerWheelTestCase::DoRun (void)
+{
+  m_expired.assign (4, Seconds (-1));
+  m_context.assign (4, 0);
+
+  NS_TEST_ASSERT_MSG_EQ (TimerWheel::GetGranularity (), MilliSeconds (1), "Unexpected default granularity");
+
+  EventId a = TimerWheel::Schedule (MicroSeconds (2500), &TimerWheelTestCase::Expire, this, 0);
+  EventId b = TimerWheel::Schedule (MilliSeconds (2), &TimerWheelTestCase::Expire, this, 3);
+  NS_TEST_EXPECT_MSG_EQ (a.IsRunning (), true, "A scheduled event is running");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetDelayLeft (a), MilliSeconds (3), "Expiration is rounded up to the tick");
+  NS_TEST_EXPECT_MSG_EQ (TimerWheel::GetNEvents (), 2, "Two events on the wheel");
+  b.Cancel ();
+  NS_TEST_EXPECT_MSG_EQ (b.IsExpired (), true, "A cancelled event is expired");
+
+  // the event is run in the context it was scheduled in
+  Simulator::ScheduleWithContext (7, MicroSeconds (5100), &TimerWheelTestCase::Start, this,
+                                  MicroSeconds (500), 2);
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_expired[0], MilliSeconds (3), "Event expired at the wrong time");
+  NS_TEST_EXPECT_MSG_EQ (m_expired[1], MilliSeconds (3), "Event expired at the wrong time");
+  NS_TEST_EXPECT_MSG_EQ (m_expired[2], MilliSeconds (6), "Event expired at the wrong time");
+  NS_TEST_EXPECT_MSG_EQ (m_context[2], 7, "Event run in the wrong context");
+  NS_TEST_EXPECT_MSG_EQ (m_expired[3], Seconds (-1), "A cancelled event expired");
+  NS_TEST_EXPECT_MSG_EQ (a.IsExpired (), true, "An event is expired once it has run");
+  NS_TEST_EXPECT_MSG_EQ (TimerWheel::GetNEvents (), 0, "The wheel is empty");
+  Simulator::Destroy ();
+}
+
+
+/**
+ * \ingroup timer-tests
+ *  Check the timer wheel events spread over all the levels of the wheel.
+ */
+class TimerWheelLevelsTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  TimerWheelLevelsTestCase ();
+  virtual void DoRun (void);
+  /**
+   * Check the expiration time of an event.
+   * \param expected The expected expiration time.
+   */
+  void Expire (Time expected);
+  /** Schedule the events to check. */
+  void Start (void);
+
+  uint32_t m_nExpired; //!< Number of expired events
+};
+
+TimerWheelLevelsTestCase::TimerWheelLevelsTestCase ()
+  : TestCase ("Check long timer wheel delays")
+{}
+
+void
+TimerWheelLevelsTestCase::Expire (Time expected)
+{
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), expected, "Event expired at the wrong time");
+  m_nExpired++;
+}
+
+void
+TimerWheelLevelsTestCase::Start (void)
+{
+  // delays in every level of the wheel and beyond, not aligned with the ticks
+  // of the wheel nor with the boundaries of the levels
+  const Time delays[] = {
+    MicroSeconds (100), MilliSeconds (255), MilliSeconds (256), MilliSeconds (300),
+    Seconds (65.5), Seconds (66), Seconds (100), Hours (4.7), Hours (5),
+    Hours (1200) + MicroSeconds (1)
+  };
+  for (const Time &delay : delays)
+    {
+      Time tick = TimerWheel::GetGranularity ();
+      Time expected = Simulator::Now () + delay;
+      expected = tick * ((expected.GetTimeStep () + tick.GetTimeStep () - 1) / tick.GetTimeStep ());
+      TimerWheel::Schedule (delay, &TimerWheelLevelsTestCase::Expire, this, expected);
+      TimerWheel::Schedule (delay, &TimerWheelLevelsTestCase::Expire, this, expected).Cancel ();
+    }
+}
+
+void
+TimerWheelLevelsTestCase::DoRun (void)
+{
+  m_nExpired = 0;
+  Simulator::Schedule (MicroSeconds (1700), &TimerWheelLevelsTestCase::Start, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  NS_TEST_EXPECT_MSG_EQ (m_nExpired, 10, "Not all the events expired");
+}
+
+
+/**
+ * \ingroup timer-tests
+ *  Check short timer wheel events added while a long one is pending.
+ */
+class TimerWheelLateScheduleTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  TimerWheelLateScheduleTestCase ();
+  virtual void DoRun (void);
+  /**
+   * Check the expiration time of an event.
+   * \param expected The expected expiration time.
+   */
+  void Expire (Time expected);
+  /**
+   * Schedule an event on the wheel.
+   * \param delay The delay of the event.
+   */
+  void Start (Time delay);
+
+  uint32_t m_nExpired; //!< Number of expired events
+};
+
+TimerWheelLateScheduleTestCase::TimerWheelLateScheduleTestCase ()
+  : TestCase ("Check short timer wheel delays added while a long one is pending")
+{}
+
+void
+TimerWheelLateScheduleTestCase::Expire (Time expected)
+{
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), expected, "Event expired at the wrong time");
+  m_nExpired++;
+}
+
+void
+TimerWheelLateScheduleTestCase::Start (Time delay)
+{
+  TimerWheel::Schedule (delay, &TimerWheelLateScheduleTestCase::Expire, this, Simulator::Now () + delay);
+}
+
+void
+TimerWheelLateScheduleTestCase::DoRun (void)
+{
+  m_nExpired = 0;
+  // the slots of the higher levels covering the time of the short events
+  // have been passed over since the long events were added, like a
+  // delayed ACK started while a retransmission timeout is pending
+  TimerWheel::Schedule (MilliSeconds (3000), &TimerWheelLateScheduleTestCase::Expire, this, MilliSeconds (3000));
+  Simulator::Schedule (MilliSeconds (700), &TimerWheelLateScheduleTestCase::Start, this, MilliSeconds (10));
+  Simulator::Schedule (MilliSeconds (300), &TimerWheelLateScheduleTestCase::Start, this, MilliSeconds (200));
+  Simulator::Schedule (MilliSeconds (768), &TimerWheelLateScheduleTestCase::Start, this, MilliSeconds (0));
+  Simulator::Schedule (MilliSeconds (2000), &TimerWheelLateScheduleTestCase::Start, this, Seconds (70));
+  Simulator::Schedule (Seconds (70), &TimerWheelLateScheduleTestCase::Start, this, MilliSeconds (1));
+  Simulator::Schedule (Seconds (70), &TimerWheelLateScheduleTestCase::Start, this, MilliSeconds (300));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_nExpired, 7, "Not all the events expired");
+  NS_TEST_EXPECT_MSG_EQ (TimerWheel::GetNEvents (), 0, "The wheel is empty");
+  Simulator::Destroy ();
+}
+
+
+/**
+ * \ingroup timer-tests
+ *  Check Timer and Watchdog scheduled on the timer wheel.
+ */
+class TimerWheelTimerTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  TimerWheelTimerTestCase ();
+  virtual void DoRun (void);
+  /**
+   * Record the expiration of a timer.
+   * \param arg The argument of the timer.
+   */
+  void Expire (int arg);
+
+  Time m_expiredTime;     //!< Time when the timer expired
+  int  m_expiredArgument; //!< Argument supplied to the expired timer
+  uint32_t m_nExpired;    //!< Number of expirations
+};
+
+TimerWheelTimerTestCase::TimerWheelTimerTestCase ()
+  : TestCase ("Check Timer and Watchdog on the timer wheel")
+{}
+
+void
+TimerWheelTimerTestCase::Expire (int arg)
+{
+  m_expiredTime = Simulator::Now ();
+  m_expiredArgument = arg;
+  m_nExpired++;
+}
+
+void
+TimerWheelTimerTestCase::DoRun (void)
+{
+  m_nExpired = 0;
+  Timer timer (Timer::CANCEL_ON_DESTROY);
+  timer.SetUseTimerWheel (true);
+  timer.SetFunction (&TimerWheelTimerTestCase::Expire, this);
+  timer.SetArguments (1);
+  timer.Schedule (MicroSeconds (1500));
+  NS_TEST_EXPECT_MSG_EQ (timer.IsRunning (), true, "Timer is running");
+  // rescheduling cancels the pending expiration
+  Simulator::Schedule (MilliSeconds (1), &Timer::Cancel, &timer);
+  Simulator::Schedule (MilliSeconds (1), &Timer::SetArguments<int>, &timer, 2);
+  Simulator::Schedule (MilliSeconds (1), static_cast<void (Timer::*) (Time)> (&Timer::Schedule),
+                       &timer, MilliSeconds (3));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_nExpired, 1, "Timer expired more than once");
+  NS_TEST_EXPECT_MSG_EQ (m_expiredTime, MilliSeconds (4), "Timer expired at the wrong time");
+  NS_TEST_EXPECT_MSG_EQ (m_expiredArgument, 2, "Timer got the wrong argument");
+  NS_TEST_EXPECT_MSG_EQ (timer.IsExpired (), true, "Timer is expired");
+
+  // suspend and resume
+  m_nExpired = 0;
+  timer.Schedule (MilliSeconds (5));
+  Simulator::Schedule (MilliSeconds (2), &Timer::Suspend, &timer);
+  Simulator::Schedule (MilliSeconds (10), &Timer::Resume, &timer);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_nExpired, 1, "Suspended timer expired more than once");
+  NS_TEST_EXPECT_MSG_EQ (m_expiredTime, MilliSeconds (17), "Resumed timer expired at the wrong time");
+
+  m_nExpired = 0;
+  Watchdog watchdog;
+  watchdog.SetUseTimerWheel (true);
+  watchdog.SetFunction (&TimerWheelTimerTestCase::Expire, this);
+  watchdog.SetArguments (3);
+  watchdog.Ping (MicroSeconds (10));
+  Simulator::Schedule (MicroSeconds (5), &Watchdog::Ping, &watchdog, MilliSeconds (2));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  NS_TEST_EXPECT_MSG_EQ (m_nExpired, 1, "Watchdog expired more than once");
+  NS_TEST_EXPECT_MSG_EQ (m_expiredTime, MilliSeconds (20), "Watchdog expired at the wrong time");
+  NS_TEST_EXPECT_MSG_EQ (m_expiredArgument, 3, "Watchdog got the wrong argument");
+}
+
+
+/**
+ * \ingroup timer-tests
+ *  TimerWheel test suite
+ */
+class TimerWheelTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  TimerWheelTestSuite ()
+    : TestSuite ("timer-wheel", UNIT)
+  {
+    AddTestCase (new TimerWheelTestCase (), TestCase::QUICK);
+    AddTestCase (new TimerWheelLevelsTestCase (), TestCase::QUICK);
+    AddTestCase (new TimerWheelLateScheduleTestCase (), TestCase::QUICK);
+    AddTestCase (new TimerWheelTimerTestCase (), TestCase::QUICK);
+  }
+};
+
+/**
+ * \ingroup timer-tests
+ * TimerWheelTestSuite instance variable.
+ */
+static TimerWheelTestSuite g_timerWheelTestSuite;
+
+
+}    // namespace tests
+
+}  // namespace ns3
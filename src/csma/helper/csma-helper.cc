@@ -214,6 +214,33 @@ CsmaHelper::EnableAsciiInternal (
   Config::Connect (oss.str (), MakeBoundCallback (&AsciiTraceHelper::DefaultDropSinkWithContext, stream));
 }
 
+void
+CsmaHelper::EnableBinaryTraceInternal (Ptr<BinaryTraceFile> file, Ptr<NetDevice> nd)
+{
+  //
+  // All of the binary trace enable functions vector through here.  We can
+  // only deal with devices of type CsmaNetDevice.
+  //
+  Ptr<CsmaNetDevice> device = nd->GetObject<CsmaNetDevice> ();
+  if (device == 0)
+    {
+      NS_LOG_INFO ("CsmaHelper::EnableBinaryTraceInternal(): Device " << device << " not of type ns3::CsmaNetDevice");
+      return;
+    }
+
+  //
+  // The same events as the ascii traces: MacRx provides the "r" event, and
+  // the "+", '-', and 'd' events are driven by the transmit queue.  All the
+  // packets carry the link layer header.
+  //
+  BinaryTraceHelper binaryTraceHelper;
+  binaryTraceHelper.HookDefaultSink<CsmaNetDevice> (device, "MacRx", file, device, 'r', PcapHelper::DLT_EN10MB);
+  Ptr<Queue<Packet> > queue = device->GetQueue ();
+  binaryTraceHelper.HookDefaultSink<Queue<Packet> > (queue, "Enqueue", file, device, '+', PcapHelper::DLT_EN10MB);
+  binaryTraceHelper.HookDefaultSink<Queue<Packet> > (queue, "Drop", file, device, 'd', PcapHelper::DLT_EN10MB);
+  binaryTraceHelper.HookDefaultSink<Queue<Packet> > (queue, "Dequeue", file, device, '-', PcapHelper::DLT_EN10MB);
+}
+
 NetDeviceContainer
 CsmaHelper::Install (Ptr<Node> node) const
 {
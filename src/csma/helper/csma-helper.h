@@ -43,7 +43,8 @@ class Packet;
  * encapsulates a general attribute or a set of functionality that
  * may be of interest to many other classes.
  */
-class CsmaHelper : public PcapHelperForDevice, public AsciiTraceHelperForDevice
+class CsmaHelper : public PcapHelperForDevice, public AsciiTraceHelperForDevice,
+                   public BinaryTraceHelperForDevice
 {
 public:
   /**
@@ -247,6 +248,17 @@ private:
                                     Ptr<NetDevice> nd,
                                     bool explicitFilename);
 
+  /**
+   * \brief Enable binary trace output on the indicated net device.
+   *
+   * NetDevice-specific implementation mechanism for hooking the trace and
+   * writing to the trace file.
+   *
+   * \param file The binary trace file to write the records to.
+   * \param nd Net device for which you want to enable tracing.
+   */
+  virtual void EnableBinaryTraceInternal (Ptr<BinaryTraceFile> file, Ptr<NetDevice> nd);
+
   ObjectFactory m_queueFactory;   //!< factory for the queues
   ObjectFactory m_deviceFactory;  //!< factory for the NetDevices
   ObjectFactory m_channelFactory; //!< factory for the channel
@@ -21,7 +21,11 @@
 #include "flow-monitor.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
+#include "ns3/abort.h"
 #include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
 #include <fstream>
 #include <sstream>
 
@@ -69,6 +73,38 @@ FlowMonitor::GetTypeId (void)
                    TimeValue (Seconds (0.5)),
                    MakeTimeAccessor (&FlowMonitor::m_flowInterruptionsMinTime),
                    MakeTimeChecker ())
+    .AddAttribute ("MaxTrackedPackets", ("The maximum number of packets in transit which are tracked, 0 for no limit.  "
+                                         "When the limit is reached, the least recently seen packet "
+                                         "is considered lost."),
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&FlowMonitor::m_maxTrackedPackets),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("FlowSampling", ("Monitor only one flow out of FlowSampling, chosen by a hash of the flow id.  "
+                                    "The statistics of the monitored flows are exact, the other flows are ignored."),
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&FlowMonitor::m_flowSampling),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("EnableHistograms", ("Fill the per-flow delay, jitter, packet size and flow interruptions histograms.  "
+                                        "The quantile sketches are enough to get the delay percentiles, "
+                                        "with much less memory."),
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&FlowMonitor::m_enableHistograms),
+                   MakeBooleanChecker ())
+    .AddAttribute ("SketchRelativeAccuracy", ("The relative accuracy of the per-flow delay and jitter quantile sketches "
+                                              "(e.g., 0.01), 0 to disable the sketches.  They take up to 32 kB per flow "
+                                              "and add the delayQuantiles and jitterQuantiles elements to the XML output."),
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&FlowMonitor::m_sketchAccuracy),
+                   MakeDoubleChecker <double> (0, 0.5))
+    .AddAttribute ("StreamInterval", ("The interval at which the statistics of the active flows are appended "
+                                      "to StreamFile, 0 to disable the streaming export."),
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&FlowMonitor::m_streamInterval),
+                   MakeTimeChecker ())
+    .AddAttribute ("StreamFile", ("The file of the streaming export, see StreamFlowStats."),
+                   StringValue ("flowmon-stream.csv"),
+                   MakeStringAccessor (&FlowMonitor::m_streamFileName),
+                   MakeStringChecker ())
   ;
   return tid;
 }
@@ -80,7 +116,11 @@ FlowMonitor::GetInstanceTypeId (void) const
 }
 
 FlowMonitor::FlowMonitor ()
-  : m_enabled (false)
+  : m_maxTrackedPackets (0),
+    m_flowSampling (1),
+    m_enabled (false),
+    m_enableHistograms (true),
+    m_sketchAccuracy (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -102,6 +142,9 @@ FlowMonitor::DoDispose (void)
       m_flowProbes[i]->Dispose ();
       m_flowProbes[i] = 0;
     }
+  m_trackedPackets.clear ();
+  m_trackedPacketAges.clear ();
+  m_stream.close ();
   Object::DoDispose ();
 }
 
@@ -109,11 +152,12 @@ inline FlowMonitor::FlowStats&
 FlowMonitor::GetStatsForFlow (FlowId flowId)
 {
   NS_LOG_FUNCTION (this);
-  FlowStatsContainerI iter;
-  iter = m_flowStats.find (flowId);
-  if (iter == m_flowStats.end ())
+  std::unordered_map<FlowId, FlowStats *>::iterator iter;
+  iter = m_flowStatsIndex.find (flowId);
+  if (iter == m_flowStatsIndex.end ())
     {
       FlowMonitor::FlowStats &ref = m_flowStats[flowId];
+      m_flowStatsIndex[flowId] = &ref;
       ref.delaySum = Seconds (0);
       ref.jitterSum = Seconds (0);
       ref.lastDelay = Seconds (0);
@@ -127,12 +171,37 @@ FlowMonitor::GetStatsForFlow (FlowId flowId)
       ref.jitterHistogram.SetDefaultBinWidth (m_jitterBinWidth);
       ref.packetSizeHistogram.SetDefaultBinWidth (m_packetSizeBinWidth);
       ref.flowInterruptionsHistogram.SetDefaultBinWidth (m_flowInterruptionsBinWidth);
+      if (m_sketchAccuracy > 0)
+        {
+          ref.delaySketch.SetRelativeAccuracy (m_sketchAccuracy);
+          ref.jitterSketch.SetRelativeAccuracy (m_sketchAccuracy);
+        }
       return ref;
     }
   else
     {
-      return iter->second;
+      return *iter->second;
+    }
+}
+
+bool
+FlowMonitor::IsSampled (FlowId flowId) const
+{
+  if (m_flowSampling <= 1)
+    {
+      return true;
     }
+  // Flow ids are sequential: scramble them so that the sampled flows
+  // are not correlated with the order in which the flows start.
+  uint32_t hash = flowId * 2654435761U;
+  return (hash >> 16) % m_flowSampling == 0;
+}
+
+void
+FlowMonitor::RemoveTrackedPacket (TrackedPacketMap::iterator tracked)
+{
+  m_trackedPacketAges.erase (tracked->second.age);
+  m_trackedPackets.erase (tracked);
 }
 
 
@@ -145,11 +214,22 @@ FlowMonitor::ReportFirstTx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t pack
       NS_LOG_DEBUG ("FlowMonitor not enabled; returning");
       return;
     }
+  if (!IsSampled (flowId))
+    {
+      return;
+    }
   Time now = Simulator::Now ();
-  TrackedPacket &tracked = m_trackedPackets[std::make_pair (flowId, packetId)];
+  TrackedPacketKey key (flowId, packetId);
+  std::pair<TrackedPacketMap::iterator, bool> inserted = m_trackedPackets.insert (std::make_pair (key, TrackedPacket ()));
+  TrackedPacket &tracked = inserted.first->second;
+  if (!inserted.second)
+    {
+      m_trackedPacketAges.erase (tracked.age);
+    }
   tracked.firstSeenTime = now;
   tracked.lastSeenTime = tracked.firstSeenTime;
   tracked.timesForwarded = 0;
+  tracked.age = m_trackedPacketAges.insert (m_trackedPacketAges.end (), key);
   NS_LOG_DEBUG ("ReportFirstTx: adding tracked packet (flowId=" << flowId << ", packetId=" << packetId
                                                                 << ").");
 
@@ -163,6 +243,17 @@ FlowMonitor::ReportFirstTx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t pack
       stats.timeFirstTxPacket = now;
     }
   stats.timeLastTxPacket = now;
+
+  if (m_maxTrackedPackets > 0 && m_trackedPackets.size () > m_maxTrackedPackets)
+    {
+      // evict the least recently seen packet, which is the most likely to be lost
+      TrackedPacketMap::iterator oldest = m_trackedPackets.find (m_trackedPacketAges.front ());
+      NS_ASSERT (oldest != m_trackedPackets.end ());
+      NS_LOG_DEBUG ("ReportFirstTx: too many tracked packets, (flowId=" << oldest->first.first
+                    << ", packetId=" << oldest->first.second << ") is considered lost.");
+      GetStatsForFlow (oldest->first.first).lostPackets++;
+      RemoveTrackedPacket (oldest);
+    }
 }
 
 
@@ -175,7 +266,11 @@ FlowMonitor::ReportForwarding (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t p
       NS_LOG_DEBUG ("FlowMonitor not enabled; returning");
       return;
     }
-  std::pair<FlowId, FlowPacketId> key (flowId, packetId);
+  if (!IsSampled (flowId))
+    {
+      return;
+    }
+  TrackedPacketKey key (flowId, packetId);
   TrackedPacketMap::iterator tracked = m_trackedPackets.find (key);
   if (tracked == m_trackedPackets.end ())
     {
@@ -186,6 +281,8 @@ FlowMonitor::ReportForwarding (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t p
 
   tracked->second.timesForwarded++;
   tracked->second.lastSeenTime = Simulator::Now ();
+  // the packet is now the most recently seen one
+  m_trackedPacketAges.splice (m_trackedPacketAges.end (), m_trackedPacketAges, tracked->second.age);
 
   Time delay = (Simulator::Now () - tracked->second.firstSeenTime);
   probe->AddPacketStats (flowId, packetSize, delay);
@@ -201,7 +298,11 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
       NS_LOG_DEBUG ("FlowMonitor not enabled; returning");
       return;
     }
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (std::make_pair (flowId, packetId));
+  if (!IsSampled (flowId))
+    {
+      return;
+    }
+  TrackedPacketMap::iterator tracked = m_trackedPackets.find (TrackedPacketKey (flowId, packetId));
   if (tracked == m_trackedPackets.end ())
     {
       NS_LOG_WARN ("Received packet last-tx report (flowId=" << flowId << ", packetId=" << packetId
@@ -215,25 +316,34 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
 
   FlowStats &stats = GetStatsForFlow (flowId);
   stats.delaySum += delay;
-  stats.delayHistogram.AddValue (delay.GetSeconds ());
+  if (m_enableHistograms)
+    {
+      stats.delayHistogram.AddValue (delay.GetSeconds ());
+    }
+  if (m_sketchAccuracy > 0)
+    {
+      stats.delaySketch.AddValue (delay.GetSeconds ());
+    }
   if (stats.rxPackets > 0 )
     {
-      Time jitter = stats.lastDelay - delay;
-      if (jitter > Seconds (0))
+      Time jitter = Abs (stats.lastDelay - delay);
+      stats.jitterSum += jitter;
+      if (m_enableHistograms)
         {
-          stats.jitterSum += jitter;
           stats.jitterHistogram.AddValue (jitter.GetSeconds ());
         }
-      else 
+      if (m_sketchAccuracy > 0)
         {
-          stats.jitterSum -= jitter;
-          stats.jitterHistogram.AddValue (-jitter.GetSeconds ());
+          stats.jitterSketch.AddValue (jitter.GetSeconds ());
         }
     }
   stats.lastDelay = delay;
 
   stats.rxBytes += packetSize;
-  stats.packetSizeHistogram.AddValue ((double) packetSize);
+  if (m_enableHistograms)
+    {
+      stats.packetSizeHistogram.AddValue ((double) packetSize);
+    }
   stats.rxPackets++;
   if (stats.rxPackets == 1)
     {
@@ -243,7 +353,7 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
     {
       // measure possible flow interruptions
       Time interArrivalTime = now - stats.timeLastRxPacket;
-      if (interArrivalTime > m_flowInterruptionsMinTime)
+      if (interArrivalTime > m_flowInterruptionsMinTime && m_enableHistograms)
         {
           stats.flowInterruptionsHistogram.AddValue (interArrivalTime.GetSeconds ());
         }
@@ -254,7 +364,7 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
   NS_LOG_DEBUG ("ReportLastTx: removing tracked packet (flowId="
                 << flowId << ", packetId=" << packetId << ").");
 
-  m_trackedPackets.erase (tracked); // we don't need to track this packet anymore
+  RemoveTrackedPacket (tracked); // we don't need to track this packet anymore
 }
 
 void
@@ -267,6 +377,10 @@ FlowMonitor::ReportDrop (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packetI
       NS_LOG_DEBUG ("FlowMonitor not enabled; returning");
       return;
     }
+  if (!IsSampled (flowId))
+    {
+      return;
+    }
 
   probe->AddPacketDropStats (flowId, packetSize, reasonCode);
 
@@ -281,14 +395,14 @@ FlowMonitor::ReportDrop (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packetI
   stats.bytesDropped[reasonCode] += packetSize;
   NS_LOG_DEBUG ("++stats.packetsDropped[" << reasonCode<< "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (std::make_pair (flowId, packetId));
+  TrackedPacketMap::iterator tracked = m_trackedPackets.find (TrackedPacketKey (flowId, packetId));
   if (tracked != m_trackedPackets.end ())
     {
       // we don't need to track this packet anymore
       // FIXME: this will not necessarily be true with broadcast/multicast
       NS_LOG_DEBUG ("ReportDrop: removing tracked packet (flowId="
                     << flowId << ", packetId=" << packetId << ").");
-      m_trackedPackets.erase (tracked);
+      RemoveTrackedPacket (tracked);
     }
 }
 
@@ -305,23 +419,22 @@ FlowMonitor::CheckForLostPackets (Time maxDelay)
   NS_LOG_FUNCTION (this << maxDelay.As (Time::S));
   Time now = Simulator::Now ();
 
-  for (TrackedPacketMap::iterator iter = m_trackedPackets.begin ();
-       iter != m_trackedPackets.end (); )
+  // The packets are sorted by last seen time: only the expired ones are visited.
+  while (!m_trackedPacketAges.empty ())
     {
-      if (now - iter->second.lastSeenTime >= maxDelay)
-        {
-          // packet is considered lost, add it to the loss statistics
-          FlowStatsContainerI flow = m_flowStats.find (iter->first.first);
-          NS_ASSERT (flow != m_flowStats.end ());
-          flow->second.lostPackets++;
-
-          // we won't track it anymore
-          m_trackedPackets.erase (iter++);
-        }
-      else
+      TrackedPacketMap::iterator iter = m_trackedPackets.find (m_trackedPacketAges.front ());
+      NS_ASSERT (iter != m_trackedPackets.end ());
+      if (now - iter->second.lastSeenTime < maxDelay)
         {
-          iter++;
+          break;
         }
+      // packet is considered lost, add it to the loss statistics
+      std::unordered_map<FlowId, FlowStats *>::iterator flow = m_flowStatsIndex.find (iter->first.first);
+      NS_ASSERT (flow != m_flowStatsIndex.end ());
+      flow->second->lostPackets++;
+
+      // we won't track it anymore
+      RemoveTrackedPacket (iter);
     }
 }
 
@@ -338,11 +451,58 @@ FlowMonitor::PeriodicCheckForLostPackets ()
   Simulator::Schedule (PERIODIC_CHECK_INTERVAL, &FlowMonitor::PeriodicCheckForLostPackets, this);
 }
 
+void
+FlowMonitor::PeriodicStreamFlowStats ()
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_stream.is_open ())
+    {
+      m_stream.open (m_streamFileName.c_str ());
+      NS_ABORT_MSG_UNLESS (m_stream.is_open (), "Unable to open " << m_streamFileName);
+      m_stream << "time,flowId,txPackets,rxPackets,lostPackets,txBytes,rxBytes,"
+               << "delayMean,delayP50,delayP99,delayP999,jitterP50,jitterP99\n";
+    }
+  Time now = Simulator::Now ();
+  StreamFlowStats (m_stream, m_lastStreamTime);
+  m_stream.flush ();
+  m_lastStreamTime = now;
+  Simulator::Schedule (m_streamInterval, &FlowMonitor::PeriodicStreamFlowStats, this);
+}
+
+void
+FlowMonitor::StreamFlowStats (std::ostream &os, Time since) const
+{
+  NS_LOG_FUNCTION (this << since.As (Time::S));
+  int64_t now = Simulator::Now ().GetNanoSeconds ();
+  for (FlowStatsContainerCI flowI = m_flowStats.begin ();
+       flowI != m_flowStats.end (); flowI++)
+    {
+      const FlowStats &stats = flowI->second;
+      if (stats.timeLastTxPacket < since && (stats.rxPackets == 0 || stats.timeLastRxPacket < since))
+        {
+          continue;
+        }
+      os << now << "," << flowI->first << ","
+         << stats.txPackets << "," << stats.rxPackets << "," << stats.lostPackets << ","
+         << stats.txBytes << "," << stats.rxBytes << ","
+         << (stats.rxPackets > 0 ? stats.delaySum.GetSeconds () / stats.rxPackets : 0) << ","
+         << stats.delaySketch.GetQuantile (0.5) << ","
+         << stats.delaySketch.GetQuantile (0.99) << ","
+         << stats.delaySketch.GetQuantile (0.999) << ","
+         << stats.jitterSketch.GetQuantile (0.5) << ","
+         << stats.jitterSketch.GetQuantile (0.99) << "\n";
+    }
+}
+
 void
 FlowMonitor::NotifyConstructionCompleted ()
 {
   Object::NotifyConstructionCompleted ();
   Simulator::Schedule (PERIODIC_CHECK_INTERVAL, &FlowMonitor::PeriodicCheckForLostPackets, this);
+  if (m_streamInterval.IsStrictlyPositive ())
+    {
+      Simulator::Schedule (m_streamInterval, &FlowMonitor::PeriodicStreamFlowStats, this);
+    }
 }
 
 void
@@ -471,6 +631,14 @@ FlowMonitor::SerializeToXmlStream (std::ostream &os, uint16_t indent, bool enabl
           flowI->second.packetSizeHistogram.SerializeToXmlStream (os, indent, "packetSizeHistogram");
           flowI->second.flowInterruptionsHistogram.SerializeToXmlStream (os, indent, "flowInterruptionsHistogram");
         }
+      if (flowI->second.delaySketch.GetCount () > 0)
+        {
+          flowI->second.delaySketch.SerializeToXmlStream (os, indent, "delayQuantiles");
+        }
+      if (flowI->second.jitterSketch.GetCount () > 0)
+        {
+          flowI->second.jitterSketch.SerializeToXmlStream (os, indent, "jitterQuantiles");
+        }
       indent -= 2;
 
       os << std::string ( indent, ' ' ) << "</Flow>\n";
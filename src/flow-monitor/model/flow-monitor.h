@@ -23,12 +23,16 @@
 
 #include <vector>
 #include <map>
+#include <list>
+#include <unordered_map>
+#include <fstream>
 
 #include "ns3/ptr.h"
 #include "ns3/object.h"
 #include "ns3/flow-probe.h"
 #include "ns3/flow-classifier.h"
 #include "ns3/histogram.h"
+#include "ns3/quantile-sketch.h"
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
 
@@ -135,6 +139,14 @@ public:
     /// comment in attribute packetsDropped.
     std::vector<uint64_t> bytesDropped; // bytesDropped[reasonCode] => number of dropped bytes
     Histogram flowInterruptionsHistogram; //!< histogram of durations of flow interruptions
+
+    /// Quantile sketch of the packet delays, in seconds.  Unlike the
+    /// histograms, its size is bounded and it can be merged with the
+    /// sketches of other flows (or of other simulations).  It is empty
+    /// unless the SketchRelativeAccuracy attribute is set.
+    QuantileSketch delaySketch;
+    /// Quantile sketch of the packet jitters, in seconds
+    QuantileSketch jitterSketch;
   };
 
   // --- basic methods ---
@@ -258,6 +270,18 @@ public:
   /// \param enableProbes if true, include also the per-probe/flow pair statistics in the output
   void SerializeToXmlFile (std::string fileName, bool enableHistograms, bool enableProbes);
 
+  /// Writes the statistics of the flows active since a given time
+  /// as comma-separated values, one line per flow: time (ns), flowId,
+  /// txPackets, rxPackets, lostPackets, txBytes, rxBytes, and the mean,
+  /// 50th, 99th and 99.9th percentiles of the delay and the 50th and
+  /// 99th percentiles of the jitter (s).  The statistics are cumulative.
+  /// This is what is written periodically to the StreamFile.  The
+  /// percentiles are 0 unless the SketchRelativeAccuracy attribute is set.
+  /// \param os the output stream
+  /// \param since the flows which neither sent nor received packets
+  ///        since this time are skipped
+  void StreamFlowStats (std::ostream &os, Time since) const;
+
 
 protected:
 
@@ -266,21 +290,46 @@ protected:
 
 private:
 
+  /// (FlowId,PacketId) identifying a tracked packet
+  typedef std::pair<FlowId, FlowPacketId> TrackedPacketKey;
+
+  /// Hash function of the tracked packet keys
+  struct TrackedPacketKeyHash
+  {
+    /// \param key the key
+    /// \returns the hash of the key
+    std::size_t operator() (const TrackedPacketKey &key) const
+    {
+      return std::hash<uint64_t> () ((static_cast<uint64_t> (key.first) << 32) | key.second);
+    }
+  };
+
+  /// Tracked packets, from the least recently seen to the most recently seen
+  typedef std::list<TrackedPacketKey> TrackedPacketAgeList;
+
   /// Structure to represent a single tracked packet data
   struct TrackedPacket
   {
     Time firstSeenTime; //!< absolute time when the packet was first seen by a probe
     Time lastSeenTime; //!< absolute time when the packet was last seen by a probe
     uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
+    TrackedPacketAgeList::iterator age; //!< position of the packet in m_trackedPacketAges
   };
 
   /// FlowId --> FlowStats
   FlowStatsContainer m_flowStats;
+  /// FlowId --> FlowStats, an index of m_flowStats for the per-packet lookups
+  std::unordered_map<FlowId, FlowStats *> m_flowStatsIndex;
 
   /// (FlowId,PacketId) --> TrackedPacket
-  typedef std::map< std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
+  typedef std::unordered_map<TrackedPacketKey, TrackedPacket, TrackedPacketKeyHash> TrackedPacketMap;
   TrackedPacketMap m_trackedPackets; //!< Tracked packets
+  /// Tracked packets sorted by last seen time, so that the packets
+  /// which appear to be lost are found without scanning all of them
+  TrackedPacketAgeList m_trackedPacketAges;
   Time m_maxPerHopDelay; //!< Minimum per-hop delay
+  uint32_t m_maxTrackedPackets; //!< Maximum number of tracked packets, 0 if unlimited
+  uint32_t m_flowSampling; //!< One flow out of m_flowSampling is monitored
   FlowProbeContainer m_flowProbes; //!< all the FlowProbes
 
   // note: this is needed only for serialization
@@ -294,6 +343,12 @@ private:
   double m_packetSizeBinWidth;  //!< packet size bin width (for histograms)
   double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
   Time m_flowInterruptionsMinTime; //!< Flow interruptions minimum time
+  bool m_enableHistograms;  //!< Fill the per-flow histograms
+  double m_sketchAccuracy;  //!< Relative accuracy of the quantile sketches, 0 if disabled
+  Time m_streamInterval;    //!< Interval of the streaming export, 0 if disabled
+  std::string m_streamFileName; //!< File of the streaming export
+  std::ofstream m_stream;   //!< Streaming export file
+  Time m_lastStreamTime;    //!< Time of the last streaming export
 
   /// Get the stats for a given flow
   /// \param flowId the Flow identification
@@ -302,6 +357,18 @@ private:
 
   /// Periodic function to check for lost packets and prune statistics
   void PeriodicCheckForLostPackets ();
+
+  /// Periodic function to export the statistics of the active flows
+  void PeriodicStreamFlowStats ();
+
+  /// Check whether a flow is monitored, see the FlowSampling attribute
+  /// \param flowId the Flow identification
+  /// \returns true if the flow is monitored
+  bool IsSampled (FlowId flowId) const;
+
+  /// Stop tracking a packet
+  /// \param tracked the tracked packet
+  void RemoveTrackedPacket (TrackedPacketMap::iterator tracked);
 };
 
 
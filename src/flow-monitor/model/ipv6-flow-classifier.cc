@@ -97,6 +97,17 @@ bool operator == (const Ipv6FlowClassifier::FiveTuple &t1,
 
 
 
+std::size_t
+Ipv6FlowClassifier::FiveTupleHash::operator() (const FiveTuple &tuple) const
+{
+  std::size_t hash = Ipv6AddressHash () (tuple.sourceAddress);
+  hash = hash * 31 + Ipv6AddressHash () (tuple.destinationAddress);
+  hash = hash * 31 + tuple.protocol;
+  hash = hash * 31 + ((static_cast<uint32_t> (tuple.sourcePort) << 16) | tuple.destinationPort);
+  return hash;
+}
+
+
 Ipv6FlowClassifier::Ipv6FlowClassifier ()
 {
 }
@@ -149,35 +160,31 @@ Ipv6FlowClassifier::Classify (const Ipv6Header &ipHeader, Ptr<const Packet> ipPa
   tuple.destinationPort = dstPort;
 
   // try to insert the tuple, but check if it already exists
-  std::pair<std::map<FiveTuple, FlowId>::iterator, bool> insert
+  std::pair<std::unordered_map<FiveTuple, FlowId, FiveTupleHash>::iterator, bool> insert
     = m_flowMap.insert (std::pair<FiveTuple, FlowId> (tuple, 0));
 
   // if the insertion succeeded, we need to assign this tuple a new flow identifier
   if (insert.second)
     {
       FlowId newFlowId = GetNewFlowId ();
+      NS_ASSERT (newFlowId == m_flows.size () + 1);
       insert.first->second = newFlowId;
-      m_flowPktIdMap[newFlowId] = 0;
-      m_flowDscpMap[newFlowId];
+      FlowData data;
+      data.tuple = tuple;
+      data.lastPacketId = 0;
+      m_flows.push_back (data);
     }
   else
     {
-      m_flowPktIdMap[insert.first->second] ++;
+      m_flows[insert.first->second - 1].lastPacketId ++;
     }
+  FlowData &flow = m_flows[insert.first->second - 1];
 
   // increment the counter of packets with the same DSCP value
-  Ipv6Header::DscpType dscp = ipHeader.GetDscp ();
-  std::pair<std::map<Ipv6Header::DscpType, uint32_t>::iterator, bool> dscpInserter
-    = m_flowDscpMap[insert.first->second].insert (std::pair<Ipv6Header::DscpType, uint32_t> (dscp, 1));
-
-  // if the insertion did not succeed, we need to increment the counter
-  if (!dscpInserter.second)
-    {
-      m_flowDscpMap[insert.first->second][dscp] ++;
-    }
+  flow.dscpCounts[ipHeader.GetDscp ()] ++;
 
   *out_flowId = insert.first->second;
-  *out_packetId = m_flowPktIdMap[*out_flowId];
+  *out_packetId = flow.lastPacketId;
 
   return true;
 }
@@ -186,13 +193,9 @@ Ipv6FlowClassifier::Classify (const Ipv6Header &ipHeader, Ptr<const Packet> ipPa
 Ipv6FlowClassifier::FiveTuple
 Ipv6FlowClassifier::FindFlow (FlowId flowId) const
 {
-  for (std::map<FiveTuple, FlowId>::const_iterator
-       iter = m_flowMap.begin (); iter != m_flowMap.end (); iter++)
+  if (flowId > 0 && flowId <= m_flows.size ())
     {
-      if (iter->second == flowId)
-        {
-          return iter->first;
-        }
+      return m_flows[flowId - 1].tuple;
     }
   NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
   FiveTuple retval = { Ipv6Address::GetZero (), Ipv6Address::GetZero (), 0, 0, 0 };
@@ -209,15 +212,13 @@ Ipv6FlowClassifier::SortByCount::operator() (std::pair<Ipv6Header::DscpType, uin
 std::vector<std::pair<Ipv6Header::DscpType, uint32_t> >
 Ipv6FlowClassifier::GetDscpCounts (FlowId flowId) const
 {
-  std::map<FlowId, std::map<Ipv6Header::DscpType, uint32_t> >::const_iterator flow
-    = m_flowDscpMap.find (flowId);
-
-  if (flow == m_flowDscpMap.end ())
+  if (flowId == 0 || flowId > m_flows.size ())
     {
       NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
     }
 
-  std::vector<std::pair<Ipv6Header::DscpType, uint32_t> > v (flow->second.begin (), flow->second.end ());
+  const std::map<Ipv6Header::DscpType, uint32_t> &counts = m_flows[flowId - 1].dscpCounts;
+  std::vector<std::pair<Ipv6Header::DscpType, uint32_t> > v (counts.begin (), counts.end ());
   std::sort (v.begin (), v.end (), SortByCount ());
   return v;
 }
@@ -228,9 +229,12 @@ Ipv6FlowClassifier::SerializeToXmlStream (std::ostream &os, uint16_t indent) con
   Indent (os, indent); os << "<Ipv6FlowClassifier>\n";
 
   indent += 2;
+  // the flows are written in the order of their FiveTuple
+  std::map<FiveTuple, FlowId> sortedFlows (m_flowMap.begin (), m_flowMap.end ());
   for (std::map<FiveTuple, FlowId>::const_iterator
-       iter = m_flowMap.begin (); iter != m_flowMap.end (); iter++)
+       iter = sortedFlows.begin (); iter != sortedFlows.end (); iter++)
     {
+      const FlowData &flow = m_flows[iter->second - 1];
       Indent (os, indent);
       os << "<Flow flowId=\"" << iter->second << "\""
          << " sourceAddress=\"" << iter->first.sourceAddress << "\""
@@ -240,17 +244,11 @@ Ipv6FlowClassifier::SerializeToXmlStream (std::ostream &os, uint16_t indent) con
          << " destinationPort=\"" << iter->first.destinationPort << "\">\n";
 
       indent += 2;
-      std::map<FlowId, std::map<Ipv6Header::DscpType, uint32_t> >::const_iterator flow
-        = m_flowDscpMap.find (iter->second);
-
-      if (flow != m_flowDscpMap.end ())
+      for (std::map<Ipv6Header::DscpType, uint32_t>::const_iterator dscp = flow.dscpCounts.begin (); dscp != flow.dscpCounts.end (); dscp++)
         {
-          for (std::map<Ipv6Header::DscpType, uint32_t>::const_iterator i = flow->second.begin (); i != flow->second.end (); i++)
-            {
-              Indent (os, indent);
-              os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t> (i->first) << "\""
-                 << " packets=\"" << std::dec << i->second << "\" />\n";
-            }
+          Indent (os, indent);
+          os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t> (dscp->first) << "\""
+             << " packets=\"" << std::dec << dscp->second << "\" />\n";
         }
 
       indent -= 2;
@@ -24,6 +24,8 @@
 
 #include <stdint.h>
 #include <map>
+#include <vector>
+#include <unordered_map>
 
 #include "ns3/ipv6-header.h"
 #include "ns3/flow-classifier.h"
@@ -93,12 +95,26 @@ public:
 
 private:
 
+  /// Hash function of the FiveTuples
+  struct FiveTupleHash
+  {
+    /// \param tuple the FiveTuple
+    /// \returns the hash of the FiveTuple
+    std::size_t operator() (const FiveTuple &tuple) const;
+  };
+
+  /// Data of a flow
+  struct FlowData
+  {
+    FiveTuple tuple;            //!< the flow FiveTuple
+    FlowPacketId lastPacketId;  //!< the identifier of the last packet of the flow
+    std::map<Ipv6Header::DscpType, uint32_t> dscpCounts; //!< (DSCP value, packet count) pairs
+  };
+
   /// Map to Flows Identifiers to FlowIds
-  std::map<FiveTuple, FlowId> m_flowMap;
-  /// Map to FlowIds to FlowPacketId
-  std::map<FlowId, FlowPacketId> m_flowPktIdMap;
-  /// Map FlowIds to (DSCP value, packet count) pairs
-  std::map<FlowId, std::map<Ipv6Header::DscpType, uint32_t> > m_flowDscpMap;
+  std::unordered_map<FiveTuple, FlowId, FiveTupleHash> m_flowMap;
+  /// Data of the flows, indexed by FlowId - 1 (flow identifiers are assigned sequentially)
+  std::vector<FlowData> m_flows;
 
 };
 
@@ -0,0 +1,495 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/object-factory.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+#include "ns3/nstime.h"
+#include "ns3/string.h"
+#include "ns3/packet.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/udp-header.h"
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/ipv4-flow-classifier.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup flow-monitor
+ * \defgroup flow-monitor-test Flow Monitor module tests
+ */
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief A FlowProbe reporting the packet events chosen by the tests.
+ */
+class FlowMonitorTestProbe : public FlowProbe
+{
+public:
+  /**
+   * Constructor
+   * \param monitor the FlowMonitor
+   */
+  FlowMonitorTestProbe (Ptr<FlowMonitor> monitor)
+    : FlowProbe (monitor)
+  {
+  }
+};
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief Check that the packets evicted by MaxTrackedPackets are counted
+ * as lost, and that the least recently seen packet is evicted.
+ */
+class FlowMonitorMaxTrackedPacketsTestCase : public TestCase
+{
+public:
+  FlowMonitorMaxTrackedPacketsTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+FlowMonitorMaxTrackedPacketsTestCase::FlowMonitorMaxTrackedPacketsTestCase ()
+  : TestCase ("Check the eviction of the tracked packets")
+{
+}
+
+void
+FlowMonitorMaxTrackedPacketsTestCase::DoRun (void)
+{
+  Ptr<FlowMonitor> monitor = CreateObject<FlowMonitor> ();
+  monitor->SetAttribute ("MaxTrackedPackets", UintegerValue (2));
+  Ptr<FlowProbe> probe = CreateObject<FlowMonitorTestProbe> (monitor);
+  monitor->StartRightNow ();
+
+  const FlowId flowId = 1;
+  monitor->ReportFirstTx (probe, flowId, 1, 100);
+  monitor->ReportFirstTx (probe, flowId, 2, 100);
+  // packet 1 is the least recently seen one
+  monitor->ReportFirstTx (probe, flowId, 3, 100);
+  NS_TEST_EXPECT_MSG_EQ (monitor->GetFlowStats ().at (flowId).lostPackets, 1, "The evicted packet is not counted as lost");
+
+  // forwarding packet 2 makes packet 3 the least recently seen one
+  monitor->ReportForwarding (probe, flowId, 2, 100);
+  monitor->ReportFirstTx (probe, flowId, 4, 100);
+  NS_TEST_EXPECT_MSG_EQ (monitor->GetFlowStats ().at (flowId).lostPackets, 2, "The evicted packet is not counted as lost");
+
+  // the evicted packets are no longer tracked: their reception is ignored
+  monitor->ReportLastRx (probe, flowId, 1, 100);
+  monitor->ReportLastRx (probe, flowId, 3, 100);
+  NS_TEST_EXPECT_MSG_EQ (monitor->GetFlowStats ().at (flowId).rxPackets, 0, "The reception of an evicted packet is counted");
+  monitor->ReportLastRx (probe, flowId, 2, 100);
+  monitor->ReportLastRx (probe, flowId, 4, 100);
+
+  FlowMonitor::FlowStats stats = monitor->GetFlowStats ().at (flowId);
+  NS_TEST_EXPECT_MSG_EQ (stats.txPackets, 4, "Wrong number of transmitted packets");
+  NS_TEST_EXPECT_MSG_EQ (stats.rxPackets, 2, "The tracked packets are not received");
+  NS_TEST_EXPECT_MSG_EQ (stats.timesForwarded, 1, "Wrong number of forwardings");
+  NS_TEST_EXPECT_MSG_EQ (stats.lostPackets, 2, "Wrong number of lost packets");
+
+  // nothing is left to be lost
+  monitor->CheckForLostPackets (Seconds (0));
+  NS_TEST_EXPECT_MSG_EQ (monitor->GetFlowStats ().at (flowId).lostPackets, 2, "A packet is still tracked");
+
+  monitor->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief Check that only the sampled flows are monitored, with exact
+ * statistics.
+ */
+class FlowMonitorFlowSamplingTestCase : public TestCase
+{
+public:
+  FlowMonitorFlowSamplingTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+FlowMonitorFlowSamplingTestCase::FlowMonitorFlowSamplingTestCase ()
+  : TestCase ("Check the flow sampling")
+{
+}
+
+void
+FlowMonitorFlowSamplingTestCase::DoRun (void)
+{
+  Ptr<FlowMonitor> monitor = CreateObject<FlowMonitor> ();
+  monitor->SetAttribute ("FlowSampling", UintegerValue (4));
+  Ptr<FlowProbe> probe = CreateObject<FlowMonitorTestProbe> (monitor);
+  monitor->StartRightNow ();
+
+  const uint32_t nFlows = 256;
+  const uint32_t nPackets = 10;
+  for (FlowId flowId = 1; flowId <= nFlows; flowId++)
+    {
+      for (FlowPacketId packetId = 0; packetId < nPackets; packetId++)
+        {
+          monitor->ReportFirstTx (probe, flowId, packetId, 100);
+          monitor->ReportForwarding (probe, flowId, packetId, 100);
+          if (packetId % 2)
+            {
+              monitor->ReportLastRx (probe, flowId, packetId, 100);
+            }
+          else
+            {
+              monitor->ReportDrop (probe, flowId, packetId, 100, 0);
+            }
+        }
+    }
+
+  FlowMonitor::FlowStatsContainer stats = monitor->GetFlowStats ();
+  NS_TEST_EXPECT_MSG_GT (stats.size (), nFlows / 8, "Too few flows sampled");
+  NS_TEST_EXPECT_MSG_LT (stats.size (), nFlows / 2, "Too many flows sampled");
+  for (FlowMonitor::FlowStatsContainerCI it = stats.begin (); it != stats.end (); ++it)
+    {
+      NS_TEST_EXPECT_MSG_EQ (it->second.txPackets, nPackets, "Flow " << it->first << " partially monitored");
+      NS_TEST_EXPECT_MSG_EQ (it->second.rxPackets, nPackets / 2, "Flow " << it->first << " partially monitored");
+      NS_TEST_EXPECT_MSG_EQ (it->second.packetsDropped.size (), 1, "Flow " << it->first << " partially monitored");
+      NS_TEST_EXPECT_MSG_EQ (it->second.packetsDropped[0], nPackets / 2, "Flow " << it->first << " partially monitored");
+      NS_TEST_EXPECT_MSG_EQ (it->second.timesForwarded, nPackets / 2, "Flow " << it->first << " partially monitored");
+    }
+
+  // the probes only see the sampled flows
+  FlowProbe::Stats probeStats = probe->GetStats ();
+  NS_TEST_EXPECT_MSG_EQ (probeStats.size (), stats.size (), "The probe sees flows which are not sampled");
+  for (FlowProbe::Stats::const_iterator it = probeStats.begin (); it != probeStats.end (); ++it)
+    {
+      NS_TEST_EXPECT_MSG_EQ ((stats.find (it->first) != stats.end ()), true, "Flow " << it->first << " is not sampled");
+    }
+
+  monitor->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief Check that Ipv4FlowClassifier writes the flows in the order of
+ * their FiveTuple.
+ */
+class Ipv4FlowClassifierXmlOrderTestCase : public TestCase
+{
+public:
+  Ipv4FlowClassifierXmlOrderTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+Ipv4FlowClassifierXmlOrderTestCase::Ipv4FlowClassifierXmlOrderTestCase ()
+  : TestCase ("Check the order of the flows of Ipv4FlowClassifier")
+{
+}
+
+void
+Ipv4FlowClassifierXmlOrderTestCase::DoRun (void)
+{
+  Ptr<Ipv4FlowClassifier> classifier = Create<Ipv4FlowClassifier> ();
+  // the flows are classified in the reverse order of their source address
+  const char *sources[] = { "10.0.0.3", "10.0.0.2", "10.0.0.1" };
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Ipv4Header ipHeader;
+      ipHeader.SetSource (Ipv4Address (sources[i]));
+      ipHeader.SetDestination (Ipv4Address ("10.0.1.1"));
+      ipHeader.SetProtocol (17);
+      UdpHeader udpHeader;
+      udpHeader.SetSourcePort (1000);
+      udpHeader.SetDestinationPort (9);
+      Ptr<Packet> packet = Create<Packet> (10);
+      packet->AddHeader (udpHeader);
+      uint32_t flowId;
+      uint32_t packetId;
+      NS_TEST_ASSERT_MSG_EQ (classifier->Classify (ipHeader, packet, &flowId, &packetId), true, "Packet not classified");
+      NS_TEST_EXPECT_MSG_EQ (flowId, i + 1, "Wrong flow id");
+    }
+
+  std::ostringstream oss;
+  classifier->SerializeToXmlStream (oss, 0);
+  std::string xml = oss.str ();
+  std::string::size_type flow1 = xml.find ("flowId=\"1\"");
+  std::string::size_type flow2 = xml.find ("flowId=\"2\"");
+  std::string::size_type flow3 = xml.find ("flowId=\"3\"");
+  NS_TEST_ASSERT_MSG_NE (flow1, std::string::npos, "Flow 1 not written");
+  NS_TEST_ASSERT_MSG_NE (flow2, std::string::npos, "Flow 2 not written");
+  NS_TEST_ASSERT_MSG_NE (flow3, std::string::npos, "Flow 3 not written");
+  NS_TEST_EXPECT_MSG_LT (flow3, flow2, "The flows are not sorted by FiveTuple");
+  NS_TEST_EXPECT_MSG_LT (flow2, flow1, "The flows are not sorted by FiveTuple");
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief Send the packets of a flow every 10 ms, with a delay alternating
+ * between 1 and 3 ms, so that the jitter is always 2 ms.
+ *
+ * \param monitor the FlowMonitor
+ * \param probe the probe reporting the packets
+ * \param flowId the flow id
+ * \param start the time of the first packet
+ * \param nPackets the number of packets
+ */
+static void
+ScheduleFlowMonitorTestFlow (Ptr<FlowMonitor> monitor, Ptr<FlowProbe> probe, FlowId flowId,
+                             Time start, uint32_t nPackets)
+{
+  for (FlowPacketId packetId = 0; packetId < nPackets; packetId++)
+    {
+      Time txTime = start + MilliSeconds (10 * packetId);
+      Time delay = MilliSeconds (packetId % 2 ? 3 : 1);
+      Simulator::Schedule (txTime, &FlowMonitor::ReportFirstTx, monitor, probe, flowId, packetId, 100);
+      Simulator::Schedule (txTime + delay, &FlowMonitor::ReportLastRx, monitor, probe, flowId, packetId, 100);
+    }
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief Check the rows of the streaming export: only the flows active
+ * since the previous export are written, with their cumulative statistics
+ * and percentiles.
+ */
+class FlowMonitorStreamTestCase : public TestCase
+{
+public:
+  FlowMonitorStreamTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+FlowMonitorStreamTestCase::FlowMonitorStreamTestCase ()
+  : TestCase ("Check the streaming export")
+{
+}
+
+void
+FlowMonitorStreamTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("flowmon-stream.csv");
+  ObjectFactory factory;
+  factory.SetTypeId ("ns3::FlowMonitor");
+  factory.Set ("SketchRelativeAccuracy", DoubleValue (0.01));
+  factory.Set ("StreamInterval", TimeValue (MilliSeconds (100)));
+  factory.Set ("StreamFile", StringValue (fileName));
+  Ptr<FlowMonitor> monitor = factory.Create<FlowMonitor> ();
+  Ptr<FlowProbe> probe = CreateObject<FlowMonitorTestProbe> (monitor);
+  monitor->StartRightNow ();
+
+  // flow 1 is active until 148 ms, flow 2 until 45 ms
+  ScheduleFlowMonitorTestFlow (monitor, probe, 1, MilliSeconds (5), 15);
+  ScheduleFlowMonitorTestFlow (monitor, probe, 2, MilliSeconds (2), 5);
+  Simulator::Stop (MilliSeconds (350));
+  Simulator::Run ();
+
+  std::ifstream file (fileName.c_str ());
+  NS_TEST_ASSERT_MSG_EQ (file.is_open (), true, "Unable to open " << fileName);
+  std::string line;
+  std::getline (file, line);
+  NS_TEST_EXPECT_MSG_EQ (line, "time,flowId,txPackets,rxPackets,lostPackets,txBytes,rxBytes,"
+                         "delayMean,delayP50,delayP99,delayP999,jitterP50,jitterP99", "Wrong header");
+  std::vector<std::vector<double> > rows;
+  while (std::getline (file, line))
+    {
+      std::vector<double> row;
+      std::istringstream iss (line);
+      std::string field;
+      while (std::getline (iss, field, ','))
+        {
+          row.push_back (std::atof (field.c_str ()));
+        }
+      NS_TEST_ASSERT_MSG_EQ (row.size (), 13, "Wrong number of fields in " << line);
+      rows.push_back (row);
+    }
+
+  // the export at 300 ms has no active flow
+  NS_TEST_ASSERT_MSG_EQ (rows.size (), 3, "Wrong number of rows");
+
+  // flow 1 at 100 ms: 10 packets, half of them with a delay of 1 ms
+  NS_TEST_EXPECT_MSG_EQ (rows[0][0], 100e6, "Wrong time");
+  NS_TEST_EXPECT_MSG_EQ (rows[0][1], 1, "Wrong flow");
+  NS_TEST_EXPECT_MSG_EQ (rows[0][2], 10, "Wrong txPackets");
+  NS_TEST_EXPECT_MSG_EQ (rows[0][3], 10, "Wrong rxPackets");
+  NS_TEST_EXPECT_MSG_EQ (rows[0][4], 0, "Wrong lostPackets");
+  NS_TEST_EXPECT_MSG_EQ (rows[0][5], 1000, "Wrong txBytes");
+  NS_TEST_EXPECT_MSG_EQ (rows[0][6], 1000, "Wrong rxBytes");
+  NS_TEST_EXPECT_MSG_EQ_TOL (rows[0][7], 2e-3, 1e-8, "Wrong delayMean");
+  NS_TEST_EXPECT_MSG_EQ_TOL (rows[0][8], 1e-3, 1e-5, "Wrong delayP50");
+  NS_TEST_EXPECT_MSG_EQ_TOL (rows[0][9], 3e-3, 3e-5, "Wrong delayP99");
+  NS_TEST_EXPECT_MSG_EQ_TOL (rows[0][10], 3e-3, 3e-5, "Wrong delayP999");
+  NS_TEST_EXPECT_MSG_EQ_TOL (rows[0][11], 2e-3, 2e-5, "Wrong jitterP50");
+  NS_TEST_EXPECT_MSG_EQ_TOL (rows[0][12], 2e-3, 2e-5, "Wrong jitterP99");
+
+  // flow 2 at 100 ms: all its 5 packets, 3 of them with a delay of 1 ms
+  NS_TEST_EXPECT_MSG_EQ (rows[1][0], 100e6, "Wrong time");
+  NS_TEST_EXPECT_MSG_EQ (rows[1][1], 2, "Wrong flow");
+  NS_TEST_EXPECT_MSG_EQ (rows[1][2], 5, "Wrong txPackets");
+  NS_TEST_EXPECT_MSG_EQ (rows[1][3], 5, "Wrong rxPackets");
+  NS_TEST_EXPECT_MSG_EQ_TOL (rows[1][7], 1.8e-3, 1e-8, "Wrong delayMean");
+  NS_TEST_EXPECT_MSG_EQ_TOL (rows[1][8], 1e-3, 1e-5, "Wrong delayP50");
+
+  // flow 1 at 200 ms, cumulative: 15 packets, 8 of them with a delay of 1 ms
+  NS_TEST_EXPECT_MSG_EQ (rows[2][0], 200e6, "Wrong time");
+  NS_TEST_EXPECT_MSG_EQ (rows[2][1], 1, "Wrong flow");
+  NS_TEST_EXPECT_MSG_EQ (rows[2][2], 15, "Wrong txPackets");
+  NS_TEST_EXPECT_MSG_EQ (rows[2][3], 15, "Wrong rxPackets");
+  NS_TEST_EXPECT_MSG_EQ (rows[2][6], 1500, "Wrong rxBytes");
+  NS_TEST_EXPECT_MSG_EQ_TOL (rows[2][7], 29e-3 / 15, 1e-8, "Wrong delayMean");
+  NS_TEST_EXPECT_MSG_EQ_TOL (rows[2][8], 1e-3, 1e-5, "Wrong delayP50");
+  NS_TEST_EXPECT_MSG_EQ_TOL (rows[2][9], 3e-3, 3e-5, "Wrong delayP99");
+
+  monitor->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief Check the percentiles of the XML output, which are only written
+ * when the sketches are enabled.
+ */
+class FlowMonitorXmlQuantilesTestCase : public TestCase
+{
+public:
+  FlowMonitorXmlQuantilesTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Run a flow and serialize the statistics of the FlowMonitor
+   * \param sketchAccuracy the SketchRelativeAccuracy attribute
+   * \return the XML output
+   */
+  std::string RunFlow (double sketchAccuracy);
+  /**
+   * \param xml the XML output
+   * \param element the element name
+   * \param attribute the attribute name
+   * \return the value of the attribute of the first element, -1 if not found
+   */
+  double GetXmlValue (const std::string &xml, std::string element, std::string attribute);
+};
+
+FlowMonitorXmlQuantilesTestCase::FlowMonitorXmlQuantilesTestCase ()
+  : TestCase ("Check the percentiles of the XML output")
+{
+}
+
+std::string
+FlowMonitorXmlQuantilesTestCase::RunFlow (double sketchAccuracy)
+{
+  Ptr<FlowMonitor> monitor = CreateObject<FlowMonitor> ();
+  if (sketchAccuracy > 0)
+    {
+      monitor->SetAttribute ("SketchRelativeAccuracy", DoubleValue (sketchAccuracy));
+    }
+  Ptr<FlowProbe> probe = CreateObject<FlowMonitorTestProbe> (monitor);
+  monitor->StartRightNow ();
+  ScheduleFlowMonitorTestFlow (monitor, probe, 1, MilliSeconds (5), 100);
+  Simulator::Stop (Seconds (2));
+  Simulator::Run ();
+  std::string xml = monitor->SerializeToXmlString (0, false, false);
+  monitor->Dispose ();
+  Simulator::Destroy ();
+  return xml;
+}
+
+double
+FlowMonitorXmlQuantilesTestCase::GetXmlValue (const std::string &xml, std::string element, std::string attribute)
+{
+  std::string::size_type start = xml.find ("<" + element + " ");
+  if (start == std::string::npos)
+    {
+      return -1;
+    }
+  std::string::size_type end = xml.find ("/>", start);
+  std::string::size_type value = xml.find (" " + attribute + "=\"", start);
+  if (value == std::string::npos || value > end)
+    {
+      return -1;
+    }
+  return std::atof (xml.c_str () + value + attribute.size () + 3);
+}
+
+void
+FlowMonitorXmlQuantilesTestCase::DoRun (void)
+{
+  // the sketches are disabled by default
+  std::string xml = RunFlow (0);
+  NS_TEST_EXPECT_MSG_EQ (xml.find ("delayQuantiles"), std::string::npos, "Unexpected delay percentiles");
+  NS_TEST_EXPECT_MSG_EQ (xml.find ("jitterQuantiles"), std::string::npos, "Unexpected jitter percentiles");
+
+  // 50 packets with a delay of 1 ms and 50 with a delay of 3 ms
+  xml = RunFlow (0.01);
+  NS_TEST_EXPECT_MSG_EQ (GetXmlValue (xml, "delayQuantiles", "count"), 100, "Wrong delay count");
+  NS_TEST_EXPECT_MSG_EQ_TOL (GetXmlValue (xml, "delayQuantiles", "min"), 1e-3, 1e-9, "Wrong delay min");
+  NS_TEST_EXPECT_MSG_EQ_TOL (GetXmlValue (xml, "delayQuantiles", "max"), 3e-3, 1e-9, "Wrong delay max");
+  NS_TEST_EXPECT_MSG_EQ_TOL (GetXmlValue (xml, "delayQuantiles", "p50"), 1e-3, 1e-5, "Wrong delay p50");
+  NS_TEST_EXPECT_MSG_EQ_TOL (GetXmlValue (xml, "delayQuantiles", "p90"), 3e-3, 3e-5, "Wrong delay p90");
+  NS_TEST_EXPECT_MSG_EQ_TOL (GetXmlValue (xml, "delayQuantiles", "p99"), 3e-3, 3e-5, "Wrong delay p99");
+  NS_TEST_EXPECT_MSG_EQ_TOL (GetXmlValue (xml, "delayQuantiles", "p999"), 3e-3, 3e-5, "Wrong delay p999");
+  NS_TEST_EXPECT_MSG_EQ (GetXmlValue (xml, "jitterQuantiles", "count"), 99, "Wrong jitter count");
+  NS_TEST_EXPECT_MSG_EQ_TOL (GetXmlValue (xml, "jitterQuantiles", "p50"), 2e-3, 2e-5, "Wrong jitter p50");
+  NS_TEST_EXPECT_MSG_EQ_TOL (GetXmlValue (xml, "jitterQuantiles", "p99"), 2e-3, 2e-5, "Wrong jitter p99");
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief FlowMonitor TestSuite
+ */
+class FlowMonitorTestSuite : public TestSuite
+{
+public:
+  FlowMonitorTestSuite ();
+};
+
+FlowMonitorTestSuite::FlowMonitorTestSuite ()
+  : TestSuite ("flow-monitor", UNIT)
+{
+  AddTestCase (new FlowMonitorMaxTrackedPacketsTestCase, TestCase::QUICK);
+  AddTestCase (new FlowMonitorFlowSamplingTestCase, TestCase::QUICK);
+  AddTestCase (new Ipv4FlowClassifierXmlOrderTestCase, TestCase::QUICK);
+  AddTestCase (new FlowMonitorStreamTestCase, TestCase::QUICK);
+  AddTestCase (new FlowMonitorXmlQuantilesTestCase, TestCase::QUICK);
+}
+
+static FlowMonitorTestSuite g_flowMonitorTestSuite; //!< Static variable for test initialization
@@ -17,6 +17,8 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
+#include <vector>
+
 #include "ns3/assert.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
@@ -195,42 +197,40 @@ void
 ArpCache::HandleWaitReplyTimeout (void)
 {
   NS_LOG_FUNCTION (this);
-  ArpCache::Entry* entry;
   bool restartWaitReplyTimer = false;
-  for (CacheI i = m_arpCache.begin (); i != m_arpCache.end (); i++) 
+  // Only the entries waiting for a reply need to be visited; take a
+  // snapshot since marking an entry dead removes it from the list.
+  std::vector<ArpCache::Entry *> waiting (m_waitReplyEntries.begin (), m_waitReplyEntries.end ());
+  for (std::vector<ArpCache::Entry *>::iterator i = waiting.begin (); i != waiting.end (); i++)
     {
-      entry = (*i).second;
-      if (entry != 0 && entry->IsWaitReply ())
+      ArpCache::Entry* entry = *i;
+      if (entry->GetRetries () < m_maxRetries)
         {
-          if (entry->GetRetries () < m_maxRetries)
-            {
-              NS_LOG_LOGIC ("node="<< m_device->GetNode ()->GetId () <<
-                            ", ArpWaitTimeout for " << entry->GetIpv4Address () <<
-                            " expired -- retransmitting arp request since retries = " <<
-                            entry->GetRetries ());
-              m_arpRequestCallback (this, entry->GetIpv4Address ());
-              restartWaitReplyTimer = true;
-              entry->IncrementRetries ();
-            }
-          else
+          NS_LOG_LOGIC ("node="<< m_device->GetNode ()->GetId () <<
+                        ", ArpWaitTimeout for " << entry->GetIpv4Address () <<
+                        " expired -- retransmitting arp request since retries = " <<
+                        entry->GetRetries ());
+          m_arpRequestCallback (this, entry->GetIpv4Address ());
+          restartWaitReplyTimer = true;
+          entry->IncrementRetries ();
+        }
+      else
+        {
+          NS_LOG_LOGIC ("node="<<m_device->GetNode ()->GetId () <<
+                        ", wait reply for " << entry->GetIpv4Address () <<
+                        " expired -- drop since max retries exceeded: " <<
+                        entry->GetRetries ());
+          entry->MarkDead ();
+          entry->ClearRetries ();
+          Ipv4PayloadHeaderPair pending = entry->DequeuePending ();
+          while (pending.first != 0)
             {
-              NS_LOG_LOGIC ("node="<<m_device->GetNode ()->GetId () <<
-                            ", wait reply for " << entry->GetIpv4Address () <<
-                            " expired -- drop since max retries exceeded: " <<
-                            entry->GetRetries ());
-              entry->MarkDead ();
-              entry->ClearRetries ();
-              Ipv4PayloadHeaderPair pending = entry->DequeuePending ();
-              while (pending.first != 0)
-                {
-                  // add the Ipv4 header for tracing purposes
-                  pending.first->AddHeader (pending.second);
-                  m_dropTrace (pending.first);
-                  pending = entry->DequeuePending ();
-                }
+              // add the Ipv4 header for tracing purposes
+              pending.first->AddHeader (pending.second);
+              m_dropTrace (pending.first);
+              pending = entry->DequeuePending ();
             }
         }
-
     }
   if (restartWaitReplyTimer)
     {
@@ -249,6 +249,8 @@ ArpCache::Flush (void)
       delete (*i).second;
     }
   m_arpCache.erase (m_arpCache.begin (), m_arpCache.end ());
+  m_macIndex.clear ();
+  m_waitReplyEntries.clear ();
   if (m_waitReplyTimer.IsRunning ())
     {
       NS_LOG_LOGIC ("Stopping WaitReplyTimer at " << Simulator::Now ().GetSeconds () << " due to ArpCache flush");
@@ -302,13 +304,10 @@ ArpCache::LookupInverse (Address to)
   NS_LOG_FUNCTION (this << to);
 
   std::list<ArpCache::Entry *> entryList;
-  for (CacheI i = m_arpCache.begin (); i != m_arpCache.end (); i++)
+  std::pair<MacIndexI, MacIndexI> range = m_macIndex.equal_range (to);
+  for (MacIndexI i = range.first; i != range.second; i++)
     {
-      ArpCache::Entry *entry = (*i).second;
-      if (entry->GetMacAddress () == to)
-        {
-          entryList.push_back (entry);
-        }
+      entryList.push_back (i->second);
     }
   return entryList;
 }
@@ -343,19 +342,62 @@ ArpCache::Remove (ArpCache::Entry *entry)
 {
   NS_LOG_FUNCTION (this << entry);
   
-  for (CacheI i = m_arpCache.begin (); i != m_arpCache.end (); i++)
+  CacheI i = m_arpCache.find (entry->GetIpv4Address ());
+  if (i != m_arpCache.end () && i->second == entry)
     {
-      if ((*i).second == entry)
+      m_arpCache.erase (i);
+      RemoveMacIndex (entry);
+      if (entry->IsWaitReply ())
         {
-          m_arpCache.erase (i);
-          entry->ClearPendingPacket (); //clear the pending packets for entry's ipaddress
-          delete entry;
-          return;
+          RemoveWaitReply (entry);
         }
+      entry->ClearPendingPacket (); //clear the pending packets for entry's ipaddress
+      delete entry;
+      return;
     }
   NS_LOG_WARN ("Entry not found in this ARP Cache");
 }
 
+void
+ArpCache::AddMacIndex (ArpCache::Entry *entry)
+{
+  NS_LOG_FUNCTION (this << entry);
+  Address mac = entry->GetMacAddress ();
+  if (!mac.IsInvalid ())
+    {
+      m_macIndex.insert (std::make_pair (mac, entry));
+    }
+}
+
+void
+ArpCache::RemoveMacIndex (ArpCache::Entry *entry)
+{
+  NS_LOG_FUNCTION (this << entry);
+  std::pair<MacIndexI, MacIndexI> range = m_macIndex.equal_range (entry->GetMacAddress ());
+  for (MacIndexI i = range.first; i != range.second; i++)
+    {
+      if (i->second == entry)
+        {
+          m_macIndex.erase (i);
+          return;
+        }
+    }
+}
+
+void
+ArpCache::AddWaitReply (ArpCache::Entry *entry)
+{
+  NS_LOG_FUNCTION (this << entry);
+  entry->m_waitReplyIt = m_waitReplyEntries.insert (m_waitReplyEntries.end (), entry);
+}
+
+void
+ArpCache::RemoveWaitReply (ArpCache::Entry *entry)
+{
+  NS_LOG_FUNCTION (this << entry);
+  m_waitReplyEntries.erase (entry->m_waitReplyIt);
+}
+
 ArpCache::Entry::Entry (ArpCache *arp)
   : m_arp (arp),
     m_state (ALIVE),
@@ -396,6 +438,10 @@ ArpCache::Entry::MarkDead (void)
 {
   NS_LOG_FUNCTION (this);
   NS_ASSERT (m_state == ALIVE || m_state == WAIT_REPLY || m_state == DEAD);
+  if (m_state == WAIT_REPLY)
+    {
+      m_arp->RemoveWaitReply (this);
+    }
   m_state = DEAD;
   ClearRetries ();
   UpdateSeen ();
@@ -405,7 +451,8 @@ ArpCache::Entry::MarkAlive (Address macAddress)
 {
   NS_LOG_FUNCTION (this << macAddress);
   NS_ASSERT (m_state == WAIT_REPLY);
-  m_macAddress = macAddress;
+  m_arp->RemoveWaitReply (this);
+  SetMacAddress (macAddress);
   m_state = ALIVE;
   ClearRetries ();
   UpdateSeen ();
@@ -416,6 +463,10 @@ ArpCache::Entry::MarkPermanent (void)
   NS_LOG_FUNCTION (this << m_macAddress);
   NS_ASSERT (!m_macAddress.IsInvalid ());
 
+  if (m_state == WAIT_REPLY)
+    {
+      m_arp->RemoveWaitReply (this);
+    }
   m_state = PERMANENT;
   ClearRetries ();
   UpdateSeen ();
@@ -445,6 +496,7 @@ ArpCache::Entry::MarkWaitReply (Ipv4PayloadHeaderPair waiting)
   NS_ASSERT_MSG (waiting.first, "Can not add a null packet to the ARP queue");
 
   m_state = WAIT_REPLY;
+  m_arp->AddWaitReply (this);
   m_pending.push_back (waiting);
   UpdateSeen ();
   m_arp->StartWaitReplyTimer ();
@@ -460,7 +512,9 @@ void
 ArpCache::Entry::SetMacAddress (Address macAddress)
 {
   NS_LOG_FUNCTION (this);
+  m_arp->RemoveMacIndex (this);
   m_macAddress = macAddress;
+  m_arp->AddMacIndex (this);
 }
 Ipv4Address 
 ArpCache::Entry::GetIpv4Address (void) const
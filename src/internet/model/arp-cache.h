@@ -22,6 +22,7 @@
 
 #include <stdint.h>
 #include <list>
+#include <deque>
 #include <unordered_map>
 #include "ns3/simulator.h"
 #include "ns3/callback.h"
@@ -284,6 +285,8 @@ public:
     void UpdateSeen (void);
 
 private:
+    friend class ArpCache;
+
     /**
      * \brief ARP cache entry states
      */
@@ -305,8 +308,9 @@ private:
     Time m_lastSeen; //!< last moment a packet from that address has been seen
     Address m_macAddress; //!< entry's MAC address
     Ipv4Address m_ipv4Address; //!< entry's IP address
-    std::list<Ipv4PayloadHeaderPair> m_pending; //!< list of pending packets for the entry's IP
+    std::deque<Ipv4PayloadHeaderPair> m_pending; //!< queue of pending packets for the entry's IP
     uint32_t m_retries; //!< rerty counter
+    std::list<Entry *>::iterator m_waitReplyIt; //!< position in the cache WAIT_REPLY list
   };
 
 private:
@@ -318,6 +322,14 @@ private:
    * \brief ARP Cache container iterator
    */
   typedef std::unordered_map<Ipv4Address, ArpCache::Entry *, Ipv4AddressHash>::iterator CacheI;
+  /**
+   * \brief Inverse (MAC to entries) index container
+   */
+  typedef std::unordered_multimap<Address, ArpCache::Entry *, AddressHash> MacIndex;
+  /**
+   * \brief Inverse index container iterator
+   */
+  typedef std::unordered_multimap<Address, ArpCache::Entry *, AddressHash>::iterator MacIndexI;
 
   virtual void DoDispose (void);
 
@@ -336,8 +348,31 @@ private:
    * If there are no Arp requests pending, this event is not scheduled.
    */
   void HandleWaitReplyTimeout (void);
+  /**
+   * \brief Index an entry under its MAC address
+   * \param entry the entry to index
+   */
+  void AddMacIndex (ArpCache::Entry *entry);
+  /**
+   * \brief Remove an entry from the MAC address index
+   * \param entry the entry to remove
+   */
+  void RemoveMacIndex (ArpCache::Entry *entry);
+  /**
+   * \brief Track an entry which entered the WAIT_REPLY state
+   * \param entry the entry waiting for a reply
+   */
+  void AddWaitReply (ArpCache::Entry *entry);
+  /**
+   * \brief Stop tracking an entry which left the WAIT_REPLY state
+   * \param entry the entry no longer waiting for a reply
+   */
+  void RemoveWaitReply (ArpCache::Entry *entry);
+
   uint32_t m_pendingQueueSize; //!< number of packets waiting for a resolution
   Cache m_arpCache; //!< the ARP cache
+  MacIndex m_macIndex; //!< entries indexed by their MAC address
+  std::list<ArpCache::Entry *> m_waitReplyEntries; //!< entries in WAIT_REPLY state
   TracedCallback<Ptr<const Packet> > m_dropTrace; //!< trace for packets dropped by the ARP cache queue
 };
 
@@ -147,6 +147,13 @@ TcpSocketBase::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&TcpSocketBase::m_limitedTx),
                    MakeBooleanChecker ())
+    .AddAttribute ("UseTimerWheel",
+                   "Schedule the retransmission, delayed ACK and persist timeouts "
+                   "on the timer wheel. Their expiration is then rounded up to the "
+                   "TimerWheelGranularity global value.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&TcpSocketBase::m_useTimerWheel),
+                   MakeBooleanChecker ())
     .AddAttribute ("UseEcn", "Parameter to set ECN functionality",
                    EnumValue (TcpSocketState::Off),
                    MakeEnumAccessor (&TcpSocketBase::SetUseEcn),
@@ -350,6 +357,7 @@ TcpSocketBase::TcpSocketBase (const TcpSocketBase& sock)
     m_recoverActive (sock.m_recoverActive),
     m_retxThresh (sock.m_retxThresh),
     m_limitedTx (sock.m_limitedTx),
+    m_useTimerWheel (sock.m_useTimerWheel),
     m_isFirstPartialAck (sock.m_isFirstPartialAck),
     m_txTrace (sock.m_txTrace),
     m_rxTrace (sock.m_rxTrace),
@@ -1380,8 +1388,8 @@ TcpSocketBase::DoForwardUp (Ptr<Packet> packet, const Address &fromAddress,
       NS_LOG_LOGIC ("Schedule persist timeout at time " <<
                     Simulator::Now ().GetSeconds () << " to expire at time " <<
                     (Simulator::Now () + m_persistTimeout).GetSeconds ());
-      m_persistEvent = Simulator::Schedule (m_persistTimeout, &TcpSocketBase::PersistTimeout, this);
-      NS_ASSERT (m_persistTimeout == Simulator::GetDelayLeft (m_persistEvent));
+      m_persistEvent = ScheduleTimeout (m_persistTimeout, &TcpSocketBase::PersistTimeout);
+      NS_ASSERT (m_useTimerWheel || m_persistTimeout == Simulator::GetDelayLeft (m_persistEvent));
     }
 
   // TCP state machine code in different process functions
@@ -2785,7 +2793,7 @@ TcpSocketBase::SendEmptyPacket (uint8_t flags)
       NS_LOG_LOGIC ("Schedule retransmission timeout at time "
                     << Simulator::Now ().GetSeconds () << " to expire at time "
                     << (Simulator::Now () + m_rto.Get ()).GetSeconds ());
-      m_retxEvent = Simulator::Schedule (m_rto, &TcpSocketBase::SendEmptyPacket, this, flags);
+      m_retxEvent = ScheduleTimeout (m_rto, &TcpSocketBase::SendEmptyPacket, flags);
     }
 }
 
@@ -3128,7 +3136,7 @@ TcpSocketBase::SendDataPacket (SequenceNumber32 seq, uint32_t maxSize, bool with
       NS_LOG_LOGIC (this << " SendDataPacket Schedule ReTxTimeout at time " <<
                     Simulator::Now ().GetSeconds () << " to expire at time " <<
                     (Simulator::Now () + m_rto.Get ()).GetSeconds () );
-      m_retxEvent = Simulator::Schedule (m_rto, &TcpSocketBase::ReTxTimeout, this);
+      m_retxEvent = ScheduleTimeout (m_rto, &TcpSocketBase::ReTxTimeout);
     }
 
   m_txTrace (p, header, this);
@@ -3513,8 +3521,7 @@ TcpSocketBase::ReceivedData (Ptr<Packet> p, const TcpHeader& tcpHeader)
       else if (m_delAckEvent.IsExpired ())
         {
           m_congestionControl->CwndEvent (m_tcb, TcpSocketState::CA_EVENT_DELAYED_ACK);
-          m_delAckEvent = Simulator::Schedule (m_delAckTimeout,
-                                               &TcpSocketBase::DelAckTimeout, this);
+          m_delAckEvent = ScheduleTimeout (m_delAckTimeout, &TcpSocketBase::DelAckTimeout);
           NS_LOG_LOGIC (this << " scheduled delayed ACK at " <<
                         (Simulator::Now () + Simulator::GetDelayLeft (m_delAckEvent)).GetSeconds ());
         }
@@ -3598,7 +3605,7 @@ TcpSocketBase::NewAck (SequenceNumber32 const& ack, bool resetRTO)
       NS_LOG_LOGIC (this << " Schedule ReTxTimeout at time " <<
                     Simulator::Now ().GetSeconds () << " to expire at time " <<
                     (Simulator::Now () + m_rto.Get ()).GetSeconds ());
-      m_retxEvent = Simulator::Schedule (m_rto, &TcpSocketBase::ReTxTimeout, this);
+      m_retxEvent = ScheduleTimeout (m_rto, &TcpSocketBase::ReTxTimeout);
     }
 
   // Note the highest ACK and tell app to send more
@@ -3842,7 +3849,7 @@ TcpSocketBase::PersistTimeout ()
   NS_LOG_LOGIC ("Schedule persist timeout at time "
                 << Simulator::Now ().GetSeconds () << " to expire at time "
                 << (Simulator::Now () + m_persistTimeout).GetSeconds ());
-  m_persistEvent = Simulator::Schedule (m_persistTimeout, &TcpSocketBase::PersistTimeout, this);
+  m_persistEvent = ScheduleTimeout (m_persistTimeout, &TcpSocketBase::PersistTimeout);
 }
 
 void
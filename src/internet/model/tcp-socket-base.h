@@ -28,6 +28,7 @@
 #include "ns3/ipv4-header.h"
 #include "ns3/ipv6-header.h"
 #include "ns3/timer.h"
+#include "ns3/timer-wheel.h"
 #include "ns3/sequence-number.h"
 #include "ns3/data-rate.h"
 #include "ns3/node.h"
@@ -1079,6 +1080,22 @@ protected:
    */
   virtual void PersistTimeout (void);
 
+  /**
+   * \brief Schedule a retransmission, delayed ACK or persist timeout
+   *
+   * The timeout is scheduled on the TimerWheel if the UseTimerWheel
+   * attribute is set, and in the simulator event list otherwise.
+   *
+   * \tparam MEM_PTR \deduced Member function type.
+   * \tparam Ts \deduced Argument types.
+   * \param delay the timeout
+   * \param memPtr the member function to invoke at expiration
+   * \param args the arguments of the member function
+   * \returns the id of the timeout event
+   */
+  template <typename MEM_PTR, typename... Ts>
+  EventId ScheduleTimeout (const Time &delay, MEM_PTR memPtr, Ts&&... args);
+
   /**
    * \brief Retransmit the first segment marked as lost, without considering
    * available window nor pacing.
@@ -1323,6 +1340,7 @@ protected:
                                                   //!< which was set for handling previous congestion event.
   uint32_t               m_retxThresh {3};   //!< Fast Retransmit threshold
   bool                   m_limitedTx  {true}; //!< perform limited transmit
+  bool                   m_useTimerWheel {false}; //!< schedule timeouts on the timer wheel
 
   // Transmission Control Block
   Ptr<TcpSocketState>    m_tcb;               //!< Congestion control information
@@ -1349,6 +1367,17 @@ protected:
   TracedValue<SequenceNumber32> m_ecnCWRSeq  {0};      //!< Sequence number of the last sent CWR
 };
 
+template <typename MEM_PTR, typename... Ts>
+EventId
+TcpSocketBase::ScheduleTimeout (const Time &delay, MEM_PTR memPtr, Ts&&... args)
+{
+  if (m_useTimerWheel)
+    {
+      return TimerWheel::Schedule (delay, memPtr, this, std::forward<Ts> (args)...);
+    }
+  return Simulator::Schedule (delay, memPtr, this, std::forward<Ts> (args)...);
+}
+
 /**
  * \ingroup tcp
  * TracedValue Callback signature for TcpCongState_t
@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/mac48-address.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/arp-cache.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief ArpCache inverse index test
+ *
+ * Checks that LookupInverse follows MAC address changes and
+ * entry removal.
+ */
+class ArpCacheInverseTest : public TestCase
+{
+public:
+  ArpCacheInverseTest ();
+private:
+  virtual void DoRun (void);
+};
+
+ArpCacheInverseTest::ArpCacheInverseTest ()
+  : TestCase ("Check the ArpCache MAC address index")
+{
+}
+
+void
+ArpCacheInverseTest::DoRun (void)
+{
+  Ptr<ArpCache> cache = CreateObject<ArpCache> ();
+  Mac48Address router ("00:00:00:00:00:01");
+  Mac48Address host ("00:00:00:00:00:02");
+
+  ArpCache::Entry *a = cache->Add (Ipv4Address ("10.0.0.1"));
+  ArpCache::Entry *b = cache->Add (Ipv4Address ("10.0.0.2"));
+  ArpCache::Entry *c = cache->Add (Ipv4Address ("10.0.0.3"));
+  a->SetMacAddress (router);
+  b->SetMacAddress (router);
+  c->SetMacAddress (host);
+
+  NS_TEST_EXPECT_MSG_EQ (cache->LookupInverse (router).size (), 2, "two entries share the router MAC");
+  NS_TEST_EXPECT_MSG_EQ (cache->LookupInverse (host).size (), 1, "one entry has the host MAC");
+
+  b->SetMacAddress (host);
+  NS_TEST_EXPECT_MSG_EQ (cache->LookupInverse (router).size (), 1, "entry moved away from the router MAC");
+  NS_TEST_EXPECT_MSG_EQ (cache->LookupInverse (host).size (), 2, "entry moved to the host MAC");
+
+  cache->Remove (c);
+  std::list<ArpCache::Entry *> entries = cache->LookupInverse (host);
+  NS_TEST_EXPECT_MSG_EQ (entries.size (), 1, "removed entry is no longer indexed");
+  NS_TEST_EXPECT_MSG_EQ (entries.front (), b, "remaining entry is the moved one");
+  NS_TEST_EXPECT_MSG_EQ (cache->Lookup (Ipv4Address ("10.0.0.3")), 0, "removed entry is not found");
+
+  cache->Flush ();
+  NS_TEST_EXPECT_MSG_EQ (cache->LookupInverse (router).size (), 0, "flush clears the index");
+
+  cache->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief ArpCache WAIT_REPLY tracking test
+ *
+ * Checks that pending packets of an unresolved entry are dropped
+ * once MaxRetries is exceeded, and that resolved entries are left alone.
+ */
+class ArpCacheWaitReplyTest : public TestCase
+{
+public:
+  ArpCacheWaitReplyTest ();
+private:
+  virtual void DoRun (void);
+  /**
+   * Count ARP requests.
+   * \param cache the cache
+   * \param to the address being resolved
+   */
+  void Request (Ptr<const ArpCache> cache, Ipv4Address to);
+  /**
+   * Count dropped packets.
+   * \param p the dropped packet
+   */
+  void Drop (Ptr<const Packet> p);
+
+  uint32_t m_requests; //!< number of ARP requests
+  uint32_t m_drops;    //!< number of dropped packets
+};
+
+ArpCacheWaitReplyTest::ArpCacheWaitReplyTest ()
+  : TestCase ("Check the ArpCache WAIT_REPLY retries"),
+    m_requests (0),
+    m_drops (0)
+{
+}
+
+void
+ArpCacheWaitReplyTest::Request (Ptr<const ArpCache> cache, Ipv4Address to)
+{
+  m_requests++;
+}
+
+void
+ArpCacheWaitReplyTest::Drop (Ptr<const Packet> p)
+{
+  m_drops++;
+}
+
+void
+ArpCacheWaitReplyTest::DoRun (void)
+{
+  Ptr<ArpCache> cache = CreateObject<ArpCache> ();
+  cache->SetArpRequestCallback (MakeCallback (&ArpCacheWaitReplyTest::Request, this));
+  cache->TraceConnectWithoutContext ("Drop", MakeCallback (&ArpCacheWaitReplyTest::Drop, this));
+
+  ArpCache::Entry *unresolved = cache->Add (Ipv4Address ("10.0.0.1"));
+  unresolved->MarkWaitReply (ArpCache::Ipv4PayloadHeaderPair (Create<Packet> (10), Ipv4Header ()));
+  unresolved->UpdateWaitReply (ArpCache::Ipv4PayloadHeaderPair (Create<Packet> (10), Ipv4Header ()));
+  ArpCache::Entry *resolved = cache->Add (Ipv4Address ("10.0.0.2"));
+  resolved->MarkWaitReply (ArpCache::Ipv4PayloadHeaderPair (Create<Packet> (10), Ipv4Header ()));
+  resolved->MarkAlive (Mac48Address ("00:00:00:00:00:02"));
+
+  Simulator::Run ();
+
+  // default MaxRetries is 3
+  NS_TEST_EXPECT_MSG_EQ (m_requests, 3, "only the unresolved entry is retried");
+  NS_TEST_EXPECT_MSG_EQ (m_drops, 2, "pending packets are dropped after MaxRetries");
+  NS_TEST_EXPECT_MSG_EQ (unresolved->IsDead (), true, "unresolved entry is dead");
+  NS_TEST_EXPECT_MSG_EQ (resolved->IsAlive (), true, "resolved entry is still alive");
+
+  cache->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief ArpCache TestSuite
+ */
+class ArpCacheTestSuite : public TestSuite
+{
+public:
+  ArpCacheTestSuite () : TestSuite ("arp-cache", UNIT)
+  {
+    AddTestCase (new ArpCacheInverseTest, TestCase::QUICK);
+    AddTestCase (new ArpCacheWaitReplyTest, TestCase::QUICK);
+  }
+};
+
+static ArpCacheTestSuite g_arpCacheTestSuite; //!< Static variable for test initialization
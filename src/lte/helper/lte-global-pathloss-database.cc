@@ -24,12 +24,23 @@
 #include "ns3/lte-ue-net-device.h"
 #include "ns3/lte-spectrum-phy.h"
 
+#include <ns3/simulator.h>
+
+#include <algorithm>
 #include <limits>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("LteGlobalPathlossDatabase");
 
+const uint32_t LteGlobalPathlossDatabase::NO_INDEX;
+
+LteGlobalPathlossDatabase::LteGlobalPathlossDatabase (void)
+  : m_stride (0),
+    m_samplingPeriod (Seconds (0))
+{
+}
+
 LteGlobalPathlossDatabase::~LteGlobalPathlossDatabase (void)
 {
 }
@@ -38,15 +49,29 @@ void
 LteGlobalPathlossDatabase::Print ()
 {
   NS_LOG_FUNCTION (this);
-  for (std::map<uint16_t, std::map<uint64_t, double> >::const_iterator cellIdIt = m_pathlossMap.begin ();
-       cellIdIt != m_pathlossMap.end ();
-       ++cellIdIt)
+  // the columns are in order of arrival, print them by IMSI
+  std::vector<std::pair<uint64_t, uint32_t> > columns;
+  for (uint32_t column = 0; column < m_imsis.size (); ++column)
     {
-      for (std::map<uint64_t, double>::const_iterator imsiIt = cellIdIt->second.begin ();
-           imsiIt != cellIdIt->second.end ();
+      columns.push_back (std::make_pair (m_imsis[column], column));
+    }
+  std::sort (columns.begin (), columns.end ());
+  for (uint32_t cellId = 0; cellId < m_cellIndex.size (); ++cellId)
+    {
+      uint32_t row = m_cellIndex[cellId];
+      if (row == NO_INDEX)
+        {
+          continue;
+        }
+      for (std::vector<std::pair<uint64_t, uint32_t> >::const_iterator imsiIt = columns.begin ();
+           imsiIt != columns.end ();
            ++imsiIt)
         {
-          std::cout << "CellId: " << cellIdIt->first << " IMSI: " << imsiIt->first << " pathloss: " << imsiIt->second << " dB" << std::endl;
+          double lossDb = m_pathloss[row * m_stride + imsiIt->second];
+          if (lossDb != std::numeric_limits<double>::infinity ())
+            {
+              std::cout << "CellId: " << cellId << " IMSI: " << imsiIt->first << " pathloss: " << lossDb << " dB" << std::endl;
+            }
         }
     }
 }
@@ -56,17 +81,74 @@ double
 LteGlobalPathlossDatabase::GetPathloss (uint16_t cellId, uint64_t imsi)
 {
   NS_LOG_FUNCTION (this);
-  std::map<uint16_t, std::map<uint64_t, double> >::iterator cellIt = m_pathlossMap.find (cellId);
-  if (cellIt == m_pathlossMap.end())
+  if (cellId >= m_cellIndex.size () || m_cellIndex[cellId] == NO_INDEX)
     {
       return std::numeric_limits<double>::infinity ();
     }
-  std::map<uint64_t, double>::iterator ueIt = cellIt->second.find (imsi);
-  if (ueIt ==  cellIt->second.end())
+  std::unordered_map<uint64_t, uint32_t>::const_iterator ueIt = m_imsiIndex.find (imsi);
+  if (ueIt == m_imsiIndex.end ())
     {
       return std::numeric_limits<double>::infinity ();
     }
-  return ueIt->second;
+  return m_pathloss[m_cellIndex[cellId] * m_stride + ueIt->second];
+}
+
+void
+LteGlobalPathlossDatabase::SetSamplingPeriod (Time period)
+{
+  NS_LOG_FUNCTION (this << period);
+  NS_ASSERT_MSG (period.IsPositive (), "negative sampling period");
+  m_samplingPeriod = period;
+}
+
+bool
+LteGlobalPathlossDatabase::IsSampled (void) const
+{
+  if (m_samplingPeriod.IsZero ())
+    {
+      return true;
+    }
+  return (Simulator::Now ().GetTimeStep () % m_samplingPeriod.GetTimeStep ()) < MilliSeconds (1).GetTimeStep ();
+}
+
+void
+LteGlobalPathlossDatabase::StorePathloss (uint16_t cellId, uint64_t imsi, double lossDb)
+{
+  if (cellId >= m_cellIndex.size ())
+    {
+      m_cellIndex.resize (cellId + 1, NO_INDEX);
+    }
+  uint32_t row = m_cellIndex[cellId];
+  if (row == NO_INDEX)
+    {
+      row = m_cellIds.size ();
+      m_cellIndex[cellId] = row;
+      m_cellIds.push_back (cellId);
+      m_pathloss.resize ((row + 1) * m_stride, std::numeric_limits<double>::infinity ());
+    }
+
+  std::pair<std::unordered_map<uint64_t, uint32_t>::iterator, bool> ret;
+  ret = m_imsiIndex.insert (std::make_pair (imsi, m_imsis.size ()));
+  uint32_t column = ret.first->second;
+  if (ret.second)
+    {
+      m_imsis.push_back (imsi);
+      if (column >= m_stride)
+        {
+          // double the number of columns, so that each UE moves the rows once on average
+          uint32_t stride = std::max<uint32_t> (2 * m_stride, 8);
+          std::vector<double> pathloss (m_cellIds.size () * stride, std::numeric_limits<double>::infinity ());
+          for (uint32_t r = 0; r < m_cellIds.size (); ++r)
+            {
+              std::copy (m_pathloss.begin () + r * m_stride,
+                         m_pathloss.begin () + (r + 1) * m_stride,
+                         pathloss.begin () + r * stride);
+            }
+          m_pathloss.swap (pathloss);
+          m_stride = stride;
+        }
+    }
+  m_pathloss[row * m_stride + column] = lossDb;
 }
  
 
@@ -77,9 +159,13 @@ DownlinkLteGlobalPathlossDatabase::UpdatePathloss (std::string context,
                                         double lossDb)
 {
   NS_LOG_FUNCTION (this << lossDb);
+  if (!IsSampled ())
+    {
+      return;
+    }
   uint16_t cellId = txPhy->GetDevice ()->GetObject<LteEnbNetDevice> ()->GetCellId ();
-  uint16_t imsi = rxPhy->GetDevice ()->GetObject<LteUeNetDevice> ()->GetImsi ();
-  m_pathlossMap[cellId][imsi] = lossDb;
+  uint64_t imsi = rxPhy->GetDevice ()->GetObject<LteUeNetDevice> ()->GetImsi ();
+  StorePathloss (cellId, imsi, lossDb);
 }
 
 
@@ -90,9 +176,13 @@ UplinkLteGlobalPathlossDatabase::UpdatePathloss (std::string context,
                                         double lossDb)
 {
   NS_LOG_FUNCTION (this << lossDb);
-  uint16_t imsi = txPhy->GetDevice ()->GetObject<LteUeNetDevice> ()->GetImsi ();
+  if (!IsSampled ())
+    {
+      return;
+    }
+  uint64_t imsi = txPhy->GetDevice ()->GetObject<LteUeNetDevice> ()->GetImsi ();
   uint16_t cellId = rxPhy->GetDevice ()->GetObject<LteEnbNetDevice> ()->GetCellId ();
-  m_pathlossMap[cellId][imsi] = lossDb;
+  StorePathloss (cellId, imsi, lossDb);
 }
 
 
@@ -24,8 +24,10 @@
 
 #include <ns3/log.h>
 #include <ns3/ptr.h>
+#include <ns3/nstime.h>
 #include <string>
-#include <map>
+#include <vector>
+#include <unordered_map>
 
 namespace ns3 {
 
@@ -37,12 +39,23 @@ class SpectrumPhy;
  * Store the last pathloss value for each TX-RX pair. This is an
  * example of how the PathlossTrace (provided by some SpectrumChannel
  * implementations) work. 
- * 
+ *
+ * The values are stored in a dense matrix, with a row per cell and a
+ * column per UE, which grows when a new cell or UE is seen. The
+ * memory is proportional to the number of cells times the number of
+ * UEs, whatever the number of updates.
+ *
+ * The PathlossTrace is fired for every signal of every TX-RX pair. With
+ * a sampling period, only the signals starting during the first
+ * millisecond of each period, i.e., of one subframe, are recorded, and
+ * the other ones are dropped before looking up their cell and UE.
  */
 class LteGlobalPathlossDatabase
 {
 public:
 
+  LteGlobalPathlossDatabase (void);
+
   virtual ~LteGlobalPathlossDatabase (void);
 
   /** 
@@ -71,12 +84,43 @@ public:
    */
   void Print ();
 
+  /**
+   * Set the sampling period of the updates.
+   *
+   * \param period the sampling period; zero, the default, records every update
+   */
+  void SetSamplingPeriod (Time period);
+
 protected:
   /**
-   * List of the last pathloss value for each UE by CellId.
-   * ( CELL ID,  ( IMSI,PATHLOSS ))
+   * \return whether the updates of the current time must be recorded
+   */
+  bool IsSampled (void) const;
+
+  /**
+   * Store the last pathloss value of a pair
+   *
+   * \param cellId the id of the eNB
+   * \param imsi the id of the UE
+   * \param lossDb the loss in dB
+   */
+  void StorePathloss (uint16_t cellId, uint64_t imsi, double lossDb);
+
+private:
+  /// The index of a cell or UE without a row or column
+  static const uint32_t NO_INDEX = 0xffffffff;
+
+  std::vector<uint32_t> m_cellIndex;                   ///< The row of the cells, by cell ID
+  std::vector<uint16_t> m_cellIds;                     ///< The cell ID of the rows
+  std::unordered_map<uint64_t, uint32_t> m_imsiIndex;  ///< The column of the UEs, by IMSI
+  std::vector<uint64_t> m_imsis;                       ///< The IMSI of the columns
+  uint32_t m_stride;                                   ///< The number of allocated columns of each row
+  /**
+   * The last pathloss value of each (cell, UE) pair, by row then
+   * column; infinity if not received
    */
-  std::map<uint16_t, std::map<uint64_t, double> > m_pathlossMap;
+  std::vector<double> m_pathloss;
+  Time m_samplingPeriod;                               ///< The sampling period of the updates
 };
 
 /**
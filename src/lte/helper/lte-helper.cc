@@ -43,6 +43,7 @@
 #include <ns3/isotropic-antenna-model.h>
 #include <ns3/lte-ue-net-device.h>
 #include <ns3/ff-mac-scheduler.h>
+#include <ns3/ff-mac-scheduler-executor.h>
 #include <ns3/lte-ffr-algorithm.h>
 #include <ns3/lte-handover-algorithm.h>
 #include <ns3/lte-enb-component-carrier-manager.h>
@@ -194,6 +195,13 @@ TypeId LteHelper::GetTypeId (void)
                    UintegerValue (1),
                    MakeUintegerAccessor (&LteHelper::m_noOfCcs),
                    MakeUintegerChecker<uint16_t> (MIN_NO_CC, MAX_NO_CC))
+    .AddAttribute ("SchedulerThreads",
+                   "The number of threads running the schedulers of the eNBs "
+                   "of a TTI in parallel (see ns3::FfMacSchedulerExecutor). "
+                   "If 0, each scheduler runs directly when called by its MAC.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&LteHelper::m_schedulerThreads),
+                   MakeUintegerChecker<uint32_t> ())
   ;
   return tid;
 }
@@ -205,6 +213,7 @@ LteHelper::DoDispose ()
   m_downlinkChannel = 0;
   m_uplinkChannel = 0;
   m_componentCarrierPhyParams.clear();
+  m_schedulerExecutor = 0;
   Object::DoDispose ();
 }
 
@@ -578,6 +587,17 @@ LteHelper::InstallSingleEnbDevice (Ptr<Node> n)
       ulPhy->SetAntenna (antenna);
 
       Ptr<LteEnbMac> mac = CreateObject<LteEnbMac> ();
+      if (m_schedulerThreads > 0)
+        {
+          // all the eNBs share the same executor, so that the schedulers
+          // of the different cells run in parallel
+          if (!m_schedulerExecutor)
+            {
+              m_schedulerExecutor = CreateObject<FfMacSchedulerExecutor> ();
+              m_schedulerExecutor->SetAttribute ("NumThreads", UintegerValue (m_schedulerThreads));
+            }
+          mac->SetSchedulerExecutor (m_schedulerExecutor);
+        }
       Ptr<FfMacScheduler> sched = m_schedulerFactory.Create<FfMacScheduler> ();
       Ptr<LteFfrAlgorithm> ffrAlgorithm = m_ffrAlgorithmFactory.Create<LteFfrAlgorithm> ();
       DynamicCast<ComponentCarrierEnb> (it->second)->SetMac (mac);
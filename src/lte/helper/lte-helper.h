@@ -52,6 +52,7 @@ class SpectrumChannel;
 class EpcHelper;
 class PropagationLossModel;
 class SpectrumPropagationLossModel;
+class FfMacSchedulerExecutor;
 
 /**
  * \ingroup lte
@@ -847,6 +848,19 @@ private:
    */
   uint16_t m_noOfCcs;
 
+  /**
+   * The `SchedulerThreads` attribute. The number of threads running the
+   * schedulers of the eNBs of a TTI in parallel; 0 to run each scheduler
+   * directly when called by its MAC.
+   */
+  uint32_t m_schedulerThreads;
+
+  /**
+   * The executor running the schedulers of all the eNBs, when
+   * m_schedulerThreads > 0.
+   */
+  Ptr<FfMacSchedulerExecutor> m_schedulerExecutor;
+
 };   // end of `class LteHelper`
 
 
@@ -54,7 +54,8 @@ NoBackhaulEpcHelper::NoBackhaulEpcHelper ()
     m_gtpcUdpPort (2123),  // fixed by the standard
     m_s5LinkDataRate (DataRate ("10Gb/s")),
     m_s5LinkDelay (Seconds (0)),
-    m_s5LinkMtu (3000)
+    m_s5LinkMtu (3000),
+    m_gtpuDirectForwarding (false)
 {
   NS_LOG_FUNCTION (this);
   // To access the attribute value within the constructor
@@ -241,6 +242,16 @@ NoBackhaulEpcHelper::GetTypeId (void)
                    UintegerValue (2000),
                    MakeUintegerAccessor (&NoBackhaulEpcHelper::m_s5LinkMtu),
                    MakeUintegerChecker<uint16_t> ())
+    .AddAttribute ("GtpuDirectForwarding",
+                   "If true, the GTP-U packets of the S1-U and S5 interfaces "
+                   "are passed directly between the applications of the eNBs, "
+                   "the SGW and the PGW, after the delay of the link, instead "
+                   "of going through the UDP/IP stacks and the links: the data "
+                   "rate, MTU, queues and pcap of the S1-U and S5 links are "
+                   "then not modeled. It applies to the eNBs added afterwards.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&NoBackhaulEpcHelper::m_gtpuDirectForwarding),
+                   MakeBooleanChecker ())
     .AddAttribute ("S11LinkDataRate", 
                    "The data rate to be used for the next S11 link to be created",
                    DataRateValue (DataRate ("10Gb/s")),
@@ -565,6 +576,22 @@ NoBackhaulEpcHelper::AddS1Interface (Ptr<Node> enb, Ipv4Address enbAddress, Ipv4
   m_mmeApp->AddEnb (cellId, enbAddress, enbApp->GetS1apSapEnb ());
   m_sgwApp->AddEnb (cellId, enbAddress, sgwAddress);
   enbApp->SetS1apSapMme (m_mmeApp->GetS1apSapMme ());
+
+  if (m_gtpuDirectForwarding)
+    {
+      NS_LOG_INFO ("Forward the GTP-U packets of eNB " << enbAddress << " directly");
+      Time s1uDelay = GetS1uLinkDelay ();
+      enbApp->SetS1uDirectForwarding (m_sgwApp, s1uDelay);
+      m_sgwApp->AddEnbDirectForwarding (enbAddress, enbApp, s1uDelay);
+      m_sgwApp->SetS5uDirectForwarding (m_pgwApp, m_s5LinkDelay);
+      m_pgwApp->SetS5uDirectForwarding (m_sgwApp, m_s5LinkDelay);
+    }
+}
+
+Time
+NoBackhaulEpcHelper::GetS1uLinkDelay (void) const
+{
+  return Seconds (0);
 }
 
 } // namespace ns3
@@ -104,6 +104,13 @@ protected:
                                          const Ptr<EpcTft> &tft,
                                          const EpsBearer &bearer) const;
 
+  /**
+   * \brief Get the delay of the S1-U link of the next eNB, which is
+   * modeled by the direct GTP-U forwarding.
+   * \return the delay of the S1-U link, zero if the backhaul is unknown
+   */
+  virtual Time GetS1uLinkDelay (void) const;
+
 private:
 
   /**
@@ -204,6 +211,12 @@ private:
    */
   uint16_t m_s5LinkMtu;
 
+  /**
+   * Whether the GTP-U packets are passed directly between the EPC
+   * applications, bypassing the UDP sockets and the S1-U and S5 links
+   */
+  bool m_gtpuDirectForwarding;
+
   /**
    * Map storing for each IMSI the corresponding eNB NetDevice
    */
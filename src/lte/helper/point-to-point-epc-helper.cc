@@ -138,4 +138,10 @@ PointToPointEpcHelper::AddEnb (Ptr<Node> enb, Ptr<NetDevice> lteEnbNetDevice, ui
   NoBackhaulEpcHelper::AddS1Interface (enb, enbS1uAddress, sgwS1uAddress, cellId);
 }
 
+Time
+PointToPointEpcHelper::GetS1uLinkDelay (void) const
+{
+  return m_s1uLinkDelay;
+}
+
 } // namespace ns3
@@ -60,6 +60,9 @@ public:
   // inherited from EpcHelper
   virtual void AddEnb (Ptr<Node> enbNode, Ptr<NetDevice> lteEnbNetDevice, uint16_t cellId);
 
+protected:
+  // inherited from NoBackhaulEpcHelper
+  virtual Time GetS1uLinkDelay (void) const;
 
 private:
 
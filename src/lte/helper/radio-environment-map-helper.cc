@@ -38,9 +38,20 @@
 #include <ns3/node.h>
 #include <ns3/buildings-helper.h>
 #include <ns3/lte-spectrum-value-helper.h>
+#include <ns3/lte-spectrum-signal-parameters.h>
+#include <ns3/spectrum-converter.h>
+#include <ns3/spectrum-propagation-loss-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/antenna-model.h>
+#include <ns3/angles.h>
 
 #include <fstream>
 #include <limits>
+#include <cmath>
+
+#ifdef HAVE_PTHREAD_H
+#include <thread>
+#endif
 
 namespace ns3 {
 
@@ -48,7 +59,14 @@ NS_LOG_COMPONENT_DEFINE ("RadioEnvironmentMapHelper");
 
 NS_OBJECT_ENSURE_REGISTERED (RadioEnvironmentMapHelper);
 
+/// The number of points of a tile of the offline map
+static const uint32_t REM_TILE_SIZE = 256;
+
 RadioEnvironmentMapHelper::RadioEnvironmentMapHelper ()
+  : m_offline (false),
+    m_numThreads (1),
+    m_maxLossDb (std::numeric_limits<double>::max ()),
+    m_nextTile (0)
 {
 }
 
@@ -154,6 +172,18 @@ RadioEnvironmentMapHelper::GetTypeId (void)
                    IntegerValue (-1),
                    MakeIntegerAccessor (&RadioEnvironmentMapHelper::m_rbId),
                    MakeIntegerChecker<int32_t> ())
+    .AddAttribute ("Offline",
+                   "If true, the map is computed from the transmissions of a single subframe "
+                   "and the loss models of the channel, without RemSpectrumPhy listeners",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RadioEnvironmentMapHelper::m_offline),
+                   MakeBooleanChecker ())
+    .AddAttribute ("NumThreads",
+                   "The number of threads computing the offline map. More than one thread "
+                   "requires loss models which can be called concurrently.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&RadioEnvironmentMapHelper::m_numThreads),
+                   MakeUintegerChecker<uint32_t> (1))
   ;
   return tid;
 }
@@ -222,6 +252,18 @@ RadioEnvironmentMapHelper::Install ()
       startDelay = 0.5001;
     }
 
+  if (m_offline)
+    {
+      // record the transmissions measured by the first iteration of the listeners
+      Simulator::Schedule (Seconds (startDelay + 0.0001),
+                           &RadioEnvironmentMapHelper::StartRecording,
+                           this);
+      Simulator::Schedule (Seconds (startDelay + 0.0006),
+                           &RadioEnvironmentMapHelper::RunOffline,
+                           this);
+      return;
+    }
+
   Simulator::Schedule (Seconds (startDelay),
                        &RadioEnvironmentMapHelper::DelayedInstall,
                        this);
@@ -355,6 +397,235 @@ RadioEnvironmentMapHelper::PrintAndReset ()
     }
 }
 
+void
+RadioEnvironmentMapHelper::StartRecording ()
+{
+  NS_LOG_FUNCTION (this);
+  m_rxSpectrumModel = LteSpectrumValueHelper::GetSpectrumModel (m_earfcn, m_bandwidth);
+  m_channel->TraceConnectWithoutContext ("TxSigParams",
+                                         MakeCallback (&RadioEnvironmentMapHelper::RecordTransmission, this));
+}
+
+void
+RadioEnvironmentMapHelper::RecordTransmission (Ptr<SpectrumSignalParameters> params)
+{
+  NS_LOG_FUNCTION (this << params);
+  if (m_useDataChannel)
+    {
+      if (DynamicCast<LteSpectrumSignalParametersDataFrame> (params) == 0)
+        {
+          return;
+        }
+    }
+  else if (DynamicCast<LteSpectrumSignalParametersDlCtrlFrame> (params) == 0)
+    {
+      return;
+    }
+
+  RemTransmitter tx;
+  tx.mobility = params->txPhy->GetMobility ();
+  tx.antenna = params->txAntenna;
+  tx.psd = params->psd;
+  if (tx.psd->GetSpectrumModelUid () != m_rxSpectrumModel->GetUid ())
+    {
+      if (tx.psd->GetSpectrumModel ()->IsOrthogonal (*m_rxSpectrumModel))
+        {
+          return;
+        }
+      SpectrumConverter converter (tx.psd->GetSpectrumModel (), m_rxSpectrumModel);
+      tx.psd = converter.Convert (tx.psd);
+    }
+  if (m_rbId >= 0)
+    {
+      tx.power = (*(tx.psd))[m_rbId] * 180000;
+    }
+  else
+    {
+      tx.power = Integral (*(tx.psd));
+    }
+  m_transmitters.push_back (tx);
+}
+
+void
+RadioEnvironmentMapHelper::RunOffline ()
+{
+  NS_LOG_FUNCTION (this);
+  m_channel->TraceDisconnectWithoutContext ("TxSigParams",
+                                            MakeCallback (&RadioEnvironmentMapHelper::RecordTransmission, this));
+  NS_LOG_INFO ("computing the map from " << m_transmitters.size () << " transmissions");
+
+  m_propagationLoss = m_channel->GetPropagationLossModel ();
+  m_spectrumPropagationLoss = m_channel->GetSpectrumPropagationLossModel ();
+  DoubleValue maxLossDb;
+  m_channel->GetAttribute ("MaxLossDb", maxLossDb);
+  m_maxLossDb = maxLossDb.Get ();
+
+  uint32_t numThreads = m_numThreads;
+#ifndef HAVE_PTHREAD_H
+  numThreads = 1;
+#endif
+  if (m_spectrumPropagationLoss)
+    {
+      numThreads = 1;
+    }
+
+  // with several threads, each thread has its own mobility models, so that
+  // the threads do not share the reference counts of the models
+  std::vector<RemWorker> workers (numThreads);
+  for (uint32_t t = 0; t < numThreads; ++t)
+    {
+      workers[t].rxMobility = CreateObject<ConstantPositionMobilityModel> ();
+      Ptr<MobilityBuildingInfo> rxBuildingInfo = CreateObject<MobilityBuildingInfo> ();
+      workers[t].rxMobility->AggregateObject (rxBuildingInfo);
+      // the first call creates the building list, which must be done in this thread
+      rxBuildingInfo->MakeConsistent (workers[t].rxMobility);
+      for (std::vector<RemTransmitter>::const_iterator it = m_transmitters.begin (); it != m_transmitters.end (); ++it)
+        {
+          if (numThreads == 1 || it->mobility == 0)
+            {
+              workers[t].txMobility.push_back (it->mobility);
+              continue;
+            }
+          Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+          mobility->SetPosition (it->mobility->GetPosition ());
+          if (it->mobility->GetObject<MobilityBuildingInfo> () != 0)
+            {
+              Ptr<MobilityBuildingInfo> buildingInfo = CreateObject<MobilityBuildingInfo> ();
+              mobility->AggregateObject (buildingInfo);
+              buildingInfo->MakeConsistent (mobility);
+            }
+          workers[t].txMobility.push_back (mobility);
+        }
+    }
+
+  // the points are generated as by DelayedInstall, and written in the same order
+  std::vector<double> xs;
+  std::vector<double> ys;
+  m_xStep = (m_xMax - m_xMin)/(m_xRes-1);
+  m_yStep = (m_yMax - m_yMin)/(m_yRes-1);
+  for (double x = m_xMin; x < m_xMax + 0.5*m_xStep; x += m_xStep)
+    {
+      xs.push_back (x);
+    }
+  for (double y = m_yMin; y < m_yMax + 0.5*m_yStep; y += m_yStep)
+    {
+      ys.push_back (y);
+    }
+
+  std::vector<Vector> points;
+  std::vector<double> sinr;
+  points.reserve (std::min<double> (m_maxPointsPerIteration, (double) xs.size () * ys.size ()));
+  for (std::size_t i = 0; i < xs.size (); ++i)
+    {
+      for (std::size_t j = 0; j < ys.size (); ++j)
+        {
+          points.push_back (Vector (xs[i], ys[j], m_z));
+          if (points.size () < m_maxPointsPerIteration
+              && (i + 1 < xs.size () || j + 1 < ys.size ()))
+            {
+              continue;
+            }
+
+          // compute the batch by tiles, then stream it to the file
+          sinr.resize (points.size ());
+          m_nextTile = 0;
+#ifdef HAVE_PTHREAD_H
+          std::vector<std::thread> threads;
+          for (uint32_t t = 1; t < numThreads; ++t)
+            {
+              threads.emplace_back (&RadioEnvironmentMapHelper::ComputeTiles, this, &workers[t], &points, &sinr);
+            }
+#endif
+          ComputeTiles (&workers[0], &points, &sinr);
+#ifdef HAVE_PTHREAD_H
+          for (std::vector<std::thread>::iterator it = threads.begin (); it != threads.end (); ++it)
+            {
+              it->join ();
+            }
+#endif
+          for (std::size_t k = 0; k < points.size (); ++k)
+            {
+              m_outFile << points[k].x << "\t"
+                        << points[k].y << "\t"
+                        << points[k].z << "\t"
+                        << sinr[k]
+                        << "\n";
+            }
+          points.clear ();
+        }
+    }
+
+  m_transmitters.clear ();
+  Finalize ();
+}
+
+void
+RadioEnvironmentMapHelper::ComputeTiles (RemWorker *worker, const std::vector<Vector> *points, std::vector<double> *sinr)
+{
+  uint32_t first;
+  while ((first = (m_nextTile += REM_TILE_SIZE) - REM_TILE_SIZE) < points->size ())
+    {
+      uint32_t last = std::min<uint32_t> (first + REM_TILE_SIZE, points->size ());
+      for (uint32_t i = first; i < last; ++i)
+        {
+          (*sinr)[i] = ComputeSinr (*worker, (*points)[i]);
+        }
+    }
+}
+
+double
+RadioEnvironmentMapHelper::ComputeSinr (RemWorker &worker, const Vector &point) const
+{
+  worker.rxMobility->SetPosition (point);
+  worker.rxMobility->GetObject<MobilityBuildingInfo> ()->MakeConsistent (worker.rxMobility);
+
+  // same computation as the channel and RemSpectrumPhy
+  double referenceSignalPower = 0;
+  double sumPower = 0;
+  for (std::size_t i = 0; i < m_transmitters.size (); ++i)
+    {
+      const RemTransmitter &tx = m_transmitters[i];
+      const Ptr<MobilityModel> &txMobility = worker.txMobility[i];
+      double power = tx.power;
+      if (txMobility != 0)
+        {
+          double pathLossDb = 0;
+          if (tx.antenna != 0)
+            {
+              Angles txAngles (point, txMobility->GetPosition ());
+              pathLossDb -= tx.antenna->GetGainDb (txAngles);
+            }
+          if (m_propagationLoss != 0)
+            {
+              pathLossDb -= m_propagationLoss->CalcRxPower (0, txMobility, worker.rxMobility);
+            }
+          if (pathLossDb > m_maxLossDb)
+            {
+              continue;
+            }
+          double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
+          if (m_spectrumPropagationLoss != 0)
+            {
+              Ptr<SpectrumValue> rxPsd = Copy<SpectrumValue> (tx.psd);
+              *rxPsd *= pathGainLinear;
+              rxPsd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxPsd, txMobility, worker.rxMobility);
+              power = (m_rbId >= 0) ? (*rxPsd)[m_rbId] * 180000 : Integral (*rxPsd);
+            }
+          else
+            {
+              power *= pathGainLinear;
+            }
+        }
+      sumPower += power;
+      if (power > referenceSignalPower)
+        {
+          referenceSignalPower = power;
+        }
+    }
+  return referenceSignalPower / (sumPower - referenceSignalPower + m_noisePower);
+}
+
+
 void 
 RadioEnvironmentMapHelper::Finalize ()
 {
@@ -23,8 +23,15 @@
 #define RADIO_ENVIRONMENT_MAP_HELPER_H
 
 
+#include <ns3/core-config.h>
 #include <ns3/object.h>
+#include <ns3/vector.h>
 #include <fstream>
+#include <vector>
+
+#ifdef HAVE_PTHREAD_H
+#include <atomic>
+#endif
 
 
 namespace ns3 {
@@ -35,6 +42,12 @@ class NetDevice;
 class SpectrumChannel;
 //class BuildingsMobilityModel;
 class MobilityModel;
+class AntennaModel;
+class SpectrumValue;
+class SpectrumModel;
+class PropagationLossModel;
+class SpectrumPropagationLossModel;
+class SpectrumSignalParameters;
 
 /** 
  * \ingroup lte
@@ -42,6 +55,19 @@ class MobilityModel;
  * Generates a 2D map of the SINR from the strongest transmitter in the
  * downlink of an LTE FDD system. For instructions on usage, please refer to
  * the User Documentation.
+ *
+ * By default, the map is measured by RemSpectrumPhy listeners attached to
+ * the channel, moved over the map one batch of points per subframe.  With
+ * the `Offline` attribute, the transmissions of a single subframe are
+ * recorded instead, and the SINR of every point is computed directly from
+ * the loss models of the channel, by tiles of points shared among
+ * `NumThreads` threads, without simulation events.  The offline map assumes
+ * that the transmissions do not change from one subframe to the next.
+ *
+ * The offline threads call the loss models concurrently: more than one
+ * thread should only be used with loss models which keep no state, e.g.,
+ * without shadowing, channel condition or fast fading caches.  A
+ * frequency-dependent loss model is always evaluated in a single thread.
  */
 class RadioEnvironmentMapHelper : public Object
 {
@@ -108,6 +134,51 @@ private:
   /// Called when the map generation procedure has been completed.
   void Finalize ();
 
+  /// Start recording the transmissions on the channel, for the offline map.
+  void StartRecording ();
+
+  /**
+   * Record a transmission on the channel.
+   * \param params the parameters of the transmitted signal
+   */
+  void RecordTransmission (Ptr<SpectrumSignalParameters> params);
+
+  /// Stop recording the transmissions, then compute and write the offline map.
+  void RunOffline ();
+
+  /// A transmitter recorded for the offline map.
+  struct RemTransmitter
+  {
+    Ptr<MobilityModel> mobility;  ///< Position of the transmitter.
+    Ptr<AntennaModel> antenna;    ///< Antenna of the transmitter.
+    Ptr<SpectrumValue> psd;       ///< Transmitted PSD, in the spectrum model of the map.
+    double power;                 ///< Transmitted power over the band of the map.
+  };
+
+  /// The objects used by a thread computing the offline map.
+  struct RemWorker
+  {
+    Ptr<MobilityModel> rxMobility;               ///< Position of the point.
+    std::vector<Ptr<MobilityModel> > txMobility; ///< Positions of the transmitters.
+  };
+
+  /**
+   * Compute the SINR of the points of the offline map not taken by another
+   * thread.
+   * \param worker the objects of the thread
+   * \param points the points of the batch
+   * \param sinr the SINR of the points of the batch
+   */
+  void ComputeTiles (RemWorker *worker, const std::vector<Vector> *points, std::vector<double> *sinr);
+
+  /**
+   * Compute the SINR of a point of the offline map.
+   * \param worker the objects of the thread
+   * \param point the position of the point
+   * \return the SINR
+   */
+  double ComputeSinr (RemWorker &worker, const Vector &point) const;
+
   /// A complete Radio Environment Map is composed of many of this structure.
   struct RemPoint 
   {
@@ -163,6 +234,20 @@ private:
   bool m_useDataChannel;  ///< The `UseDataChannel` attribute.
   int32_t m_rbId;         ///< The `RbId` attribute.
 
+  bool m_offline;         ///< The `Offline` attribute.
+  uint32_t m_numThreads;  ///< The `NumThreads` attribute.
+
+  std::vector<RemTransmitter> m_transmitters;  ///< The transmitters recorded for the offline map.
+  Ptr<const SpectrumModel> m_rxSpectrumModel;  ///< The spectrum model of the map.
+  Ptr<PropagationLossModel> m_propagationLoss; ///< The propagation loss model of the channel.
+  Ptr<SpectrumPropagationLossModel> m_spectrumPropagationLoss; ///< The frequency-dependent loss model of the channel.
+  double m_maxLossDb;     ///< The maximum loss of the channel, in dB.
+#ifdef HAVE_PTHREAD_H
+  std::atomic<uint32_t> m_nextTile; ///< The first point of the next tile of the offline map, in the batch.
+#else
+  uint32_t m_nextTile;    ///< The first point of the next tile of the offline map, in the batch.
+#endif
+
 }; // end of `class RadioEnvironmentMapHelper`
 
 
@@ -26,8 +26,11 @@
 #include "ns3/ipv4.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/uinteger.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
 
 #include "epc-gtpu-header.h"
+#include "epc-sgw-application.h"
 #include "eps-bearer-tag.h"
 
 
@@ -83,6 +86,7 @@ EpcEnbApplication::DoDispose (void)
   m_lteSocket = 0;
   m_lteSocket6 = 0;
   m_s1uSocket = 0;
+  m_sgwApp = 0;
   delete m_s1SapProvider;
   delete m_s1apSapEnb;
 }
@@ -115,6 +119,14 @@ EpcEnbApplication::AddS1Interface (Ptr<Socket> s1uSocket, Ipv4Address enbAddress
   m_sgwS1uAddress = sgwAddress;
 }
 
+void
+EpcEnbApplication::SetS1uDirectForwarding (Ptr<EpcSgwApplication> sgwApp, Time delay)
+{
+  NS_LOG_FUNCTION (this << sgwApp << delay);
+  m_sgwApp = sgwApp;
+  m_s1uDirectDelay = delay;
+}
+
 
 EpcEnbApplication::~EpcEnbApplication (void)
 {
@@ -197,7 +209,7 @@ void
 EpcEnbApplication::DoUeContextRelease (uint16_t rnti)
 {
   NS_LOG_FUNCTION (this << rnti);
-  std::map<uint16_t, std::map<uint8_t, uint32_t> >::iterator rntiIt = m_rbidTeidMap.find (rnti);
+  auto rntiIt = m_rbidTeidMap.find (rnti);
   if (rntiIt != m_rbidTeidMap.end ())
     {
       for (std::map<uint8_t, uint32_t>::iterator bidIt = rntiIt->second.begin ();
@@ -208,8 +220,8 @@ EpcEnbApplication::DoUeContextRelease (uint16_t rnti)
           m_teidRbidMap.erase (teid);
           NS_LOG_INFO ("TEID: " << teid << " erased");
         }
-      m_rbidTeidMap.erase (rntiIt);
       NS_LOG_INFO ("RNTI: " << rntiIt->first << " erased");
+      m_rbidTeidMap.erase (rntiIt);
     }
 }
 
@@ -281,7 +293,7 @@ EpcEnbApplication::RecvFromLteSocket (Ptr<Socket> socket)
   uint16_t rnti = tag.GetRnti ();
   uint8_t bid = tag.GetBid ();
   NS_LOG_LOGIC ("received packet with RNTI=" << (uint32_t) rnti << ", BID=" << (uint32_t)  bid);
-  std::map<uint16_t, std::map<uint8_t, uint32_t> >::iterator rntiIt = m_rbidTeidMap.find (rnti);
+  auto rntiIt = m_rbidTeidMap.find (rnti);
   if (rntiIt == m_rbidTeidMap.end ())
     {
       NS_LOG_WARN ("UE context not found, discarding packet");
@@ -291,7 +303,10 @@ EpcEnbApplication::RecvFromLteSocket (Ptr<Socket> socket)
       std::map<uint8_t, uint32_t>::iterator bidIt = rntiIt->second.find (bid);
       NS_ASSERT (bidIt != rntiIt->second.end ());
       uint32_t teid = bidIt->second;
-      m_rxLteSocketPktTrace (packet->Copy ());
+      if (!m_rxLteSocketPktTrace.IsEmpty ())
+        {
+          m_rxLteSocketPktTrace (packet->Copy ());
+        }
       SendToS1uSocket (packet, teid);
     }
 }
@@ -302,17 +317,27 @@ EpcEnbApplication::RecvFromS1uSocket (Ptr<Socket> socket)
   NS_LOG_FUNCTION (this << socket);  
   NS_ASSERT (socket == m_s1uSocket);
   Ptr<Packet> packet = socket->Recv ();
+  RecvFromS1u (packet);
+}
+
+void 
+EpcEnbApplication::RecvFromS1u (Ptr<Packet> packet)
+{
+  NS_LOG_FUNCTION (this << packet);
   GtpuHeader gtpu;
   packet->RemoveHeader (gtpu);
   uint32_t teid = gtpu.GetTeid ();
-  std::map<uint32_t, EpsFlowId_t>::iterator it = m_teidRbidMap.find (teid);
+  auto it = m_teidRbidMap.find (teid);
   if (it == m_teidRbidMap.end ())
     {
       NS_LOG_WARN ("UE context at cell id " << m_cellId << " not found, discarding packet");
     }
   else
     {
-      m_rxS1uSocketPktTrace (packet->Copy ());
+      if (!m_rxS1uSocketPktTrace.IsEmpty ())
+        {
+          m_rxS1uSocketPktTrace (packet->Copy ());
+        }
       SendToLteSocket (packet, it->second.m_rnti, it->second.m_bid);
     }
 }
@@ -356,6 +381,12 @@ EpcEnbApplication::SendToS1uSocket (Ptr<Packet> packet, uint32_t teid)
   // Length of the payload + the non obligatory GTP-U header
   gtpu.SetLength (packet->GetSize () + gtpu.GetSerializedSize () - 8);  
   packet->AddHeader (gtpu);
+  if (m_sgwApp)
+    {
+      Simulator::ScheduleWithContext (m_sgwApp->GetNode ()->GetId (), m_s1uDirectDelay,
+                                      &EpcSgwApplication::RecvFromS1u, m_sgwApp, packet);
+      return;
+    }
   uint32_t flags = 0;
   m_s1uSocket->SendTo (packet, flags, InetSocketAddress (m_sgwS1uAddress, m_gtpuUdpPort));
 }
@@ -34,11 +34,14 @@
 #include <ns3/eps-bearer.h>
 #include <ns3/epc-enb-s1-sap.h>
 #include <ns3/epc-s1ap-sap.h>
+#include <ns3/nstime.h>
 #include <map>
+#include <unordered_map>
 
 namespace ns3 {
 class EpcEnbS1SapUser;
 class EpcEnbS1SapProvider;
+class EpcSgwApplication;
 
 
 /**
@@ -86,6 +89,18 @@ public:
    */
   void AddS1Interface (Ptr<Socket> s1uSocket, Ipv4Address enbAddress, Ipv4Address sgwAddress);
 
+  /**
+   * Pass the GTP-U packets of the S1-U interface directly to the SGW
+   * application, instead of sending them through the S1-U socket.
+   *
+   * The packets skip the UDP/IP stacks and the S1-U link: only the
+   * delay of the link is modeled, and not its data rate, MTU or queue.
+   *
+   * \param sgwApp the SGW application
+   * \param delay the delay of the S1-U link
+   */
+  void SetS1uDirectForwarding (Ptr<EpcSgwApplication> sgwApp, Time delay);
+
 
   /**
    * Destructor
@@ -135,6 +150,14 @@ public:
    */
   void RecvFromS1uSocket (Ptr<Socket> socket);
 
+  /**
+   * Process a GTP-U packet received from the SGW, either by the S1-U
+   * socket or directly from the SGW application.
+   *
+   * \param packet the packet, starting with the GTP-U header
+   */
+  void RecvFromS1u (Ptr<Packet> packet);
+
   /**
    * TracedCallback signature for data Packet reception event.
    *
@@ -284,13 +307,23 @@ private:
    * map of maps telling for each RNTI and BID the corresponding  S1-U TEID
    * 
    */
-  std::map<uint16_t, std::map<uint8_t, uint32_t> > m_rbidTeidMap;  
+  std::unordered_map<uint16_t, std::map<uint8_t, uint32_t> > m_rbidTeidMap;
 
   /**
    * map telling for each S1-U TEID the corresponding RNTI,BID
    * 
    */
-  std::map<uint32_t, EpsFlowId_t> m_teidRbidMap;
+  std::unordered_map<uint32_t, EpsFlowId_t> m_teidRbidMap;
+
+  /**
+   * SGW application the S1-U packets are passed to, if the direct forwarding is enabled
+   */
+  Ptr<EpcSgwApplication> m_sgwApp;
+
+  /**
+   * delay of the S1-U link in the direct forwarding
+   */
+  Time m_s1uDirectDelay;
  
   /**
    * UDP port to be used for GTP
@@ -28,8 +28,11 @@
 #include "ns3/ipv6-header.h"
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/inet-socket-address.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
 #include "ns3/epc-gtpu-header.h"
 #include "ns3/epc-pgw-application.h"
+#include "ns3/epc-sgw-application.h"
 
 namespace ns3 {
 
@@ -138,6 +141,7 @@ EpcPgwApplication::DoDispose ()
   m_s5uSocket = 0;
   m_s5cSocket->SetRecvCallback (MakeNullCallback<void, Ptr<Socket> > ());
   m_s5cSocket = 0;
+  m_sgwApp = 0;
 }
 
 EpcPgwApplication::EpcPgwApplication (const Ptr<VirtualNetDevice> tunDevice, Ipv4Address s5Addr,
@@ -163,7 +167,10 @@ bool
 EpcPgwApplication::RecvFromTunDevice (Ptr<Packet> packet, const Address& source, const Address& dest, uint16_t protocolNumber)
 {
   NS_LOG_FUNCTION (this << source << dest << protocolNumber << packet << packet->GetSize ());
-  m_rxTunPktTrace (packet->Copy ());
+  if (!m_rxTunPktTrace.IsEmpty ())
+    {
+      m_rxTunPktTrace (packet->Copy ());
+    }
 
   // get IP address of UE
   if (protocolNumber == Ipv4L3Protocol::PROT_NUMBER)
@@ -174,7 +181,7 @@ EpcPgwApplication::RecvFromTunDevice (Ptr<Packet> packet, const Address& source,
       NS_LOG_LOGIC ("packet addressed to UE " << ueAddr);
 
       // find corresponding UeInfo address
-      std::map<Ipv4Address, Ptr<UeInfo> >::iterator it = m_ueInfoByAddrMap.find (ueAddr);
+      auto it = m_ueInfoByAddrMap.find (ueAddr);
       if (it == m_ueInfoByAddrMap.end ())
         {
           NS_LOG_WARN ("unknown UE address " << ueAddr);
@@ -201,7 +208,7 @@ EpcPgwApplication::RecvFromTunDevice (Ptr<Packet> packet, const Address& source,
       NS_LOG_LOGIC ("packet addressed to UE " << ueAddr);
 
       // find corresponding UeInfo address
-      std::map<Ipv6Address, Ptr<UeInfo> >::iterator it = m_ueInfoByAddrMap6.find (ueAddr);
+      auto it = m_ueInfoByAddrMap6.find (ueAddr);
       if (it == m_ueInfoByAddrMap6.end ())
         {
           NS_LOG_WARN ("unknown UE address " << ueAddr);
@@ -238,7 +245,17 @@ EpcPgwApplication::RecvFromS5uSocket (Ptr<Socket> socket)
   NS_LOG_FUNCTION (this << socket);
   NS_ASSERT (socket == m_s5uSocket);
   Ptr<Packet> packet = socket->Recv ();
-  m_rxS5PktTrace (packet->Copy ());
+  RecvFromS5u (packet);
+}
+
+void
+EpcPgwApplication::RecvFromS5u (Ptr<Packet> packet)
+{
+  NS_LOG_FUNCTION (this << packet);
+  if (!m_rxS5PktTrace.IsEmpty ())
+    {
+      m_rxS5PktTrace (packet->Copy ());
+    }
 
   GtpuHeader gtpu;
   packet->RemoveHeader (gtpu);
@@ -467,11 +484,25 @@ EpcPgwApplication::SendToS5uSocket (Ptr<Packet> packet, Ipv4Address sgwAddr, uin
   // Length of the payload + the non obligatory GTP-U header
   gtpu.SetLength (packet->GetSize () + gtpu.GetSerializedSize () - 8);
   packet->AddHeader (gtpu);
+  if (m_sgwApp)
+    {
+      Simulator::ScheduleWithContext (m_sgwApp->GetNode ()->GetId (), m_s5uDirectDelay,
+                                      &EpcSgwApplication::RecvFromS5u, m_sgwApp, packet);
+      return;
+    }
   uint32_t flags = 0;
   m_s5uSocket->SendTo (packet, flags, InetSocketAddress (sgwAddr, m_gtpuUdpPort));
 }
 
 
+void
+EpcPgwApplication::SetS5uDirectForwarding (Ptr<EpcSgwApplication> sgwApp, Time delay)
+{
+  NS_LOG_FUNCTION (this << sgwApp << delay);
+  m_sgwApp = sgwApp;
+  m_s5uDirectDelay = delay;
+}
+
 void
 EpcPgwApplication::AddSgw (Ipv4Address sgwS5Addr)
 {
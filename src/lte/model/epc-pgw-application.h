@@ -27,9 +27,14 @@
 #include "ns3/application.h"
 #include "ns3/epc-tft-classifier.h"
 #include "ns3/epc-gtpc-header.h"
+#include "ns3/nstime.h"
+#include <map>
+#include <unordered_map>
 
 namespace ns3 {
 
+class EpcSgwApplication;
+
 /**
  * \ingroup lte
  *
@@ -98,6 +103,23 @@ public:
    */
   void RecvFromS5uSocket (Ptr<Socket> socket);
 
+  /**
+   * Process a GTP-U packet received from the SGW, either by the S5-U
+   * socket or directly from the SGW application.
+   *
+   * \param packet the packet, starting with the GTP-U header
+   */
+  void RecvFromS5u (Ptr<Packet> packet);
+
+  /**
+   * Pass the GTP-U packets of the S5 interface directly to the SGW
+   * application, instead of sending them through the S5-U socket.
+   *
+   * \param sgwApp the SGW application
+   * \param delay the delay of the S5 link
+   */
+  void SetS5uDirectForwarding (Ptr<EpcSgwApplication> sgwApp, Time delay);
+
   /**
    * Method to be assigned to the receiver callback of the S5-C socket.
    * It is called when the PGW receives a control packet from the SGW.
@@ -300,12 +322,12 @@ private:
   /**
    * UeInfo stored by UE IPv4 address
    */
-  std::map<Ipv4Address, Ptr<UeInfo> > m_ueInfoByAddrMap;
+  std::unordered_map<Ipv4Address, Ptr<UeInfo>, Ipv4AddressHash> m_ueInfoByAddrMap;
 
   /**
    * UeInfo stored by UE IPv6 address
    */
-  std::map<Ipv6Address, Ptr<UeInfo> > m_ueInfoByAddrMap6;
+  std::unordered_map<Ipv6Address, Ptr<UeInfo>, Ipv6AddressHash> m_ueInfoByAddrMap6;
 
   /**
    * UeInfo stored by IMSI
@@ -336,6 +358,16 @@ private:
    * \brief Callback to trace received data packets from S5 socket.
    */
   TracedCallback<Ptr<Packet> > m_rxS5PktTrace;
+
+  /**
+   * SGW application the S5-U packets are passed to, if the direct forwarding is enabled
+   */
+  Ptr<EpcSgwApplication> m_sgwApp;
+
+  /**
+   * S5 link delay in the direct forwarding
+   */
+  Time m_s5uDirectDelay;
 };
 
 } // namespace ns3
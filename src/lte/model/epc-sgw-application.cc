@@ -19,7 +19,11 @@
  */
 
 #include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
 #include "ns3/epc-gtpu-header.h"
+#include "ns3/epc-enb-application.h"
+#include "ns3/epc-pgw-application.h"
 #include "ns3/epc-sgw-application.h"
 
 namespace ns3 {
@@ -59,6 +63,8 @@ EpcSgwApplication::DoDispose ()
   m_s5uSocket = 0;
   m_s5cSocket->SetRecvCallback (MakeNullCallback<void, Ptr<Socket> > ());
   m_s5cSocket = 0;
+  m_enbDirectByAddr.clear ();
+  m_pgwApp = 0;
 }
 
 TypeId
@@ -97,6 +103,24 @@ EpcSgwApplication::AddEnb (uint16_t cellId, Ipv4Address enbAddr, Ipv4Address sgw
   m_enbInfoByCellId[cellId] = enbInfo;
 }
 
+void
+EpcSgwApplication::AddEnbDirectForwarding (Ipv4Address enbAddr, Ptr<EpcEnbApplication> enbApp, Time delay)
+{
+  NS_LOG_FUNCTION (this << enbAddr << enbApp << delay);
+  EnbDirectInfo info;
+  info.enbApp = enbApp;
+  info.delay = delay;
+  m_enbDirectByAddr[enbAddr] = info;
+}
+
+void
+EpcSgwApplication::SetS5uDirectForwarding (Ptr<EpcPgwApplication> pgwApp, Time delay)
+{
+  NS_LOG_FUNCTION (this << pgwApp << delay);
+  m_pgwApp = pgwApp;
+  m_s5uDirectDelay = delay;
+}
+
 
 void
 EpcSgwApplication::RecvFromS11Socket (Ptr<Socket> socket)
@@ -139,8 +163,17 @@ EpcSgwApplication::RecvFromS5uSocket (Ptr<Socket> socket)
   NS_LOG_FUNCTION (this << socket);
   NS_ASSERT (socket == m_s5uSocket);
   Ptr<Packet> packet = socket->Recv ();
+  RecvFromS5u (packet);
+}
+
+void
+EpcSgwApplication::RecvFromS5u (Ptr<Packet> packet)
+{
+  NS_LOG_FUNCTION (this << packet);
+  // the S1-U and S5 tunnels of a bearer use the same TEID, so the
+  // GTP-U header is left in place and the packet is forwarded as is
   GtpuHeader gtpu;
-  packet->RemoveHeader (gtpu);
+  packet->PeekHeader (gtpu);
   uint32_t teid = gtpu.GetTeid ();
 
   Ipv4Address enbAddr = m_enbByTeidMap[teid];
@@ -184,8 +217,15 @@ EpcSgwApplication::RecvFromS1uSocket (Ptr<Socket> socket)
   NS_LOG_FUNCTION (this << socket);
   NS_ASSERT (socket == m_s1uSocket);
   Ptr<Packet> packet = socket->Recv ();
+  RecvFromS1u (packet);
+}
+
+void
+EpcSgwApplication::RecvFromS1u (Ptr<Packet> packet)
+{
+  NS_LOG_FUNCTION (this << packet);
   GtpuHeader gtpu;
-  packet->RemoveHeader (gtpu);
+  packet->PeekHeader (gtpu);
   uint32_t teid = gtpu.GetTeid ();
 
   SendToS5uSocket (packet, m_pgwAddr, teid);
@@ -196,12 +236,16 @@ EpcSgwApplication::SendToS1uSocket (Ptr<Packet> packet, Ipv4Address enbAddr, uin
 {
   NS_LOG_FUNCTION (this << packet << enbAddr << teid);
 
-  GtpuHeader gtpu;
-  gtpu.SetTeid (teid);
-  // From 3GPP TS 29.281 v10.0.0 Section 5.1
-  // Length of the payload + the non obligatory GTP-U header
-  gtpu.SetLength (packet->GetSize () + gtpu.GetSerializedSize () - 8);
-  packet->AddHeader (gtpu);
+  if (!m_enbDirectByAddr.empty ())
+    {
+      auto it = m_enbDirectByAddr.find (enbAddr);
+      if (it != m_enbDirectByAddr.end ())
+        {
+          Simulator::ScheduleWithContext (it->second.enbApp->GetNode ()->GetId (), it->second.delay,
+                                          &EpcEnbApplication::RecvFromS1u, it->second.enbApp, packet);
+          return;
+        }
+    }
   m_s1uSocket->SendTo (packet, 0, InetSocketAddress (enbAddr, m_gtpuUdpPort));
 }
 
@@ -210,12 +254,12 @@ EpcSgwApplication::SendToS5uSocket (Ptr<Packet> packet, Ipv4Address pgwAddr, uin
 {
   NS_LOG_FUNCTION (this << packet << pgwAddr << teid);
 
-  GtpuHeader gtpu;
-  gtpu.SetTeid (teid);
-  // From 3GPP TS 29.281 v10.0.0 Section 5.1
-  // Length of the payload + the non obligatory GTP-U header
-  gtpu.SetLength (packet->GetSize () + gtpu.GetSerializedSize () - 8);
-  packet->AddHeader (gtpu);
+  if (m_pgwApp)
+    {
+      Simulator::ScheduleWithContext (m_pgwApp->GetNode ()->GetId (), m_s5uDirectDelay,
+                                      &EpcPgwApplication::RecvFromS5u, m_pgwApp, packet);
+      return;
+    }
   m_s5uSocket->SendTo (packet, 0, InetSocketAddress (pgwAddr, m_gtpuUdpPort));
 }
 
@@ -323,7 +367,7 @@ EpcSgwApplication::DoRecvModifyBearerRequest (Ptr<Packet> packet)
       Ipv4Address enbAddr = bearerContext.fteid.addr;
       NS_LOG_DEBUG ("bearerId " << (uint16_t)bearerContext.epsBearerId <<
                     " TEID " << teid);
-      std::map<uint32_t, Ipv4Address>::iterator addrit = m_enbByTeidMap.find (teid);
+      auto addrit = m_enbByTeidMap.find (teid);
       NS_ASSERT_MSG (addrit != m_enbByTeidMap.end (), "unknown TEID " << teid);
       addrit->second = enbAddr;
       GtpcModifyBearerRequestMessage::BearerContextToBeModified bearerContextOut;
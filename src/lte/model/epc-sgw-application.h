@@ -25,9 +25,15 @@
 #include "ns3/address.h"
 #include "ns3/socket.h"
 #include "ns3/epc-gtpc-header.h"
+#include "ns3/nstime.h"
+#include <map>
+#include <unordered_map>
 
 namespace ns3 {
 
+class EpcEnbApplication;
+class EpcPgwApplication;
+
 /**
  * \ingroup lte
  *
@@ -95,6 +101,41 @@ public:
    */
   void AddEnb (uint16_t cellId, Ipv4Address enbAddr, Ipv4Address sgwAddr);
 
+  /**
+   * Pass the GTP-U packets of the S1-U interface of an eNB directly to
+   * the eNB application, instead of sending them through the S1-U socket.
+   *
+   * \param enbAddr the S1-U address of the eNB
+   * \param enbApp the eNB application
+   * \param delay the delay of the S1-U link
+   */
+  void AddEnbDirectForwarding (Ipv4Address enbAddr, Ptr<EpcEnbApplication> enbApp, Time delay);
+
+  /**
+   * Pass the GTP-U packets of the S5 interface directly to the PGW
+   * application, instead of sending them through the S5-U socket.
+   *
+   * \param pgwApp the PGW application
+   * \param delay the delay of the S5 link
+   */
+  void SetS5uDirectForwarding (Ptr<EpcPgwApplication> pgwApp, Time delay);
+
+  /**
+   * Forward a GTP-U packet received from an eNB, either by the S1-U
+   * socket or directly from the eNB application, to the PGW.
+   *
+   * \param packet the packet, starting with the GTP-U header
+   */
+  void RecvFromS1u (Ptr<Packet> packet);
+
+  /**
+   * Forward a GTP-U packet received from the PGW, either by the S5-U
+   * socket or directly from the PGW application, to an eNB.
+   *
+   * \param packet the packet, starting with the GTP-U header
+   */
+  void RecvFromS5u (Ptr<Packet> packet);
+
 
 private:
   /**
@@ -134,7 +175,7 @@ private:
   /**
    * Send a data packet to the PGW via the S5 interface
    *
-   * \param packet packet to be sent
+   * \param packet packet to be sent, with the GTP-U header of the tunnel
    * \param pgwAddr the address of the PGW
    * \param teid the Tunnel Enpoint Identifier
    */
@@ -143,7 +184,7 @@ private:
   /**
    * Send a data packet to an eNB via the S1-U interface
    *
-   * \param packet packet to be sent
+   * \param packet packet to be sent, with the GTP-U header of the tunnel
    * \param enbS1uAddress the address of the eNB
    * \param teid the Tunnel Enpoint IDentifier
    */
@@ -264,7 +305,29 @@ private:
   /**
    * Map for eNB address by TEID
    */
-  std::map<uint32_t, Ipv4Address> m_enbByTeidMap;
+  std::unordered_map<uint32_t, Ipv4Address> m_enbByTeidMap;
+
+  /// Direct forwarding to an eNB
+  struct EnbDirectInfo
+  {
+    Ptr<EpcEnbApplication> enbApp; ///< eNB application
+    Time delay;                    ///< S1-U link delay
+  };
+
+  /**
+   * Map for the direct forwarding by eNB S1-U address
+   */
+  std::unordered_map<Ipv4Address, EnbDirectInfo, Ipv4AddressHash> m_enbDirectByAddr;
+
+  /**
+   * PGW application the S5-U packets are passed to, if the direct forwarding is enabled
+   */
+  Ptr<EpcPgwApplication> m_pgwApp;
+
+  /**
+   * S5 link delay in the direct forwarding
+   */
+  Time m_s5uDirectDelay;
 
   /**
    * MME S11 FTEID by SGW S5C TEID
@@ -27,10 +27,6 @@
 #include "epc-tft.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
-#include "ns3/ipv4-header.h"
-#include "ns3/ipv6-header.h"
-#include "ns3/udp-header.h"
-#include "ns3/tcp-header.h"
 #include "ns3/ipv4-l3-protocol.h"
 #include "ns3/icmpv4-l4-protocol.h"
 #include "ns3/udp-l4-protocol.h"
@@ -42,6 +38,48 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EpcTftClassifier");
 
+/// The number of bytes peeked from a packet: the largest IPv4 header, then the ports
+static const uint32_t MAX_PEEK_SIZE = 60 + 4;
+
+/**
+ * \param buf the bytes of a packet
+ * \return the 16 bits in network order at the start of buf
+ */
+static inline uint16_t
+ReadNtohU16 (const uint8_t *buf)
+{
+  return (buf[0] << 8) | buf[1];
+}
+
+/**
+ * \param buf the bytes of a packet
+ * \return the 32 bits in network order at the start of buf
+ */
+static inline uint32_t
+ReadNtohU32 (const uint8_t *buf)
+{
+  return ((uint32_t) ReadNtohU16 (buf) << 16) | ReadNtohU16 (buf + 2);
+}
+
+/**
+ * \param address an IPv6 address
+ * \param masked the masked address of a filter
+ * \param prefix the prefix of the filter
+ * \return true if the address matches the filter
+ */
+static inline bool
+IsIpv6Match (const uint8_t *address, const uint8_t *masked, const uint8_t *prefix)
+{
+  for (uint32_t i = 0; i < 16; i++)
+    {
+      if ((address[i] & prefix[i]) != masked[i])
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
 EpcTftClassifier::EpcTftClassifier ()
 {
   NS_LOG_FUNCTION (this);
@@ -55,6 +93,7 @@ EpcTftClassifier::Add (Ptr<EpcTft> tft, uint32_t id)
 
   // simple sanity check: there shouldn't be more than 16 bearers (hence TFTs) per UE
   NS_ASSERT (m_tftMap.size () <= 16);
+  Compile ();
 }
 
 void
@@ -62,6 +101,72 @@ EpcTftClassifier::Delete (uint32_t id)
 {
   NS_LOG_FUNCTION (this << id);
   m_tftMap.erase (id);
+  Compile ();
+}
+
+void
+EpcTftClassifier::Compile (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_uplinkFilters.clear ();
+  m_downlinkFilters.clear ();
+
+  // we use a reverse iterator since filter priority is not implemented properly.
+  // This way, since the default bearer is expected to be added first, it will be evaluated last.
+  for (std::map <uint32_t, Ptr<EpcTft> >::const_reverse_iterator it = m_tftMap.rbegin ();
+       it != m_tftMap.rend ();
+       ++it)
+    {
+      std::list<EpcTft::PacketFilter> packetFilters = it->second->GetPacketFilters ();
+      for (std::list<EpcTft::PacketFilter>::const_iterator pfIt = packetFilters.begin ();
+           pfIt != packetFilters.end ();
+           ++pfIt)
+        {
+          CompiledFilter f;
+          f.id = it->first;
+          f.remoteMask = pfIt->remoteMask.Get ();
+          f.remoteAddress = pfIt->remoteAddress.Get () & f.remoteMask;
+          f.localMask = pfIt->localMask.Get ();
+          f.localAddress = pfIt->localAddress.Get () & f.localMask;
+          pfIt->remoteIpv6Address.GetBytes (f.remoteIpv6Address);
+          pfIt->remoteIpv6Prefix.GetBytes (f.remoteIpv6Prefix);
+          pfIt->localIpv6Address.GetBytes (f.localIpv6Address);
+          pfIt->localIpv6Prefix.GetBytes (f.localIpv6Prefix);
+          for (uint32_t i = 0; i < 16; i++)
+            {
+              f.remoteIpv6Address[i] &= f.remoteIpv6Prefix[i];
+              f.localIpv6Address[i] &= f.localIpv6Prefix[i];
+            }
+          f.remotePortStart = pfIt->remotePortStart;
+          f.remotePortEnd = pfIt->remotePortEnd;
+          f.localPortStart = pfIt->localPortStart;
+          f.localPortEnd = pfIt->localPortEnd;
+          f.typeOfServiceMask = pfIt->typeOfServiceMask;
+          f.typeOfService = pfIt->typeOfService & pfIt->typeOfServiceMask;
+
+          if (pfIt->direction & EpcTft::UPLINK)
+            {
+              m_uplinkFilters.push_back (f);
+            }
+          if (pfIt->direction & EpcTft::DOWNLINK)
+            {
+              m_downlinkFilters.push_back (f);
+            }
+        }
+    }
+  NS_LOG_LOGIC ("compiled " << m_uplinkFilters.size () << " uplink and "
+                << m_downlinkFilters.size () << " downlink packet filters");
+}
+
+const std::vector<EpcTftClassifier::CompiledFilter> &
+EpcTftClassifier::GetFilters (EpcTft::Direction direction) const
+{
+  if (direction == EpcTft::UPLINK)
+    {
+      return m_uplinkFilters;
+    }
+  NS_ASSERT (direction == EpcTft::DOWNLINK);
+  return m_downlinkFilters;
 }
 
 uint32_t 
@@ -69,13 +174,15 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction, uint16_t
 {
   NS_LOG_FUNCTION (this << p << p->GetSize () << direction);
 
-  Ptr<Packet> pCopy = p->Copy ();
+  // the headers are read from the first bytes of the packet, without copying it
+  uint8_t buf[MAX_PEEK_SIZE];
+  uint32_t size = p->CopyData (buf, MAX_PEEK_SIZE);
 
-  Ipv4Address localAddressIpv4;
-  Ipv4Address remoteAddressIpv4;
+  uint32_t localAddressIpv4 = 0;
+  uint32_t remoteAddressIpv4 = 0;
 
-  Ipv6Address localAddressIpv6;
-  Ipv6Address remoteAddressIpv6;
+  const uint8_t *localAddressIpv6 = 0;
+  const uint8_t *remoteAddressIpv6 = 0;
 
   uint8_t protocol;
   uint8_t tos;
@@ -83,90 +190,47 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction, uint16_t
   uint16_t localPort = 0;
   uint16_t remotePort = 0;
 
+  // the source and destination ports of the transport header, if available
+  const uint8_t *ports = 0;
+
   if (protocolNumber == Ipv4L3Protocol::PROT_NUMBER)
     {
-      Ipv4Header ipv4Header;
-      pCopy->RemoveHeader (ipv4Header);
+      NS_ABORT_MSG_IF (size < 20, "EpcTftClassifier::Classify - Truncated IPv4 header");
+      uint16_t headerSize = (buf[0] & 0x0f) * 4;
+      tos = buf[1];
+      uint16_t payloadSize = ReadNtohU16 (buf + 2) - headerSize;
+      uint16_t identification = ReadNtohU16 (buf + 4);
+      uint16_t fragmentOffset = ReadNtohU16 (buf + 6) & 0x1fff;
+      bool isLastFragment = (buf[6] & 0x20) == 0;
+      protocol = buf[9];
+      uint32_t source = ReadNtohU32 (buf + 12);
+      uint32_t destination = ReadNtohU32 (buf + 16);
 
       if (direction ==  EpcTft::UPLINK)
         {
-          localAddressIpv4 = ipv4Header.GetSource ();
-          remoteAddressIpv4 = ipv4Header.GetDestination ();
+          localAddressIpv4 = source;
+          remoteAddressIpv4 = destination;
         }
       else
         {
           NS_ASSERT (direction ==  EpcTft::DOWNLINK);
-          remoteAddressIpv4 = ipv4Header.GetSource ();
-          localAddressIpv4 = ipv4Header.GetDestination ();
+          remoteAddressIpv4 = source;
+          localAddressIpv4 = destination;
         }
-      NS_LOG_INFO ("local address: " << localAddressIpv4 << " remote address: " << remoteAddressIpv4);
-
-      uint16_t payloadSize = ipv4Header.GetPayloadSize ();
-      uint16_t fragmentOffset = ipv4Header.GetFragmentOffset ();
-      bool isLastFragment = ipv4Header.IsLastFragment ();
-
-      // NS_LOG_DEBUG ("PayloadSize = " << payloadSize);
-      // NS_LOG_DEBUG ("fragmentOffset " << fragmentOffset << " isLastFragment " << isLastFragment);
-
-      protocol = ipv4Header.GetProtocol ();
-      tos = ipv4Header.GetTos ();
+      NS_LOG_INFO ("local address: " << Ipv4Address (localAddressIpv4) << " remote address: " << Ipv4Address (remoteAddressIpv4));
 
       // Port info only can be get if it is the first fragment and
       // there is enough data in the payload
       // We keep the port info for fragmented packets,
       // i.e. it is the first one but it is not the last one
+      Ipv4FragmentKey fragmentKey = {source, destination, protocol, identification};
       if (fragmentOffset == 0)
         {
-          if (protocol == UdpL4Protocol::PROT_NUMBER && payloadSize >= 8)
-            {
-              UdpHeader udpHeader;
-              pCopy->RemoveHeader (udpHeader);
-              if (direction ==  EpcTft::UPLINK)
-                {
-                  localPort = udpHeader.GetSourcePort ();
-                  remotePort = udpHeader.GetDestinationPort ();
-                }
-              else
-                {
-                  remotePort = udpHeader.GetSourcePort ();
-                  localPort = udpHeader.GetDestinationPort ();
-                }
-              if (!isLastFragment)
-                {
-                  std::tuple<uint32_t, uint32_t, uint8_t, uint16_t> fragmentKey =
-                      std::make_tuple (ipv4Header.GetSource ().Get (),
-                                       ipv4Header.GetDestination ().Get (),
-                                       protocol,
-                                       ipv4Header.GetIdentification ());
-
-                  m_classifiedIpv4Fragments[fragmentKey] = std::make_pair (localPort, remotePort);
-                }
-            }
-          else if (protocol == TcpL4Protocol::PROT_NUMBER && payloadSize >= 20)
+          if (((protocol == UdpL4Protocol::PROT_NUMBER && payloadSize >= 8)
+               || (protocol == TcpL4Protocol::PROT_NUMBER && payloadSize >= 20))
+              && size >= headerSize + 4u)
             {
-              TcpHeader tcpHeader;
-              pCopy->RemoveHeader (tcpHeader);
-              if (direction ==  EpcTft::UPLINK)
-                {
-                  localPort = tcpHeader.GetSourcePort ();
-                  remotePort = tcpHeader.GetDestinationPort ();
-                }
-              else
-                {
-                  remotePort = tcpHeader.GetSourcePort ();
-                  localPort = tcpHeader.GetDestinationPort ();
-                }
-
-              if (!isLastFragment)
-                {
-                  std::tuple<uint32_t, uint32_t, uint8_t, uint16_t> fragmentKey =
-                      std::make_tuple (ipv4Header.GetSource ().Get (),
-                                       ipv4Header.GetDestination ().Get (),
-                                       protocol,
-                                       ipv4Header.GetIdentification ());
-
-                  m_classifiedIpv4Fragments[fragmentKey] = std::make_pair (localPort, remotePort);
-                }
+              ports = buf + headerSize;
             }
 
           // else
@@ -177,14 +241,7 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction, uint16_t
         {
           // Not first fragment, so port info is not available but
           // port info should already be known (if there is not fragment reordering)
-          std::tuple<uint32_t, uint32_t, uint8_t, uint16_t> fragmentKey =
-              std::make_tuple (ipv4Header.GetSource ().Get (),
-                               ipv4Header.GetDestination ().Get (),
-                               protocol,
-                               ipv4Header.GetIdentification ());
-
-          std::map< std::tuple<uint32_t, uint32_t, uint8_t, uint16_t>,
-                    std::pair<uint32_t, uint32_t> >::iterator it =
+          std::unordered_map <Ipv4FragmentKey, std::pair<uint32_t, uint32_t>, Ipv4FragmentKeyHash>::iterator it =
               m_classifiedIpv4Fragments.find (fragmentKey);
 
           if (it != m_classifiedIpv4Fragments.end ())
@@ -194,61 +251,60 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction, uint16_t
 
               if (isLastFragment)
                 {
-                  m_classifiedIpv4Fragments.erase (fragmentKey);
+                  m_classifiedIpv4Fragments.erase (it);
                 }
             }
         }
+
+      if (ports != 0)
+        {
+          if (direction ==  EpcTft::UPLINK)
+            {
+              localPort = ReadNtohU16 (ports);
+              remotePort = ReadNtohU16 (ports + 2);
+            }
+          else
+            {
+              remotePort = ReadNtohU16 (ports);
+              localPort = ReadNtohU16 (ports + 2);
+            }
+          if (!isLastFragment)
+            {
+              m_classifiedIpv4Fragments[fragmentKey] = std::make_pair (localPort, remotePort);
+            }
+        }
     }
   else if (protocolNumber == Ipv6L3Protocol::PROT_NUMBER)
     {
-      Ipv6Header ipv6Header;
-      pCopy->RemoveHeader (ipv6Header);
-
+      NS_ABORT_MSG_IF (size < 40, "EpcTftClassifier::Classify - Truncated IPv6 header");
       if (direction ==  EpcTft::UPLINK)
         {
-          localAddressIpv6 = ipv6Header.GetSource ();
-          remoteAddressIpv6 = ipv6Header.GetDestination ();
+          localAddressIpv6 = buf + 8;
+          remoteAddressIpv6 = buf + 24;
         }
       else
         {
           NS_ASSERT (direction ==  EpcTft::DOWNLINK);
-          remoteAddressIpv6 = ipv6Header.GetSource ();
-          localAddressIpv6 = ipv6Header.GetDestination ();
+          remoteAddressIpv6 = buf + 8;
+          localAddressIpv6 = buf + 24;
         }
-      NS_LOG_INFO ("local address: " << localAddressIpv6 << " remote address: " << remoteAddressIpv6);
-
-      protocol = ipv6Header.GetNextHeader ();
-      tos = ipv6Header.GetTrafficClass ();
 
-      if (protocol == UdpL4Protocol::PROT_NUMBER)
-        {
-          UdpHeader udpHeader;
-          pCopy->RemoveHeader (udpHeader);
+      protocol = buf[6];
+      tos = (buf[0] << 4) | (buf[1] >> 4);
 
-          if (direction ==  EpcTft::UPLINK)
-            {
-              localPort = udpHeader.GetSourcePort ();
-              remotePort = udpHeader.GetDestinationPort ();
-            }
-          else
-            {
-              remotePort = udpHeader.GetSourcePort ();
-              localPort = udpHeader.GetDestinationPort ();
-            }
-        }
-      else if (protocol == TcpL4Protocol::PROT_NUMBER)
+      if ((protocol == UdpL4Protocol::PROT_NUMBER || protocol == TcpL4Protocol::PROT_NUMBER)
+          && size >= 40 + 4)
         {
-          TcpHeader tcpHeader;
-          pCopy->RemoveHeader (tcpHeader);
+          ports = buf + 40;
           if (direction ==  EpcTft::UPLINK)
             {
-              localPort = tcpHeader.GetSourcePort ();
-              remotePort = tcpHeader.GetDestinationPort ();
+              localPort = ReadNtohU16 (ports);
+              remotePort = ReadNtohU16 (ports + 2);
             }
           else
             {
-              remotePort = tcpHeader.GetSourcePort ();
-              localPort = tcpHeader.GetDestinationPort ();
+              remotePort = ReadNtohU16 (ports);
+              localPort = ReadNtohU16 (ports + 2);
             }
         }
     }
@@ -257,60 +313,52 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction, uint16_t
       NS_ABORT_MSG ("EpcTftClassifier::Classify - Unknown IP type...");
     }
 
-
-  if (protocolNumber == Ipv4L3Protocol::PROT_NUMBER)
+  bool isIpv4 = (protocolNumber == Ipv4L3Protocol::PROT_NUMBER);
+  if (isIpv4)
     {
       NS_LOG_INFO ("Classifying packet:"
-          << " localAddr="  << localAddressIpv4
-          << " remoteAddr=" << remoteAddressIpv4
+          << " localAddr="  << Ipv4Address (localAddressIpv4)
+          << " remoteAddr=" << Ipv4Address (remoteAddressIpv4)
           << " localPort="  << localPort
           << " remotePort=" << remotePort
           << " tos=0x" << (uint16_t) tos );
-
-      // now it is possible to classify the packet!
-      // we use a reverse iterator since filter priority is not implemented properly.
-      // This way, since the default bearer is expected to be added first, it will be evaluated last.
-      std::map <uint32_t, Ptr<EpcTft> >::const_reverse_iterator it;
-      NS_LOG_LOGIC ("TFT MAP size: " << m_tftMap.size ());
-
-      for (it = m_tftMap.rbegin (); it != m_tftMap.rend (); ++it)
-        {
-          NS_LOG_LOGIC ("TFT id: " << it->first );
-          NS_LOG_LOGIC (" Ptr<EpcTft>: " << it->second);
-          Ptr<EpcTft> tft = it->second;
-          if (tft->Matches (direction, remoteAddressIpv4, localAddressIpv4, remotePort, localPort, tos))
-            {
-              NS_LOG_LOGIC ("matches with TFT ID = " << it->first);
-              return it->first; // the id of the matching TFT
-            }
-        }
     }
-  else if (protocolNumber == Ipv6L3Protocol::PROT_NUMBER)
+  else
     {
       NS_LOG_INFO ("Classifying packet:"
-          << " localAddr="  << localAddressIpv6
-          << " remoteAddr=" << remoteAddressIpv6
+          << " localAddr="  << Ipv6Address (const_cast<uint8_t *> (localAddressIpv6))
+          << " remoteAddr=" << Ipv6Address (const_cast<uint8_t *> (remoteAddressIpv6))
           << " localPort="  << localPort
           << " remotePort=" << remotePort
           << " tos=0x" << (uint16_t) tos );
+    }
 
-      // now it is possible to classify the packet!
-      // we use a reverse iterator since filter priority is not implemented properly.
-      // This way, since the default bearer is expected to be added first, it will be evaluated last.
-      std::map <uint32_t, Ptr<EpcTft> >::const_reverse_iterator it;
-      NS_LOG_LOGIC ("TFT MAP size: " << m_tftMap.size ());
-
-      for (it = m_tftMap.rbegin (); it != m_tftMap.rend (); ++it)
+  // now it is possible to classify the packet!
+  const std::vector<CompiledFilter> &filters = GetFilters (direction);
+  NS_LOG_LOGIC ("TFT MAP size: " << m_tftMap.size () << " packet filters: " << filters.size ());
+  for (std::vector<CompiledFilter>::const_iterator it = filters.begin (); it != filters.end (); ++it)
+    {
+      if (isIpv4)
         {
-          NS_LOG_LOGIC ("TFT id: " << it->first );
-          NS_LOG_LOGIC (" Ptr<EpcTft>: " << it->second);
-          Ptr<EpcTft> tft = it->second;
-          if (tft->Matches (direction, remoteAddressIpv6, localAddressIpv6, remotePort, localPort, tos))
+          if ((remoteAddressIpv4 & it->remoteMask) != it->remoteAddress
+              || (localAddressIpv4 & it->localMask) != it->localAddress)
             {
-              NS_LOG_LOGIC ("matches with TFT ID = " << it->first);
-              return it->first; // the id of the matching TFT
+              continue;
             }
         }
+      else if (!IsIpv6Match (remoteAddressIpv6, it->remoteIpv6Address, it->remoteIpv6Prefix)
+               || !IsIpv6Match (localAddressIpv6, it->localIpv6Address, it->localIpv6Prefix))
+        {
+          continue;
+        }
+      if (remotePort < it->remotePortStart || remotePort > it->remotePortEnd
+          || localPort < it->localPortStart || localPort > it->localPortEnd
+          || (tos & it->typeOfServiceMask) != it->typeOfService)
+        {
+          continue;
+        }
+      NS_LOG_LOGIC ("matches with TFT ID = " << it->id);
+      return it->id; // the id of the matching TFT
     }
   NS_LOG_LOGIC ("no match");
   return 0;  // no match
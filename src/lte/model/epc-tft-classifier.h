@@ -28,6 +28,8 @@
 #include "ns3/epc-tft.h"
 
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 
 namespace ns3 {
@@ -50,6 +52,12 @@ class Packet;
  *
  * When we cannot cache the port info, the TFT of the default bearer is used. This may happen
  * if there is reordering or losses of IP packets.
+ *
+ * The packet filters of the TFTs are compiled when a TFT is added or deleted, into one
+ * array per direction, in the order of evaluation and with the addresses, masks and type
+ * of service already masked. The classification reads the IP and transport headers
+ * directly from the bytes of the packet, without copying the packet. A TFT changed after
+ * being added must be added again for the change to be seen.
  */
 class EpcTftClassifier : public SimpleRefCount<EpcTftClassifier>
 {
@@ -89,8 +97,41 @@ protected:
   
   std::map <uint32_t, Ptr<EpcTft> > m_tftMap; ///< TFT map
 
-  std::map < std::tuple<uint32_t, uint32_t, uint8_t, uint16_t>,
-             std::pair<uint32_t, uint32_t> >
+  /// The key of an IPv4 fragment: source, destination, protocol and identification
+  struct Ipv4FragmentKey
+  {
+    uint32_t source;          ///< the source address
+    uint32_t destination;     ///< the destination address
+    uint8_t protocol;         ///< the protocol
+    uint16_t identification;  ///< the identification
+
+    /**
+     * \param other the other key
+     * \return true if the keys are equal
+     */
+    bool operator== (const Ipv4FragmentKey &other) const
+    {
+      return source == other.source && destination == other.destination
+             && protocol == other.protocol && identification == other.identification;
+    }
+  };
+
+  /// The hash of an Ipv4FragmentKey
+  struct Ipv4FragmentKeyHash
+  {
+    /**
+     * \param key the key
+     * \return the hash of the key
+     */
+    std::size_t operator() (const Ipv4FragmentKey &key) const
+    {
+      uint64_t h = ((uint64_t) key.source << 32) | key.destination;
+      h ^= ((uint64_t) key.protocol << 16 | key.identification) * 0x9e3779b97f4a7c15ULL;
+      return std::hash<uint64_t> () (h);
+    }
+  };
+
+  std::unordered_map <Ipv4FragmentKey, std::pair<uint32_t, uint32_t>, Ipv4FragmentKeyHash>
       m_classifiedIpv4Fragments; ///< Map with already classified IPv4 Fragments
                                  ///< An entry is added when the port info is available, i.e.
                                  ///<   first fragment, UDP/TCP protocols and enough payload data
@@ -98,6 +139,39 @@ protected:
                                  ///<   not first fragment or not enough payload data for TCP/UDP
                                  ///< An entry is removed when the last fragment is classified
                                  ///<   Note: If last fragment is lost, entry is not removed
+
+private:
+  /// A packet filter, with its fields in the form used by Classify
+  struct CompiledFilter
+  {
+    uint32_t id;                    ///< the identifier of the TFT of the filter
+    uint32_t remoteAddress;         ///< the masked IPv4 address of the remote host
+    uint32_t remoteMask;            ///< the IPv4 address mask of the remote host
+    uint32_t localAddress;          ///< the masked IPv4 address of the UE
+    uint32_t localMask;             ///< the IPv4 address mask of the UE
+    uint8_t remoteIpv6Address[16];  ///< the masked IPv6 address of the remote host
+    uint8_t remoteIpv6Prefix[16];   ///< the IPv6 address prefix of the remote host
+    uint8_t localIpv6Address[16];   ///< the masked IPv6 address of the UE
+    uint8_t localIpv6Prefix[16];    ///< the IPv6 address prefix of the UE
+    uint16_t remotePortStart;       ///< start of the port number range of the remote host
+    uint16_t remotePortEnd;         ///< end of the port number range of the remote host
+    uint16_t localPortStart;        ///< start of the port number range of the UE
+    uint16_t localPortEnd;          ///< end of the port number range of the UE
+    uint8_t typeOfService;          ///< the masked type of service
+    uint8_t typeOfServiceMask;      ///< type of service field mask
+  };
+
+  /// Compile the packet filters of the TFTs
+  void Compile (void);
+
+  /**
+   * \param direction the EPC TFT direction, uplink or downlink
+   * \return the compiled packet filters of the direction, in the order of evaluation
+   */
+  const std::vector<CompiledFilter> & GetFilters (EpcTft::Direction direction) const;
+
+  std::vector<CompiledFilter> m_uplinkFilters;   ///< the compiled packet filters applying to the uplink
+  std::vector<CompiledFilter> m_downlinkFilters; ///< the compiled packet filters applying to the downlink
 };
 
 
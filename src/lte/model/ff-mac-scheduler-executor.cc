@@ -0,0 +1,200 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ff-mac-scheduler-executor.h"
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/uinteger.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FfMacSchedulerExecutor");
+
+NS_OBJECT_ENSURE_REGISTERED (FfMacSchedulerExecutor);
+
+TypeId
+FfMacSchedulerExecutor::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::FfMacSchedulerExecutor")
+    .SetParent<Object> ()
+    .SetGroupName ("Lte")
+    .AddConstructor<FfMacSchedulerExecutor> ()
+    .AddAttribute ("NumThreads",
+                   "The number of threads computing the scheduler calls of a "
+                   "time step, including the simulator thread.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&FfMacSchedulerExecutor::m_numThreads),
+                   MakeUintegerChecker<uint32_t> (1))
+  ;
+  return tid;
+}
+
+FfMacSchedulerExecutor::FfMacSchedulerExecutor ()
+  : m_numThreads (1),
+#ifdef HAVE_PTHREAD_H
+    m_generation (0),
+    m_busyWorkers (0),
+    m_stop (false),
+#endif
+    m_nextJob (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+FfMacSchedulerExecutor::~FfMacSchedulerExecutor ()
+{
+  NS_LOG_FUNCTION (this);
+#ifdef HAVE_PTHREAD_H
+  StopWorkers ();
+#endif
+}
+
+void
+FfMacSchedulerExecutor::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+#ifdef HAVE_PTHREAD_H
+  StopWorkers ();
+#endif
+  m_batchEvent.Cancel ();
+  m_batch.clear ();
+  m_running.clear ();
+  Object::DoDispose ();
+}
+
+uint32_t
+FfMacSchedulerExecutor::GetNumThreads (void) const
+{
+  return m_numThreads;
+}
+
+void
+FfMacSchedulerExecutor::Submit (Callback<void> compute, Callback<void> deliver)
+{
+  NS_LOG_FUNCTION (this);
+  Job job;
+  job.m_compute = compute;
+  job.m_deliver = deliver;
+  m_batch.push_back (job);
+  if (!m_batchEvent.IsRunning ())
+    {
+      // the jobs submitted later during this time step join the batch
+      m_batchEvent = Simulator::ScheduleNow (&FfMacSchedulerExecutor::RunBatch, this);
+    }
+}
+
+void
+FfMacSchedulerExecutor::ComputeJobs (void)
+{
+  uint32_t i;
+  while ((i = m_nextJob++) < m_running.size ())
+    {
+      m_running[i].m_compute ();
+    }
+}
+
+void
+FfMacSchedulerExecutor::RunBatch (void)
+{
+  NS_LOG_FUNCTION (this << m_batch.size ());
+  // the deliveries can submit jobs: they form a new batch
+  m_running.swap (m_batch);
+  m_batch.clear ();
+  m_nextJob = 0;
+
+#ifdef HAVE_PTHREAD_H
+  uint32_t numWorkers = std::min<uint32_t> (m_numThreads, m_running.size ()) - 1;
+  if (numWorkers > 0)
+    {
+      if (m_workers.size () != m_numThreads - 1)
+        {
+          StopWorkers ();
+          m_stop = false;
+          for (uint32_t t = 0; t < m_numThreads - 1; t++)
+            {
+              m_workers.emplace_back (&FfMacSchedulerExecutor::WorkerLoop, this, m_generation);
+            }
+        }
+      {
+        std::lock_guard<std::mutex> lock (m_mutex);
+        m_busyWorkers = m_workers.size ();
+        m_generation++;
+      }
+      m_wakeUp.notify_all ();
+      ComputeJobs ();
+      std::unique_lock<std::mutex> lock (m_mutex);
+      m_done.wait (lock, [this] { return m_busyWorkers == 0; });
+    }
+  else
+#endif
+    {
+      ComputeJobs ();
+    }
+
+  for (std::vector<Job>::iterator it = m_running.begin (); it != m_running.end (); ++it)
+    {
+      it->m_deliver ();
+    }
+  m_running.clear ();
+}
+
+#ifdef HAVE_PTHREAD_H
+void
+FfMacSchedulerExecutor::WorkerLoop (uint64_t generation)
+{
+  while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock (m_mutex);
+        m_wakeUp.wait (lock, [this, generation] { return m_stop || m_generation != generation; });
+        if (m_stop)
+          {
+            return;
+          }
+        generation = m_generation;
+      }
+      ComputeJobs ();
+      {
+        std::lock_guard<std::mutex> lock (m_mutex);
+        if (--m_busyWorkers == 0)
+          {
+            m_done.notify_one ();
+          }
+      }
+    }
+}
+
+void
+FfMacSchedulerExecutor::StopWorkers (void)
+{
+  if (m_workers.empty ())
+    {
+      return;
+    }
+  {
+    std::lock_guard<std::mutex> lock (m_mutex);
+    m_stop = true;
+  }
+  m_wakeUp.notify_all ();
+  for (std::vector<std::thread>::iterator it = m_workers.begin (); it != m_workers.end (); ++it)
+    {
+      it->join ();
+    }
+  m_workers.clear ();
+}
+#endif
+
+} // namespace ns3
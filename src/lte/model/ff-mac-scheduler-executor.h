@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FF_MAC_SCHEDULER_EXECUTOR_H
+#define FF_MAC_SCHEDULER_EXECUTOR_H
+
+#include <ns3/core-config.h>
+#include <ns3/object.h>
+#include <ns3/callback.h>
+#include <ns3/event-id.h>
+#include <vector>
+
+#ifdef HAVE_PTHREAD_H
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * \brief Runs the scheduler calls of several eNB MACs in parallel.
+ *
+ * The MACs attached to an executor do not call their FF MAC scheduler
+ * directly: they queue the calls, and submit a job to the executor.
+ * All the jobs submitted during the same time step form a batch, run at
+ * the end of the time step: the computation of the jobs, i.e., the
+ * scheduler calls, is split among NumThreads threads, then the results
+ * of the jobs, i.e., the indications of the schedulers, are delivered
+ * in the simulator thread, in the order of submission.
+ *
+ * The schedulers of different cells share no state, so the results do
+ * not depend on the number of threads.  The decisions of the
+ * schedulers are however delivered after the other events of the time
+ * step, so they are not identical to the ones of the sequential mode.
+ * The log of the schedulers should be disabled when NumThreads > 1.
+ */
+class FfMacSchedulerExecutor : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  FfMacSchedulerExecutor ();
+  virtual ~FfMacSchedulerExecutor ();
+
+  /**
+   * \brief Add a job to the batch of the current time step.
+   *
+   * \param compute the computation of the job; it can run in any thread,
+   * concurrently with the computation of the other jobs of the batch
+   * \param deliver the delivery of the results of the job; it runs in the
+   * simulator thread, after the computation of all the jobs of the batch
+   */
+  void Submit (Callback<void> compute, Callback<void> deliver);
+
+  /**
+   * \return the number of threads computing the jobs
+   */
+  uint32_t GetNumThreads (void) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /// A job
+  struct Job
+  {
+    Callback<void> m_compute; //!< the computation of the job
+    Callback<void> m_deliver; //!< the delivery of the results of the job
+  };
+
+  /// Run the batch of the current time step
+  void RunBatch (void);
+
+  /**
+   * \brief Compute the jobs of the running batch not taken by another thread.
+   */
+  void ComputeJobs (void);
+
+  std::vector<Job> m_batch;   //!< the jobs of the batch of the current time step
+  EventId m_batchEvent;       //!< the event running the batch
+  uint32_t m_numThreads;      //!< the number of threads computing the jobs
+  std::vector<Job> m_running; //!< the jobs of the running batch
+
+#ifdef HAVE_PTHREAD_H
+  /**
+   * \brief The loop of the worker threads.
+   * \param generation the number of batches run before the thread started
+   */
+  void WorkerLoop (uint64_t generation);
+
+  /// Stop and join the worker threads
+  void StopWorkers (void);
+
+  std::vector<std::thread> m_workers;  //!< the worker threads
+  std::mutex m_mutex;                  //!< the mutex protecting the state of the workers
+  std::condition_variable m_wakeUp;    //!< notified when a batch starts or the workers stop
+  std::condition_variable m_done;      //!< notified when the workers are done with a batch
+  uint64_t m_generation;               //!< the number of batches run by the workers
+  uint32_t m_busyWorkers;              //!< the number of workers computing the running batch
+  bool m_stop;                         //!< whether the workers must stop
+  std::atomic<uint32_t> m_nextJob;     //!< the index of the next job of the running batch
+#else
+  uint32_t m_nextJob;                  //!< the index of the next job of the running batch
+#endif
+};
+
+} // namespace ns3
+
+#endif /* FF_MAC_SCHEDULER_EXECUTOR_H */
@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ff-mac-ue-table.h"
+#include <algorithm>
+
+namespace ns3 {
+
+const uint32_t FfMacUeTable::NO_UE;
+const uint8_t FfMacUeTable::MAX_LAYERS;
+
+FfMacUeTable::FfMacUeTable ()
+  : m_nRbg (0)
+{
+}
+
+void
+FfMacUeTable::Clear (uint16_t nRbg)
+{
+  for (std::vector<uint16_t>::const_iterator it = m_rnti.begin (); it != m_rnti.end (); ++it)
+    {
+      m_index[*it] = NO_UE;
+    }
+  m_nRbg = nRbg;
+  m_rnti.clear ();
+  m_nLayers.clear ();
+  m_activeLcs.clear ();
+  m_throughput.clear ();
+  m_eligible.clear ();
+  m_sbCqiLayers.clear ();
+  m_sbCqi.clear ();
+}
+
+uint32_t
+FfMacUeTable::Add (uint16_t rnti)
+{
+  if (rnti >= m_index.size ())
+    {
+      m_index.resize (rnti + 1, NO_UE);
+    }
+  NS_ASSERT_MSG (m_index[rnti] == NO_UE, "RNTI " << rnti << " already in the table");
+  uint32_t ue = m_rnti.size ();
+  m_index[rnti] = ue;
+  m_rnti.push_back (rnti);
+  m_nLayers.push_back (0);
+  m_activeLcs.push_back (0);
+  m_throughput.push_back (0.0);
+  m_eligible.push_back (false);
+  m_sbCqiLayers.resize (m_sbCqiLayers.size () + m_nRbg, 0);
+  m_sbCqi.resize (m_sbCqi.size () + m_nRbg * MAX_LAYERS, 0);
+  return ue;
+}
+
+void
+FfMacUeTable::SetSbCqi (uint32_t ue, uint16_t rbg, const std::vector<uint8_t> &cqi)
+{
+  NS_ASSERT (ue < m_rnti.size () && rbg < m_nRbg);
+  uint32_t i = ue * m_nRbg + rbg;
+  uint8_t nLayers = std::min<size_t> (cqi.size (), MAX_LAYERS);
+  m_sbCqiLayers[i] = nLayers;
+  std::copy (cqi.begin (), cqi.begin () + nLayers, m_sbCqi.begin () + i * MAX_LAYERS);
+}
+
+void
+FfMacUeTable::SetWidebandCqi (uint32_t ue, uint8_t cqi, uint8_t nLayers)
+{
+  NS_ASSERT (ue < m_rnti.size ());
+  nLayers = std::min (nLayers, MAX_LAYERS);
+  for (uint16_t rbg = 0; rbg < m_nRbg; rbg++)
+    {
+      uint32_t i = ue * m_nRbg + rbg;
+      m_sbCqiLayers[i] = nLayers;
+      std::fill (m_sbCqi.begin () + i * MAX_LAYERS, m_sbCqi.begin () + i * MAX_LAYERS + nLayers, cqi);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,227 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FF_MAC_UE_TABLE_H
+#define FF_MAC_UE_TABLE_H
+
+#include <ns3/assert.h>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup ff-api
+ *
+ * \brief Dense per-UE state of a FF MAC scheduler for one TTI.
+ *
+ * The FF MAC schedulers keep the state of the UEs in maps keyed by
+ * RNTI, which are looked up for every RBG of every TTI.  Before its
+ * RBG loop, a scheduler can copy the state it needs into this table:
+ * the UEs get consecutive indexes, the RNTIs are mapped to the indexes
+ * by a direct lookup, and each property is stored in its own array,
+ * the sub-band CQIs being stored per (UE, RBG, layer).
+ *
+ * The table is a snapshot: the maps of the scheduler remain the
+ * reference, and the table is refilled when they change.  Clearing it
+ * keeps the memory allocated, so the refills of the following TTIs do
+ * not allocate.
+ */
+class FfMacUeTable
+{
+public:
+  /// The index returned when a RNTI is not in the table
+  static const uint32_t NO_UE = 0xffffffff;
+  /// The maximum number of layers of the sub-band CQIs
+  static const uint8_t MAX_LAYERS = 2;
+
+  FfMacUeTable ();
+
+  /**
+   * \brief Remove all the UEs.
+   * \param nRbg the number of RBGs of the sub-band CQIs of the next UEs
+   */
+  void Clear (uint16_t nRbg);
+
+  /**
+   * \brief Add a UE.
+   *
+   * The properties of the UE are reset: no layer, no active LC, zero
+   * throughput, not eligible, and no sub-band CQI.
+   *
+   * \param rnti the RNTI of the UE, which must not be in the table
+   * \return the index of the UE
+   */
+  uint32_t Add (uint16_t rnti);
+
+  /**
+   * \param rnti the RNTI of a UE
+   * \return the index of the UE, or NO_UE
+   */
+  uint32_t Find (uint16_t rnti) const
+  {
+    return rnti < m_index.size () ? m_index[rnti] : NO_UE;
+  }
+
+  /// \return the number of UEs
+  uint32_t GetN (void) const
+  {
+    return m_rnti.size ();
+  }
+
+  /// \return the number of RBGs of the sub-band CQIs
+  uint16_t GetNRbg (void) const
+  {
+    return m_nRbg;
+  }
+
+  /**
+   * \param ue the index of a UE
+   * \return the RNTI of the UE
+   */
+  uint16_t GetRnti (uint32_t ue) const
+  {
+    return m_rnti[ue];
+  }
+
+  /**
+   * \param ue the index of a UE
+   * \param nLayers the number of layers of the UE
+   */
+  void SetLayers (uint32_t ue, uint8_t nLayers)
+  {
+    m_nLayers[ue] = nLayers;
+  }
+
+  /**
+   * \param ue the index of a UE
+   * \return the number of layers of the UE
+   */
+  uint8_t GetLayers (uint32_t ue) const
+  {
+    return m_nLayers[ue];
+  }
+
+  /**
+   * \param ue the index of a UE
+   * \param nLcs the number of LCs of the UE with data to transmit
+   */
+  void SetActiveLcs (uint32_t ue, uint16_t nLcs)
+  {
+    m_activeLcs[ue] = nLcs;
+  }
+
+  /**
+   * \param ue the index of a UE
+   * \return the number of LCs of the UE with data to transmit
+   */
+  uint16_t GetActiveLcs (uint32_t ue) const
+  {
+    return m_activeLcs[ue];
+  }
+
+  /**
+   * \param ue the index of a UE
+   * \param throughput the averaged throughput of the UE
+   */
+  void SetThroughput (uint32_t ue, double throughput)
+  {
+    m_throughput[ue] = throughput;
+  }
+
+  /**
+   * \param ue the index of a UE
+   * \return the averaged throughput of the UE
+   */
+  double GetThroughput (uint32_t ue) const
+  {
+    return m_throughput[ue];
+  }
+
+  /**
+   * \param ue the index of a UE
+   * \param eligible whether the UE can be allocated new resources
+   */
+  void SetEligible (uint32_t ue, bool eligible)
+  {
+    m_eligible[ue] = eligible;
+  }
+
+  /**
+   * \param ue the index of a UE
+   * \return whether the UE can be allocated new resources
+   */
+  bool IsEligible (uint32_t ue) const
+  {
+    return m_eligible[ue];
+  }
+
+  /**
+   * \brief Set the sub-band CQIs of a UE on a RBG.
+   *
+   * Only the CQIs of the first MAX_LAYERS layers are stored.
+   *
+   * \param ue the index of a UE
+   * \param rbg the index of the RBG
+   * \param cqi the CQIs of the layers
+   */
+  void SetSbCqi (uint32_t ue, uint16_t rbg, const std::vector<uint8_t> &cqi);
+
+  /**
+   * \brief Set the same CQIs on all the RBGs.
+   * \param ue the index of a UE
+   * \param cqi the CQI of each layer
+   * \param nLayers the number of layers with a CQI
+   */
+  void SetWidebandCqi (uint32_t ue, uint8_t cqi, uint8_t nLayers);
+
+  /**
+   * \param ue the index of a UE
+   * \param rbg the index of the RBG
+   * \return the number of layers with a CQI of the UE on the RBG
+   */
+  uint8_t GetSbCqiLayers (uint32_t ue, uint16_t rbg) const
+  {
+    NS_ASSERT (rbg < m_nRbg);
+    return m_sbCqiLayers[ue * m_nRbg + rbg];
+  }
+
+  /**
+   * \param ue the index of a UE
+   * \param rbg the index of the RBG
+   * \return the CQIs of the layers of the UE on the RBG
+   */
+  const uint8_t * GetSbCqi (uint32_t ue, uint16_t rbg) const
+  {
+    NS_ASSERT (rbg < m_nRbg);
+    return &m_sbCqi[(ue * m_nRbg + rbg) * MAX_LAYERS];
+  }
+
+private:
+  uint16_t m_nRbg;                   //!< the number of RBGs of the sub-band CQIs
+  std::vector<uint32_t> m_index;     //!< the index of the UEs, by RNTI
+  std::vector<uint16_t> m_rnti;      //!< the RNTI of the UEs
+  std::vector<uint8_t> m_nLayers;    //!< the number of layers of the UEs
+  std::vector<uint16_t> m_activeLcs; //!< the number of active LCs of the UEs
+  std::vector<double> m_throughput;  //!< the averaged throughput of the UEs
+  std::vector<uint8_t> m_eligible;   //!< whether the UEs are eligible
+  std::vector<uint8_t> m_sbCqiLayers; //!< the number of layers with a CQI, by UE and RBG
+  std::vector<uint8_t> m_sbCqi;      //!< the CQIs, by UE, RBG and layer
+};
+
+} // namespace ns3
+
+#endif /* FF_MAC_UE_TABLE_H */
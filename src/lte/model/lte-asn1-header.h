@@ -22,6 +22,7 @@
 #define ASN1_HEADER_H
 
 #include "ns3/header.h"
+#include "ns3/bit-serializer.h"
 
 #include <bitset>
 #include <string>
@@ -65,13 +66,14 @@ public:
   virtual void PreSerialize (void) const = 0;
 
 protected:
-  mutable uint8_t m_serializationPendingBits; //!< pending bits
-  mutable uint8_t m_numSerializationPendingBits; //!< number of pending bits
+  mutable uint8_t m_serializationPendingBits; //!< pending bits of the deserialization
+  mutable uint8_t m_numSerializationPendingBits; //!< number of pending bits of the deserialization
   mutable bool m_isDataSerialized; //!< true if data is serialized
   mutable Buffer m_serializationResult; //!< serialization result
+  mutable BitSerializer m_serializationBits; //!< bits of the serialization in progress
 
   /**
-   * Function to write in m_serializationResult, after resizing its size
+   * Function to write an octet in the bits of the serialization
    * \param octet bits to write
    */
   void WriteOctet (uint8_t octet) const;
@@ -120,6 +122,13 @@ protected:
    * Finalizes an in progress serialization.
    */
   void FinalizeSerialization () const;
+  /**
+   * Finalizes an in progress deserialization, dropping the padding bits.
+   * \param start buffer iterator at the start of the message
+   * \param bIterator buffer iterator at the end of the message
+   * \returns the number of bytes of the message
+   */
+  uint32_t FinalizeDeserialization (Buffer::Iterator start, Buffer::Iterator bIterator);
 
   /**
    * Serialize a bitset
@@ -263,6 +272,16 @@ protected:
 
   // Deserialization functions
 
+  /**
+   * Deserialize bits
+   * \param value buffer to store the result, the last bit read being the
+   *              least significant one
+   * \param numBits number of bits to read, at most 64
+   * \param bIterator buffer iterator
+   * \returns the modified buffer iterator
+   */
+  Buffer::Iterator DeserializeBits (uint64_t *value, int numBits,
+                                    Buffer::Iterator bIterator);
   /**
    * Deserialize a bitset
    * \param data buffer to store the result
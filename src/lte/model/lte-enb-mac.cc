@@ -171,6 +171,12 @@ EnbMacMemberFfMacSchedSapUser::EnbMacMemberFfMacSchedSapUser (LteEnbMac* mac)
 void
 EnbMacMemberFfMacSchedSapUser::SchedDlConfigInd (const struct SchedDlConfigIndParameters& params)
 {
+  if (m_mac->m_schedulerExecutor)
+    {
+      LteEnbMac* mac = m_mac;
+      m_mac->DeferSchedulerIndication ([mac, params] () { mac->DoSchedDlConfigInd (params); });
+      return;
+    }
   m_mac->DoSchedDlConfigInd (params);
 }
 
@@ -179,6 +185,12 @@ EnbMacMemberFfMacSchedSapUser::SchedDlConfigInd (const struct SchedDlConfigIndPa
 void
 EnbMacMemberFfMacSchedSapUser::SchedUlConfigInd (const struct SchedUlConfigIndParameters& params)
 {
+  if (m_mac->m_schedulerExecutor)
+    {
+      LteEnbMac* mac = m_mac;
+      m_mac->DeferSchedulerIndication ([mac, params] () { mac->DoSchedUlConfigInd (params); });
+      return;
+    }
   m_mac->DoSchedUlConfigInd (params);
 }
 
@@ -215,47 +227,269 @@ EnbMacMemberFfMacCschedSapUser::EnbMacMemberFfMacCschedSapUser (LteEnbMac* mac)
 void
 EnbMacMemberFfMacCschedSapUser::CschedCellConfigCnf (const struct CschedCellConfigCnfParameters& params)
 {
+  if (m_mac->m_schedulerExecutor)
+    {
+      LteEnbMac* mac = m_mac;
+      m_mac->DeferSchedulerIndication ([mac, params] () { mac->DoCschedCellConfigCnf (params); });
+      return;
+    }
   m_mac->DoCschedCellConfigCnf (params);
 }
 
 void
 EnbMacMemberFfMacCschedSapUser::CschedUeConfigCnf (const struct CschedUeConfigCnfParameters& params)
 {
+  if (m_mac->m_schedulerExecutor)
+    {
+      LteEnbMac* mac = m_mac;
+      m_mac->DeferSchedulerIndication ([mac, params] () { mac->DoCschedUeConfigCnf (params); });
+      return;
+    }
   m_mac->DoCschedUeConfigCnf (params);
 }
 
 void
 EnbMacMemberFfMacCschedSapUser::CschedLcConfigCnf (const struct CschedLcConfigCnfParameters& params)
 {
+  if (m_mac->m_schedulerExecutor)
+    {
+      LteEnbMac* mac = m_mac;
+      m_mac->DeferSchedulerIndication ([mac, params] () { mac->DoCschedLcConfigCnf (params); });
+      return;
+    }
   m_mac->DoCschedLcConfigCnf (params);
 }
 
 void
 EnbMacMemberFfMacCschedSapUser::CschedLcReleaseCnf (const struct CschedLcReleaseCnfParameters& params)
 {
+  if (m_mac->m_schedulerExecutor)
+    {
+      LteEnbMac* mac = m_mac;
+      m_mac->DeferSchedulerIndication ([mac, params] () { mac->DoCschedLcReleaseCnf (params); });
+      return;
+    }
   m_mac->DoCschedLcReleaseCnf (params);
 }
 
 void
 EnbMacMemberFfMacCschedSapUser::CschedUeReleaseCnf (const struct CschedUeReleaseCnfParameters& params)
 {
+  if (m_mac->m_schedulerExecutor)
+    {
+      LteEnbMac* mac = m_mac;
+      m_mac->DeferSchedulerIndication ([mac, params] () { mac->DoCschedUeReleaseCnf (params); });
+      return;
+    }
   m_mac->DoCschedUeReleaseCnf (params);
 }
 
 void
 EnbMacMemberFfMacCschedSapUser::CschedUeConfigUpdateInd (const struct CschedUeConfigUpdateIndParameters& params)
 {
+  if (m_mac->m_schedulerExecutor)
+    {
+      LteEnbMac* mac = m_mac;
+      m_mac->DeferSchedulerIndication ([mac, params] () { mac->DoCschedUeConfigUpdateInd (params); });
+      return;
+    }
   m_mac->DoCschedUeConfigUpdateInd (params);
 }
 
 void
 EnbMacMemberFfMacCschedSapUser::CschedCellConfigUpdateInd (const struct CschedCellConfigUpdateIndParameters& params)
 {
+  if (m_mac->m_schedulerExecutor)
+    {
+      LteEnbMac* mac = m_mac;
+      m_mac->DeferSchedulerIndication ([mac, params] () { mac->DoCschedCellConfigUpdateInd (params); });
+      return;
+    }
   m_mac->DoCschedCellConfigUpdateInd (params);
 }
 
 
 
+/**
+ * \brief Sched SAP provider queueing the calls of the MAC to the scheduler,
+ * run later by the scheduler executor.
+ */
+class EnbMacDeferredFfMacSchedSapProvider : public FfMacSchedSapProvider
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param mac the MAC
+   */
+  EnbMacDeferredFfMacSchedSapProvider (LteEnbMac* mac);
+
+  // inherited from FfMacSchedSapProvider
+  virtual void SchedDlRlcBufferReq (const struct SchedDlRlcBufferReqParameters& params);
+  virtual void SchedDlPagingBufferReq (const struct SchedDlPagingBufferReqParameters& params);
+  virtual void SchedDlMacBufferReq (const struct SchedDlMacBufferReqParameters& params);
+  virtual void SchedDlTriggerReq (const struct SchedDlTriggerReqParameters& params);
+  virtual void SchedDlRachInfoReq (const struct SchedDlRachInfoReqParameters& params);
+  virtual void SchedDlCqiInfoReq (const struct SchedDlCqiInfoReqParameters& params);
+  virtual void SchedUlTriggerReq (const struct SchedUlTriggerReqParameters& params);
+  virtual void SchedUlNoiseInterferenceReq (const struct SchedUlNoiseInterferenceReqParameters& params);
+  virtual void SchedUlSrInfoReq (const struct SchedUlSrInfoReqParameters& params);
+  virtual void SchedUlMacCtrlInfoReq (const struct SchedUlMacCtrlInfoReqParameters& params);
+  virtual void SchedUlCqiInfoReq (const struct SchedUlCqiInfoReqParameters& params);
+
+private:
+  LteEnbMac* m_mac; ///< the MAC
+};
+
+EnbMacDeferredFfMacSchedSapProvider::EnbMacDeferredFfMacSchedSapProvider (LteEnbMac* mac)
+  : m_mac (mac)
+{
+}
+
+void
+EnbMacDeferredFfMacSchedSapProvider::SchedDlRlcBufferReq (const struct SchedDlRlcBufferReqParameters& params)
+{
+  FfMacSchedSapProvider* provider = m_mac->m_schedulerSchedSapProvider;
+  m_mac->DeferSchedulerCall ([provider, params] () { provider->SchedDlRlcBufferReq (params); });
+}
+
+void
+EnbMacDeferredFfMacSchedSapProvider::SchedDlPagingBufferReq (const struct SchedDlPagingBufferReqParameters& params)
+{
+  FfMacSchedSapProvider* provider = m_mac->m_schedulerSchedSapProvider;
+  m_mac->DeferSchedulerCall ([provider, params] () { provider->SchedDlPagingBufferReq (params); });
+}
+
+void
+EnbMacDeferredFfMacSchedSapProvider::SchedDlMacBufferReq (const struct SchedDlMacBufferReqParameters& params)
+{
+  FfMacSchedSapProvider* provider = m_mac->m_schedulerSchedSapProvider;
+  m_mac->DeferSchedulerCall ([provider, params] () { provider->SchedDlMacBufferReq (params); });
+}
+
+void
+EnbMacDeferredFfMacSchedSapProvider::SchedDlTriggerReq (const struct SchedDlTriggerReqParameters& params)
+{
+  FfMacSchedSapProvider* provider = m_mac->m_schedulerSchedSapProvider;
+  m_mac->DeferSchedulerCall ([provider, params] () { provider->SchedDlTriggerReq (params); });
+}
+
+void
+EnbMacDeferredFfMacSchedSapProvider::SchedDlRachInfoReq (const struct SchedDlRachInfoReqParameters& params)
+{
+  FfMacSchedSapProvider* provider = m_mac->m_schedulerSchedSapProvider;
+  m_mac->DeferSchedulerCall ([provider, params] () { provider->SchedDlRachInfoReq (params); });
+}
+
+void
+EnbMacDeferredFfMacSchedSapProvider::SchedDlCqiInfoReq (const struct SchedDlCqiInfoReqParameters& params)
+{
+  FfMacSchedSapProvider* provider = m_mac->m_schedulerSchedSapProvider;
+  m_mac->DeferSchedulerCall ([provider, params] () { provider->SchedDlCqiInfoReq (params); });
+}
+
+void
+EnbMacDeferredFfMacSchedSapProvider::SchedUlTriggerReq (const struct SchedUlTriggerReqParameters& params)
+{
+  FfMacSchedSapProvider* provider = m_mac->m_schedulerSchedSapProvider;
+  m_mac->DeferSchedulerCall ([provider, params] () { provider->SchedUlTriggerReq (params); });
+}
+
+void
+EnbMacDeferredFfMacSchedSapProvider::SchedUlNoiseInterferenceReq (const struct SchedUlNoiseInterferenceReqParameters& params)
+{
+  FfMacSchedSapProvider* provider = m_mac->m_schedulerSchedSapProvider;
+  m_mac->DeferSchedulerCall ([provider, params] () { provider->SchedUlNoiseInterferenceReq (params); });
+}
+
+void
+EnbMacDeferredFfMacSchedSapProvider::SchedUlSrInfoReq (const struct SchedUlSrInfoReqParameters& params)
+{
+  FfMacSchedSapProvider* provider = m_mac->m_schedulerSchedSapProvider;
+  m_mac->DeferSchedulerCall ([provider, params] () { provider->SchedUlSrInfoReq (params); });
+}
+
+void
+EnbMacDeferredFfMacSchedSapProvider::SchedUlMacCtrlInfoReq (const struct SchedUlMacCtrlInfoReqParameters& params)
+{
+  FfMacSchedSapProvider* provider = m_mac->m_schedulerSchedSapProvider;
+  m_mac->DeferSchedulerCall ([provider, params] () { provider->SchedUlMacCtrlInfoReq (params); });
+}
+
+void
+EnbMacDeferredFfMacSchedSapProvider::SchedUlCqiInfoReq (const struct SchedUlCqiInfoReqParameters& params)
+{
+  FfMacSchedSapProvider* provider = m_mac->m_schedulerSchedSapProvider;
+  m_mac->DeferSchedulerCall ([provider, params] () { provider->SchedUlCqiInfoReq (params); });
+}
+
+
+/**
+ * \brief Csched SAP provider queueing the calls of the MAC to the scheduler,
+ * run later by the scheduler executor.
+ */
+class EnbMacDeferredFfMacCschedSapProvider : public FfMacCschedSapProvider
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param mac the MAC
+   */
+  EnbMacDeferredFfMacCschedSapProvider (LteEnbMac* mac);
+
+  // inherited from FfMacCschedSapProvider
+  virtual void CschedCellConfigReq (const struct CschedCellConfigReqParameters& params);
+  virtual void CschedUeConfigReq (const struct CschedUeConfigReqParameters& params);
+  virtual void CschedLcConfigReq (const struct CschedLcConfigReqParameters& params);
+  virtual void CschedLcReleaseReq (const struct CschedLcReleaseReqParameters& params);
+  virtual void CschedUeReleaseReq (const struct CschedUeReleaseReqParameters& params);
+
+private:
+  LteEnbMac* m_mac; ///< the MAC
+};
+
+EnbMacDeferredFfMacCschedSapProvider::EnbMacDeferredFfMacCschedSapProvider (LteEnbMac* mac)
+  : m_mac (mac)
+{
+}
+
+void
+EnbMacDeferredFfMacCschedSapProvider::CschedCellConfigReq (const struct CschedCellConfigReqParameters& params)
+{
+  FfMacCschedSapProvider* provider = m_mac->m_schedulerCschedSapProvider;
+  m_mac->DeferSchedulerCall ([provider, params] () { provider->CschedCellConfigReq (params); });
+}
+
+void
+EnbMacDeferredFfMacCschedSapProvider::CschedUeConfigReq (const struct CschedUeConfigReqParameters& params)
+{
+  FfMacCschedSapProvider* provider = m_mac->m_schedulerCschedSapProvider;
+  m_mac->DeferSchedulerCall ([provider, params] () { provider->CschedUeConfigReq (params); });
+}
+
+void
+EnbMacDeferredFfMacCschedSapProvider::CschedLcConfigReq (const struct CschedLcConfigReqParameters& params)
+{
+  FfMacCschedSapProvider* provider = m_mac->m_schedulerCschedSapProvider;
+  m_mac->DeferSchedulerCall ([provider, params] () { provider->CschedLcConfigReq (params); });
+}
+
+void
+EnbMacDeferredFfMacCschedSapProvider::CschedLcReleaseReq (const struct CschedLcReleaseReqParameters& params)
+{
+  FfMacCschedSapProvider* provider = m_mac->m_schedulerCschedSapProvider;
+  m_mac->DeferSchedulerCall ([provider, params] () { provider->CschedLcReleaseReq (params); });
+}
+
+void
+EnbMacDeferredFfMacCschedSapProvider::CschedUeReleaseReq (const struct CschedUeReleaseReqParameters& params)
+{
+  FfMacCschedSapProvider* provider = m_mac->m_schedulerCschedSapProvider;
+  m_mac->DeferSchedulerCall ([provider, params] () { provider->CschedUeReleaseReq (params); });
+}
+
+
 /// ---------- PHY-SAP
 class EnbMacMemberLteEnbPhySapUser : public LteEnbPhySapUser
 {
@@ -380,6 +614,10 @@ LteEnbMac::GetTypeId (void)
 
 
 LteEnbMac::LteEnbMac ():
+m_schedSapProvider (0),
+m_cschedSapProvider (0),
+m_schedulerSchedSapProvider (0),
+m_schedulerCschedSapProvider (0),
 m_ccmMacSapUser (0)
 {
   NS_LOG_FUNCTION (this);
@@ -389,6 +627,8 @@ m_ccmMacSapUser (0)
   m_cschedSapUser = new EnbMacMemberFfMacCschedSapUser (this);
   m_enbPhySapUser = new EnbMacMemberLteEnbPhySapUser (this);
   m_ccmMacSapProvider = new MemberLteCcmMacSapProvider<LteEnbMac> (this);
+  m_deferredSchedSapProvider = new EnbMacDeferredFfMacSchedSapProvider (this);
+  m_deferredCschedSapProvider = new EnbMacDeferredFfMacCschedSapProvider (this);
 }
 
 
@@ -413,6 +653,11 @@ LteEnbMac::DoDispose ()
   delete m_cschedSapUser;
   delete m_enbPhySapUser;
   delete m_ccmMacSapProvider;
+  delete m_deferredSchedSapProvider;
+  delete m_deferredCschedSapProvider;
+  m_schedulerExecutor = 0;
+  m_schedulerCalls.clear ();
+  m_schedulerIndications.clear ();
 }
 
 void
@@ -424,7 +669,8 @@ LteEnbMac::SetComponentCarrierId (uint8_t index)
 void
 LteEnbMac::SetFfMacSchedSapProvider (FfMacSchedSapProvider* s)
 {
-  m_schedSapProvider = s;
+  m_schedulerSchedSapProvider = s;
+  m_schedSapProvider = m_schedulerExecutor ? m_deferredSchedSapProvider : s;
 }
 
 FfMacSchedSapUser*
@@ -436,7 +682,8 @@ LteEnbMac::GetFfMacSchedSapUser (void)
 void
 LteEnbMac::SetFfMacCschedSapProvider (FfMacCschedSapProvider* s)
 {
-  m_cschedSapProvider = s;
+  m_schedulerCschedSapProvider = s;
+  m_cschedSapProvider = m_schedulerExecutor ? m_deferredCschedSapProvider : s;
 }
 
 FfMacCschedSapUser*
@@ -445,6 +692,57 @@ LteEnbMac::GetFfMacCschedSapUser (void)
   return m_cschedSapUser;
 }
 
+void
+LteEnbMac::SetSchedulerExecutor (Ptr<FfMacSchedulerExecutor> executor)
+{
+  NS_LOG_FUNCTION (this << executor);
+  NS_ASSERT_MSG (m_schedulerCalls.empty (), "scheduler calls pending");
+  m_schedulerExecutor = executor;
+  m_schedSapProvider = executor ? m_deferredSchedSapProvider : m_schedulerSchedSapProvider;
+  m_cschedSapProvider = executor ? m_deferredCschedSapProvider : m_schedulerCschedSapProvider;
+}
+
+void
+LteEnbMac::DeferSchedulerCall (std::function<void ()> call)
+{
+  if (m_schedulerCalls.empty ())
+    {
+      m_schedulerExecutor->Submit (MakeCallback (&LteEnbMac::RunSchedulerCalls, this),
+                                   MakeCallback (&LteEnbMac::DeliverSchedulerIndications, this));
+    }
+  m_schedulerCalls.push_back (call);
+}
+
+void
+LteEnbMac::DeferSchedulerIndication (std::function<void ()> indication)
+{
+  m_schedulerIndications.push_back (indication);
+}
+
+void
+LteEnbMac::RunSchedulerCalls (void)
+{
+  // this may run in a worker thread of the executor: only the state of
+  // this MAC and of its scheduler can be touched
+  for (std::vector<std::function<void ()> >::iterator it = m_schedulerCalls.begin (); it != m_schedulerCalls.end (); ++it)
+    {
+      (*it) ();
+    }
+  m_schedulerCalls.clear ();
+}
+
+void
+LteEnbMac::DeliverSchedulerIndications (void)
+{
+  NS_LOG_FUNCTION (this << m_schedulerIndications.size ());
+  std::vector<std::function<void ()> > indications;
+  indications.swap (m_schedulerIndications);
+  for (std::vector<std::function<void ()> >::iterator it = indications.begin (); it != indications.end (); ++it)
+    {
+      (*it) ();
+    }
+}
+
 
 
 void
@@ -846,6 +1144,9 @@ LteEnbMac::DoRemoveUe (uint16_t rnti)
   FfMacCschedSapProvider::CschedUeReleaseReqParameters params;
   params.m_rnti = rnti;
   m_cschedSapProvider->CschedUeReleaseReq (params);
+  // with a scheduler executor, indications for this UE computed before the
+  // release can still be delivered: DoSchedDlConfigInd and
+  // DoSchedUlConfigInd drop them, since the RLC of the UE is going away
   m_rlcAttached.erase (rnti);
   m_miDlHarqProcessesPackets.erase (rnti);
 
@@ -881,6 +1182,45 @@ LteEnbMac::DoRemoveUe (uint16_t rnti)
           itCeRxd++;
         }
     }
+
+  // the reports received before the removal are not forwarded to the
+  // scheduler, which no longer knows the UE
+  std::vector<CqiListElement_s>::iterator itCqiRxd = m_dlCqiReceived.begin ();
+  while (itCqiRxd != m_dlCqiReceived.end ())
+    {
+      if (itCqiRxd->m_rnti == rnti)
+        {
+          itCqiRxd = m_dlCqiReceived.erase (itCqiRxd);
+        }
+      else
+        {
+          itCqiRxd++;
+        }
+    }
+  std::vector<DlInfoListElement_s>::iterator itDlInfoRxd = m_dlInfoListReceived.begin ();
+  while (itDlInfoRxd != m_dlInfoListReceived.end ())
+    {
+      if (itDlInfoRxd->m_rnti == rnti)
+        {
+          itDlInfoRxd = m_dlInfoListReceived.erase (itDlInfoRxd);
+        }
+      else
+        {
+          itDlInfoRxd++;
+        }
+    }
+  std::vector<UlInfoListElement_s>::iterator itUlInfoRxd = m_ulInfoListReceived.begin ();
+  while (itUlInfoRxd != m_ulInfoListReceived.end ())
+    {
+      if (itUlInfoRxd->m_rnti == rnti)
+        {
+          itUlInfoRxd = m_ulInfoListReceived.erase (itUlInfoRxd);
+        }
+      else
+        {
+          itUlInfoRxd++;
+        }
+    }
 }
 
 void
@@ -1084,6 +1424,24 @@ void
 LteEnbMac::DoSchedDlConfigInd (FfMacSchedSapUser::SchedDlConfigIndParameters ind)
 {
   NS_LOG_FUNCTION (this);
+  if (m_schedulerExecutor)
+    {
+      // the decisions are delivered at the end of the time step: drop the
+      // ones of the UEs removed since the scheduler ran
+      std::vector<BuildDataListElement_s>::iterator itBuild = ind.m_buildDataList.begin ();
+      while (itBuild != ind.m_buildDataList.end ())
+        {
+          if (m_rlcAttached.find (itBuild->m_rnti) == m_rlcAttached.end ())
+            {
+              NS_LOG_DEBUG (this << " dropping DL allocation of removed RNTI " << itBuild->m_rnti);
+              itBuild = ind.m_buildDataList.erase (itBuild);
+            }
+          else
+            {
+              ++itBuild;
+            }
+        }
+    }
   // Create DL PHY PDU
   Ptr<PacketBurst> pb = CreateObject<PacketBurst> ();
   std::map <LteFlowId_t, LteMacSapUser* >::iterator it;
@@ -1226,6 +1584,23 @@ void
 LteEnbMac::DoSchedUlConfigInd (FfMacSchedSapUser::SchedUlConfigIndParameters ind)
 {
   NS_LOG_FUNCTION (this);
+  if (m_schedulerExecutor)
+    {
+      // as in DoSchedDlConfigInd, drop the grants of the removed UEs
+      std::vector<UlDciListElement_s>::iterator itDci = ind.m_dciList.begin ();
+      while (itDci != ind.m_dciList.end ())
+        {
+          if (m_rlcAttached.find (itDci->m_rnti) == m_rlcAttached.end ())
+            {
+              NS_LOG_DEBUG (this << " dropping UL grant of removed RNTI " << itDci->m_rnti);
+              itDci = ind.m_dciList.erase (itDci);
+            }
+          else
+            {
+              ++itDci;
+            }
+        }
+    }
 
   for (unsigned int i = 0; i < ind.m_dciList.size (); i++)
     {
@@ -1290,6 +1665,11 @@ void
 LteEnbMac::DoCschedUeConfigUpdateInd (FfMacCschedSapUser::CschedUeConfigUpdateIndParameters params)
 {
   NS_LOG_FUNCTION (this);
+  if (m_schedulerExecutor && m_rlcAttached.find (params.m_rnti) == m_rlcAttached.end ())
+    {
+      // the UE has been removed since the scheduler ran
+      return;
+    }
   // propagates to RRC
   LteEnbCmacSapUser::UeConfig ueConfigUpdate;
   ueConfigUpdate.m_rnti = params.m_rnti;
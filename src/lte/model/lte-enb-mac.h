@@ -26,6 +26,7 @@
 #define LTE_ENB_MAC_H
 
 
+#include <functional>
 #include <map>
 #include <vector>
 #include <ns3/lte-common.h>
@@ -39,6 +40,7 @@
 #include <ns3/packet.h>
 #include <ns3/packet-burst.h>
 #include <ns3/lte-ccm-mac-sap.h>
+#include <ns3/ff-mac-scheduler-executor.h>
 
 namespace ns3 {
 
@@ -66,6 +68,10 @@ class LteEnbMac :   public Object
   friend class EnbMacMemberLteEnbPhySapUser;
   /// allow MemberLteCcmMacSapProvider<LteEnbMac> class friend access
   friend class MemberLteCcmMacSapProvider<LteEnbMac>;
+  /// allow EnbMacDeferredFfMacSchedSapProvider class friend access
+  friend class EnbMacDeferredFfMacSchedSapProvider;
+  /// allow EnbMacDeferredFfMacCschedSapProvider class friend access
+  friend class EnbMacDeferredFfMacCschedSapProvider;
 
 public:
   /**
@@ -103,6 +109,17 @@ public:
    * \return a pointer to the control scheduler SAP user
    */
   FfMacCschedSapUser* GetFfMacCschedSapUser (void);
+  /**
+   * \brief Set the executor running the calls to the scheduler
+   *
+   * When an executor is set, the calls to the scheduler are queued and
+   * run by the executor at the end of the time step, possibly in
+   * parallel with the ones of the other cells, and the indications of
+   * the scheduler are delivered after all of them.
+   *
+   * \param executor the executor, or 0 to call the scheduler directly
+   */
+  void SetSchedulerExecutor (Ptr<FfMacSchedulerExecutor> executor);
 
 
 
@@ -404,6 +421,30 @@ private:
   FfMacSchedSapUser* m_schedSapUser; ///< the Sched SAP user
   FfMacCschedSapUser* m_cschedSapUser; ///< the CSched SAP user
 
+  /**
+   * \brief Queue a call to the scheduler for the scheduler executor
+   * \param call the call
+   */
+  void DeferSchedulerCall (std::function<void ()> call);
+  /**
+   * \brief Record an indication of the scheduler, delivered after the
+   * scheduler calls of all the cells
+   * \param indication the indication
+   */
+  void DeferSchedulerIndication (std::function<void ()> indication);
+  /// Run the queued calls to the scheduler; called by the scheduler executor
+  void RunSchedulerCalls (void);
+  /// Deliver the recorded indications of the scheduler; called by the scheduler executor
+  void DeliverSchedulerIndications (void);
+
+  Ptr<FfMacSchedulerExecutor> m_schedulerExecutor; ///< the executor running the calls to the scheduler, if any
+  FfMacSchedSapProvider* m_schedulerSchedSapProvider; ///< the Sched SAP provider of the scheduler
+  FfMacCschedSapProvider* m_schedulerCschedSapProvider; ///< the Csched SAP provider of the scheduler
+  FfMacSchedSapProvider* m_deferredSchedSapProvider; ///< the Sched SAP provider queueing the calls for the executor
+  FfMacCschedSapProvider* m_deferredCschedSapProvider; ///< the Csched SAP provider queueing the calls for the executor
+  std::vector<std::function<void ()> > m_schedulerCalls; ///< the calls to the scheduler queued for the executor
+  std::vector<std::function<void ()> > m_schedulerIndications; ///< the recorded indications of the scheduler
+
   // PHY-SAP
   LteEnbPhySapProvider* m_enbPhySapProvider; ///< the ENB Phy SAP provider
   LteEnbPhySapUser* m_enbPhySapUser; ///< the ENB Phy SAP user
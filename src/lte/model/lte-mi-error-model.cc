@@ -29,6 +29,8 @@
 *      Marco Miozzo <marco.miozzo@cttc.es>
 */ 
 
+#include <algorithm>
+#include <cstring>
 #include <list>
 #include <vector>
 #include <ns3/log.h>
@@ -331,83 +333,226 @@ static const double cEcrTable [9][38] = {
 };
 
 
+namespace {
+
+/**
+ * A table mapping the SINR to the mutual information of a modulation.
+ * Since the values of the SINR axis are uniformly spaced, the index of
+ * a SINR is ((sinrLin - axis[0]) / (axis[SIZE-1] - axis[0])) * (SIZE-1):
+ * the scaling coefficient is computed once.
+ */
+struct MiMap
+{
+  /**
+   * Constructor
+   * \param mi the mutual information values
+   * \param axis the SINR values
+   * \param size the number of values
+   */
+  MiMap (const double *mi, const double *axis, uint16_t size)
+    : m_mi (mi),
+      m_axis0 (axis[0]),
+      m_axisMax (axis[size - 1]),
+      m_scalingCoeff ((size - 1) / (axis[size - 1] - axis[0])),
+      m_size (size)
+  {
+  }
+
+  /**
+   * \param sinrLin a SINR in linear units
+   * \return the mutual information of the SINR
+   */
+  double GetMi (double sinrLin) const
+  {
+    if (sinrLin > m_axisMax)
+      {
+        return 1;
+      }
+    double sinrIndexDouble = (sinrLin - m_axis0) * m_scalingCoeff + 1;
+    uint32_t sinrIndex = std::max (0.0, std::floor (sinrIndexDouble));
+    NS_ASSERT_MSG (sinrIndex < m_size, "MI map out of data");
+    return m_mi[sinrIndex];
+  }
+
+  const double *m_mi;     //!< the mutual information values
+  double m_axis0;         //!< the first SINR value
+  double m_axisMax;       //!< the last SINR value
+  double m_scalingCoeff;  //!< the number of values per SINR unit
+  uint16_t m_size;        //!< the number of values
+};
+
+/// the MI map of QPSK
+static const MiMap g_miMapQpsk (MI_map_qpsk, MI_map_qpsk_axis, MI_MAP_QPSK_SIZE);
+/// the MI map of 16-QAM
+static const MiMap g_miMap16qam (MI_map_16qam, MI_map_16qam_axis, MI_MAP_16QAM_SIZE);
+/// the MI map of 64-QAM
+static const MiMap g_miMap64qam (MI_map_64qam, MI_map_64qam_axis, MI_MAP_64QAM_SIZE);
+
+/**
+ * \param mcs a MCS
+ * \return the MI map of the modulation of the MCS
+ */
+const MiMap &
+GetMiMap (uint8_t mcs)
+{
+  if (mcs <= MI_QPSK_MAX_ID)
+    {
+      return g_miMapQpsk;
+    }
+  else if (mcs <= MI_16QAM_MAX_ID)
+    {
+      return g_miMap16qam;
+    }
+  return g_miMap64qam;
+}
+
+/**
+ * The parameters b and c of the BLER curves, for each CB size and ECR.
+ * The missing curves of a CB size are replaced by the ones of the lowest
+ * larger CB size, to remove the CB size quantization errors.
+ */
+struct BlerCurves
+{
+  BlerCurves ()
+  {
+    for (uint8_t ecrId = 0; ecrId <= MI_64QAM_BLER_MAX_ID; ecrId++)
+      {
+        for (int cbIndex = 0; cbIndex < 9; cbIndex++)
+          {
+            double b = bEcrTable[cbIndex][ecrId];
+            for (int i = cbIndex; (i < 9) && (b < 0); )
+              {
+                b = bEcrTable[i++][ecrId];
+              }
+            double c = cEcrTable[cbIndex][ecrId];
+            for (int i = cbIndex; (i < 9) && (c < 0); )
+              {
+                c = cEcrTable[i++][ecrId];
+              }
+            m_b[cbIndex][ecrId] = b;
+            m_c[cbIndex][ecrId] = c;
+          }
+      }
+  }
+
+  double m_b[9][38];  //!< the parameters b
+  double m_c[9][38];  //!< the parameters c
+};
+
+/// the parameters of the BLER curves
+static const BlerCurves g_blerCurves;
+
+/**
+ * A cache of the TB error rates, indexed by the MI, the ECR and the code
+ * block segmentation. The error rate only depends on them, and the same
+ * TBs are received with the same SINRs when the channel does not change.
+ */
+class TbErrorRateCache
+{
+public:
+  TbErrorRateCache ()
+  {
+    std::memset (m_entries, 0, sizeof (m_entries));
+  }
+
+  /**
+   * \param mi the mutual information
+   * \param ecrId the ECR id
+   * \param kPlus the size of the large CBs
+   * \param cPlus the number of large CBs
+   * \param cMinus the number of small CBs
+   * \param [out] errorRate the cached error rate
+   * \return whether the error rate is cached
+   */
+  bool Lookup (double mi, uint8_t ecrId, uint16_t kPlus, uint32_t cPlus, uint32_t cMinus, double &errorRate) const
+  {
+    const Entry &e = m_entries[Hash (mi, ecrId, kPlus, cPlus, cMinus)];
+    if (e.m_valid && e.m_mi == mi && e.m_ecrId == ecrId && e.m_kPlus == kPlus
+        && e.m_cPlus == cPlus && e.m_cMinus == cMinus)
+      {
+        errorRate = e.m_errorRate;
+        return true;
+      }
+    return false;
+  }
+
+  /**
+   * \param mi the mutual information
+   * \param ecrId the ECR id
+   * \param kPlus the size of the large CBs
+   * \param cPlus the number of large CBs
+   * \param cMinus the number of small CBs
+   * \param errorRate the error rate
+   */
+  void Insert (double mi, uint8_t ecrId, uint16_t kPlus, uint32_t cPlus, uint32_t cMinus, double errorRate)
+  {
+    Entry &e = m_entries[Hash (mi, ecrId, kPlus, cPlus, cMinus)];
+    e.m_valid = true;
+    e.m_mi = mi;
+    e.m_ecrId = ecrId;
+    e.m_kPlus = kPlus;
+    e.m_cPlus = cPlus;
+    e.m_cMinus = cMinus;
+    e.m_errorRate = errorRate;
+  }
+
+private:
+  /// the number of entries
+  static const uint32_t SIZE = 1024;
+
+  /// an entry of the cache
+  struct Entry
+  {
+    bool m_valid;        //!< whether the entry is used
+    uint8_t m_ecrId;     //!< the ECR id
+    uint16_t m_kPlus;    //!< the size of the large CBs
+    uint32_t m_cPlus;    //!< the number of large CBs
+    uint32_t m_cMinus;   //!< the number of small CBs
+    double m_mi;         //!< the mutual information
+    double m_errorRate;  //!< the error rate
+  };
+
+  /**
+   * \param mi the mutual information
+   * \param ecrId the ECR id
+   * \param kPlus the size of the large CBs
+   * \param cPlus the number of large CBs
+   * \param cMinus the number of small CBs
+   * \return the index of the entry of the key
+   */
+  static uint32_t Hash (double mi, uint8_t ecrId, uint16_t kPlus, uint32_t cPlus, uint32_t cMinus)
+  {
+    uint64_t bits;
+    std::memcpy (&bits, &mi, sizeof (bits));
+    uint64_t h = bits ^ (static_cast<uint64_t> (ecrId) << 56) ^ (static_cast<uint64_t> (kPlus) << 40)
+      ^ (static_cast<uint64_t> (cPlus) << 20) ^ cMinus;
+    h *= 0x9e3779b97f4a7c15ULL;
+    return static_cast<uint32_t> (h >> 54) % SIZE;
+  }
+
+  Entry m_entries[SIZE]; //!< the entries
+};
+
+/// the cache of the TB error rates
+static TbErrorRateCache g_tbErrorRateCache;
+
+} // unnamed namespace
+
 double 
 LteMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
 {
   NS_LOG_FUNCTION (sinr << &map << (uint32_t) mcs);
-  
+
+  // the modulation is the same for all the RBs of the TB
+  const MiMap &miMap = GetMiMap (mcs);
+  Values::const_iterator sinrValues = sinr.ConstValuesBegin ();
   double MI;
   double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-  
   for (uint32_t i = 0; i < map.size (); i++)
     {
-      double sinrLin = sinrCopy[map.at (i)];
-      if (mcs <= MI_QPSK_MAX_ID) // QPSK
-        {
-
-          if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1])
-            {
-              MI = 1;
-            }
-          else 
-            { 
-              // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-              // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-              static const double scalingCoeffQpsk = 
-                (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]);
-              double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-              uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-              NS_ASSERT_MSG (sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-              MI = MI_map_qpsk[sinrIndex];
-            }
-        }
-      else
-        {
-          if (mcs > MI_QPSK_MAX_ID && mcs <= MI_16QAM_MAX_ID )	// 16-QAM
-            {
-              if (sinrLin > MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1])
-                {
-                  MI = 1;
-                }
-              else 
-                {
-                  // since the values in MI_map_16QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff16qam = 
-                    (MI_MAP_16QAM_SIZE - 1) / (MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1] - MI_map_16qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_16qam_axis[0]) * scalingCoeff16qam + 1;
-                  uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MI_MAP_16QAM_SIZE, "MI map out of data");
-                  MI = MI_map_16qam[sinrIndex];
-                }
-            }
-          else // 64-QAM
-            {
-              if (sinrLin > MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1])
-                {
-                  MI = 1;
-                }
-              else
-                {
-                  // since the values in MI_map_64QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff64qam = 
-                    (MI_MAP_64QAM_SIZE - 1) / (MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1] - MI_map_64qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_64qam_axis[0]) * scalingCoeff64qam + 1;
-                  uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MI_MAP_64QAM_SIZE, "MI map out of data");
-                  MI = MI_map_64qam[sinrIndex];
-                }
-            }
-        }
-      NS_LOG_LOGIC (" RB " << map.at (i) << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
+      double sinrLin = sinrValues[map[i]];
+      MI = miMap.GetMi (sinrLin);
+      NS_LOG_LOGIC (" RB " << map[i] << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
       MIsum += MI;
     }
   MI = MIsum / map.size ();
@@ -432,28 +577,8 @@ LteMiErrorModel::MappingMiBler (double mib, uint8_t ecrId, uint16_t cbSize)
   cbIndex--;
   NS_LOG_LOGIC (" ECRid " << (uint16_t)ecrId << " ECR " << BlerCurvesEcrMap[ecrId] << " CB size " << cbSize << " CB size curve " << cbMiSizeTable[cbIndex]);
 
-  b = bEcrTable[cbIndex][ecrId];
-  if (b<0.0)
-    {
-      //take the lowest CB size including this CB for removing CB size
-      //quatization errors
-      int i = cbIndex;
-      while ((i<9)&&(b<0))
-        {
-          b = bEcrTable[i++][ecrId];
-        }
-    }
-  c = cEcrTable[cbIndex][ecrId];
-  if (c<0.0)
-    {
-      //take the lowest CB size including this CB for removing CB size
-      //quatization errors
-      int i = cbIndex;
-      while ((i<9)&&(c<0))
-        {
-          c = cEcrTable[i++][ecrId];
-        }
-    }
+  b = g_blerCurves.m_b[cbIndex][ecrId];
+  c = g_blerCurves.m_c[cbIndex][ecrId];
   // see IEEE802.16m EMD formula 55 of section 4.3.2.1
   double bler = 0.5*( 1 - erf((mib-b)/(sqrt(2)*c)) );
   NS_LOG_LOGIC ("MIB: " << mib << " BLER:" << bler << " b:" << b << " c:" << c);
@@ -468,42 +593,20 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
   NS_LOG_FUNCTION (sinr);
   double MI;
   double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-  Values::iterator sinrIt = sinrCopy.ValuesBegin ();
+  Values::const_iterator sinrIt = sinr.ConstValuesBegin ();
   uint16_t rb = 0;
-  NS_ASSERT (sinrIt!=sinrCopy.ValuesEnd ());
-  while (sinrIt!=sinrCopy.ValuesEnd ())
+  NS_ASSERT (sinrIt!=sinr.ConstValuesEnd ());
+  while (sinrIt!=sinr.ConstValuesEnd ())
     {
-      double sinrLin = *sinrIt;
-      if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1])
-        {
-          MI = 1;
-        }
-      else 
-        { 
-          // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-          // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-          static const double scalingCoeffQpsk = 
-            (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]);
-          double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-          uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-          NS_ASSERT_MSG (sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-          MI = MI_map_qpsk[sinrIndex];
-        }
-      MIsum += MI;
+      MIsum += g_miMapQpsk.GetMi (*sinrIt);
       sinrIt++;
       rb++;
     }
   MI = MIsum / rb;
-  // return to the effective SINR value
-  int j = 0;
+  // return to the effective SINR value; the MI map is increasing, so the
+  // first value not lower than MI is found with a binary search
+  int j = std::lower_bound (MI_map_qpsk, MI_map_qpsk + MI_MAP_QPSK_SIZE, MI) - MI_map_qpsk;
   double esinr = 0.0;
-  while ((j<MI_MAP_QPSK_SIZE)&&(MI_map_qpsk[j] < MI))
-    {
-      j++;
-    }
   if (MI > MI_map_qpsk[MI_MAP_QPSK_SIZE-1])
     {
       esinr = MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1];
@@ -531,12 +634,9 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
 
   double esirnDb = 10*log10 (esinr); 
 //   NS_LOG_DEBUG ("Effective SINR " << esirnDb << " max " << 10*log10 (MI_map_qpsk [MI_MAP_QPSK_SIZE-1]));
-  uint16_t i = 0;
+  uint16_t i = std::lower_bound (PdcchPcfichBlerCurveXaxis, PdcchPcfichBlerCurveXaxis + PDCCH_PCFICH_CURVE_SIZE, esirnDb)
+    - PdcchPcfichBlerCurveXaxis;
   double errorRate = 0.0;
-  while ((i<PDCCH_PCFICH_CURVE_SIZE)&&(PdcchPcfichBlerCurveXaxis[i] < esirnDb))
-    {
-      i++;
-    }
   if (esirnDb > PdcchPcfichBlerCurveXaxis[PDCCH_PCFICH_CURVE_SIZE-1])
     {
       errorRate = 0.0;
@@ -554,7 +654,7 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
 
 
 TbStats_t
-LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, HarqProcessInfoList_t miHistory)
+LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t &miHistory)
 {
   NS_LOG_FUNCTION (sinr << &map << (uint32_t) size << (uint32_t) mcs);
 
@@ -719,17 +819,23 @@ LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std:
       NS_LOG_DEBUG ("HARQ ECR " << (uint16_t)ecrId);
     }
 
-  if (C!=1)
+  if (g_tbErrorRateCache.Lookup (MI, ecrId, Kplus, Cplus, Cminus, errorRate))
+    {
+      NS_LOG_LOGIC (" Cached error rate " << errorRate);
+    }
+  else if (C!=1)
     {
       double cbler = MappingMiBler (MI, ecrId, Kplus);
       errorRate *= pow (1.0 - cbler, Cplus);
       cbler = MappingMiBler (MI, ecrId, Kminus);
       errorRate *= pow (1.0 - cbler, Cminus);
       errorRate = 1.0 - errorRate;
+      g_tbErrorRateCache.Insert (MI, ecrId, Kplus, Cplus, Cminus, errorRate);
     }
   else
     {
       errorRate = MappingMiBler (MI, ecrId, Kplus);
+      g_tbErrorRateCache.Insert (MI, ecrId, Kplus, Cplus, Cminus, errorRate);
     }
 
   NS_LOG_LOGIC (" Error rate " << errorRate);
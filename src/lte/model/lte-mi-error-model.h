@@ -109,7 +109,7 @@ public:
    * \param miHistory MI of past transmissions (in case of retx)
    * \return the TB error rate and MI
    */
-  static TbStats_t GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, HarqProcessInfoList_t miHistory);
+  static TbStats_t GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t &miHistory);
   
   /** 
   * \brief run the error-model algorithm for the specified PCFICH+PDCCH channels
@@ -24,7 +24,6 @@
 
 #include "ns3/lte-rlc-am-header.h"
 #include "ns3/lte-rlc-am.h"
-#include "ns3/lte-rlc-sdu-status-tag.h"
 #include "ns3/lte-rlc-tag.h"
 
 
@@ -42,6 +41,7 @@ LteRlcAm::LteRlcAm ()
   // Buffers
   m_txonBufferSize = 0;
   m_retxBuffer.resize (1024);
+  m_rxonBuffer.resize (1024);
   m_retxBufferSize = 0;
   m_txedBuffer.resize (1024);
   m_txedBufferSize = 0;
@@ -165,9 +165,6 @@ LteRlcAm::DoTransmitPdcpPdu (Ptr<Packet> p)
   if (m_txonBufferSize + p->GetSize () <= m_maxTxBufferSize || (m_maxTxBufferSize == 0))
     {
       /** Store PDCP PDU */
-      LteRlcSduStatusTag tag;
-      tag.SetStatus (LteRlcSduStatusTag::FULL_SDU);
-      p->AddPacketTag (tag);
 
       NS_LOG_LOGIC ("Txon Buffer: New packet added");
       m_txonBuffer.push_back (TxPdu (p, Simulator::Now ()));
@@ -231,7 +228,6 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
       NS_LOG_LOGIC ("Check for SNs to NACK from " << m_vrR.GetValue() << " to " << m_vrMs.GetValue());
       SequenceNumber10 sn;
       sn.SetModulusBase (m_vrR);
-      std::map<uint16_t, PduBuffer>::iterator pduIt;
       for (sn = m_vrR; sn < m_vrMs; sn++) 
         {
           NS_LOG_LOGIC ("SN = " << sn);          
@@ -240,8 +236,7 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
               NS_LOG_LOGIC ("Can't fit more NACKs in STATUS PDU");
               break;
             }          
-          pduIt = m_rxonBuffer.find (sn.GetValue ());
-          if (pduIt == m_rxonBuffer.end () || (!(pduIt->second.m_pduComplete)))
+          if (!m_rxonBuffer[sn.GetValue ()].m_pduComplete)
             {
               NS_LOG_LOGIC ("adding NACK_SN " << sn.GetValue ());
               rlcAmHeader.PushNack (sn.GetValue ());              
@@ -251,13 +246,11 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
       // 3GPP TS 36.322 section 6.2.2.1.4 ACK SN
       // find the  SN of the next not received RLC Data PDU 
       // which is not reported as missing in the STATUS PDU. 
-      pduIt = m_rxonBuffer.find (sn.GetValue ());
-      while ((sn < m_vrMs) && (pduIt != m_rxonBuffer.end ()) && (pduIt->second.m_pduComplete))            
+      while ((sn < m_vrMs) && m_rxonBuffer[sn.GetValue ()].m_pduComplete)
         {
           NS_LOG_LOGIC ("SN = " << sn << " < " << m_vrMs << " = " << (sn < m_vrMs));
           sn++;
           NS_LOG_LOGIC ("SN = " << sn);
-          pduIt = m_rxonBuffer.find (sn.GetValue ());
         }
       
       NS_ASSERT_MSG (sn <= m_vrMs, "first SN not reported as missing = " << sn << ", VR(MS) = " << m_vrMs);      
@@ -435,193 +428,103 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
   //
   //
 
-  Ptr<Packet> packet = Create<Packet> ();
   LteRlcAmHeader rlcAmHeader;
   rlcAmHeader.SetDataPdu ();
 
   // Build Data field
   uint32_t nextSegmentSize = txOpParams.bytes - 4;
   uint32_t nextSegmentId = 1;
-  uint32_t dataFieldTotalSize = 0;
-  uint32_t dataFieldAddedSize = 0;
   std::vector < Ptr<Packet> > dataField;
+  bool firstSegmentIsSdu = false;   // whether the first segment is a full SDU, shared with the buffer
+  bool firstByte = false;           // whether the data field starts with the first byte of a SDU
+  bool lastByte = false;            // whether the data field ends with the last byte of a SDU
 
-  // Remove the first packet from the transmission buffer.
-  // If only a segment of the packet is taken, then the remaining is given back later
-  if ( m_txonBuffer.size () == 0 )
+  if ( m_txonBuffer.empty () )
     {
       NS_LOG_LOGIC ("No data pending");
       return;
     }
 
   NS_LOG_LOGIC ("SDUs in TxonBuffer  = " << m_txonBuffer.size ());
-  NS_LOG_LOGIC ("First SDU buffer  = " << m_txonBuffer.begin ()->m_pdu);
-  NS_LOG_LOGIC ("First SDU size    = " << m_txonBuffer.begin ()->m_pdu->GetSize ());
   NS_LOG_LOGIC ("Next segment size = " << nextSegmentSize);
-  NS_LOG_LOGIC ("Remove SDU from TxBuffer");
-  Time firstSegmentTime = m_txonBuffer.begin ()->m_waitingSince;
-  Ptr<Packet> firstSegment = m_txonBuffer.begin ()->m_pdu->Copy ();
-  m_txonBufferSize -= m_txonBuffer.begin ()->m_pdu->GetSize ();
-  NS_LOG_LOGIC ("txBufferSize      = " << m_txonBufferSize );
-  m_txonBuffer.erase (m_txonBuffer.begin ());
-
-  while ( firstSegment && (firstSegment->GetSize () > 0) && (nextSegmentSize > 0) )
+
+  // The segments are taken from the SDUs at the front of the transmission
+  // buffer: a SDU taken in full is used as is, and a segment is a fragment
+  // of its SDU. A SDU stays in the buffer until its last byte is taken.
+  while ( !m_txonBuffer.empty () && (nextSegmentSize > 0) )
     {
-      NS_LOG_LOGIC ("WHILE ( firstSegment && firstSegment->GetSize > 0 && nextSegmentSize > 0 )");
-      NS_LOG_LOGIC ("    firstSegment size = " << firstSegment->GetSize ());
+      TxPdu &firstSdu = m_txonBuffer.front ();
+      uint32_t sduSize = firstSdu.m_pdu->GetSize ();
+      uint32_t firstSegmentSize = sduSize - firstSdu.m_offset;
+      NS_LOG_LOGIC ("    firstSegment size = " << firstSegmentSize);
       NS_LOG_LOGIC ("    nextSegmentSize   = " << nextSegmentSize);
-      if ( (firstSegment->GetSize () > nextSegmentSize) ||
+
+      uint32_t currSegmentSize = firstSegmentSize;
+      bool lastSegment = true;
+      if ( (firstSegmentSize > nextSegmentSize) ||
            // Segment larger than 2047 octets can only be mapped to the end of the Data field
-           (firstSegment->GetSize () > 2047)
+           (firstSegmentSize > 2047)
          )
         {
           // Take the minimum size, due to the 2047-bytes 3GPP exception
           // This exception is due to the length of the LI field (just 11 bits)
-          uint32_t currSegmentSize = std::min (firstSegment->GetSize (), nextSegmentSize);
-
+          currSegmentSize = std::min (firstSegmentSize, nextSegmentSize);
           NS_LOG_LOGIC ("    IF ( firstSegment > nextSegmentSize ||");
           NS_LOG_LOGIC ("         firstSegment > 2047 )");
-
-          // Segment txBuffer.FirstBuffer and
-          // Give back the remaining segment to the transmission buffer
-          Ptr<Packet> newSegment = firstSegment->CreateFragment (0, currSegmentSize);
-          NS_LOG_LOGIC ("    newSegment size   = " << newSegment->GetSize ());
-
-          // Status tag of the new and remaining segments
-          // Note: This is the only place where a PDU is segmented and
-          // therefore its status can change
-          LteRlcSduStatusTag oldTag, newTag;
-          firstSegment->RemovePacketTag (oldTag);
-          newSegment->RemovePacketTag (newTag);
-          if (oldTag.GetStatus () == LteRlcSduStatusTag::FULL_SDU)
-            {
-              newTag.SetStatus (LteRlcSduStatusTag::FIRST_SEGMENT);
-              oldTag.SetStatus (LteRlcSduStatusTag::LAST_SEGMENT);
-            }
-          else if (oldTag.GetStatus () == LteRlcSduStatusTag::LAST_SEGMENT)
-            {
-              newTag.SetStatus (LteRlcSduStatusTag::MIDDLE_SEGMENT);
-              //oldTag.SetStatus (LteRlcSduStatusTag::LAST_SEGMENT);
-            }
-
-          // Give back the remaining segment to the transmission buffer
-          firstSegment->RemoveAtStart (currSegmentSize);
-          NS_LOG_LOGIC ("    firstSegment size (after RemoveAtStart) = " << firstSegment->GetSize ());
-          if (firstSegment->GetSize () > 0)
-            {
-              firstSegment->AddPacketTag (oldTag);
-
-              m_txonBuffer.insert (m_txonBuffer.begin (), TxPdu (firstSegment, firstSegmentTime));
-              m_txonBufferSize += m_txonBuffer.begin ()->m_pdu->GetSize ();
-
-              NS_LOG_LOGIC ("    Txon buffer: Give back the remaining segment");
-              NS_LOG_LOGIC ("    Txon buffers = " << m_txonBuffer.size ());
-              NS_LOG_LOGIC ("    Front buffer size = " << m_txonBuffer.begin ()->m_pdu->GetSize ());
-              NS_LOG_LOGIC ("    txonBufferSize = " << m_txonBufferSize );
-            }
-          else
-            {
-              // Whole segment was taken, so adjust tag
-              if (newTag.GetStatus () == LteRlcSduStatusTag::FIRST_SEGMENT)
-                {
-                  newTag.SetStatus (LteRlcSduStatusTag::FULL_SDU);
-                }
-              else if (newTag.GetStatus () == LteRlcSduStatusTag::MIDDLE_SEGMENT)
-                {
-                  newTag.SetStatus (LteRlcSduStatusTag::LAST_SEGMENT);
-                }
-            }
-          // Segment is completely taken or
-          // the remaining segment is given back to the transmission buffer
-          firstSegment = 0;
-
-          // Put status tag once it has been adjusted
-          newSegment->AddPacketTag (newTag);
-
-          // Add Segment to Data field
-          dataFieldAddedSize = newSegment->GetSize ();
-          dataFieldTotalSize += dataFieldAddedSize;
-          dataField.push_back (newSegment);
-          newSegment = 0;
-
-          // ExtensionBit (Next_Segment - 1) = 0
-          rlcAmHeader.PushExtensionBit (LteRlcAmHeader::DATA_FIELD_FOLLOWS);
-
-          // no LengthIndicator for the last one
-
-          nextSegmentSize -= dataFieldAddedSize;
-          nextSegmentId++;
-
-          // nextSegmentSize MUST be zero (only if segment is smaller or equal to 2047)
-
-          // (NO more segments) ? exit
-          // break;
         }
-      else if ( (nextSegmentSize - firstSegment->GetSize () <= 2) || (m_txonBuffer.size () == 0) )
+      else if ( (nextSegmentSize - firstSegmentSize <= 2) || (m_txonBuffer.size () == 1) )
         {
-          NS_LOG_LOGIC ("    IF nextSegmentSize - firstSegment->GetSize () <= 2 || txonBuffer.size == 0");
+          NS_LOG_LOGIC ("    IF nextSegmentSize - firstSegment->GetSize () <= 2 || txonBuffer.size == 1");
+        }
+      else
+        {
+          NS_LOG_LOGIC ("    IF firstSegment < NextSegmentSize && txonBuffer.size > 1");
+          lastSegment = false;
+        }
 
-          // Add txBuffer.FirstBuffer to DataField
-          dataFieldAddedSize = firstSegment->GetSize ();
-          dataFieldTotalSize += dataFieldAddedSize;
-          dataField.push_back (firstSegment);
-          firstSegment = 0;
+      // Add the segment to the Data field
+      if (dataField.empty ())
+        {
+          firstByte = (firstSdu.m_offset == 0);
+          firstSegmentIsSdu = (currSegmentSize == sduSize);
+        }
+      if (currSegmentSize == sduSize)
+        {
+          dataField.push_back (firstSdu.m_pdu);
+        }
+      else
+        {
+          dataField.push_back (firstSdu.m_pdu->CreateFragment (firstSdu.m_offset, currSegmentSize));
+        }
+      firstSdu.m_offset += currSegmentSize;
+      m_txonBufferSize -= currSegmentSize;
+      lastByte = (firstSdu.m_offset == sduSize);
+      if (lastByte)
+        {
+          NS_LOG_LOGIC ("    Remove SDU from TxonBuffer");
+          m_txonBuffer.pop_front ();
+        }
+      NS_LOG_LOGIC ("    txonBufferSize = " << m_txonBufferSize);
 
+      if (lastSegment)
+        {
           // ExtensionBit (Next_Segment - 1) = 0
           rlcAmHeader.PushExtensionBit (LteRlcAmHeader::DATA_FIELD_FOLLOWS);
 
           // no LengthIndicator for the last one
 
-          nextSegmentSize -= dataFieldAddedSize;
-          nextSegmentId++;
-
-          NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txonBuffer.size ());
-          if (m_txonBuffer.size () > 0)
-            {
-              NS_LOG_LOGIC ("        First SDU buffer  = " << m_txonBuffer.begin ()->m_pdu);
-              NS_LOG_LOGIC ("        First SDU size    = " << m_txonBuffer.begin ()->m_pdu->GetSize ());
-            }
-          NS_LOG_LOGIC ("        Next segment size = " << nextSegmentSize);
-
-          // nextSegmentSize <= 2 (only if txBuffer is not empty)
-
-          // (NO more segments) ? exit
-          // break;
+          nextSegmentSize -= currSegmentSize;
+          break;
         }
-      else // (firstSegment->GetSize () < m_nextSegmentSize) && (m_txBuffer.size () > 0)
-        {
-          NS_LOG_LOGIC ("    IF firstSegment < NextSegmentSize && txonBuffer.size > 0");
-          // Add txBuffer.FirstBuffer to DataField
-          dataFieldAddedSize = firstSegment->GetSize ();
-          dataFieldTotalSize += dataFieldAddedSize;
-          dataField.push_back (firstSegment);
 
-          // ExtensionBit (Next_Segment - 1) = 1
-          rlcAmHeader.PushExtensionBit (LteRlcAmHeader::E_LI_FIELDS_FOLLOWS);
+      // ExtensionBit (Next_Segment - 1) = 1
+      rlcAmHeader.PushExtensionBit (LteRlcAmHeader::E_LI_FIELDS_FOLLOWS);
 
-          // LengthIndicator (Next_Segment)  = txBuffer.FirstBuffer.length()
-          rlcAmHeader.PushLengthIndicator (firstSegment->GetSize ());
-
-          nextSegmentSize -= ((nextSegmentId % 2) ? (2) : (1)) + dataFieldAddedSize;
-          nextSegmentId++;
-
-          NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txonBuffer.size ());
-          if (m_txonBuffer.size () > 0)
-            {
-              NS_LOG_LOGIC ("        First SDU buffer  = " << m_txonBuffer.begin ()->m_pdu);
-              NS_LOG_LOGIC ("        First SDU size    = " << m_txonBuffer.begin ()->m_pdu->GetSize ());
-            }
-          NS_LOG_LOGIC ("        Next segment size = " << nextSegmentSize);
-          NS_LOG_LOGIC ("        Remove SDU from TxBuffer");
-
-          // (more segments)
-          firstSegment = m_txonBuffer.begin ()->m_pdu->Copy ();
-          firstSegmentTime = m_txonBuffer.begin ()->m_waitingSince;
-          m_txonBufferSize -= m_txonBuffer.begin ()->m_pdu->GetSize ();
-          m_txonBuffer.erase (m_txonBuffer.begin ());
-          NS_LOG_LOGIC ("        txBufferSize = " << m_txonBufferSize );
-        }
+      // LengthIndicator (Next_Segment)  = txBuffer.FirstBuffer.length()
+      rlcAmHeader.PushLengthIndicator (currSegmentSize);
 
+      nextSegmentSize -= ((nextSegmentId % 2) ? (2) : (1)) + currSegmentSize;
+      nextSegmentId++;
     }
 
   //
@@ -638,52 +541,19 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
 
   // Calculate FramingInfo flag according the status of the SDUs in the DataField
   uint8_t framingInfo = 0;
-  std::vector< Ptr<Packet> >::iterator it;
-  it = dataField.begin ();
-
-  // FIRST SEGMENT
-  LteRlcSduStatusTag tag;
-  NS_ASSERT_MSG ((*it)->PeekPacketTag (tag), "LteRlcSduStatusTag is missing");
-  (*it)->PeekPacketTag (tag);
-  if ( (tag.GetStatus () == LteRlcSduStatusTag::FULL_SDU) ||
-       (tag.GetStatus () == LteRlcSduStatusTag::FIRST_SEGMENT)
-     )
-    {
-      framingInfo |= LteRlcAmHeader::FIRST_BYTE;
-    }
-  else
-    {
-      framingInfo |= LteRlcAmHeader::NO_FIRST_BYTE;
-    }
+  framingInfo |= firstByte ? LteRlcAmHeader::FIRST_BYTE : LteRlcAmHeader::NO_FIRST_BYTE;
+  // LAST SEGMENT (Note: There could be only one and be the first one)
+  framingInfo |= lastByte ? LteRlcAmHeader::LAST_BYTE : LteRlcAmHeader::NO_LAST_BYTE;
 
   // Add all SDUs (in DataField) to the Packet
-  while (it < dataField.end ())
+  // A full SDU is still referenced by the upper layers, so it is copied
+  // before the other segments and the header are added to it
+  std::vector< Ptr<Packet> >::iterator it = dataField.begin ();
+  Ptr<Packet> packet = firstSegmentIsSdu ? (*it)->Copy () : *it;
+  for (++it; it != dataField.end (); ++it)
     {
       NS_LOG_LOGIC ("Adding SDU/segment to packet, length = " << (*it)->GetSize ());
-
-      NS_ASSERT_MSG ((*it)->PeekPacketTag (tag), "LteRlcSduStatusTag is missing");
-      (*it)->RemovePacketTag (tag);
-      if (packet->GetSize () > 0)
-        {
-          packet->AddAtEnd (*it);
-        }
-      else
-        {
-          packet = (*it);
-        }
-      it++;
-    }
-
-  // LAST SEGMENT (Note: There could be only one and be the first one)
-  it--;
-  if ( (tag.GetStatus () == LteRlcSduStatusTag::FULL_SDU) ||
-        (tag.GetStatus () == LteRlcSduStatusTag::LAST_SEGMENT) )
-    {
-      framingInfo |= LteRlcAmHeader::LAST_BYTE;
-    }
-  else
-    {
-      framingInfo |= LteRlcAmHeader::NO_LAST_BYTE;
+      packet->AddAtEnd (*it);
     }
 
   // Set the FramingInfo flag after the calculation
@@ -901,18 +771,18 @@ LteRlcAm::DoReceivePdu (LteMacSapUser::ReceivePduParameters rxPduParams)
           //         - discard the duplicate byte segments.
           // note: re-segmentation of AMD PDU is currently not supported, 
           // so we just check that the segment was not received before
-          std::map <uint16_t, PduBuffer>::iterator it = m_rxonBuffer.find (seqNumber.GetValue ());
-          if (it != m_rxonBuffer.end () )
+          PduBuffer &pdu = m_rxonBuffer[seqNumber.GetValue ()];
+          if (pdu.m_pduComplete)
             {
-              NS_ASSERT (it->second.m_byteSegments.size () > 0);
-              NS_ASSERT_MSG (it->second.m_byteSegments.size () == 1, "re-segmentation not supported");
+              NS_ASSERT (pdu.m_byteSegments.size () > 0);
+              NS_ASSERT_MSG (pdu.m_byteSegments.size () == 1, "re-segmentation not supported");
               NS_LOG_LOGIC ("PDU segment already received, discarded");
             }
           else
             {
               NS_LOG_LOGIC ("Place PDU in the reception buffer ( SN = " << seqNumber << " )");
-              m_rxonBuffer[ seqNumber.GetValue () ].m_byteSegments.push_back (rxPduParams.p);
-              m_rxonBuffer[ seqNumber.GetValue () ].m_pduComplete = true;
+              pdu.m_byteSegments.push_back (rxPduParams.p);
+              pdu.m_pduComplete = true;
             }
 
 
@@ -935,16 +805,12 @@ LteRlcAm::DoReceivePdu (LteMacSapUser::ReceivePduParameters rxPduParams)
       //     - update VR(MS) to the SN of the first AMD PDU with SN > current VR(MS) for
       //       which not all byte segments have been received;
 
-      std::map <uint16_t, PduBuffer>::iterator it = m_rxonBuffer.find (m_vrMs.GetValue ());
-      if ( it != m_rxonBuffer.end () &&
-           it->second.m_pduComplete )
+      if ( m_rxonBuffer[m_vrMs.GetValue ()].m_pduComplete )
         {
           int firstVrMs = m_vrMs.GetValue ();
-          while ( it != m_rxonBuffer.end () &&
-                  it->second.m_pduComplete )
+          while ( m_rxonBuffer[m_vrMs.GetValue ()].m_pduComplete )
             {
               m_vrMs++;
-              it = m_rxonBuffer.find (m_vrMs.GetValue ());
               NS_LOG_LOGIC ("Incr VR(MS) = " << m_vrMs);
 
               NS_ASSERT_MSG (firstVrMs != m_vrMs.GetValue (), "Infinite loop in RxonBuffer");
@@ -960,27 +826,24 @@ LteRlcAm::DoReceivePdu (LteMacSapUser::ReceivePduParameters rxPduParams)
 
       if ( seqNumber == m_vrR )
         {
-          std::map <uint16_t, PduBuffer>::iterator it = m_rxonBuffer.find (seqNumber.GetValue ());
-          if ( it != m_rxonBuffer.end () &&
-               it->second.m_pduComplete )
+          if ( m_rxonBuffer[seqNumber.GetValue ()].m_pduComplete )
             {
-              it = m_rxonBuffer.find (m_vrR.GetValue ());
               int firstVrR = m_vrR.GetValue ();
-              while ( it != m_rxonBuffer.end () &&
-                      it->second.m_pduComplete )
+              while ( m_rxonBuffer[m_vrR.GetValue ()].m_pduComplete )
                 {
+                  PduBuffer &pdu = m_rxonBuffer[m_vrR.GetValue ()];
                   NS_LOG_LOGIC ("Reassemble and Deliver ( SN = " << m_vrR << " )");
-                  NS_ASSERT_MSG (it->second.m_byteSegments.size () == 1,
+                  NS_ASSERT_MSG (pdu.m_byteSegments.size () == 1,
                                 "Too many segments. PDU Reassembly process didn't work");
-                  ReassembleAndDeliver (it->second.m_byteSegments.front ());
-                  m_rxonBuffer.erase (m_vrR.GetValue ());
+                  ReassembleAndDeliver (pdu.m_byteSegments.front ());
+                  pdu.m_byteSegments.clear ();
+                  pdu.m_pduComplete = false;
 
                   m_vrR++;
                   m_vrR.SetModulusBase (m_vrR);
                   m_vrX.SetModulusBase (m_vrR);
                   m_vrMs.SetModulusBase (m_vrR);
                   m_vrH.SetModulusBase (m_vrR);
-                  it = m_rxonBuffer.find (m_vrR.GetValue ());
 
                   NS_ASSERT_MSG (firstVrR != m_vrR.GetValue (), "Infinite loop in RxonBuffer");
                 }
@@ -1673,12 +1536,9 @@ LteRlcAm::ExpireReorderingTimer (void)
 
   m_vrMs = m_vrX;
   int firstVrMs = m_vrMs.GetValue ();
-  std::map <uint16_t, PduBuffer>::iterator it = m_rxonBuffer.find (m_vrMs.GetValue ());
-  while ( it != m_rxonBuffer.end () &&
-          it->second.m_pduComplete )
+  while ( m_rxonBuffer[m_vrMs.GetValue ()].m_pduComplete )
     {
       m_vrMs++;
-      it = m_rxonBuffer.find (m_vrMs.GetValue ());
 
       NS_ASSERT_MSG (firstVrMs != m_vrMs.GetValue (), "Infinite loop in ExpireReorderingTimer");
     }
@@ -25,8 +25,9 @@
 #include <ns3/lte-rlc-sequence-number.h>
 #include <ns3/lte-rlc.h>
 
+#include <deque>
+#include <list>
 #include <vector>
-#include <map>
 
 namespace ns3 {
 
@@ -119,16 +120,18 @@ private:
      */
     TxPdu (const Ptr<Packet> &pdu, const Time &time) :
       m_pdu (pdu),
-      m_waitingSince (time)
+      m_waitingSince (time),
+      m_offset (0)
     { }
 
     TxPdu () = delete;
 
     Ptr<Packet> m_pdu;           ///< PDU
     Time        m_waitingSince;  ///< Layer arrival time
+    uint32_t    m_offset;        ///< Number of bytes of the PDU already transmitted
   };
 
-  std::vector < TxPdu > m_txonBuffer; ///< Transmission buffer
+  std::deque < TxPdu > m_txonBuffer; ///< Transmission buffer
 
   /// RetxPdu structure
   struct RetxPdu
@@ -154,13 +157,15 @@ private:
     /// PduBuffer structure
     struct PduBuffer
     {
+      PduBuffer () : m_pduComplete (false) { }
+
       SequenceNumber10  m_seqNumber; ///< sequence number
       std::list < Ptr<Packet> >  m_byteSegments; ///< byte segments
 
       bool      m_pduComplete; ///< PDU complete?
     };
 
-    std::map <uint16_t, PduBuffer > m_rxonBuffer; ///< Reception buffer
+    std::vector <PduBuffer> m_rxonBuffer; ///< Reception buffer, indexed by SN
 
     Ptr<Packet> m_controlPduBuffer;               ///< Control PDU buffer (just one PDU)
 
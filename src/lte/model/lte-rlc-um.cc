@@ -23,7 +23,6 @@
 
 #include "ns3/lte-rlc-header.h"
 #include "ns3/lte-rlc-um.h"
-#include "ns3/lte-rlc-sdu-status-tag.h"
 #include "ns3/lte-rlc-tag.h"
 
 namespace ns3 {
@@ -43,6 +42,7 @@ LteRlcUm::LteRlcUm ()
     m_expectedSeqNumber (0)
 {
   NS_LOG_FUNCTION (this);
+  m_rxBuffer.resize (1024);
   m_reassemblingState = WAITING_S0_FULL;
 }
 
@@ -94,10 +94,6 @@ LteRlcUm::DoTransmitPdcpPdu (Ptr<Packet> p)
   if (m_txBufferSize + p->GetSize () <= m_maxTxBufferSize)
     {
       /** Store PDCP PDU */
-      LteRlcSduStatusTag tag;
-      tag.SetStatus (LteRlcSduStatusTag::FULL_SDU);
-      p->AddPacketTag (tag);
-
       NS_LOG_LOGIC ("Tx Buffer: New packet added");
       m_txBuffer.push_back (TxPdu (p, Simulator::Now ()));
       m_txBufferSize += p->GetSize ();
@@ -136,245 +132,123 @@ LteRlcUm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
       return;
     }
 
-  Ptr<Packet> packet = Create<Packet> ();
   LteRlcHeader rlcHeader;
 
   // Build Data field
   uint32_t nextSegmentSize = txOpParams.bytes - 2;
   uint32_t nextSegmentId = 1;
-  uint32_t dataFieldTotalSize = 0;
-  uint32_t dataFieldAddedSize = 0;
   std::vector < Ptr<Packet> > dataField;
+  bool firstSegmentIsSdu = false;   // whether the first segment is a full SDU, shared with the buffer
+  bool firstByte = false;           // whether the data field starts with the first byte of a SDU
+  bool lastByte = false;            // whether the data field ends with the last byte of a SDU
 
-  // Remove the first packet from the transmission buffer.
-  // If only a segment of the packet is taken, then the remaining is given back later
-  if ( m_txBuffer.size () == 0 )
+  if ( m_txBuffer.empty () )
     {
       NS_LOG_LOGIC ("No data pending");
       return;
     }
 
-  Ptr<Packet> firstSegment = m_txBuffer.begin ()->m_pdu->Copy ();
-  Time firstSegmentTime = m_txBuffer.begin ()->m_waitingSince;
-
   NS_LOG_LOGIC ("SDUs in TxBuffer  = " << m_txBuffer.size ());
-  NS_LOG_LOGIC ("First SDU buffer  = " << firstSegment);
-  NS_LOG_LOGIC ("First SDU size    = " << firstSegment->GetSize ());
   NS_LOG_LOGIC ("Next segment size = " << nextSegmentSize);
-  NS_LOG_LOGIC ("Remove SDU from TxBuffer");
-  m_txBufferSize -= firstSegment->GetSize ();
-  NS_LOG_LOGIC ("txBufferSize      = " << m_txBufferSize );
-  m_txBuffer.erase (m_txBuffer.begin ());
 
-  while ( firstSegment && (firstSegment->GetSize () > 0) && (nextSegmentSize > 0) )
+  // The segments are taken from the SDUs at the front of the transmission
+  // buffer: a SDU taken in full is used as is, and a segment is a fragment
+  // of its SDU. A SDU stays in the buffer until its last byte is taken.
+  while ( !m_txBuffer.empty () && (nextSegmentSize > 0) )
     {
-      NS_LOG_LOGIC ("WHILE ( firstSegment && firstSegment->GetSize > 0 && nextSegmentSize > 0 )");
-      NS_LOG_LOGIC ("    firstSegment size = " << firstSegment->GetSize ());
+      TxPdu &firstSdu = m_txBuffer.front ();
+      uint32_t sduSize = firstSdu.m_pdu->GetSize ();
+      uint32_t firstSegmentSize = sduSize - firstSdu.m_offset;
+      NS_LOG_LOGIC ("    firstSegment size = " << firstSegmentSize);
       NS_LOG_LOGIC ("    nextSegmentSize   = " << nextSegmentSize);
-      if ( (firstSegment->GetSize () > nextSegmentSize) ||
+
+      uint32_t currSegmentSize = firstSegmentSize;
+      bool lastSegment = true;
+      if ( (firstSegmentSize > nextSegmentSize) ||
            // Segment larger than 2047 octets can only be mapped to the end of the Data field
-           (firstSegment->GetSize () > 2047)
+           (firstSegmentSize > 2047)
          )
         {
           // Take the minimum size, due to the 2047-bytes 3GPP exception
           // This exception is due to the length of the LI field (just 11 bits)
-          uint32_t currSegmentSize = std::min (firstSegment->GetSize (), nextSegmentSize);
-
+          currSegmentSize = std::min (firstSegmentSize, nextSegmentSize);
           NS_LOG_LOGIC ("    IF ( firstSegment > nextSegmentSize ||");
           NS_LOG_LOGIC ("         firstSegment > 2047 )");
+        }
+      else if ( (nextSegmentSize - firstSegmentSize <= 2) || (m_txBuffer.size () == 1) )
+        {
+          NS_LOG_LOGIC ("    IF nextSegmentSize - firstSegment->GetSize () <= 2 || txBuffer.size == 1");
+        }
+      else
+        {
+          NS_LOG_LOGIC ("    IF firstSegment < NextSegmentSize && txBuffer.size > 1");
+          lastSegment = false;
+        }
 
-          // Segment txBuffer.FirstBuffer and
-          // Give back the remaining segment to the transmission buffer
-          Ptr<Packet> newSegment = firstSegment->CreateFragment (0, currSegmentSize);
-          NS_LOG_LOGIC ("    newSegment size   = " << newSegment->GetSize ());
-
-          // Status tag of the new and remaining segments
-          // Note: This is the only place where a PDU is segmented and
-          // therefore its status can change
-          LteRlcSduStatusTag oldTag, newTag;
-          firstSegment->RemovePacketTag (oldTag);
-          newSegment->RemovePacketTag (newTag);
-          if (oldTag.GetStatus () == LteRlcSduStatusTag::FULL_SDU)
-            {
-              newTag.SetStatus (LteRlcSduStatusTag::FIRST_SEGMENT);
-              oldTag.SetStatus (LteRlcSduStatusTag::LAST_SEGMENT);
-            }
-          else if (oldTag.GetStatus () == LteRlcSduStatusTag::LAST_SEGMENT)
-            {
-              newTag.SetStatus (LteRlcSduStatusTag::MIDDLE_SEGMENT);
-              //oldTag.SetStatus (LteRlcSduStatusTag::LAST_SEGMENT);
-            }
-
-          // Give back the remaining segment to the transmission buffer
-          firstSegment->RemoveAtStart (currSegmentSize);
-          NS_LOG_LOGIC ("    firstSegment size (after RemoveAtStart) = " << firstSegment->GetSize ());
-          if (firstSegment->GetSize () > 0)
-            {
-              firstSegment->AddPacketTag (oldTag);
-
-              m_txBuffer.insert (m_txBuffer.begin (), TxPdu (firstSegment, firstSegmentTime));
-              m_txBufferSize += m_txBuffer.begin()->m_pdu->GetSize ();
-
-              NS_LOG_LOGIC ("    TX buffer: Give back the remaining segment");
-              NS_LOG_LOGIC ("    TX buffers = " << m_txBuffer.size ());
-              NS_LOG_LOGIC ("    Front buffer size = " << m_txBuffer.begin()->m_pdu->GetSize ());
-              NS_LOG_LOGIC ("    txBufferSize = " << m_txBufferSize );
-            }
-          else
-            {
-              // Whole segment was taken, so adjust tag
-              if (newTag.GetStatus () == LteRlcSduStatusTag::FIRST_SEGMENT)
-                {
-                  newTag.SetStatus (LteRlcSduStatusTag::FULL_SDU);
-                }
-              else if (newTag.GetStatus () == LteRlcSduStatusTag::MIDDLE_SEGMENT)
-                {
-                  newTag.SetStatus (LteRlcSduStatusTag::LAST_SEGMENT);
-                }
-            }
-          // Segment is completely taken or
-          // the remaining segment is given back to the transmission buffer
-          firstSegment = 0;
-
-          // Put status tag once it has been adjusted
-          newSegment->AddPacketTag (newTag);
-
-          // Add Segment to Data field
-          dataFieldAddedSize = newSegment->GetSize ();
-          dataFieldTotalSize += dataFieldAddedSize;
-          dataField.push_back (newSegment);
-          newSegment = 0;
-
-          // ExtensionBit (Next_Segment - 1) = 0
-          rlcHeader.PushExtensionBit (LteRlcHeader::DATA_FIELD_FOLLOWS);
-
-          // no LengthIndicator for the last one
-
-          nextSegmentSize -= dataFieldAddedSize;
-          nextSegmentId++;
-
-          // nextSegmentSize MUST be zero (only if segment is smaller or equal to 2047)
-
-          // (NO more segments) → exit
-          // break;
+      // Add the segment to the Data field
+      if (dataField.empty ())
+        {
+          firstByte = (firstSdu.m_offset == 0);
+          firstSegmentIsSdu = (currSegmentSize == sduSize);
+        }
+      if (currSegmentSize == sduSize)
+        {
+          dataField.push_back (firstSdu.m_pdu);
+        }
+      else
+        {
+          dataField.push_back (firstSdu.m_pdu->CreateFragment (firstSdu.m_offset, currSegmentSize));
         }
-      else if ( (nextSegmentSize - firstSegment->GetSize () <= 2) || (m_txBuffer.size () == 0) )
+      firstSdu.m_offset += currSegmentSize;
+      m_txBufferSize -= currSegmentSize;
+      lastByte = (firstSdu.m_offset == sduSize);
+      if (lastByte)
         {
-          NS_LOG_LOGIC ("    IF nextSegmentSize - firstSegment->GetSize () <= 2 || txBuffer.size == 0");
-          // Add txBuffer.FirstBuffer to DataField
-          dataFieldAddedSize = firstSegment->GetSize ();
-          dataFieldTotalSize += dataFieldAddedSize;
-          dataField.push_back (firstSegment);
-          firstSegment = 0;
+          NS_LOG_LOGIC ("    Remove SDU from TxBuffer");
+          m_txBuffer.pop_front ();
+        }
+      NS_LOG_LOGIC ("    txBufferSize = " << m_txBufferSize);
 
+      if (lastSegment)
+        {
           // ExtensionBit (Next_Segment - 1) = 0
           rlcHeader.PushExtensionBit (LteRlcHeader::DATA_FIELD_FOLLOWS);
 
           // no LengthIndicator for the last one
 
-          nextSegmentSize -= dataFieldAddedSize;
-          nextSegmentId++;
-
-          NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txBuffer.size ());
-          if (m_txBuffer.size () > 0)
-            {
-              NS_LOG_LOGIC ("        First SDU buffer  = " << m_txBuffer.begin()->m_pdu);
-              NS_LOG_LOGIC ("        First SDU size    = " << m_txBuffer.begin()->m_pdu->GetSize ());
-            }
-          NS_LOG_LOGIC ("        Next segment size = " << nextSegmentSize);
-
-          // nextSegmentSize <= 2 (only if txBuffer is not empty)
-
-          // (NO more segments) → exit
-          // break;
+          nextSegmentSize -= currSegmentSize;
+          break;
         }
-      else // (firstSegment->GetSize () < m_nextSegmentSize) && (m_txBuffer.size () > 0)
-        {
-          NS_LOG_LOGIC ("    IF firstSegment < NextSegmentSize && txBuffer.size > 0");
-          // Add txBuffer.FirstBuffer to DataField
-          dataFieldAddedSize = firstSegment->GetSize ();
-          dataFieldTotalSize += dataFieldAddedSize;
-          dataField.push_back (firstSegment);
 
-          // ExtensionBit (Next_Segment - 1) = 1
-          rlcHeader.PushExtensionBit (LteRlcHeader::E_LI_FIELDS_FOLLOWS);
+      // ExtensionBit (Next_Segment - 1) = 1
+      rlcHeader.PushExtensionBit (LteRlcHeader::E_LI_FIELDS_FOLLOWS);
 
-          // LengthIndicator (Next_Segment)  = txBuffer.FirstBuffer.length()
-          rlcHeader.PushLengthIndicator (firstSegment->GetSize ());
-
-          nextSegmentSize -= ((nextSegmentId % 2) ? (2) : (1)) + dataFieldAddedSize;
-          nextSegmentId++;
-
-          NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txBuffer.size ());
-          if (m_txBuffer.size () > 0)
-            {
-              NS_LOG_LOGIC ("        First SDU buffer  = " << m_txBuffer.begin()->m_pdu);
-              NS_LOG_LOGIC ("        First SDU size    = " << m_txBuffer.begin()->m_pdu->GetSize ());
-            }
-          NS_LOG_LOGIC ("        Next segment size = " << nextSegmentSize);
-          NS_LOG_LOGIC ("        Remove SDU from TxBuffer");
-
-          // (more segments)
-          firstSegment = m_txBuffer.begin ()->m_pdu->Copy ();
-          firstSegmentTime = m_txBuffer.begin ()->m_waitingSince;
-          m_txBufferSize -= firstSegment->GetSize ();
-          m_txBuffer.erase (m_txBuffer.begin ());
-          NS_LOG_LOGIC ("        txBufferSize = " << m_txBufferSize );
-        }
+      // LengthIndicator (Next_Segment)  = txBuffer.FirstBuffer.length()
+      rlcHeader.PushLengthIndicator (currSegmentSize);
 
+      nextSegmentSize -= ((nextSegmentId % 2) ? (2) : (1)) + currSegmentSize;
+      nextSegmentId++;
     }
 
   // Build RLC header
   rlcHeader.SetSequenceNumber (m_sequenceNumber++);
 
   // Build RLC PDU with DataField and Header
-  std::vector< Ptr<Packet> >::iterator it;
-  it = dataField.begin ();
+  std::vector< Ptr<Packet> >::iterator it = dataField.begin ();
 
-  uint8_t framingInfo = 0;
-
-  // FIRST SEGMENT
-  LteRlcSduStatusTag tag;
-  NS_ASSERT_MSG ((*it)->PeekPacketTag (tag), "LteRlcSduStatusTag is missing");
-  (*it)->PeekPacketTag (tag);
-  if ( (tag.GetStatus () == LteRlcSduStatusTag::FULL_SDU) ||
-        (tag.GetStatus () == LteRlcSduStatusTag::FIRST_SEGMENT) )
-    {
-      framingInfo |= LteRlcHeader::FIRST_BYTE;
-    }
-  else
-    {
-      framingInfo |= LteRlcHeader::NO_FIRST_BYTE;
-    }
-
-  while (it < dataField.end ())
+  // A full SDU is still referenced by the upper layers, so it is copied
+  // before the other segments and the header are added to it
+  Ptr<Packet> packet = firstSegmentIsSdu ? (*it)->Copy () : *it;
+  for (++it; it != dataField.end (); ++it)
     {
       NS_LOG_LOGIC ("Adding SDU/segment to packet, length = " << (*it)->GetSize ());
-
-      NS_ASSERT_MSG ((*it)->PeekPacketTag (tag), "LteRlcSduStatusTag is missing");
-      (*it)->RemovePacketTag (tag);
-      if (packet->GetSize () > 0)
-        {
-          packet->AddAtEnd (*it);
-        }
-      else
-        {
-          packet = (*it);
-        }
-      it++;
+      packet->AddAtEnd (*it);
     }
 
+  uint8_t framingInfo = 0;
+  framingInfo |= firstByte ? LteRlcHeader::FIRST_BYTE : LteRlcHeader::NO_FIRST_BYTE;
   // LAST SEGMENT (Note: There could be only one and be the first one)
-  it--;
-  if ( (tag.GetStatus () == LteRlcSduStatusTag::FULL_SDU) ||
-        (tag.GetStatus () == LteRlcSduStatusTag::LAST_SEGMENT) )
-    {
-      framingInfo |= LteRlcHeader::LAST_BYTE;
-    }
-  else
-    {
-      framingInfo |= LteRlcHeader::NO_LAST_BYTE;
-    }
+  framingInfo |= lastByte ? LteRlcHeader::LAST_BYTE : LteRlcHeader::NO_LAST_BYTE;
 
   rlcHeader.SetFramingInfo (framingInfo);
 
@@ -461,7 +335,7 @@ LteRlcUm::DoReceivePdu (LteMacSapUser::ReceivePduParameters rxPduParams)
   m_vrUh.SetModulusBase (m_vrUh - m_windowSize);
   seqNumber.SetModulusBase (m_vrUh - m_windowSize);
 
-  if ( ( (m_vrUr < seqNumber) && (seqNumber < m_vrUh) && (m_rxBuffer.count (seqNumber.GetValue ()) > 0) ) ||
+  if ( ( (m_vrUr < seqNumber) && (seqNumber < m_vrUh) && m_rxBuffer[seqNumber.GetValue ()] ) ||
        ( ((m_vrUh - m_windowSize) <= seqNumber) && (seqNumber < m_vrUr) )
      )
     {
@@ -510,17 +384,14 @@ LteRlcUm::DoReceivePdu (LteMacSapUser::ReceivePduParameters rxPduParams)
   //      so and deliver the reassembled RLC SDUs to upper layer in ascending order of the RLC SN if not delivered
   //      before;
 
-  if ( m_rxBuffer.count (m_vrUr.GetValue ()) > 0 )
+  if ( m_rxBuffer[m_vrUr.GetValue ()] )
     {
       NS_LOG_LOGIC ("Reception buffer contains SN = " << m_vrUr);
 
-      std::map <uint16_t, Ptr<Packet> >::iterator it;
-      uint16_t newVrUr;
       SequenceNumber10 oldVrUr = m_vrUr;
-
-      it = m_rxBuffer.find (m_vrUr.GetValue ());
-      newVrUr = (it->first) + 1;
-      while ( m_rxBuffer.count (newVrUr) > 0 )
+      SequenceNumber10 newVrUr = m_vrUr;
+      newVrUr++;
+      while ( m_rxBuffer[newVrUr.GetValue ()] )
         {
           newVrUr++;
         }
@@ -1069,24 +940,20 @@ LteRlcUm::ReassembleOutsideWindow (void)
 {
   NS_LOG_LOGIC ("Reassemble Outside Window");
 
-  std::map <uint16_t, Ptr<Packet> >::iterator it;
-  it = m_rxBuffer.begin ();
-
-  while ( (it != m_rxBuffer.end ()) && ! IsInsideReorderingWindow (SequenceNumber10 (it->first)) )
+  // The received PDUs not yet delivered have a SN >= VR(UR), so the ones
+  // outside of the window are the ones from VR(UR) to the window
+  for (SequenceNumber10 sn = m_vrUr; ! IsInsideReorderingWindow (sn); sn++)
     {
-      NS_LOG_LOGIC ("SN = " << it->first);
-
-      // Reassemble RLC SDUs and deliver the PDCP PDU to upper layer
-      ReassembleAndDeliver (it->second);
+      Ptr<Packet> &pdu = m_rxBuffer[sn.GetValue ()];
+      if (pdu)
+        {
+          NS_LOG_LOGIC ("SN = " << sn);
 
-      std::map <uint16_t, Ptr<Packet> >::iterator it_tmp = it;
-      ++it;
-      m_rxBuffer.erase (it_tmp);
-    }
+          // Reassemble RLC SDUs and deliver the PDCP PDU to upper layer
+          ReassembleAndDeliver (pdu);
 
-  if (it != m_rxBuffer.end ())
-    {
-      NS_LOG_LOGIC ("(SN = " << it->first << ") is inside the reordering window");
+          pdu = 0;
+        }
     }
 }
 
@@ -1095,25 +962,21 @@ LteRlcUm::ReassembleSnInterval (SequenceNumber10 lowSeqNumber, SequenceNumber10
 {
   NS_LOG_LOGIC ("Reassemble SN between " << lowSeqNumber << " and " << highSeqNumber);
 
-  std::map <uint16_t, Ptr<Packet> >::iterator it;
-
   SequenceNumber10 reassembleSn = lowSeqNumber;
   NS_LOG_LOGIC ("reassembleSN = " << reassembleSn);
   NS_LOG_LOGIC ("highSeqNumber = " << highSeqNumber);
   while (reassembleSn < highSeqNumber)
     {
       NS_LOG_LOGIC ("reassembleSn < highSeqNumber");
-      it = m_rxBuffer.find (reassembleSn.GetValue ());
-      NS_LOG_LOGIC ("it->first  = " << it->first);
-      NS_LOG_LOGIC ("it->second = " << it->second);
-      if (it != m_rxBuffer.end () )
+      Ptr<Packet> &pdu = m_rxBuffer[reassembleSn.GetValue ()];
+      if (pdu)
         {
-          NS_LOG_LOGIC ("SN = " << it->first);
+          NS_LOG_LOGIC ("SN = " << reassembleSn);
 
           // Reassemble RLC SDUs and deliver the PDCP PDU to upper layer
-          ReassembleAndDeliver (it->second);
+          ReassembleAndDeliver (pdu);
 
-          m_rxBuffer.erase (it);
+          pdu = 0;
         }
         
       reassembleSn++;
@@ -1163,10 +1026,9 @@ LteRlcUm::ExpireReorderingTimer (void)
   //    - start t-Reordering;
   //    - set VR(UX) to VR(UH).
 
-  std::map <uint16_t, Ptr<Packet> >::iterator it;
   SequenceNumber10 newVrUr = m_vrUx;
 
-  while ( (it = m_rxBuffer.find (newVrUr.GetValue ())) != m_rxBuffer.end () )
+  while ( m_rxBuffer[newVrUr.GetValue ()] )
     {
       newVrUr++;
     }
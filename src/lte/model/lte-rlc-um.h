@@ -25,7 +25,9 @@
 #include "ns3/lte-rlc.h"
 
 #include <ns3/event-id.h>
-#include <map>
+#include <deque>
+#include <list>
+#include <vector>
 
 namespace ns3 {
 
@@ -109,17 +111,19 @@ private:
      */
     TxPdu (const Ptr<Packet> &pdu, const Time &time) :
       m_pdu (pdu),
-      m_waitingSince (time)
+      m_waitingSince (time),
+      m_offset (0)
     { }
 
     TxPdu () = delete;
 
     Ptr<Packet> m_pdu;           ///< PDU
     Time        m_waitingSince;  ///< Layer arrival time
+    uint32_t    m_offset;        ///< Number of bytes of the PDU already transmitted
   };
 
-  std::vector < TxPdu > m_txBuffer; ///< Transmission buffer
-  std::map <uint16_t, Ptr<Packet> > m_rxBuffer; ///< Reception buffer
+  std::deque < TxPdu > m_txBuffer; ///< Transmission buffer
+  std::vector < Ptr<Packet> > m_rxBuffer;       ///< Reception buffer, indexed by SN
   std::vector < Ptr<Packet> > m_reasBuffer;     ///< Reassembling buffer
 
   std::list < Ptr<Packet> > m_sdusBuffer;       ///< List of SDUs in a packet
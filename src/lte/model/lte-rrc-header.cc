@@ -110,13 +110,13 @@ RrcAsn1Header::EnumToBandwidth (int n) const
 }
 
 void
-RrcAsn1Header::SerializeDrbToAddModList (std::list<LteRrcSap::DrbToAddMod> drbToAddModList) const
+RrcAsn1Header::SerializeDrbToAddModList (const std::list<LteRrcSap::DrbToAddMod> &drbToAddModList) const
 {
   // Serialize DRB-ToAddModList sequence-of
   SerializeSequenceOf (drbToAddModList.size (),MAX_DRB,1);
 
   // Serialize the elements in the sequence-of list
-  std::list<LteRrcSap::DrbToAddMod>::iterator it = drbToAddModList.begin ();
+  std::list<LteRrcSap::DrbToAddMod>::const_iterator it = drbToAddModList.begin ();
   for (; it != drbToAddModList.end (); it++)
     {
       // Serialize DRB-ToAddMod sequence
@@ -198,13 +198,13 @@ RrcAsn1Header::SerializeDrbToAddModList (std::list<LteRrcSap::DrbToAddMod> drbTo
 }
 
 void
-RrcAsn1Header::SerializeSrbToAddModList (std::list<LteRrcSap::SrbToAddMod> srbToAddModList) const
+RrcAsn1Header::SerializeSrbToAddModList (const std::list<LteRrcSap::SrbToAddMod> &srbToAddModList) const
 {
   // Serialize SRB-ToAddModList ::= SEQUENCE (SIZE (1..2)) OF SRB-ToAddMod
   SerializeSequenceOf (srbToAddModList.size (),2,1);
 
   // Serialize the elements in the sequence-of list
-  std::list<LteRrcSap::SrbToAddMod>::iterator it = srbToAddModList.begin ();
+  std::list<LteRrcSap::SrbToAddMod>::const_iterator it = srbToAddModList.begin ();
   for (; it != srbToAddModList.end (); it++)
     {
       // Serialize SRB-ToAddMod sequence
@@ -227,7 +227,7 @@ RrcAsn1Header::SerializeSrbToAddModList (std::list<LteRrcSap::SrbToAddMod> srbTo
 }
 
 void
-RrcAsn1Header::SerializeLogicalChannelConfig (LteRrcSap::LogicalChannelConfig logicalChannelConfig) const
+RrcAsn1Header::SerializeLogicalChannelConfig (const LteRrcSap::LogicalChannelConfig &logicalChannelConfig) const
 {
   // Serialize LogicalChannelConfig sequence
   // 1 optional field (ul-SpecificParameters), which is present. Extension marker present.
@@ -302,7 +302,7 @@ RrcAsn1Header::SerializeLogicalChannelConfig (LteRrcSap::LogicalChannelConfig lo
 }
 
 void
-RrcAsn1Header::SerializePhysicalConfigDedicated (LteRrcSap::PhysicalConfigDedicated physicalConfigDedicated) const
+RrcAsn1Header::SerializePhysicalConfigDedicated (const LteRrcSap::PhysicalConfigDedicated &physicalConfigDedicated) const
 {
   // Serialize PhysicalConfigDedicated Sequence
   std::bitset<10> optionalFieldsPhysicalConfigDedicated;
@@ -399,7 +399,7 @@ RrcAsn1Header::SerializePhysicalConfigDedicated (LteRrcSap::PhysicalConfigDedica
 }
 
 void
-RrcAsn1Header::SerializeRadioResourceConfigDedicated (LteRrcSap::RadioResourceConfigDedicated radioResourceConfigDedicated) const
+RrcAsn1Header::SerializeRadioResourceConfigDedicated (const LteRrcSap::RadioResourceConfigDedicated &radioResourceConfigDedicated) const
 {
   bool isSrbToAddModListPresent = !radioResourceConfigDedicated.srbToAddModList.empty ();
   bool isDrbToAddModListPresent = !radioResourceConfigDedicated.drbToAddModList.empty ();
@@ -431,7 +431,7 @@ RrcAsn1Header::SerializeRadioResourceConfigDedicated (LteRrcSap::RadioResourceCo
   if (isDrbToReleaseListPresent)
     {
       SerializeSequenceOf (radioResourceConfigDedicated.drbToReleaseList.size (),MAX_DRB,1);
-      std::list<uint8_t>::iterator it = radioResourceConfigDedicated.drbToReleaseList.begin ();
+      std::list<uint8_t>::const_iterator it = radioResourceConfigDedicated.drbToReleaseList.begin ();
       for (; it != radioResourceConfigDedicated.drbToReleaseList.end (); it++)
         {
           // DRB-Identity ::= INTEGER (1..32)
@@ -446,7 +446,7 @@ RrcAsn1Header::SerializeRadioResourceConfigDedicated (LteRrcSap::RadioResourceCo
 }
 
 void
-RrcAsn1Header::SerializeSystemInformationBlockType1 (LteRrcSap::SystemInformationBlockType1 systemInformationBlockType1) const
+RrcAsn1Header::SerializeSystemInformationBlockType1 (const LteRrcSap::SystemInformationBlockType1 &systemInformationBlockType1) const
 {
   // 3 optional fields, no extension marker.
   std::bitset<3> sysInfoBlk1Opts;
@@ -505,7 +505,7 @@ RrcAsn1Header::SerializeSystemInformationBlockType1 (LteRrcSap::SystemInformatio
 }
 
 void
-RrcAsn1Header::SerializeRadioResourceConfigCommon (LteRrcSap::RadioResourceConfigCommon radioResourceConfigCommon) const
+RrcAsn1Header::SerializeRadioResourceConfigCommon (const LteRrcSap::RadioResourceConfigCommon &radioResourceConfigCommon) const
 {
   // 9 optional fields. Extension marker yes.
   std::bitset<9> rrCfgCmmOpts;
@@ -556,7 +556,7 @@ RrcAsn1Header::SerializeRadioResourceConfigCommon (LteRrcSap::RadioResourceConfi
 }
 
 void
-RrcAsn1Header::SerializeRadioResourceConfigCommonSib (LteRrcSap::RadioResourceConfigCommonSib radioResourceConfigCommonSib) const
+RrcAsn1Header::SerializeRadioResourceConfigCommonSib (const LteRrcSap::RadioResourceConfigCommonSib &radioResourceConfigCommonSib) const
 {
   SerializeSequence (std::bitset<0> (0),true);
 
@@ -615,7 +615,7 @@ RrcAsn1Header::SerializeRadioResourceConfigCommonSib (LteRrcSap::RadioResourceCo
 }
 
 void
-RrcAsn1Header::SerializeSystemInformationBlockType2 (LteRrcSap::SystemInformationBlockType2 systemInformationBlockType2) const
+RrcAsn1Header::SerializeSystemInformationBlockType2 (const LteRrcSap::SystemInformationBlockType2 &systemInformationBlockType2) const
 {
   SerializeSequence (std::bitset<2> (0),true);
 
@@ -642,19 +642,17 @@ RrcAsn1Header::SerializeSystemInformationBlockType2 (LteRrcSap::SystemInformatio
 }
 
 void
-RrcAsn1Header::SerializeMeasResults (LteRrcSap::MeasResults measResults) const
+RrcAsn1Header::SerializeMeasResults (const LteRrcSap::MeasResults &measResults) const
 {
   // Watchdog: if list has 0 elements, set boolean to false
-  if (measResults.measResultListEutra.empty ())
-    {
-      measResults.haveMeasResultNeighCells = false;
-    }
+  bool haveMeasResultNeighCells = measResults.haveMeasResultNeighCells
+    && !measResults.measResultListEutra.empty ();
 
     std::bitset<4> measResultOptional;
     measResultOptional.set (3,  measResults.haveScellsMeas);
     measResultOptional.set (2, false); //LocationInfo-r10
     measResultOptional.set (1, false); // MeasResultForECID-r9
-    measResultOptional.set (0, measResults.haveMeasResultNeighCells);
+    measResultOptional.set (0, haveMeasResultNeighCells);
     SerializeSequence(measResultOptional,true);
 
   // Serialize measId
@@ -669,7 +667,7 @@ RrcAsn1Header::SerializeMeasResults (LteRrcSap::MeasResults measResults) const
   // Serialize rsrqResult
   SerializeInteger (measResults.rsrqResult,0,34);
 
-  if (measResults.haveMeasResultNeighCells)
+  if (haveMeasResultNeighCells)
     {
       // Serialize Choice = 0 (MeasResultListEUTRA)
       SerializeChoice (4,0,false);
@@ -678,7 +676,7 @@ RrcAsn1Header::SerializeMeasResults (LteRrcSap::MeasResults measResults) const
       SerializeSequenceOf (measResults.measResultListEutra.size (),MAX_CELL_REPORT,1);
 
       // serialize MeasResultEutra elements in the list
-      std::list<LteRrcSap::MeasResultEutra>::iterator it;
+      std::list<LteRrcSap::MeasResultEutra>::const_iterator it;
       for (it = measResults.measResultListEutra.begin (); it != measResults.measResultListEutra.end (); it++)
         {
           SerializeSequence (std::bitset<1> (it->haveCgiInfo),false);
@@ -703,7 +701,7 @@ RrcAsn1Header::SerializeMeasResults (LteRrcSap::MeasResults measResults) const
               if (!it->cgiInfo.plmnIdentityList.empty ())
                 {
                   SerializeSequenceOf (it->cgiInfo.plmnIdentityList.size (),5,1);
-                  std::list<uint32_t>::iterator it2;
+                  std::list<uint32_t>::const_iterator it2;
                   for (it2 = it->cgiInfo.plmnIdentityList.begin (); it2 != it->cgiInfo.plmnIdentityList.end (); it2++)
                     {
                       SerializePlmnIdentity (*it2);
@@ -733,7 +731,7 @@ RrcAsn1Header::SerializeMeasResults (LteRrcSap::MeasResults measResults) const
         // Serialize measResultNeighCells
         SerializeSequenceOf (measResults.measScellResultList.measResultScell.size (),MAX_SCELL_REPORT,1);
         // serialize MeasResultServFreqList-r10 elements in the list
-        std::list<LteRrcSap::MeasResultScell>::iterator it;
+        std::list<LteRrcSap::MeasResultScell>::const_iterator it;
         for (it = measResults.measScellResultList.measResultScell.begin (); it != measResults.measScellResultList.measResultScell.end (); it++)
           {
             // Serialize measId
@@ -786,7 +784,7 @@ RrcAsn1Header::SerializePlmnIdentity (uint32_t plmnId) const
 }
 
 void 
-RrcAsn1Header::SerializeRachConfigCommon (LteRrcSap::RachConfigCommon rachConfigCommon) const
+RrcAsn1Header::SerializeRachConfigCommon (const LteRrcSap::RachConfigCommon &rachConfigCommon) const
 {
   // rach-ConfigCommon
   SerializeSequence (std::bitset<0> (0),true);
@@ -1052,7 +1050,7 @@ RrcAsn1Header::SerializeQoffsetRange (int8_t qOffsetRange) const
 }
 
 void
-RrcAsn1Header::SerializeThresholdEutra (LteRrcSap::ThresholdEutra thresholdEutra) const
+RrcAsn1Header::SerializeThresholdEutra (const LteRrcSap::ThresholdEutra &thresholdEutra) const
 {
   switch (thresholdEutra.choice)
     {
@@ -1068,7 +1066,7 @@ RrcAsn1Header::SerializeThresholdEutra (LteRrcSap::ThresholdEutra thresholdEutra
 }
 
 void
-RrcAsn1Header::SerializeMeasConfig (LteRrcSap::MeasConfig measConfig) const
+RrcAsn1Header::SerializeMeasConfig (const LteRrcSap::MeasConfig &measConfig) const
 {
   // Serialize MeasConfig sequence
   // 11 optional fields, extension marker present
@@ -1089,7 +1087,7 @@ RrcAsn1Header::SerializeMeasConfig (LteRrcSap::MeasConfig measConfig) const
   if (!measConfig.measObjectToRemoveList.empty ())
     {
       SerializeSequenceOf (measConfig.measObjectToRemoveList.size (),MAX_OBJECT_ID,1);
-      for (std::list<uint8_t>::iterator it = measConfig.measObjectToRemoveList.begin (); it != measConfig.measObjectToRemoveList.end (); it++)
+      for (std::list<uint8_t>::const_iterator it = measConfig.measObjectToRemoveList.begin (); it != measConfig.measObjectToRemoveList.end (); it++)
         {
           SerializeInteger (*it, 1, MAX_OBJECT_ID);
         }
@@ -1098,7 +1096,7 @@ RrcAsn1Header::SerializeMeasConfig (LteRrcSap::MeasConfig measConfig) const
   if (!measConfig.measObjectToAddModList.empty ())
     {
       SerializeSequenceOf (measConfig.measObjectToAddModList.size (),MAX_OBJECT_ID,1);
-      for (std::list<LteRrcSap::MeasObjectToAddMod>::iterator it = measConfig.measObjectToAddModList.begin (); it != measConfig.measObjectToAddModList.end (); it++)
+      for (std::list<LteRrcSap::MeasObjectToAddMod>::const_iterator it = measConfig.measObjectToAddModList.begin (); it != measConfig.measObjectToAddModList.end (); it++)
         {
           SerializeSequence (std::bitset<0> (), false);
           SerializeInteger (it->measObjectId, 1, MAX_OBJECT_ID);
@@ -1126,7 +1124,7 @@ RrcAsn1Header::SerializeMeasConfig (LteRrcSap::MeasConfig measConfig) const
           if (!it->measObjectEutra.cellsToRemoveList.empty ())
             {
               SerializeSequenceOf (it->measObjectEutra.cellsToRemoveList.size (),MAX_CELL_MEAS,1);
-              for (std::list<uint8_t>::iterator it2 = it->measObjectEutra.cellsToRemoveList.begin (); it2 != it->measObjectEutra.cellsToRemoveList.end (); it2++)
+              for (std::list<uint8_t>::const_iterator it2 = it->measObjectEutra.cellsToRemoveList.begin (); it2 != it->measObjectEutra.cellsToRemoveList.end (); it2++)
                 {
                   SerializeInteger (*it2, 1, MAX_CELL_MEAS);
                 }
@@ -1135,7 +1133,7 @@ RrcAsn1Header::SerializeMeasConfig (LteRrcSap::MeasConfig measConfig) const
           if (!it->measObjectEutra.cellsToAddModList.empty ())
             {
               SerializeSequenceOf (it->measObjectEutra.cellsToAddModList.size (), MAX_CELL_MEAS, 1);
-              for (std::list<LteRrcSap::CellsToAddMod>::iterator it2 = it->measObjectEutra.cellsToAddModList.begin (); it2 != it->measObjectEutra.cellsToAddModList.end (); it2++)
+              for (std::list<LteRrcSap::CellsToAddMod>::const_iterator it2 = it->measObjectEutra.cellsToAddModList.begin (); it2 != it->measObjectEutra.cellsToAddModList.end (); it2++)
                 {
                   SerializeSequence (std::bitset<0> (), false);
 
@@ -1153,7 +1151,7 @@ RrcAsn1Header::SerializeMeasConfig (LteRrcSap::MeasConfig measConfig) const
           if (!it->measObjectEutra.blackCellsToRemoveList.empty () )
             {
               SerializeSequenceOf (it->measObjectEutra.blackCellsToRemoveList.size (),MAX_CELL_MEAS,1);
-              for (std::list<uint8_t>::iterator it2 = it->measObjectEutra.blackCellsToRemoveList.begin (); it2 != it->measObjectEutra.blackCellsToRemoveList.end (); it2++)
+              for (std::list<uint8_t>::const_iterator it2 = it->measObjectEutra.blackCellsToRemoveList.begin (); it2 != it->measObjectEutra.blackCellsToRemoveList.end (); it2++)
                 {
                   SerializeInteger (*it2, 1, MAX_CELL_MEAS);
                 }
@@ -1162,7 +1160,7 @@ RrcAsn1Header::SerializeMeasConfig (LteRrcSap::MeasConfig measConfig) const
           if (!it->measObjectEutra.blackCellsToAddModList.empty () )
             {
               SerializeSequenceOf (it->measObjectEutra.blackCellsToAddModList.size (), MAX_CELL_MEAS, 1);
-              for (std::list<LteRrcSap::BlackCellsToAddMod>::iterator it2 = it->measObjectEutra.blackCellsToAddModList.begin (); it2 != it->measObjectEutra.blackCellsToAddModList.end (); it2++)
+              for (std::list<LteRrcSap::BlackCellsToAddMod>::const_iterator it2 = it->measObjectEutra.blackCellsToAddModList.begin (); it2 != it->measObjectEutra.blackCellsToAddModList.end (); it2++)
                 {
                   SerializeSequence (std::bitset<0> (),false);
                   SerializeInteger (it2->cellIndex, 1, MAX_CELL_MEAS);
@@ -1237,7 +1235,7 @@ RrcAsn1Header::SerializeMeasConfig (LteRrcSap::MeasConfig measConfig) const
   if (!measConfig.reportConfigToRemoveList.empty () )
     {
       SerializeSequenceOf (measConfig.reportConfigToRemoveList.size (),MAX_REPORT_CONFIG_ID,1);
-      for (std::list<uint8_t>::iterator it = measConfig.reportConfigToRemoveList.begin (); it != measConfig.reportConfigToRemoveList.end (); it++)
+      for (std::list<uint8_t>::const_iterator it = measConfig.reportConfigToRemoveList.begin (); it != measConfig.reportConfigToRemoveList.end (); it++)
         {
           SerializeInteger (*it, 1,MAX_REPORT_CONFIG_ID);
         }
@@ -1246,7 +1244,7 @@ RrcAsn1Header::SerializeMeasConfig (LteRrcSap::MeasConfig measConfig) const
   if (!measConfig.reportConfigToAddModList.empty () )
     {
       SerializeSequenceOf (measConfig.reportConfigToAddModList.size (),MAX_REPORT_CONFIG_ID,1);
-      for (std::list<LteRrcSap::ReportConfigToAddMod>::iterator it = measConfig.reportConfigToAddModList.begin (); it != measConfig.reportConfigToAddModList.end (); it++)
+      for (std::list<LteRrcSap::ReportConfigToAddMod>::const_iterator it = measConfig.reportConfigToAddModList.begin (); it != measConfig.reportConfigToAddModList.end (); it++)
         {
           SerializeSequence (std::bitset<0> (), false);
           SerializeInteger (it->reportConfigId,1,MAX_REPORT_CONFIG_ID);
@@ -1468,7 +1466,7 @@ RrcAsn1Header::SerializeMeasConfig (LteRrcSap::MeasConfig measConfig) const
   if (!measConfig.measIdToRemoveList.empty () )
     {
       SerializeSequenceOf (measConfig.measIdToRemoveList.size (), MAX_MEAS_ID, 1);
-      for (std::list<uint8_t>::iterator it = measConfig.measIdToRemoveList.begin (); it != measConfig.measIdToRemoveList.end (); it++)
+      for (std::list<uint8_t>::const_iterator it = measConfig.measIdToRemoveList.begin (); it != measConfig.measIdToRemoveList.end (); it++)
         {
           SerializeInteger (*it, 1, MAX_MEAS_ID);
         }
@@ -1477,7 +1475,7 @@ RrcAsn1Header::SerializeMeasConfig (LteRrcSap::MeasConfig measConfig) const
   if (!measConfig.measIdToAddModList.empty () )
     {
       SerializeSequenceOf ( measConfig.measIdToAddModList.size (), MAX_MEAS_ID, 1);
-      for (std::list<LteRrcSap::MeasIdToAddMod>::iterator it = measConfig.measIdToAddModList.begin (); it != measConfig.measIdToAddModList.end (); it++)
+      for (std::list<LteRrcSap::MeasIdToAddMod>::const_iterator it = measConfig.measIdToAddModList.begin (); it != measConfig.measIdToAddModList.end (); it++)
         {
           SerializeInteger (it->measId, 1, MAX_MEAS_ID);
           SerializeInteger (it->measObjectId, 1, MAX_OBJECT_ID);
@@ -1725,7 +1723,7 @@ RrcAsn1Header::SerializeMeasConfig (LteRrcSap::MeasConfig measConfig) const
     }
 }
   void
-  RrcAsn1Header::SerializeNonCriticalExtensionConfiguration (LteRrcSap::NonCriticalExtensionConfiguration nonCriticalExtension) const
+  RrcAsn1Header::SerializeNonCriticalExtensionConfiguration (const LteRrcSap::NonCriticalExtensionConfiguration &nonCriticalExtension) const
   {
     // 3 optional fields. Extension marker not present.
     std::bitset<3> noncriticalExtension_v1020;
@@ -1736,7 +1734,7 @@ RrcAsn1Header::SerializeMeasConfig (LteRrcSap::MeasConfig measConfig) const
     if (!nonCriticalExtension.sCellsToAddModList.empty ())
       {
         SerializeSequenceOf (nonCriticalExtension.sCellsToAddModList.size (),MAX_OBJECT_ID,1);
-        for (std::list<LteRrcSap::SCellToAddMod>::iterator it = nonCriticalExtension.sCellsToAddModList.begin (); it != nonCriticalExtension.sCellsToAddModList.end (); it++)
+        for (std::list<LteRrcSap::SCellToAddMod>::const_iterator it = nonCriticalExtension.sCellsToAddModList.begin (); it != nonCriticalExtension.sCellsToAddModList.end (); it++)
           {
             std::bitset<4> sCellToAddMod_r10;
             sCellToAddMod_r10.set (3,1); // sCellIndex
@@ -1773,7 +1771,7 @@ RrcAsn1Header::SerializeMeasConfig (LteRrcSap::MeasConfig measConfig) const
   
   }
   void
-  RrcAsn1Header::SerializeRadioResourceConfigCommonSCell (LteRrcSap::RadioResourceConfigCommonSCell rrccsc) const
+  RrcAsn1Header::SerializeRadioResourceConfigCommonSCell (const LteRrcSap::RadioResourceConfigCommonSCell &rrccsc) const
   {
     // 2 optional fields. Extension marker not present.
     std::bitset<2> radioResourceConfigCommonSCell_r10;
@@ -1853,7 +1851,7 @@ RrcAsn1Header::SerializeMeasConfig (LteRrcSap::MeasConfig measConfig) const
      
   }
   void
-  RrcAsn1Header::SerializeRadioResourceDedicatedSCell (LteRrcSap::RadioResourceConfigDedicatedSCell rrcdsc) const
+  RrcAsn1Header::SerializeRadioResourceDedicatedSCell (const LteRrcSap::RadioResourceConfigDedicatedSCell &rrcdsc) const
   {
     //Serialize RadioResourceConfigDedicatedSCell
     std::bitset<1> RadioResourceConfigDedicatedSCell_r10;
@@ -1865,7 +1863,7 @@ RrcAsn1Header::SerializeMeasConfig (LteRrcSap::MeasConfig measConfig) const
   }
   
   void
-  RrcAsn1Header::SerializePhysicalConfigDedicatedSCell (LteRrcSap::PhysicalConfigDedicatedSCell pcdsc) const
+  RrcAsn1Header::SerializePhysicalConfigDedicatedSCell (const LteRrcSap::PhysicalConfigDedicatedSCell &pcdsc) const
   {
     std::bitset<2> pcdscOpt;
     pcdscOpt.set (1,pcdsc.haveNonUlConfiguration);
@@ -4639,6 +4637,7 @@ RrcConnectionRequestHeader::PreSerialize () const
 uint32_t
 RrcConnectionRequestHeader::Deserialize (Buffer::Iterator bIterator)
 {
+  Buffer::Iterator start = bIterator;
   std::bitset<1> dummy;
   std::bitset<0> optionalOrDefaultMask;
   int selectedOption;
@@ -4672,7 +4671,7 @@ RrcConnectionRequestHeader::Deserialize (Buffer::Iterator bIterator)
   // Deserialize spare
   bIterator = DeserializeBitstring (&dummy,bIterator);
 
-  return GetSerializedSize ();
+  return FinalizeDeserialization (start, bIterator);
 }
 
 void
@@ -4765,6 +4764,7 @@ RrcConnectionSetupHeader::PreSerialize () const
 uint32_t
 RrcConnectionSetupHeader::Deserialize (Buffer::Iterator bIterator)
 {
+  Buffer::Iterator start = bIterator;
   int n;
 
   std::bitset<0> bitset0;
@@ -4810,18 +4810,15 @@ RrcConnectionSetupHeader::Deserialize (Buffer::Iterator bIterator)
           // Deserialize radioResourceConfigDedicated
           bIterator = DeserializeRadioResourceConfigDedicated (&m_radioResourceConfigDedicated,bIterator);
 
-          if (bitset1[0])
-            {
-              // Deserialize nonCriticalExtension
-              // 2 optional fields, no extension marker.
-              bIterator = DeserializeSequence (&bitset2,false,bIterator);
+          // Deserialize nonCriticalExtension, which is always serialized
+          // 2 optional fields, no extension marker.
+          bIterator = DeserializeSequence (&bitset2,false,bIterator);
 
-              // Deserialization of lateR8NonCriticalExtension and nonCriticalExtension
-              // ...
-            }
+          // Deserialization of lateR8NonCriticalExtension and nonCriticalExtension
+          // ...
         }
     }
-  return GetSerializedSize ();
+  return FinalizeDeserialization (start, bIterator);
 }
 
 void
@@ -4925,6 +4922,7 @@ RrcConnectionSetupCompleteHeader::PreSerialize () const
 uint32_t
 RrcConnectionSetupCompleteHeader::Deserialize (Buffer::Iterator bIterator)
 {
+  Buffer::Iterator start = bIterator;
   std::bitset<0> bitset0;
 
   bIterator = DeserializeUlDcchMessage (bIterator);
@@ -4959,7 +4957,7 @@ RrcConnectionSetupCompleteHeader::Deserialize (Buffer::Iterator bIterator)
         }
     }
 
-  return GetSerializedSize ();
+  return FinalizeDeserialization (start, bIterator);
 }
 
 void
@@ -5028,6 +5026,7 @@ RrcConnectionReconfigurationCompleteHeader::PreSerialize () const
 uint32_t
 RrcConnectionReconfigurationCompleteHeader::Deserialize (Buffer::Iterator bIterator)
 {
+  Buffer::Iterator start = bIterator;
   std::bitset<0> bitset0;
   int n;
 
@@ -5050,7 +5049,7 @@ RrcConnectionReconfigurationCompleteHeader::Deserialize (Buffer::Iterator bItera
       // ...
     }
 
-  return GetSerializedSize ();
+  return FinalizeDeserialization (start, bIterator);
 }
 
 void
@@ -5213,6 +5212,7 @@ RrcConnectionReconfigurationHeader::PreSerialize () const
 uint32_t
 RrcConnectionReconfigurationHeader::Deserialize (Buffer::Iterator bIterator)
 {
+  Buffer::Iterator start = bIterator;
   std::bitset<0> bitset0;
 
   bIterator = DeserializeDlDcchMessage (bIterator);
@@ -5356,7 +5356,7 @@ RrcConnectionReconfigurationHeader::Deserialize (Buffer::Iterator bIterator)
         }
     }
 
-  return GetSerializedSize ();
+  return FinalizeDeserialization (start, bIterator);
 }
 
 void
@@ -5798,6 +5798,7 @@ HandoverPreparationInfoHeader::PreSerialize () const
 uint32_t
 HandoverPreparationInfoHeader::Deserialize (Buffer::Iterator bIterator)
 {
+  Buffer::Iterator start = bIterator;
   std::bitset<0> bitset0;
   int n;
 
@@ -5908,7 +5909,7 @@ HandoverPreparationInfoHeader::Deserialize (Buffer::Iterator bIterator)
         }
     }
 
-  return GetSerializedSize ();
+  return FinalizeDeserialization (start, bIterator);
 }
 
 void
@@ -6011,6 +6012,7 @@ RrcConnectionReestablishmentRequestHeader::PreSerialize () const
 uint32_t
 RrcConnectionReestablishmentRequestHeader::Deserialize (Buffer::Iterator bIterator)
 {
+  Buffer::Iterator start = bIterator;
   std::bitset<0> bitset0;
   int n;
 
@@ -6072,7 +6074,7 @@ RrcConnectionReestablishmentRequestHeader::Deserialize (Buffer::Iterator bIterat
       bIterator = DeserializeBitstring (&spare,bIterator);
     }
 
-  return GetSerializedSize ();
+  return FinalizeDeserialization (start, bIterator);
 }
 
 void
@@ -6160,6 +6162,7 @@ RrcConnectionReestablishmentHeader::PreSerialize () const
 uint32_t
 RrcConnectionReestablishmentHeader::Deserialize (Buffer::Iterator bIterator)
 {
+  Buffer::Iterator start = bIterator;
   std::bitset<0> bitset0;
   int n;
 
@@ -6205,7 +6208,7 @@ RrcConnectionReestablishmentHeader::Deserialize (Buffer::Iterator bIterator)
         }
     }
 
-  return GetSerializedSize ();
+  return FinalizeDeserialization (start, bIterator);
 }
 
 void
@@ -6280,6 +6283,7 @@ RrcConnectionReestablishmentCompleteHeader::PreSerialize () const
 uint32_t
 RrcConnectionReestablishmentCompleteHeader::Deserialize (Buffer::Iterator bIterator)
 {
+  Buffer::Iterator start = bIterator;
   std::bitset<0> bitset0;
   int n;
 
@@ -6313,7 +6317,7 @@ RrcConnectionReestablishmentCompleteHeader::Deserialize (Buffer::Iterator bItera
         }
     }
 
-  return GetSerializedSize ();
+  return FinalizeDeserialization (start, bIterator);
 }
 
 void
@@ -6379,6 +6383,7 @@ RrcConnectionReestablishmentRejectHeader::PreSerialize () const
 uint32_t
 RrcConnectionReestablishmentRejectHeader::Deserialize (Buffer::Iterator bIterator)
 {
+  Buffer::Iterator start = bIterator;
   std::bitset<0> bitset0;
 
   bIterator = DeserializeDlCcchMessage (bIterator);
@@ -6407,7 +6412,7 @@ RrcConnectionReestablishmentRejectHeader::Deserialize (Buffer::Iterator bIterato
         }
     }
 
-  return GetSerializedSize ();
+  return FinalizeDeserialization (start, bIterator);
 }
 
 void
@@ -6473,6 +6478,7 @@ RrcConnectionReleaseHeader::PreSerialize () const
 uint32_t
 RrcConnectionReleaseHeader::Deserialize (Buffer::Iterator bIterator)
 {
+  Buffer::Iterator start = bIterator;
   std::bitset<0> bitset0;
   int n;
 
@@ -6532,7 +6538,7 @@ RrcConnectionReleaseHeader::Deserialize (Buffer::Iterator bIterator)
         }
     }
 
-  return GetSerializedSize ();
+  return FinalizeDeserialization (start, bIterator);
 }
 
 void
@@ -6595,6 +6601,7 @@ RrcConnectionRejectHeader::PreSerialize () const
 uint32_t
 RrcConnectionRejectHeader::Deserialize (Buffer::Iterator bIterator)
 {
+  Buffer::Iterator start = bIterator;
   std::bitset<0> bitset0;
   int n;
 
@@ -6639,7 +6646,7 @@ RrcConnectionRejectHeader::Deserialize (Buffer::Iterator bIterator)
         }
     }
 
-  return GetSerializedSize ();
+  return FinalizeDeserialization (start, bIterator);
 }
 
 void
@@ -6705,6 +6712,7 @@ MeasurementReportHeader::PreSerialize () const
 uint32_t
 MeasurementReportHeader::Deserialize (Buffer::Iterator bIterator)
 {
+  Buffer::Iterator start = bIterator;
   std::bitset<0> bitset0;
 
   bIterator = DeserializeSequence (&bitset0,false,bIterator);
@@ -6747,7 +6755,7 @@ MeasurementReportHeader::Deserialize (Buffer::Iterator bIterator)
         }
     }
 
-  return GetSerializedSize ();
+  return FinalizeDeserialization (start, bIterator);
 }
 
 void
@@ -88,67 +88,67 @@ protected:
    *
    * \param srbToAddModList std::list<LteRrcSap::SrbToAddMod>
    */
-  void SerializeSrbToAddModList (std::list<LteRrcSap::SrbToAddMod> srbToAddModList) const;
+  void SerializeSrbToAddModList (const std::list<LteRrcSap::SrbToAddMod> &srbToAddModList) const;
   /**
    * Serialize DRB to add mod list function
    *
    * \param drbToAddModList std::list<LteRrcSap::SrbToAddMod>
    */
-  void SerializeDrbToAddModList (std::list<LteRrcSap::DrbToAddMod> drbToAddModList) const;
+  void SerializeDrbToAddModList (const std::list<LteRrcSap::DrbToAddMod> &drbToAddModList) const;
   /**
    * Serialize logicala channel config function
    *
    * \param logicalChannelConfig LteRrcSap::LogicalChannelConfig
    */
-  void SerializeLogicalChannelConfig (LteRrcSap::LogicalChannelConfig logicalChannelConfig) const;
+  void SerializeLogicalChannelConfig (const LteRrcSap::LogicalChannelConfig &logicalChannelConfig) const;
   /**
    * Serialize radio resource config function
    *
    * \param radioResourceConfigDedicated LteRrcSap::RadioResourceConfigDedicated
    */
-  void SerializeRadioResourceConfigDedicated (LteRrcSap::RadioResourceConfigDedicated radioResourceConfigDedicated) const;
+  void SerializeRadioResourceConfigDedicated (const LteRrcSap::RadioResourceConfigDedicated &radioResourceConfigDedicated) const;
   /**
    * Serialize physical config dedicated function
    *
    * \param physicalConfigDedicated LteRrcSap::PhysicalConfigDedicated
    */
-  void SerializePhysicalConfigDedicated (LteRrcSap::PhysicalConfigDedicated physicalConfigDedicated) const;
+  void SerializePhysicalConfigDedicated (const LteRrcSap::PhysicalConfigDedicated &physicalConfigDedicated) const;
   /**
    * Serialize physical config dedicated function
    *
    * \param pcdsc LteRrcSap::PhysicalConfigDedicatedSCell
    */
-  void SerializePhysicalConfigDedicatedSCell (LteRrcSap::PhysicalConfigDedicatedSCell pcdsc) const;
+  void SerializePhysicalConfigDedicatedSCell (const LteRrcSap::PhysicalConfigDedicatedSCell &pcdsc) const;
   /**
    * Serialize system information block type 1 function
    *
    * \param systemInformationBlockType1 LteRrcSap::SystemInformationBlockType1
    */
-  void SerializeSystemInformationBlockType1 (LteRrcSap::SystemInformationBlockType1 systemInformationBlockType1) const;
+  void SerializeSystemInformationBlockType1 (const LteRrcSap::SystemInformationBlockType1 &systemInformationBlockType1) const;
   /**
    * Serialize system information block type 2 function
    *
    * \param systemInformationBlockType2 LteRrcSap::SystemInformationBlockType2
    */
-  void SerializeSystemInformationBlockType2 (LteRrcSap::SystemInformationBlockType2 systemInformationBlockType2) const;
+  void SerializeSystemInformationBlockType2 (const LteRrcSap::SystemInformationBlockType2 &systemInformationBlockType2) const;
   /**
    * Serialize system information block type 2 function
    *
    * \param radioResourceConfigCommon LteRrcSap::RadioResourceConfigCommon
    */
-  void SerializeRadioResourceConfigCommon (LteRrcSap::RadioResourceConfigCommon radioResourceConfigCommon) const;
+  void SerializeRadioResourceConfigCommon (const LteRrcSap::RadioResourceConfigCommon &radioResourceConfigCommon) const;
   /**
    * Serialize radio resource config common SIB function
    *
    * \param radioResourceConfigCommonSib LteRrcSap::RadioResourceConfigCommonSib
    */
-  void SerializeRadioResourceConfigCommonSib (LteRrcSap::RadioResourceConfigCommonSib radioResourceConfigCommonSib) const;
+  void SerializeRadioResourceConfigCommonSib (const LteRrcSap::RadioResourceConfigCommonSib &radioResourceConfigCommonSib) const;
   /**
    * Serialize measure results function
    *
    * \param measResults LteRrcSap::MeasResults
    */
-  void SerializeMeasResults (LteRrcSap::MeasResults measResults) const;
+  void SerializeMeasResults (const LteRrcSap::MeasResults &measResults) const;
   /**
    * Serialize PLMN identity function
    *
@@ -160,31 +160,31 @@ protected:
    *
    * \param rachConfigCommon LteRrcSap::RachConfigCommon
    */
-  void SerializeRachConfigCommon (LteRrcSap::RachConfigCommon rachConfigCommon) const;
+  void SerializeRachConfigCommon (const LteRrcSap::RachConfigCommon &rachConfigCommon) const;
   /**
    * Serialize measure config function
    *
    * \param measConfig LteRrcSap::MeasConfig
    */
-  void SerializeMeasConfig (LteRrcSap::MeasConfig measConfig) const;
+  void SerializeMeasConfig (const LteRrcSap::MeasConfig &measConfig) const;
   /**
    * Serialize non critical extension config function
    *
    * \param nonCriticalExtensionConfiguration LteRrcSap::NonCriticalExtensionConfiguration
    */
-  void SerializeNonCriticalExtensionConfiguration (LteRrcSap::NonCriticalExtensionConfiguration nonCriticalExtensionConfiguration) const;
+  void SerializeNonCriticalExtensionConfiguration (const LteRrcSap::NonCriticalExtensionConfiguration &nonCriticalExtensionConfiguration) const;
   /**
    * Serialize radio resource config common SCell function
    *
    * \param rrccsc LteRrcSap::RadioResourceConfigCommonSCell
    */
-  void SerializeRadioResourceConfigCommonSCell (LteRrcSap::RadioResourceConfigCommonSCell rrccsc) const;
+  void SerializeRadioResourceConfigCommonSCell (const LteRrcSap::RadioResourceConfigCommonSCell &rrccsc) const;
   /**
    * Serialize radio resource dedicated SCell function
    *
    * \param rrcdsc LteRrcSap::RadioResourceConfigDedicatedSCell
    */
-  void SerializeRadioResourceDedicatedSCell (LteRrcSap::RadioResourceConfigDedicatedSCell rrcdsc) const;
+  void SerializeRadioResourceDedicatedSCell (const LteRrcSap::RadioResourceConfigDedicatedSCell &rrcdsc) const;
   /**
    * Serialize Q offset range function
    *
@@ -196,7 +196,7 @@ protected:
    *
    * \param thresholdEutra LteRrcSap::ThresholdEutra
    */
-  void SerializeThresholdEutra (LteRrcSap::ThresholdEutra thresholdEutra) const;
+  void SerializeThresholdEutra (const LteRrcSap::ThresholdEutra &thresholdEutra) const;
   
   // Deserialization functions
   /**
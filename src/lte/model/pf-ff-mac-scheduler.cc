@@ -405,6 +405,72 @@ PfFfMacScheduler::HarqProcessAvailability (uint16_t rnti)
 
 
 
+
+void
+PfFfMacScheduler::UpdateDlUeTable (const std::set <uint16_t> &rntiAllocated, uint16_t rbgNum)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_dlUeTable.Clear (rbgNum);
+  std::map <uint16_t, pfsFlowPerf_t>::iterator it;
+  for (it = m_flowStatsDl.begin (); it != m_flowStatsDl.end (); it++)
+    {
+      uint16_t rnti = (*it).first;
+      uint32_t ue = m_dlUeTable.Add (rnti);
+      m_dlUeTable.SetThroughput (ue, (*it).second.lastAveragedThroughput);
+      if (rntiAllocated.find (rnti) != rntiAllocated.end ())
+        {
+          NS_LOG_DEBUG (this << " RNTI discared for HARQ tx" << rnti);
+          continue;
+        }
+      if (!HarqProcessAvailability (rnti))
+        {
+          NS_LOG_DEBUG (this << " RNTI discared for HARQ id" << rnti);
+          continue;
+        }
+      m_dlUeTable.SetEligible (ue, true);
+
+      // without transmission mode, the number of layers stays 0: the
+      // error is raised if the UE is considered for a RBG
+      std::map <uint16_t,uint8_t>::iterator itTxMode = m_uesTxMode.find (rnti);
+      if (itTxMode == m_uesTxMode.end ())
+        {
+          continue;
+        }
+      uint8_t nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
+      m_dlUeTable.SetLayers (ue, nLayer);
+      std::map <uint16_t,SbMeasResult_s>::iterator itCqi = m_a30CqiRxed.find (rnti);
+      if (itCqi == m_a30CqiRxed.end ())
+        {
+          m_dlUeTable.SetWidebandCqi (ue, 1, nLayer);  // start with lowest value
+        }
+      else
+        {
+          const std::vector <HigherLayerSelected_s> &sb = (*itCqi).second.m_higherLayerSelected;
+          for (uint16_t i = 0; i < rbgNum && i < sb.size (); i++)
+            {
+              m_dlUeTable.SetSbCqi (ue, i, sb[i].m_sbCqi);
+            }
+        }
+    }
+
+  // count the active LCs of all the UEs in one pass
+  std::map <LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator itBuf;
+  for (itBuf = m_rlcBufferReq.begin (); itBuf != m_rlcBufferReq.end (); itBuf++)
+    {
+      if (((*itBuf).second.m_rlcTransmissionQueueSize > 0)
+          || ((*itBuf).second.m_rlcRetransmissionQueueSize > 0)
+          || ((*itBuf).second.m_rlcStatusPduSize > 0))
+        {
+          uint32_t ue = m_dlUeTable.Find ((*itBuf).first.m_rnti);
+          if (ue != FfMacUeTable::NO_UE)
+            {
+              m_dlUeTable.SetActiveLcs (ue, m_dlUeTable.GetActiveLcs (ue) + 1);
+            }
+        }
+    }
+}
+
 uint8_t
 PfFfMacScheduler::UpdateHarqProcessId (uint16_t rnti)
 {
@@ -920,116 +986,112 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
 
 
 
+  UpdateDlUeTable (rntiAllocated, rbgNum);
+
+  // the MCS and the achievable rate on a RBG only depend on the CQI
+  uint8_t mcsForCqi[16];
+  double rateForCqi[16];
+  for (uint8_t cqi = 0; cqi < 16; cqi++)
+    {
+      mcsForCqi[cqi] = m_amc->GetMcsFromCqi (cqi);
+      rateForCqi[cqi] = ((m_amc->GetDlTbSizeFromMcs (mcsForCqi[cqi], rbgSize) / 8) / 0.001);   // = TB size / TTI
+    }
+  double rateForNoCqi = ((m_amc->GetDlTbSizeFromMcs (0, rbgSize) / 8) / 0.001);
+
   for (int i = 0; i < rbgNum; i++)
     {
       NS_LOG_INFO (this << " ALLOCATION for RBG " << i << " of " << rbgNum);
       if (rbgMap.at (i) == false)
         {
-          std::map <uint16_t, pfsFlowPerf_t>::iterator it;
-          std::map <uint16_t, pfsFlowPerf_t>::iterator itMax = m_flowStatsDl.end ();
+          uint32_t ueMax = FfMacUeTable::NO_UE;
           double rcqiMax = 0.0;
-          for (it = m_flowStatsDl.begin (); it != m_flowStatsDl.end (); it++)
+          for (uint32_t ue = 0; ue < m_dlUeTable.GetN (); ue++)
             {
-              if ((m_ffrSapProvider->IsDlRbgAvailableForUe (i, (*it).first)) == false)
+              uint16_t rnti = m_dlUeTable.GetRnti (ue);
+              if ((m_ffrSapProvider->IsDlRbgAvailableForUe (i, rnti)) == false)
                 continue;
 
-              std::set <uint16_t>::iterator itRnti = rntiAllocated.find ((*it).first);
-              if ((itRnti != rntiAllocated.end ())||(!HarqProcessAvailability ((*it).first)))
+              if (!m_dlUeTable.IsEligible (ue))
                 {
                   // UE already allocated for HARQ or without HARQ process available -> drop it
-                  if (itRnti != rntiAllocated.end ())
-                    {
-                      NS_LOG_DEBUG (this << " RNTI discared for HARQ tx" << (uint16_t)(*it).first);
-                    }
-                  if (!HarqProcessAvailability ((*it).first))
-                    {
-                      NS_LOG_DEBUG (this << " RNTI discared for HARQ id" << (uint16_t)(*it).first);
-                    }
                   continue;
                 }
-              std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
-              itCqi = m_a30CqiRxed.find ((*it).first);
-              std::map <uint16_t,uint8_t>::iterator itTxMode;
-              itTxMode = m_uesTxMode.find ((*it).first);
-              if (itTxMode == m_uesTxMode.end ())
-                {
-                  NS_FATAL_ERROR ("No Transmission Mode info on user " << (*it).first);
-                }
-              int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
-              std::vector <uint8_t> sbCqi;
-              if (itCqi == m_a30CqiRxed.end ())
+              uint8_t nLayer = m_dlUeTable.GetLayers (ue);
+              if (nLayer == 0)
                 {
-                  for (uint8_t k = 0; k < nLayer; k++)
-                    {
-                      sbCqi.push_back (1);  // start with lowest value
-                    }
+                  NS_FATAL_ERROR ("No Transmission Mode info on user " << rnti);
                 }
-              else
+              uint8_t nCqi = m_dlUeTable.GetSbCqiLayers (ue, i);
+              const uint8_t *sbCqi = m_dlUeTable.GetSbCqi (ue, i);
+              uint8_t cqi1 = 0;
+              uint8_t cqi2 = 0;
+              if (nCqi > 0)
                 {
-                  sbCqi = (*itCqi).second.m_higherLayerSelected.at (i).m_sbCqi;
+                  cqi1 = sbCqi[0];
                 }
-              uint8_t cqi1 = sbCqi.at (0);
-              uint8_t cqi2 = 0;
-              if (sbCqi.size () > 1)
+              if (nCqi > 1)
                 {
-                  cqi2 = sbCqi.at (1);
+                  cqi2 = sbCqi[1];
                 }
 
               if ((cqi1 > 0)||(cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
                 {
-                  if (LcActivePerFlow ((*it).first) > 0)
+                  if (m_dlUeTable.GetActiveLcs (ue) > 0)
                     {
                       // this UE has data to transmit
                       double achievableRate = 0.0;
                       uint8_t mcs = 0;
                       for (uint8_t k = 0; k < nLayer; k++)
                         {
-                          if (sbCqi.size () > k)
+                          if (nCqi > k)
                             {
-                              mcs = m_amc->GetMcsFromCqi (sbCqi.at (k));
+                              NS_ASSERT_MSG (sbCqi[k] <= 15, "CQI must be in [0..15] = " << (uint16_t)sbCqi[k]);
+                              mcs = mcsForCqi[sbCqi[k]];
+                              achievableRate += rateForCqi[sbCqi[k]];
                             }
                           else
                             {
                               // no info on this subband -> worst MCS
                               mcs = 0;
+                              achievableRate += rateForNoCqi;
                             }
-                          achievableRate += ((m_amc->GetDlTbSizeFromMcs (mcs, rbgSize) / 8) / 0.001);   // = TB size / TTI
                         }
 
-                      double rcqi = achievableRate / (*it).second.lastAveragedThroughput;
-                      NS_LOG_INFO (this << " RNTI " << (*it).first << " MCS " << (uint32_t)mcs << " achievableRate " << achievableRate << " avgThr " << (*it).second.lastAveragedThroughput << " RCQI " << rcqi);
+                      double rcqi = achievableRate / m_dlUeTable.GetThroughput (ue);
+                      NS_LOG_INFO (this << " RNTI " << rnti << " MCS " << (uint32_t)mcs << " achievableRate " << achievableRate << " avgThr " << m_dlUeTable.GetThroughput (ue) << " RCQI " << rcqi);
 
                       if (rcqi > rcqiMax)
                         {
                           rcqiMax = rcqi;
-                          itMax = it;
+                          ueMax = ue;
                         }
                     }
                 }   // end if cqi
-            } // end for m_rlcBufferReq
+            } // end for UEs
 
-          if (itMax == m_flowStatsDl.end ())
+          if (ueMax == FfMacUeTable::NO_UE)
             {
               // no UE available for this RB
               NS_LOG_INFO (this << " any UE found");
             }
           else
             {
+              uint16_t rntiMax = m_dlUeTable.GetRnti (ueMax);
               rbgMap.at (i) = true;
               std::map <uint16_t, std::vector <uint16_t> >::iterator itMap;
-              itMap = allocationMap.find ((*itMax).first);
+              itMap = allocationMap.find (rntiMax);
               if (itMap == allocationMap.end ())
                 {
                   // insert new element
                   std::vector <uint16_t> tempMap;
                   tempMap.push_back (i);
-                  allocationMap.insert (std::pair <uint16_t, std::vector <uint16_t> > ((*itMax).first, tempMap));
+                  allocationMap.insert (std::pair <uint16_t, std::vector <uint16_t> > (rntiMax, tempMap));
                 }
               else
                 {
                   (*itMap).second.push_back (i);
                 }
-              NS_LOG_INFO (this << " UE assigned " << (*itMax).first);
+              NS_LOG_INFO (this << " UE assigned " << rntiMax);
             }
         } // end for RBG free
     } // end for RBGs
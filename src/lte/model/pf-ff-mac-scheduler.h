@@ -27,9 +27,11 @@
 #include <ns3/ff-mac-scheduler.h>
 #include <vector>
 #include <map>
+#include <set>
 #include <ns3/nstime.h>
 #include <ns3/lte-amc.h>
 #include <ns3/lte-ffr-sap.h>
+#include <ns3/ff-mac-ue-table.h>
 
 // value for SINR outside the range defined by FF-API, used to indicate that there
 // is no CQI for this element
@@ -300,6 +302,14 @@ private:
   */
   uint8_t HarqProcessAvailability (uint16_t rnti);
 
+  /**
+  * \brief Fill the DL UE table with the state of the UEs for this TTI
+  *
+  * \param rntiAllocated the RNTIs of the UEs already allocated for HARQ retransmissions
+  * \param rbgNum the number of RBGs
+  */
+  void UpdateDlUeTable (const std::set <uint16_t> &rntiAllocated, uint16_t rbgNum);
+
   /**
   * \brief Refresh HARQ processes according to the timers
   *
@@ -319,6 +329,11 @@ private:
   */
   std::map <uint16_t, pfsFlowPerf_t> m_flowStatsDl;
 
+  /**
+  * Dense copy of the state of the DL flows used by the RBG allocation of a TTI
+  */
+  FfMacUeTable m_dlUeTable;
+
   /**
   * Map of UE statistics (per RNTI basis)
   */
@@ -103,18 +103,21 @@ public:
    *
    * \param name the name of the test case instance
    * \param v list of eNodeB downlink test data information
+   * \param directForwarding whether the GTP-U packets are forwarded directly
    */
-  EpcS1uDlTestCase (std::string name, std::vector<EnbDlTestData> v);
+  EpcS1uDlTestCase (std::string name, std::vector<EnbDlTestData> v, bool directForwarding = false);
   virtual ~EpcS1uDlTestCase ();
 
 private:
   virtual void DoRun (void);
+  bool m_directForwarding; ///< whether the GTP-U packets are forwarded directly
   std::vector<EnbDlTestData> m_enbDlTestData; ///< ENB DL test data
 };
 
 
-EpcS1uDlTestCase::EpcS1uDlTestCase (std::string name, std::vector<EnbDlTestData> v)
+EpcS1uDlTestCase::EpcS1uDlTestCase (std::string name, std::vector<EnbDlTestData> v, bool directForwarding)
   : TestCase (name),
+    m_directForwarding (directForwarding),
     m_enbDlTestData (v)
 {
 }
@@ -126,6 +129,7 @@ void
 EpcS1uDlTestCase::DoRun ()
 {
   Ptr<PointToPointEpcHelper> epcHelper = CreateObject<PointToPointEpcHelper> ();
+  epcHelper->SetAttribute ("GtpuDirectForwarding", BooleanValue (m_directForwarding));
   Ptr<Node> pgw = epcHelper->GetPgwNode ();
 
   // allow jumbo packets
@@ -313,6 +317,7 @@ EpcS1uDlTestSuite::EpcS1uDlTestSuite ()
   v4.push_back (e1);
   v4.push_back (e2);
   AddTestCase (new EpcS1uDlTestCase ("3 eNBs", v4), TestCase::QUICK);
+  AddTestCase (new EpcS1uDlTestCase ("3 eNBs, direct GTP-U forwarding", v4, true), TestCase::QUICK);
 
   std::vector<EnbDlTestData> v5;  
   EnbDlTestData e5;
@@ -316,18 +316,21 @@ public:
    *
    * \param name the reference name
    * \param v the list of UE lists
+   * \param directForwarding whether the GTP-U packets are forwarded directly
    */
-  EpcS1uUlTestCase (std::string name, std::vector<EnbUlTestData> v);
+  EpcS1uUlTestCase (std::string name, std::vector<EnbUlTestData> v, bool directForwarding = false);
   virtual ~EpcS1uUlTestCase ();
 
 private:
   virtual void DoRun (void);
+  bool m_directForwarding; ///< whether the GTP-U packets are forwarded directly
   std::vector<EnbUlTestData> m_enbUlTestData; ///< ENB UL test data
 };
 
 
-EpcS1uUlTestCase::EpcS1uUlTestCase (std::string name, std::vector<EnbUlTestData> v)
+EpcS1uUlTestCase::EpcS1uUlTestCase (std::string name, std::vector<EnbUlTestData> v, bool directForwarding)
   : TestCase (name),
+    m_directForwarding (directForwarding),
     m_enbUlTestData (v)
 {}
 
@@ -338,6 +341,7 @@ void
 EpcS1uUlTestCase::DoRun ()
 {
   Ptr<PointToPointEpcHelper> epcHelper = CreateObject<PointToPointEpcHelper> ();
+  epcHelper->SetAttribute ("GtpuDirectForwarding", BooleanValue (m_directForwarding));
   Ptr<Node> pgw = epcHelper->GetPgwNode ();
 
   // allow jumbo packets
@@ -554,6 +558,7 @@ EpcS1uUlTestSuite::EpcS1uUlTestSuite ()
   v4.push_back (e1);
   v4.push_back (e2);
   AddTestCase (new EpcS1uUlTestCase ("3 eNBs", v4), TestCase::QUICK);
+  AddTestCase (new EpcS1uUlTestCase ("3 eNBs, direct GTP-U forwarding", v4, true), TestCase::QUICK);
 
   std::vector<EnbUlTestData> v5;
   EnbUlTestData e5;
@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <limits>
+
+#include <ns3/test.h>
+#include <ns3/simulator.h>
+#include <ns3/lte-global-pathloss-database.h>
+
+using namespace ns3;
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief A pathloss database storing the values given by the test.
+ */
+class TestLteGlobalPathlossDatabase : public LteGlobalPathlossDatabase
+{
+public:
+  // inherited from LteGlobalPathlossDatabase
+  virtual void UpdatePathloss (std::string context, Ptr<const SpectrumPhy> txPhy, Ptr<const SpectrumPhy> rxPhy, double lossDb)
+  {
+  }
+
+  /**
+   * Store a value if the current time is sampled
+   * \param cellId the id of the eNB
+   * \param imsi the id of the UE
+   * \param lossDb the loss in dB
+   */
+  void Update (uint16_t cellId, uint64_t imsi, double lossDb)
+  {
+    if (IsSampled ())
+      {
+        StorePathloss (cellId, imsi, lossDb);
+      }
+  }
+};
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Check that the values of the pathloss database are kept when
+ * the matrix grows, and that only the sampled updates are recorded.
+ */
+class LteGlobalPathlossDatabaseTestCase : public TestCase
+{
+public:
+  LteGlobalPathlossDatabaseTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteGlobalPathlossDatabaseTestCase::LteGlobalPathlossDatabaseTestCase ()
+  : TestCase ("Check the storage and the sampling of the LteGlobalPathlossDatabase")
+{
+}
+
+void
+LteGlobalPathlossDatabaseTestCase::DoRun (void)
+{
+  const double infinity = std::numeric_limits<double>::infinity ();
+  TestLteGlobalPathlossDatabase db;
+  NS_TEST_ASSERT_MSG_EQ (db.GetPathloss (1, 1), infinity, "Pathloss of an unknown pair");
+
+  // the cells and UEs are added in an interleaved order, so that the rows are moved several times
+  for (uint16_t cellId = 1; cellId <= 7; cellId++)
+    {
+      for (uint64_t imsi = 1; imsi <= 40; imsi++)
+        {
+          db.Update (cellId * 3, imsi * 1000000007ULL, cellId * 1000 + imsi);
+        }
+    }
+  db.Update (2, 5 * 1000000007ULL, 42);
+  for (uint16_t cellId = 1; cellId <= 7; cellId++)
+    {
+      for (uint64_t imsi = 1; imsi <= 40; imsi++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (db.GetPathloss (cellId * 3, imsi * 1000000007ULL), cellId * 1000 + imsi,
+                                 "Wrong pathloss of cell " << cellId * 3 << " IMSI " << imsi);
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (db.GetPathloss (2, 5 * 1000000007ULL), 42, "Wrong pathloss of cell 2");
+  NS_TEST_ASSERT_MSG_EQ (db.GetPathloss (2, 6 * 1000000007ULL), infinity, "Pathloss of a pair without update");
+  NS_TEST_ASSERT_MSG_EQ (db.GetPathloss (4, 5 * 1000000007ULL), infinity, "Pathloss of an unknown cell");
+  NS_TEST_ASSERT_MSG_EQ (db.GetPathloss (3, 41 * 1000000007ULL), infinity, "Pathloss of an unknown UE");
+
+  // with a period of 10 ms, only the updates of the first ms of each period are recorded
+  db.SetSamplingPeriod (MilliSeconds (10));
+  Simulator::Schedule (MicroSeconds (20500), &TestLteGlobalPathlossDatabase::Update, &db, 3, 1000000007ULL, 1);
+  Simulator::Schedule (MicroSeconds (21500), &TestLteGlobalPathlossDatabase::Update, &db, 3, 1000000007ULL, 2);
+  Simulator::Schedule (MicroSeconds (21500), &TestLteGlobalPathlossDatabase::Update, &db, 5, 1, 3);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  NS_TEST_ASSERT_MSG_EQ (db.GetPathloss (3, 1000000007ULL), 1, "The sampling did not record the right update");
+  NS_TEST_ASSERT_MSG_EQ (db.GetPathloss (5, 1), infinity, "The sampling recorded an update out of the first ms");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief LteGlobalPathlossDatabase TestSuite
+ */
+class LteGlobalPathlossDatabaseTestSuite : public TestSuite
+{
+public:
+  LteGlobalPathlossDatabaseTestSuite ();
+};
+
+LteGlobalPathlossDatabaseTestSuite::LteGlobalPathlossDatabaseTestSuite ()
+  : TestSuite ("lte-global-pathloss-database", UNIT)
+{
+  AddTestCase (new LteGlobalPathlossDatabaseTestCase, TestCase::QUICK);
+}
+
+static LteGlobalPathlossDatabaseTestSuite g_lteGlobalPathlossDatabaseTestSuite; //!< Static variable for test initialization
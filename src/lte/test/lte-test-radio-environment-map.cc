@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <ns3/test.h>
+#include <ns3/simulator.h>
+#include <ns3/boolean.h>
+#include <ns3/double.h>
+#include <ns3/pointer.h>
+#include <ns3/string.h>
+#include <ns3/uinteger.h>
+#include <ns3/mobility-helper.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/node-container.h>
+#include <ns3/net-device-container.h>
+#include <ns3/lte-helper.h>
+#include <ns3/radio-environment-map-helper.h>
+
+using namespace ns3;
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Check that the offline REM, computed with one or several
+ * threads, is the same as the REM measured by the listeners.
+ */
+class LteRadioEnvironmentMapTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param numThreads the number of threads of the offline REM
+   */
+  LteRadioEnvironmentMapTestCase (uint32_t numThreads);
+
+private:
+  virtual void DoRun (void);
+
+  /// A point of a REM
+  struct Point
+  {
+    double x;     //!< the x coordinate
+    double y;     //!< the y coordinate
+    double sinr;  //!< the SINR
+  };
+
+  /**
+   * Generate a REM of a two-cell scenario
+   * \param offline whether the REM is computed offline
+   * \param filename the REM file
+   * \return the points of the REM
+   */
+  std::vector<Point> RunScenario (bool offline, std::string filename);
+
+  uint32_t m_numThreads;  //!< the number of threads of the offline REM
+};
+
+LteRadioEnvironmentMapTestCase::LteRadioEnvironmentMapTestCase (uint32_t numThreads)
+  : TestCase ("Check the offline REM with " + std::to_string (numThreads) + " threads"),
+    m_numThreads (numThreads)
+{
+}
+
+std::vector<LteRadioEnvironmentMapTestCase::Point>
+LteRadioEnvironmentMapTestCase::RunScenario (bool offline, std::string filename)
+{
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetEnbAntennaModelType ("ns3::CosineAntennaModel");
+  lteHelper->SetEnbAntennaModelAttribute ("HorizontalBeamwidth", DoubleValue (60));
+
+  NodeContainer enbNodes;
+  enbNodes.Create (2);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (enbNodes);
+  enbNodes.Get (0)->GetObject<MobilityModel> ()->SetPosition (Vector (0, 0, 30));
+  enbNodes.Get (1)->GetObject<MobilityModel> ()->SetPosition (Vector (500, 0, 30));
+  lteHelper->SetEnbAntennaModelAttribute ("Orientation", DoubleValue (0));
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes.Get (0));
+  lteHelper->SetEnbAntennaModelAttribute ("Orientation", DoubleValue (180));
+  enbDevs.Add (lteHelper->InstallEnbDevice (enbNodes.Get (1)));
+
+  Ptr<RadioEnvironmentMapHelper> remHelper = CreateObject<RadioEnvironmentMapHelper> ();
+  remHelper->SetAttribute ("Channel", PointerValue (lteHelper->GetDownlinkSpectrumChannel ()));
+  remHelper->SetAttribute ("OutputFile", StringValue (filename));
+  remHelper->SetAttribute ("XMin", DoubleValue (-200));
+  remHelper->SetAttribute ("XMax", DoubleValue (700));
+  remHelper->SetAttribute ("XRes", UintegerValue (31));
+  remHelper->SetAttribute ("YMin", DoubleValue (-300));
+  remHelper->SetAttribute ("YMax", DoubleValue (300));
+  remHelper->SetAttribute ("YRes", UintegerValue (21));
+  remHelper->SetAttribute ("Z", DoubleValue (1.5));
+  remHelper->SetAttribute ("MaxPointsPerIteration", UintegerValue (250));
+  remHelper->SetAttribute ("Offline", BooleanValue (offline));
+  remHelper->SetAttribute ("NumThreads", UintegerValue (m_numThreads));
+  remHelper->Install ();
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::vector<Point> points;
+  std::ifstream remFile (filename.c_str ());
+  Point p;
+  double z;
+  while (remFile >> p.x >> p.y >> z >> p.sinr)
+    {
+      points.push_back (p);
+    }
+  return points;
+}
+
+void
+LteRadioEnvironmentMapTestCase::DoRun (void)
+{
+  std::vector<Point> online = RunScenario (false, CreateTempDirFilename ("rem-online.out"));
+  std::vector<Point> offline = RunScenario (true, CreateTempDirFilename ("rem-offline.out"));
+
+  NS_TEST_ASSERT_MSG_EQ (online.size (), 31 * 21, "Wrong number of points of the online REM");
+  NS_TEST_ASSERT_MSG_EQ (offline.size (), online.size (), "Wrong number of points of the offline REM");
+  for (uint32_t i = 0; i < online.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (offline[i].x, online[i].x, "Different x of point " << i);
+      NS_TEST_ASSERT_MSG_EQ (offline[i].y, online[i].y, "Different y of point " << i);
+      NS_TEST_ASSERT_MSG_EQ_TOL (offline[i].sinr, online[i].sinr, online[i].sinr * 1e-4, "Different SINR of point " << i);
+    }
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief RadioEnvironmentMapHelper TestSuite
+ */
+class LteRadioEnvironmentMapTestSuite : public TestSuite
+{
+public:
+  LteRadioEnvironmentMapTestSuite ();
+};
+
+LteRadioEnvironmentMapTestSuite::LteRadioEnvironmentMapTestSuite ()
+  : TestSuite ("lte-radio-environment-map", SYSTEM)
+{
+  AddTestCase (new LteRadioEnvironmentMapTestCase (1), TestCase::QUICK);
+  AddTestCase (new LteRadioEnvironmentMapTestCase (3), TestCase::QUICK);
+}
+
+static LteRadioEnvironmentMapTestSuite g_lteRadioEnvironmentMapTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,229 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/lte-rlc-header.h"
+#include "ns3/lte-rlc-tag.h"
+#include "ns3/lte-rlc-sap.h"
+#include "ns3/lte-mac-sap.h"
+#include "ns3/lte-rlc-um.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Check the reassembly of the SDUs received by RLC UM when the
+ * sequence numbers wrap around.
+ *
+ * Every SDU is split in three UMD PDUs, which are given to the receiving
+ * RLC entity in the order of the test.  The PDU number n of the test has
+ * the SN n modulo 1024.  At the end, the t-Reordering timer delivers the
+ * SDUs left in the reception buffer.
+ */
+class LteRlcUmReceiverSnWrapTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param name the name of the test case
+   * \param pdus the PDU numbers, in the order of reception
+   * \param expectedSdus the numbers of the SDUs which must be delivered
+   */
+  LteRlcUmReceiverSnWrapTestCase (std::string name, std::vector<uint32_t> pdus, std::vector<uint32_t> expectedSdus);
+  virtual ~LteRlcUmReceiverSnWrapTestCase ();
+
+  /**
+   * Receive an SDU from the RLC entity
+   *
+   * \param p the SDU
+   */
+  void DoReceivePdcpPdu (Ptr<Packet> p);
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \param sdu the SDU number
+   * \return the data of the SDU
+   */
+  static std::string GetSduData (uint32_t sdu);
+  /**
+   * \param pdu the PDU number
+   * \return the UMD PDU, with the segment of its SDU
+   */
+  static Ptr<Packet> CreatePdu (uint32_t pdu);
+
+  static const uint32_t SEGMENTS_PER_SDU = 3; ///< number of PDUs of each SDU
+  static const uint32_t SEGMENT_SIZE = 10; ///< size of every segment
+
+  std::vector<uint32_t> m_pdus; ///< the PDU numbers, in the order of reception
+  std::vector<uint32_t> m_expectedSdus; ///< the SDUs which must be delivered
+  std::vector<std::string> m_receivedSdus; ///< the data of the SDUs delivered
+};
+
+LteRlcUmReceiverSnWrapTestCase::LteRlcUmReceiverSnWrapTestCase (std::string name, std::vector<uint32_t> pdus,
+                                                                std::vector<uint32_t> expectedSdus)
+  : TestCase (name),
+    m_pdus (pdus),
+    m_expectedSdus (expectedSdus)
+{
+}
+
+LteRlcUmReceiverSnWrapTestCase::~LteRlcUmReceiverSnWrapTestCase ()
+{
+}
+
+std::string
+LteRlcUmReceiverSnWrapTestCase::GetSduData (uint32_t sdu)
+{
+  std::ostringstream oss;
+  oss << "SDU " << sdu << " ";
+  std::string data = oss.str ();
+  data.resize (SEGMENTS_PER_SDU * SEGMENT_SIZE, (char) ('a' + sdu % 26));
+  return data;
+}
+
+Ptr<Packet>
+LteRlcUmReceiverSnWrapTestCase::CreatePdu (uint32_t pdu)
+{
+  uint32_t segment = pdu % SEGMENTS_PER_SDU;
+  std::string data = GetSduData (pdu / SEGMENTS_PER_SDU).substr (segment * SEGMENT_SIZE, SEGMENT_SIZE);
+  Ptr<Packet> packet = Create<Packet> ((const uint8_t *) data.data (), data.size ());
+
+  LteRlcHeader rlcHeader;
+  rlcHeader.PushExtensionBit (LteRlcHeader::DATA_FIELD_FOLLOWS);
+  rlcHeader.SetSequenceNumber (SequenceNumber10 (pdu % 1024));
+  uint8_t framingInfo = 0;
+  framingInfo |= (segment == 0) ? LteRlcHeader::FIRST_BYTE : LteRlcHeader::NO_FIRST_BYTE;
+  framingInfo |= (segment == SEGMENTS_PER_SDU - 1) ? LteRlcHeader::LAST_BYTE : LteRlcHeader::NO_LAST_BYTE;
+  rlcHeader.SetFramingInfo (framingInfo);
+  packet->AddHeader (rlcHeader);
+
+  RlcTag rlcTag (Simulator::Now ());
+  packet->AddByteTag (rlcTag, 1, rlcHeader.GetSerializedSize ());
+  return packet;
+}
+
+void
+LteRlcUmReceiverSnWrapTestCase::DoReceivePdcpPdu (Ptr<Packet> p)
+{
+  std::string data (p->GetSize (), ' ');
+  p->CopyData ((uint8_t *) &data[0], data.size ());
+  m_receivedSdus.push_back (data);
+}
+
+void
+LteRlcUmReceiverSnWrapTestCase::DoRun (void)
+{
+  uint16_t rnti = 1111;
+  uint8_t lcid = 222;
+
+  Ptr<LteRlc> rxRlc = CreateObject<LteRlcUm> ();
+  rxRlc->SetRnti (rnti);
+  rxRlc->SetLcId (lcid);
+  LteRlcSapUser *rlcSapUser = new LteRlcSpecificLteRlcSapUser<LteRlcUmReceiverSnWrapTestCase> (this);
+  rxRlc->SetLteRlcSapUser (rlcSapUser);
+
+  for (std::vector<uint32_t>::const_iterator it = m_pdus.begin (); it != m_pdus.end (); ++it)
+    {
+      LteMacSapUser::ReceivePduParameters rxPduParams (CreatePdu (*it), rnti, lcid);
+      rxRlc->GetLteMacSapUser ()->ReceivePdu (rxPduParams);
+    }
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_receivedSdus.size (), m_expectedSdus.size (), "Wrong number of SDUs delivered");
+  for (uint32_t i = 0; i < m_expectedSdus.size () && i < m_receivedSdus.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_receivedSdus[i], GetSduData (m_expectedSdus[i]), "Wrong SDU delivered at position " << i);
+    }
+
+  rxRlc->Dispose ();
+  delete rlcSapUser;
+  Simulator::Destroy ();
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief RLC UM receiver test suite
+ */
+class LteRlcUmReceiverTestSuite : public TestSuite
+{
+public:
+  LteRlcUmReceiverTestSuite ();
+};
+
+LteRlcUmReceiverTestSuite::LteRlcUmReceiverTestSuite ()
+  : TestSuite ("lte-rlc-um-receiver", UNIT)
+{
+  const uint32_t nSdus = 600;
+  const uint32_t nPdus = 3 * nSdus;
+
+  // the PDUs around the SN wraparound, SN 1016 to 7, are received in
+  // reverse order: they are all buffered until SN 1016 arrives, then
+  // reassembled in one go from VR(UR) across the wraparound
+  std::vector<uint32_t> pdus;
+  std::vector<uint32_t> sdus;
+  for (uint32_t pdu = 0; pdu < nPdus; pdu++)
+    {
+      pdus.push_back (pdu);
+    }
+  std::reverse (pdus.begin () + 1016, pdus.begin () + 1032);
+  for (uint32_t sdu = 0; sdu < nSdus; sdu++)
+    {
+      sdus.push_back (sdu);
+    }
+  AddTestCase (new LteRlcUmReceiverSnWrapTestCase ("Out of order PDUs across the SN wraparound", pdus, sdus),
+               TestCase::QUICK);
+
+  // PDU 1000 (SDU 333) is lost, PDUs 1001 to 1030 are buffered, then the
+  // SN jumps to 1540 (PDUs 1031 to 1539 are lost), which pushes PDUs 1001
+  // to 1028 out of the reordering window: they are reassembled in SN order
+  // across the wraparound.  SDU 343 lacks its last segment and SDU 513 its
+  // first one.
+  pdus.clear ();
+  sdus.clear ();
+  for (uint32_t pdu = 0; pdu < nPdus; pdu++)
+    {
+      if (pdu != 1000 && (pdu <= 1030 || pdu >= 1540))
+        {
+          pdus.push_back (pdu);
+        }
+    }
+  for (uint32_t sdu = 0; sdu < nSdus; sdu++)
+    {
+      if (sdu != 333 && sdu != 343 && (sdu <= 342 || sdu >= 514))
+        {
+          sdus.push_back (sdu);
+        }
+    }
+  AddTestCase (new LteRlcUmReceiverSnWrapTestCase ("PDUs pushed out of the reordering window across the SN wraparound", pdus, sdus),
+               TestCase::QUICK);
+}
+
+static LteRlcUmReceiverTestSuite g_lteRlcUmReceiverTestSuite; ///< the test suite
@@ -0,0 +1,417 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <vector>
+
+#include <ns3/test.h>
+#include <ns3/simulator.h>
+#include <ns3/config.h>
+#include <ns3/boolean.h>
+#include <ns3/double.h>
+#include <ns3/string.h>
+#include <ns3/uinteger.h>
+#include <ns3/mobility-helper.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/node-container.h>
+#include <ns3/net-device-container.h>
+#include <ns3/eps-bearer.h>
+#include <ns3/lte-helper.h>
+#include <ns3/lte-enb-net-device.h>
+#include <ns3/lte-enb-mac.h>
+#include <ns3/lte-enb-rrc.h>
+#include <ns3/lte-ue-net-device.h>
+#include <ns3/lte-ue-rrc.h>
+#include <ns3/ff-mac-scheduler-executor.h>
+
+using namespace ns3;
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Check that the executor computes all the jobs of a batch, then
+ * delivers their results in the order of submission.
+ */
+class FfMacSchedulerExecutorTestCase : public TestCase
+{
+public:
+  FfMacSchedulerExecutorTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Submit the jobs of a batch
+   * \param executor the executor
+   */
+  void SubmitJobs (Ptr<FfMacSchedulerExecutor> executor);
+  /**
+   * Compute a job
+   * \param test the test case
+   * \param job the index of the job
+   */
+  static void Compute (FfMacSchedulerExecutorTestCase *test, uint32_t job);
+  /**
+   * Deliver the result of a job
+   * \param test the test case
+   * \param job the index of the job
+   */
+  static void Deliver (FfMacSchedulerExecutorTestCase *test, uint32_t job);
+
+  std::vector<uint64_t> m_results;     //!< the results of the jobs
+  std::vector<uint32_t> m_deliveries;  //!< the indexes of the delivered jobs
+  bool m_computedBeforeDelivery;       //!< whether all the jobs were computed before the first delivery
+};
+
+FfMacSchedulerExecutorTestCase::FfMacSchedulerExecutorTestCase ()
+  : TestCase ("Check the batches of the FfMacSchedulerExecutor"),
+    m_computedBeforeDelivery (true)
+{
+}
+
+void
+FfMacSchedulerExecutorTestCase::SubmitJobs (Ptr<FfMacSchedulerExecutor> executor)
+{
+  for (uint32_t i = 0; i < m_results.size (); i++)
+    {
+      executor->Submit (MakeBoundCallback (&FfMacSchedulerExecutorTestCase::Compute, this, i),
+                        MakeBoundCallback (&FfMacSchedulerExecutorTestCase::Deliver, this, i));
+    }
+}
+
+void
+FfMacSchedulerExecutorTestCase::Compute (FfMacSchedulerExecutorTestCase *test, uint32_t job)
+{
+  uint64_t result = job;
+  for (uint32_t i = 0; i < 100000; i++)
+    {
+      result = result * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+  test->m_results[job] = result;
+}
+
+void
+FfMacSchedulerExecutorTestCase::Deliver (FfMacSchedulerExecutorTestCase *test, uint32_t job)
+{
+  for (uint32_t i = 0; i < test->m_results.size (); i++)
+    {
+      test->m_computedBeforeDelivery &= (test->m_results[i] != 0);
+    }
+  test->m_deliveries.push_back (job);
+}
+
+void
+FfMacSchedulerExecutorTestCase::DoRun (void)
+{
+  Ptr<FfMacSchedulerExecutor> executor = CreateObject<FfMacSchedulerExecutor> ();
+  executor->SetAttribute ("NumThreads", UintegerValue (4));
+  m_results.assign (20, 0);
+  Simulator::Schedule (MilliSeconds (1), &FfMacSchedulerExecutorTestCase::SubmitJobs, this, executor);
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_computedBeforeDelivery, true, "A job was delivered before all the jobs were computed");
+  NS_TEST_ASSERT_MSG_EQ (m_deliveries.size (), m_results.size (), "Wrong number of deliveries");
+  for (uint32_t i = 0; i < m_deliveries.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_deliveries[i], i, "The jobs are not delivered in the order of submission");
+    }
+  executor->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Check that the scheduling decisions of a multi-cell scenario do
+ * not depend on the number of threads running the schedulers.
+ */
+class LteSchedulerThreadsTestCase : public TestCase
+{
+public:
+  LteSchedulerThreadsTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /// A DL scheduling decision
+  struct Decision
+  {
+    int64_t time;   //!< the time of the decision, in ns
+    uint16_t cell;  //!< the index of the eNB
+    uint16_t rnti;  //!< the RNTI of the UE
+    uint8_t mcs;    //!< the MCS of the first TB
+    uint16_t size;  //!< the size of the first TB
+  };
+
+  /**
+   * Run the scenario
+   * \param threads the number of threads running the schedulers
+   * \return the DL scheduling decisions
+   */
+  std::vector<Decision> RunScenario (uint32_t threads);
+
+  /**
+   * Record a DL scheduling decision
+   * \param decisions the decisions
+   * \param cell the index of the eNB
+   * \param info the decision
+   */
+  static void DlScheduling (std::vector<Decision> *decisions, uint16_t cell, DlSchedulingCallbackInfo info);
+};
+
+LteSchedulerThreadsTestCase::LteSchedulerThreadsTestCase ()
+  : TestCase ("Check that the scheduling decisions do not depend on the number of scheduler threads")
+{
+}
+
+void
+LteSchedulerThreadsTestCase::DlScheduling (std::vector<Decision> *decisions, uint16_t cell, DlSchedulingCallbackInfo info)
+{
+  Decision d;
+  d.time = Simulator::Now ().GetNanoSeconds ();
+  d.cell = cell;
+  d.rnti = info.rnti;
+  d.mcs = info.mcsTb1;
+  d.size = info.sizeTb1;
+  decisions->push_back (d);
+}
+
+std::vector<LteSchedulerThreadsTestCase::Decision>
+LteSchedulerThreadsTestCase::RunScenario (uint32_t threads)
+{
+  Config::SetDefault ("ns3::LteHelper::UseIdealRrc", BooleanValue (true));
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("SchedulerThreads", UintegerValue (threads));
+  lteHelper->SetSchedulerType ("ns3::PfFfMacScheduler");
+
+  const uint16_t nEnbs = 3;
+  const uint16_t nUesPerEnb = 4;
+  NodeContainer enbNodes;
+  NodeContainer ueNodes;
+  enbNodes.Create (nEnbs);
+  ueNodes.Create (nEnbs * nUesPerEnb);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+  for (uint16_t i = 0; i < nEnbs; i++)
+    {
+      enbNodes.Get (i)->GetObject<MobilityModel> ()->SetPosition (Vector (1000.0 * i, 0, 0));
+      for (uint16_t u = 0; u < nUesPerEnb; u++)
+        {
+          ueNodes.Get (i * nUesPerEnb + u)->GetObject<MobilityModel> ()->SetPosition (Vector (1000.0 * i + 100.0 * (u + 1), 50.0, 0));
+        }
+    }
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  // both runs must draw the same random numbers
+  int64_t stream = 1;
+  stream += lteHelper->AssignStreams (enbDevs, stream);
+  stream += lteHelper->AssignStreams (ueDevs, stream);
+  for (uint16_t i = 0; i < nEnbs; i++)
+    {
+      for (uint16_t u = 0; u < nUesPerEnb; u++)
+        {
+          lteHelper->Attach (ueDevs.Get (i * nUesPerEnb + u), enbDevs.Get (i));
+        }
+    }
+  lteHelper->ActivateDataRadioBearer (ueDevs, EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+
+  std::vector<Decision> decisions;
+  for (uint16_t i = 0; i < nEnbs; i++)
+    {
+      Ptr<LteEnbMac> mac = enbDevs.Get (i)->GetObject<LteEnbNetDevice> ()->GetMac ();
+      mac->TraceConnectWithoutContext ("DlScheduling", MakeBoundCallback (&LteSchedulerThreadsTestCase::DlScheduling, &decisions, i));
+    }
+
+  Simulator::Stop (Seconds (0.3));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  return decisions;
+}
+
+void
+LteSchedulerThreadsTestCase::DoRun (void)
+{
+  std::vector<Decision> single = RunScenario (1);
+  std::vector<Decision> multi = RunScenario (3);
+
+  NS_TEST_ASSERT_MSG_GT (single.size (), 0, "No DL scheduling decisions");
+  NS_TEST_ASSERT_MSG_EQ (multi.size (), single.size (), "Different number of DL scheduling decisions");
+  for (uint32_t i = 0; i < single.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (multi[i].time, single[i].time, "Different time of decision " << i);
+      NS_TEST_ASSERT_MSG_EQ (multi[i].cell, single[i].cell, "Different cell of decision " << i);
+      NS_TEST_ASSERT_MSG_EQ (multi[i].rnti, single[i].rnti, "Different RNTI of decision " << i);
+      NS_TEST_ASSERT_MSG_EQ ((uint16_t) multi[i].mcs, (uint16_t) single[i].mcs, "Different MCS of decision " << i);
+      NS_TEST_ASSERT_MSG_EQ (multi[i].size, single[i].size, "Different TB size of decision " << i);
+    }
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Check that a UE can be removed from an eNB while the scheduler,
+ * run by the executor, is allocating it DL resources.
+ *
+ * The UE is removed after the subframe indication of the MAC, and before
+ * the batch running the scheduler: the allocation of the UE computed by
+ * the scheduler is delivered after the removal, and must be dropped.
+ */
+class LteSchedulerThreadsUeRemovalTestCase : public TestCase
+{
+public:
+  LteSchedulerThreadsUeRemovalTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Record a DL scheduling decision, and plan the removal of the UE
+   * \param test the test case
+   * \param info the decision
+   */
+  static void DlScheduling (LteSchedulerThreadsUeRemovalTestCase *test, DlSchedulingCallbackInfo info);
+  /**
+   * Remove the UE from the eNB, as after a radio link failure
+   * \param test the test case
+   */
+  static void RemoveUe (LteSchedulerThreadsUeRemovalTestCase *test);
+
+  Ptr<LteEnbRrc> m_enbRrc;        //!< the RRC of the eNB
+  Ptr<LteUeRrc> m_ueRrc;          //!< the RRC of the removed UE
+  Time m_removalTime;             //!< the time of the subframe in which the UE is removed
+  uint16_t m_rnti;                //!< the RNTI of the removed UE
+  bool m_removalScheduled;        //!< whether the removal has been scheduled
+  uint32_t m_allocationsBefore;   //!< the number of DL allocations of the UE before the removal
+  uint32_t m_allocationsAfter;    //!< the number of DL allocations of the UE after the removal
+  uint32_t m_otherAllocations;    //!< the number of DL allocations of the other UE after the removal
+};
+
+LteSchedulerThreadsUeRemovalTestCase::LteSchedulerThreadsUeRemovalTestCase ()
+  : TestCase ("Check the removal of a UE with DL traffic in flight in the deferred scheduler"),
+    m_removalTime (MilliSeconds (203)),
+    m_rnti (0),
+    m_removalScheduled (false),
+    m_allocationsBefore (0),
+    m_allocationsAfter (0),
+    m_otherAllocations (0)
+{
+}
+
+void
+LteSchedulerThreadsUeRemovalTestCase::DlScheduling (LteSchedulerThreadsUeRemovalTestCase *test, DlSchedulingCallbackInfo info)
+{
+  if (Simulator::Now () < test->m_removalTime)
+    {
+      if (info.rnti == test->m_ueRrc->GetRnti ())
+        {
+          test->m_allocationsBefore++;
+        }
+      if (!test->m_removalScheduled && Simulator::Now () + MilliSeconds (1) == test->m_removalTime)
+        {
+          // the decisions of a TTI are delivered after the end of the
+          // subframe has been scheduled: the removal runs after the subframe
+          // indication of the next TTI, but before the scheduler is run for
+          // it (except at a frame boundary, where the PHY starts the
+          // subframe later)
+          test->m_removalScheduled = true;
+          Simulator::Schedule (MilliSeconds (1), &LteSchedulerThreadsUeRemovalTestCase::RemoveUe, test);
+        }
+    }
+  else if (info.rnti == test->m_rnti)
+    {
+      test->m_allocationsAfter++;
+    }
+  else
+    {
+      test->m_otherAllocations++;
+    }
+}
+
+void
+LteSchedulerThreadsUeRemovalTestCase::RemoveUe (LteSchedulerThreadsUeRemovalTestCase *test)
+{
+  test->m_rnti = test->m_ueRrc->GetRnti ();
+  test->m_enbRrc->GetLteEnbRrcSapProvider ()->RecvIdealUeContextRemoveRequest (test->m_rnti);
+}
+
+void
+LteSchedulerThreadsUeRemovalTestCase::DoRun (void)
+{
+  Config::SetDefault ("ns3::LteHelper::UseIdealRrc", BooleanValue (true));
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("SchedulerThreads", UintegerValue (1));
+  lteHelper->SetSchedulerType ("ns3::PfFfMacScheduler");
+
+  NodeContainer enbNodes;
+  NodeContainer ueNodes;
+  enbNodes.Create (1);
+  ueNodes.Create (2);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+  ueNodes.Get (0)->GetObject<MobilityModel> ()->SetPosition (Vector (100.0, 0, 0));
+  ueNodes.Get (1)->GetObject<MobilityModel> ()->SetPosition (Vector (200.0, 0, 0));
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  lteHelper->Attach (ueDevs, enbDevs.Get (0));
+  // saturated DL traffic, with the RLC SM of the default bearer mapping
+  lteHelper->ActivateDataRadioBearer (ueDevs, EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+
+  Ptr<LteEnbNetDevice> enbDev = enbDevs.Get (0)->GetObject<LteEnbNetDevice> ();
+  m_enbRrc = enbDev->GetRrc ();
+  m_ueRrc = ueDevs.Get (0)->GetObject<LteUeNetDevice> ()->GetRrc ();
+  enbDev->GetMac ()->TraceConnectWithoutContext ("DlScheduling", MakeBoundCallback (&LteSchedulerThreadsUeRemovalTestCase::DlScheduling, this));
+
+  Simulator::Stop (m_removalTime + MilliSeconds (50));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_removalScheduled, true, "The removal of the UE has not been scheduled");
+  NS_TEST_ASSERT_MSG_GT (m_allocationsBefore, 0, "No DL allocations of the UE before its removal");
+  NS_TEST_ASSERT_MSG_EQ (m_allocationsAfter, 0, "DL allocations of the UE after its removal");
+  NS_TEST_ASSERT_MSG_GT (m_otherAllocations, 0, "No DL allocations of the other UE after the removal");
+  m_enbRrc = 0;
+  m_ueRrc = 0;
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief FfMacSchedulerExecutor TestSuite
+ */
+class LteSchedulerExecutorTestSuite : public TestSuite
+{
+public:
+  LteSchedulerExecutorTestSuite ();
+};
+
+LteSchedulerExecutorTestSuite::LteSchedulerExecutorTestSuite ()
+  : TestSuite ("lte-scheduler-executor", SYSTEM)
+{
+  AddTestCase (new FfMacSchedulerExecutorTestCase, TestCase::QUICK);
+  AddTestCase (new LteSchedulerThreadsTestCase, TestCase::QUICK);
+  AddTestCase (new LteSchedulerThreadsUeRemovalTestCase, TestCase::QUICK);
+}
+
+static LteSchedulerExecutorTestSuite g_lteSchedulerExecutorTestSuite; //!< Static variable for test initialization
@@ -332,6 +332,7 @@ RrcConnectionRequestTestCase::DoRun (void)
   // Remove header
   RrcConnectionRequestHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "The decoded message is not the whole packet");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionRequestHeader> (destination,"DESTINATION");
@@ -385,6 +386,7 @@ RrcConnectionSetupTestCase::DoRun (void)
   // remove header
   RrcConnectionSetupHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "The decoded message is not the whole packet");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionSetupHeader> (destination,"DESTINATION");
@@ -438,6 +440,7 @@ RrcConnectionSetupCompleteTestCase::DoRun (void)
   // Remove header
   RrcConnectionSetupCompleteHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "The decoded message is not the whole packet");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionSetupCompleteHeader> (destination,"DESTINATION");
@@ -490,6 +493,7 @@ RrcConnectionReconfigurationCompleteTestCase::DoRun (void)
   // remove header
   RrcConnectionReconfigurationCompleteHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "The decoded message is not the whole packet");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionReconfigurationCompleteHeader> (destination,"DESTINATION");
@@ -653,6 +657,7 @@ RrcConnectionReconfigurationTestCase::DoRun (void)
   // remove header
   RrcConnectionReconfigurationHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "The decoded message is not the whole packet");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionReconfigurationHeader> (destination,"DESTINATION");
@@ -771,6 +776,7 @@ HandoverPreparationInfoTestCase::DoRun (void)
   // remove header
   HandoverPreparationInfoHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "The decoded message is not the whole packet");
 
   // Log destination info
   TestUtils::LogPacketInfo<HandoverPreparationInfoHeader> (destination,"DESTINATION");
@@ -832,6 +838,7 @@ RrcConnectionReestablishmentRequestTestCase::DoRun (void)
   // remove header
   RrcConnectionReestablishmentRequestHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "The decoded message is not the whole packet");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionReestablishmentRequestHeader> (destination,"DESTINATION");
@@ -886,6 +893,7 @@ RrcConnectionReestablishmentTestCase::DoRun (void)
   // remove header
   RrcConnectionReestablishmentHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "The decoded message is not the whole packet");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionReestablishmentHeader> (destination,"DESTINATION");
@@ -938,6 +946,7 @@ RrcConnectionReestablishmentCompleteTestCase::DoRun (void)
   // remove header
   RrcConnectionReestablishmentCompleteHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "The decoded message is not the whole packet");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionReestablishmentCompleteHeader> (destination,"DESTINATION");
@@ -989,6 +998,7 @@ RrcConnectionRejectTestCase::DoRun (void)
   // remove header
   RrcConnectionRejectHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "The decoded message is not the whole packet");
 
   // Log destination info
   TestUtils::LogPacketInfo<RrcConnectionRejectHeader> (destination,"DESTINATION");
@@ -1057,6 +1067,7 @@ MeasurementReportTestCase::DoRun (void)
   // remove header
   MeasurementReportHeader destination;
   packet->RemoveHeader (destination);
+  NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), 0, "The decoded message is not the whole packet");
 
   // Log destination info
   TestUtils::LogPacketInfo<MeasurementReportHeader> (destination,"DESTINATION");
@@ -212,6 +212,87 @@ EpcTftClassifierTestCase::DoRun (void)
 
 
 
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case to check that the fragments of an IPv4 packet are
+ * classified with the ports of the first fragment, until the last
+ * fragment.
+ */
+class EpcTftClassifierFragmentTestCase : public TestCase
+{
+public:
+  EpcTftClassifierFragmentTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Classify an uplink fragment of a UDP packet
+   * \param c the EPC TFT classifier
+   * \param fragmentOffset the offset of the fragment, in bytes
+   * \param isLastFragment whether the fragment is the last one
+   * \return the identifier of the TFT of the fragment
+   */
+  uint32_t ClassifyFragment (Ptr<EpcTftClassifier> c, uint16_t fragmentOffset, bool isLastFragment);
+};
+
+EpcTftClassifierFragmentTestCase::EpcTftClassifierFragmentTestCase ()
+  : TestCase ("Check the classification of the fragments of an IPv4 packet")
+{
+}
+
+uint32_t
+EpcTftClassifierFragmentTestCase::ClassifyFragment (Ptr<EpcTftClassifier> c, uint16_t fragmentOffset, bool isLastFragment)
+{
+  Ptr<Packet> packet = Create<Packet> (1000);
+  if (fragmentOffset == 0)
+    {
+      UdpHeader udpHeader;
+      udpHeader.SetSourcePort (4000);
+      udpHeader.SetDestinationPort (5000);
+      packet->AddHeader (udpHeader);
+    }
+  Ipv4Header ipHeader;
+  ipHeader.SetSource (Ipv4Address ("1.1.1.1"));
+  ipHeader.SetDestination (Ipv4Address ("2.2.2.2"));
+  ipHeader.SetProtocol (UdpL4Protocol::PROT_NUMBER);
+  ipHeader.SetPayloadSize (packet->GetSize ());
+  ipHeader.SetIdentification (7);
+  ipHeader.SetFragmentOffset (fragmentOffset);
+  if (isLastFragment)
+    {
+      ipHeader.SetLastFragment ();
+    }
+  else
+    {
+      ipHeader.SetMoreFragments ();
+    }
+  packet->AddHeader (ipHeader);
+  return c->Classify (packet, EpcTft::UPLINK, Ipv4L3Protocol::PROT_NUMBER);
+}
+
+void
+EpcTftClassifierFragmentTestCase::DoRun (void)
+{
+  Ptr<EpcTftClassifier> c = Create<EpcTftClassifier> ();
+  c->Add (EpcTft::Default (), 1);
+  Ptr<EpcTft> tft = Create<EpcTft> ();
+  EpcTft::PacketFilter pf;
+  pf.remotePortStart = 5000;
+  pf.remotePortEnd = 5000;
+  tft->Add (pf);
+  c->Add (tft, 2);
+
+  NS_TEST_ASSERT_MSG_EQ (ClassifyFragment (c, 0, false), 2, "bad classification of the first fragment");
+  NS_TEST_ASSERT_MSG_EQ (ClassifyFragment (c, 1008, false), 2, "bad classification of a middle fragment");
+  NS_TEST_ASSERT_MSG_EQ (ClassifyFragment (c, 2016, true), 2, "bad classification of the last fragment");
+  // the port info is deleted with the last fragment
+  NS_TEST_ASSERT_MSG_EQ (ClassifyFragment (c, 2016, true), 1, "port info kept after the last fragment");
+}
+
+
 /**
  * \ingroup lte-test
  * \ingroup tests
@@ -430,4 +511,5 @@ EpcTftClassifierTestSuite::EpcTftClassifierTestSuite ()
       AddTestCase (new EpcTftClassifierTestCase (c4, EpcTft::UPLINK,   "9.1.1.1", "8.1.1.1",     9,     5897,     0,    2, useIpv6), TestCase::QUICK);
       AddTestCase (new EpcTftClassifierTestCase (c4, EpcTft::DOWNLINK, "9.1.1.1", "8.1.1.1",  5897,       10,     0,    2, useIpv6), TestCase::QUICK);
     }
+  AddTestCase (new EpcTftClassifierFragmentTestCase, TestCase::QUICK);
 }
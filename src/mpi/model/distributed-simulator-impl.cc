@@ -120,6 +120,7 @@ DistributedSimulatorImpl::DistributedSimulatorImpl ()
   m_currentTs = 0;
   m_currentContext = Simulator::NO_CONTEXT;
   m_unscheduledEvents = 0;
+  m_cancelledEvents = 0;
   m_eventCount = 0;
   m_events = 0;
 }
@@ -317,6 +318,10 @@ DistributedSimulatorImpl::ProcessOneEvent (void)
   NS_ASSERT (next.key.m_ts >= m_currentTs);
   m_unscheduledEvents--;
   m_eventCount++;
+  if (next.impl->IsCancelled ())
+    {
+      m_cancelledEvents--;
+    }
 
   NS_LOG_LOGIC ("handle " << next.key.m_ts);
   m_currentTs = next.key.m_ts;
@@ -589,6 +594,12 @@ DistributedSimulatorImpl::Cancel (const EventId &id)
   if (!IsExpired (id))
     {
       id.PeekEventImpl ()->Cancel ();
+      // destroy events and events not scheduled by this simulator
+      // are not in the event list
+      if (id.GetUid () >= 4 && id.GetUid () < m_uid)
+        {
+          m_cancelledEvents++;
+        }
     }
 }
 
@@ -646,4 +657,16 @@ DistributedSimulatorImpl::GetEventCount (void) const
   return m_eventCount;
 }
 
+uint32_t
+DistributedSimulatorImpl::GetPendingEventCount (void) const
+{
+  return m_unscheduledEvents - m_cancelledEvents;
+}
+
+uint32_t
+DistributedSimulatorImpl::GetCancelledEventCount (void) const
+{
+  return m_cancelledEvents;
+}
+
 } // namespace ns3
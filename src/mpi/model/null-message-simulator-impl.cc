@@ -89,6 +89,7 @@ NullMessageSimulatorImpl::NullMessageSimulatorImpl ()
   m_currentTs = 0;
   m_currentContext = Simulator::NO_CONTEXT;
   m_unscheduledEvents = 0;
+  m_cancelledEvents = 0;
   m_eventCount = 0;
   m_events = 0;
 
@@ -238,6 +239,10 @@ NullMessageSimulatorImpl::ProcessOneEvent (void)
   NS_ASSERT (next.key.m_ts >= m_currentTs);
   m_unscheduledEvents--;
   m_eventCount++;
+  if (next.impl->IsCancelled ())
+    {
+      m_cancelledEvents--;
+    }
 
   NS_LOG_LOGIC ("handle " << next.key.m_ts);
   m_currentTs = next.key.m_ts;
@@ -519,6 +524,12 @@ NullMessageSimulatorImpl::Cancel (const EventId &id)
   if (!IsExpired (id))
     {
       id.PeekEventImpl ()->Cancel ();
+      // destroy events and events not scheduled by this simulator
+      // are not in the event list
+      if (id.GetUid () >= 4 && id.GetUid () < m_uid)
+        {
+          m_cancelledEvents++;
+        }
     }
 }
 
@@ -576,6 +587,18 @@ NullMessageSimulatorImpl::GetEventCount (void) const
   return m_eventCount;
 }
 
+uint32_t
+NullMessageSimulatorImpl::GetPendingEventCount (void) const
+{
+  return m_unscheduledEvents - m_cancelledEvents;
+}
+
+uint32_t
+NullMessageSimulatorImpl::GetCancelledEventCount (void) const
+{
+  return m_cancelledEvents;
+}
+
 Time NullMessageSimulatorImpl::CalculateGuaranteeTime (uint32_t nodeSysId)
 {
   Ptr<RemoteChannelBundle> bundle = RemoteChannelBundleManager::Find (nodeSysId);
@@ -84,6 +84,8 @@ public:
   virtual uint32_t GetSystemId (void) const;
   virtual uint32_t GetContext (void) const;
   virtual uint64_t GetEventCount (void) const;
+  virtual uint32_t GetPendingEventCount (void) const;
+  virtual uint32_t GetCancelledEventCount (void) const;
 
   /**
    * \return singleton instance
@@ -205,6 +207,8 @@ private:
    * not counting the "destroy" events; this is used for validation.
    */
   int m_unscheduledEvents;
+  /** Number of cancelled events in the event list. */
+  uint32_t m_cancelledEvents;
 
   uint32_t     m_myId;        /**< MPI rank. */
   uint32_t     m_systemCount; /**< MPI communicator size. */
@@ -33,6 +33,8 @@
 #include <string>
 #include <iomanip>
 #include <map>
+#include <cmath>
+#include <cstring>
 
 // ns3 includes
 #include "ns3/animation-interface.h"
@@ -59,8 +61,15 @@
 #include "ns3/ipv6.h"
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/energy-source-container.h"
+#include "ns3/core-config.h"
 #include "animation-interface.h"
 
+#ifdef HAVE_PTHREAD_H
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("AnimationInterface");
@@ -69,6 +78,250 @@ NS_LOG_COMPONENT_DEFINE ("AnimationInterface");
 
 static bool initialized = false; //!< Initialization flag
 
+namespace {
+
+/// First bytes of a binary trace file
+const char BINARY_MAGIC[8] = {'N', 'S', '3', 'A', 'N', 'I', 'M', '1'};
+
+/// Types of the records of a binary trace file
+enum BinaryRecordType
+{
+  BINARY_XML = 0,      //!< XML text
+  BINARY_P = 1,        //!< packet, see WriteXmlP
+  BINARY_PR = 2,       //!< wireless packet transmission, see WriteXmlPRef
+  BINARY_WPR = 3,      //!< wireless packet reception, see WriteXmlP
+  BINARY_POSITION = 4  //!< node position update, see WriteXmlUpdateNodePosition
+};
+
+/**
+ * \brief Append an unsigned integer to a binary record, 7 bits per byte
+ * \param record the record
+ * \param value the value
+ */
+void
+AppendVarint (std::string &record, uint64_t value)
+{
+  while (value >= 0x80)
+    {
+      record.push_back (static_cast<char> ((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+  record.push_back (static_cast<char> (value));
+}
+
+/**
+ * \brief Append a signed integer to a binary record, small magnitudes first
+ * \param record the record
+ * \param value the value
+ */
+void
+AppendSignedVarint (std::string &record, int64_t value)
+{
+  AppendVarint (record, (static_cast<uint64_t> (value) << 1) ^ static_cast<uint64_t> (value >> 63));
+}
+
+/**
+ * \brief Append a double to a binary record, in little endian order
+ * \param record the record
+ * \param value the value
+ */
+void
+AppendDouble (std::string &record, double value)
+{
+  uint64_t bits;
+  std::memcpy (&bits, &value, sizeof (bits));
+  for (uint32_t i = 0; i < 8; ++i)
+    {
+      record.push_back (static_cast<char> ((bits >> (8 * i)) & 0xff));
+    }
+}
+
+/**
+ * \brief Append a string to a binary record, preceded by its length
+ * \param record the record
+ * \param value the value
+ */
+void
+AppendString (std::string &record, const std::string &value)
+{
+  AppendVarint (record, value.size ());
+  record.append (value);
+}
+
+/**
+ * \brief Read an unsigned integer written by AppendVarint
+ * \param is the input stream
+ * \param [out] value the value
+ * \returns false at the end of the stream
+ */
+bool
+ReadVarint (std::istream &is, uint64_t &value)
+{
+  value = 0;
+  for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+      int byte = is.get ();
+      if (byte == std::char_traits<char>::eof ())
+        {
+          return false;
+        }
+      value |= static_cast<uint64_t> (byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+/**
+ * \brief Read a signed integer written by AppendSignedVarint
+ * \param is the input stream
+ * \param [out] value the value
+ * \returns false at the end of the stream
+ */
+bool
+ReadSignedVarint (std::istream &is, int64_t &value)
+{
+  uint64_t v;
+  if (!ReadVarint (is, v))
+    {
+      return false;
+    }
+  value = static_cast<int64_t> (v >> 1) ^ -static_cast<int64_t> (v & 1);
+  return true;
+}
+
+/**
+ * \brief Read a double written by AppendDouble
+ * \param is the input stream
+ * \param [out] value the value
+ * \returns false at the end of the stream
+ */
+bool
+ReadDouble (std::istream &is, double &value)
+{
+  uint8_t bytes[8];
+  if (!is.read (reinterpret_cast<char *> (bytes), 8))
+    {
+      return false;
+    }
+  uint64_t bits = 0;
+  for (uint32_t i = 0; i < 8; ++i)
+    {
+      bits |= static_cast<uint64_t> (bytes[i]) << (8 * i);
+    }
+  std::memcpy (&value, &bits, sizeof (value));
+  return true;
+}
+
+/**
+ * \brief Read a string written by AppendString
+ * \param is the input stream
+ * \param [out] value the value
+ * \returns false at the end of the stream
+ */
+bool
+ReadString (std::istream &is, std::string &value)
+{
+  uint64_t size;
+  if (!ReadVarint (is, size))
+    {
+      return false;
+    }
+  value.resize (size);
+  return size == 0 || is.read (&value[0], size);
+}
+
+} // unnamed namespace
+
+#ifdef HAVE_PTHREAD_H
+/**
+ * \brief The thread writing the output buffers of an AnimationInterface
+ *
+ * The output buffer is handed over by swapping it with the spare buffer
+ * of the writer, which is written to the trace file in the background.
+ */
+class AnimationInterface::Writer
+{
+public:
+  Writer ()
+    : m_file (0),
+      m_busy (false),
+      m_stop (false),
+      m_thread (&Writer::Run, this)
+  {}
+
+  ~Writer ()
+  {
+    {
+      std::unique_lock<std::mutex> lock (m_mutex);
+      m_done.wait (lock, [this] { return !m_busy; });
+      m_stop = true;
+      m_work.notify_one ();
+    }
+    m_thread.join ();
+  }
+
+  /**
+   * \brief Write a buffer in the background
+   * \param buffer [in,out] the buffer, replaced by an empty one
+   * \param file the trace file
+   */
+  void Submit (std::string &buffer, FILE *file)
+  {
+    Wait ();
+    m_buffer.swap (buffer);
+    buffer.clear ();
+    std::unique_lock<std::mutex> lock (m_mutex);
+    m_file = file;
+    m_busy = true;
+    m_work.notify_one ();
+  }
+
+  /**
+   * \brief Wait until the submitted buffer has been written
+   */
+  void Wait (void)
+  {
+    std::unique_lock<std::mutex> lock (m_mutex);
+    m_done.wait (lock, [this] { return !m_busy; });
+  }
+
+private:
+  /**
+   * \brief Write the submitted buffers until the writer is destroyed
+   */
+  void Run (void)
+  {
+    std::unique_lock<std::mutex> lock (m_mutex);
+    while (true)
+      {
+        m_work.wait (lock, [this] { return m_stop || m_busy; });
+        if (!m_busy)
+          {
+            return;
+          }
+        lock.unlock ();
+        std::fwrite (m_buffer.data (), 1, m_buffer.size (), m_file);
+        m_buffer.clear ();
+        lock.lock ();
+        m_busy = false;
+        m_done.notify_all ();
+      }
+  }
+
+  std::string m_buffer;             //!< the buffer being written
+  FILE *m_file;                     //!< the file the buffer is written to
+  std::mutex m_mutex;               //!< protects m_busy and m_stop
+  std::condition_variable m_work;   //!< signaled when a buffer is submitted
+  std::condition_variable m_done;   //!< signaled when a buffer has been written
+  bool m_busy;                      //!< whether a buffer is being written
+  bool m_stop;                      //!< whether the thread must exit
+  std::thread m_thread;             //!< the writer thread
+};
+#endif /* HAVE_PTHREAD_H */
+
 
 // Public methods
 
@@ -88,7 +341,12 @@ AnimationInterface::AnimationInterface (const std::string fn)
     m_routingStopTime (Seconds (0)),
     m_routingFileName (""),
     m_routingPollInterval (Seconds (5)),
-    m_trackPackets (true)
+    m_trackPackets (true),
+    m_mobilityPolling (true),
+    m_packetSampling (1),
+    m_binaryOutput (false),
+    m_outputBufferSize (0),
+    m_writer (0)
 {
   initialized = true;
   StartAnimation ();
@@ -97,6 +355,9 @@ AnimationInterface::AnimationInterface (const std::string fn)
 AnimationInterface::~AnimationInterface ()
 {
   StopAnimation ();
+#ifdef HAVE_PTHREAD_H
+  delete m_writer;
+#endif
 }
 
 void
@@ -292,6 +553,50 @@ AnimationInterface::SetMobilityPollInterval (Time t)
   m_mobilityPollInterval = t;
 }
 
+void
+AnimationInterface::EnableMobilityPolling (bool enable)
+{
+  m_mobilityPolling = enable;
+}
+
+void
+AnimationInterface::SetPacketSampling (uint32_t n)
+{
+  NS_ASSERT (n > 0);
+  m_packetSampling = n;
+}
+
+bool
+AnimationInterface::IsSampled (uint64_t uid) const
+{
+  return m_packetSampling == 1 || uid % m_packetSampling == 0;
+}
+
+void
+AnimationInterface::EnableBinaryOutput (void)
+{
+  if (m_binaryOutput)
+    {
+      return;
+    }
+  NS_LOG_INFO ("Restarting the animation in the binary format");
+  bool started = m_started;
+  StopAnimation (true);
+  m_binaryOutput = true;
+  if (started)
+    {
+      StartAnimation (true);
+    }
+}
+
+void
+AnimationInterface::SetOutputBufferSize (uint32_t size)
+{
+  FlushOutputBuffer (true);
+  m_outputBufferSize = size;
+  m_outputBuffer.reserve (size);
+}
+
 
 void
 AnimationInterface::SetConstantPosition (Ptr <Node> n, double x, double y, double z)
@@ -420,6 +725,11 @@ AnimationInterface::MobilityCourseChangeTrace (Ptr <const MobilityModel> mobilit
     {
       v = mobility->GetPosition ();
     }
+  std::map <uint32_t, Vector>::const_iterator it = m_nodeLocation.find (n->GetId ());
+  if (it != m_nodeLocation.end () && it->second == v)
+    {
+      return; // only the velocity has changed
+    }
   UpdatePosition (n, v);
   WriteXmlUpdateNodePosition (n->GetId (), v.x, v.y);
 }
@@ -445,13 +755,16 @@ void
 AnimationInterface::MobilityAutoCheck ()
 {
   CHECK_STARTED_INTIMEWINDOW;
-  std::vector <Ptr <Node> > MovedNodes = GetMovedNodes ();
-  for (uint32_t i = 0; i < MovedNodes.size (); i++)
+  if (m_mobilityPolling)
     {
-      Ptr <Node> n = MovedNodes [i];
-      NS_ASSERT (n);
-      Vector v = GetPosition (n);
-      WriteXmlUpdateNodePosition (n->GetId (), v.x, v.y);
+      std::vector <Ptr <Node> > MovedNodes = GetMovedNodes ();
+      for (uint32_t i = 0; i < MovedNodes.size (); i++)
+        {
+          Ptr <Node> n = MovedNodes [i];
+          NS_ASSERT (n);
+          Vector v = GetPosition (n);
+          WriteXmlUpdateNodePosition (n->GetId (), v.x, v.y);
+        }
     }
   if (!Simulator::IsFinished ())
     {
@@ -507,6 +820,12 @@ AnimationInterface::WriteN (const std::string& st, FILE * f)
     {
       m_writeCallback (st.c_str ());
     }
+  if (m_binaryOutput && f == m_f)
+    {
+      m_record.assign (1, BINARY_XML);
+      AppendString (m_record, st);
+      return WriteN (m_record.data (), m_record.size (), f);
+    }
   return WriteN (st.c_str (), st.length (), f);
 }
 
@@ -517,6 +836,15 @@ AnimationInterface::WriteN (const char* data, uint32_t count, FILE * f)
     {
       return 0;
     }
+  if (m_outputBufferSize > 0 && f == m_f)
+    {
+      m_outputBuffer.append (data, count);
+      if (m_outputBuffer.size () >= m_outputBufferSize)
+        {
+          FlushOutputBuffer (false);
+        }
+      return count;
+    }
   // Write count bytes to h from data
   uint32_t    nLeft   = count;
   const char* p       = data;
@@ -535,6 +863,38 @@ AnimationInterface::WriteN (const char* data, uint32_t count, FILE * f)
   return written;
 }
 
+void
+AnimationInterface::FlushOutputBuffer (bool wait)
+{
+  if (!m_f)
+    {
+      return;
+    }
+#ifdef HAVE_PTHREAD_H
+  if (!m_outputBuffer.empty ())
+    {
+      if (!m_writer)
+        {
+          m_writer = new Writer;
+        }
+      m_writer->Submit (m_outputBuffer, m_f);
+    }
+  if (wait && m_writer)
+    {
+      m_writer->Wait ();
+    }
+#else
+  std::fwrite (m_outputBuffer.data (), 1, m_outputBuffer.size (), m_f);
+  m_outputBuffer.clear ();
+#endif
+}
+
+void
+AnimationInterface::WriteBinaryRecord (void)
+{
+  WriteN (m_record.data (), m_record.size (), m_f);
+}
+
 void
 AnimationInterface::WriteRoutePath (uint32_t nodeId, std::string destination, Ipv4RoutePathElements rpElements)
 {
@@ -787,6 +1147,10 @@ AnimationInterface::DevTxTrace (std::string context,
   CHECK_STARTED_INTIMEWINDOW_TRACKPACKETS;
   NS_ASSERT (tx);
   NS_ASSERT (rx);
+  if (!IsSampled (p->GetUid ()))
+    {
+      return;
+    }
   Time now = Simulator::Now ();
   double fbTx = now.GetSeconds ();
   double lbTx = (now + txTime).GetSeconds ();
@@ -815,6 +1179,10 @@ AnimationInterface::GenericWirelessTxTrace (std::string context, Ptr<const Packe
   ++gAnimUid;
   NS_LOG_INFO (ProtocolTypeToString (protocolType).c_str () << " GenericWirelessTxTrace for packet:" << gAnimUid);
   AddByteTag (gAnimUid, p);
+  if (!IsSampled (gAnimUid))
+    {
+      return;
+    }
   AnimPacketInfo pktInfo (ndev, Simulator::Now ());
   AddPendingPacket (protocolType, gAnimUid, pktInfo);
 
@@ -842,6 +1210,10 @@ AnimationInterface::GenericWirelessRxTrace (std::string context, Ptr<const Packe
   NS_ASSERT (ndev);
   UpdatePosition (ndev);
   uint64_t animUid = GetAnimUidFromPacket (p);
+  if (!IsSampled (animUid))
+    {
+      return;
+    }
   NS_LOG_INFO (ProtocolTypeToString (protocolType).c_str () << " for packet:" << animUid);
   if (!IsPacketPending (animUid, protocolType))
     {
@@ -886,6 +1258,10 @@ AnimationInterface::WifiPhyTxBeginTrace (std::string context, WifiConstPsduMap p
           ++gAnimUid;
           NS_LOG_INFO ("WifiPhyTxTrace for MPDU:" << gAnimUid);
           AddByteTag (gAnimUid, mpdu->GetPacket ()); //the underlying MSDU/A-MSDU should be handed off
+          if (!IsSampled (gAnimUid))
+            {
+              continue;
+            }
           AddPendingPacket (WIFI, gAnimUid, pktInfo);
           OutputWirelessPacketTxInfo (mpdu->GetProtocolDataUnit (), pendingPackets->at (gAnimUid), gAnimUid); //PDU should be considered in order to have header
         }
@@ -917,6 +1293,10 @@ AnimationInterface::WifiPhyRxBeginTrace (std::string context, Ptr<const Packet>
   NS_ASSERT (ndev);
   UpdatePosition (ndev);
   uint64_t animUid = GetAnimUidFromPacket (p);
+  if (!IsSampled (animUid))
+    {
+      return;
+    }
   NS_LOG_INFO ("Wifi RxBeginTrace for packet: " << animUid);
   if (!IsPacketPending (animUid, AnimationInterface::WIFI))
     {
@@ -990,6 +1370,10 @@ AnimationInterface::LrWpanPhyTxBeginTrace (std::string context,
   ++gAnimUid;
   NS_LOG_INFO ("LrWpan TxBeginTrace for packet:" << gAnimUid);
   AddByteTag (gAnimUid, p);
+  if (!IsSampled (gAnimUid))
+    {
+      return;
+    }
 
   AnimPacketInfo pktInfo (ndev, Simulator::Now ());
   AddPendingPacket (AnimationInterface::LRWPAN, gAnimUid, pktInfo);
@@ -1015,6 +1399,10 @@ AnimationInterface::LrWpanPhyRxBeginTrace (std::string context,
     }
 
   uint64_t animUid = GetAnimUidFromPacket (p);
+  if (!IsSampled (animUid))
+    {
+      return;
+    }
   NS_LOG_INFO ("LrWpan RxBeginTrace for packet:" << animUid);
   if (!IsPacketPending (animUid, AnimationInterface::LRWPAN))
     {
@@ -1042,6 +1430,10 @@ AnimationInterface::WavePhyRxBeginTrace (std::string context, Ptr<const Packet>
   NS_ASSERT (ndev);
   UpdatePosition (ndev);
   uint64_t animUid = GetAnimUidFromPacket (p);
+  if (!IsSampled (animUid))
+    {
+      return;
+    }
   NS_LOG_INFO ("Wave RxBeginTrace for packet:" << animUid);
   if (!IsPacketPending (animUid, AnimationInterface::WAVE))
     {
@@ -1125,6 +1517,10 @@ AnimationInterface::LteSpectrumPhyTxStart (std::string context, Ptr<const Packet
       NS_LOG_INFO ("LteSpectrumPhyTxTrace for packet:" << gAnimUid);
       AnimPacketInfo pktInfo (ndev, Simulator::Now ());
       AddByteTag (gAnimUid, p);
+      if (!IsSampled (gAnimUid))
+        {
+          continue;
+        }
       AddPendingPacket (AnimationInterface::LTE, gAnimUid, pktInfo);
       OutputWirelessPacketTxInfo (p, pktInfo, gAnimUid);
     }
@@ -1152,6 +1548,10 @@ AnimationInterface::LteSpectrumPhyRxStart (std::string context, Ptr<const Packet
     {
       Ptr <Packet> p = *i;
       uint64_t animUid = GetAnimUidFromPacket (p);
+      if (!IsSampled (animUid))
+        {
+          continue;
+        }
       NS_LOG_INFO ("LteSpectrumPhyRxTrace for packet:" << gAnimUid);
       if (!IsPacketPending (animUid, AnimationInterface::LTE))
         {
@@ -1175,6 +1575,10 @@ AnimationInterface::CsmaPhyTxBeginTrace (std::string context, Ptr<const Packet>
   ++gAnimUid;
   NS_LOG_INFO ("CsmaPhyTxBeginTrace for packet:" << gAnimUid);
   AddByteTag (gAnimUid, p);
+  if (!IsSampled (gAnimUid))
+    {
+      return;
+    }
   UpdatePosition (ndev);
   AnimPacketInfo pktInfo (ndev, Simulator::Now ());
   AddPendingPacket (AnimationInterface::CSMA, gAnimUid, pktInfo);
@@ -1191,6 +1595,10 @@ AnimationInterface::CsmaPhyTxEndTrace (std::string context, Ptr<const Packet> p)
   NS_ASSERT (ndev);
   UpdatePosition (ndev);
   uint64_t animUid = GetAnimUidFromPacket (p);
+  if (!IsSampled (animUid))
+    {
+      return;
+    }
   NS_LOG_INFO ("CsmaPhyTxEndTrace for packet:" << animUid);
   if (!IsPacketPending (animUid, AnimationInterface::CSMA))
     {
@@ -1214,6 +1622,10 @@ AnimationInterface::CsmaPhyRxEndTrace (std::string context, Ptr<const Packet> p)
   NS_ASSERT (ndev);
   UpdatePosition (ndev);
   uint64_t animUid = GetAnimUidFromPacket (p);
+  if (!IsSampled (animUid))
+    {
+      return;
+    }
   if (!IsPacketPending (animUid, AnimationInterface::CSMA))
     {
       NS_LOG_WARN ("CsmaPhyRxEndTrace: unknown Uid");
@@ -1236,6 +1648,10 @@ AnimationInterface::CsmaMacRxTrace (std::string context,
   Ptr <NetDevice> ndev = GetNetDeviceFromContext (context);
   NS_ASSERT (ndev);
   uint64_t animUid = GetAnimUidFromPacket (p);
+  if (!IsSampled (animUid))
+    {
+      return;
+    }
   if (!IsPacketPending (animUid, AnimationInterface::CSMA))
     {
       NS_LOG_WARN ("CsmaMacRxTrace: unknown Uid");
@@ -1474,6 +1890,7 @@ AnimationInterface::StopAnimation (bool onlyAnimation)
     {
       // Terminate the anim element
       WriteXmlClose ("anim");
+      FlushOutputBuffer (true);
       std::fclose (m_f);
       m_f = 0;
     }
@@ -1495,6 +1912,11 @@ AnimationInterface::StartAnimation (bool restart)
   m_currentPktCount = 0;
   m_started = true;
   SetOutputFile (m_outputFileName);
+  if (m_binaryOutput)
+    {
+      m_binaryPositions.clear ();
+      WriteN (BINARY_MAGIC, sizeof (BINARY_MAGIC), m_f);
+    }
   WriteXmlAnim ();
   WriteNodes ();
   WriteNodeColors ();
@@ -2578,6 +3000,22 @@ AnimationInterface::WriteXmlRp (uint32_t nodeId, std::string destination, Ipv4Ro
 
 void
 AnimationInterface::WriteXmlPRef (uint64_t animUid, uint32_t fId, double fbTx, std::string metaInfo)
+{
+  if (m_binaryOutput)
+    {
+      m_record.assign (1, BINARY_PR);
+      AppendVarint (m_record, animUid);
+      AppendVarint (m_record, fId);
+      AppendDouble (m_record, fbTx);
+      AppendString (m_record, metaInfo);
+      WriteBinaryRecord ();
+      return;
+    }
+  WriteN (GetXmlPRef (animUid, fId, fbTx, metaInfo),  m_f);
+}
+
+std::string
+AnimationInterface::GetXmlPRef (uint64_t animUid, uint32_t fId, double fbTx, std::string metaInfo)
 {
   AnimXmlElement element ("pr");
   element.AddAttribute ("uId", animUid);
@@ -2587,23 +3025,59 @@ AnimationInterface::WriteXmlPRef (uint64_t animUid, uint32_t fId, double fbTx, s
     {
       element.AddAttribute ("meta-info", metaInfo.c_str (), true);
     }
-  WriteN (element.ToString (),  m_f);
+  return element.ToString ();
 }
 
 void
 AnimationInterface::WriteXmlP (uint64_t animUid, std::string pktType, uint32_t tId, double fbRx, double lbRx)
+{
+  if (m_binaryOutput && pktType == "wpr")
+    {
+      m_record.assign (1, BINARY_WPR);
+      AppendVarint (m_record, animUid);
+      AppendVarint (m_record, tId);
+      AppendDouble (m_record, fbRx);
+      AppendDouble (m_record, lbRx);
+      WriteBinaryRecord ();
+      return;
+    }
+  WriteN (GetXmlP (animUid, pktType, tId, fbRx, lbRx),  m_f);
+}
+
+std::string
+AnimationInterface::GetXmlP (uint64_t animUid, std::string pktType, uint32_t tId, double fbRx, double lbRx)
 {
   AnimXmlElement element (pktType);
   element.AddAttribute ("uId", animUid);
   element.AddAttribute ("tId", tId);
   element.AddAttribute ("fbRx", fbRx);
   element.AddAttribute ("lbRx", lbRx);
-  WriteN (element.ToString (),  m_f);
+  return element.ToString ();
 }
 
 void
 AnimationInterface::WriteXmlP (std::string pktType, uint32_t fId, double fbTx, double lbTx,
                                uint32_t tId, double fbRx, double lbRx, std::string metaInfo)
+{
+  if (m_binaryOutput && pktType == "p")
+    {
+      m_record.assign (1, BINARY_P);
+      AppendVarint (m_record, fId);
+      AppendDouble (m_record, fbTx);
+      AppendDouble (m_record, lbTx);
+      AppendVarint (m_record, tId);
+      AppendDouble (m_record, fbRx);
+      AppendDouble (m_record, lbRx);
+      AppendString (m_record, metaInfo);
+      WriteBinaryRecord ();
+      return;
+    }
+  WriteN (GetXmlP (pktType, fId, fbTx, lbTx, tId, fbRx, lbRx, metaInfo),  m_f);
+}
+
+std::string
+AnimationInterface::GetXmlP (std::string pktType, uint32_t fId, double fbTx, double lbTx,
+                             uint32_t tId, double fbRx, double lbRx, std::string metaInfo)
 {
   AnimXmlElement element (pktType);
   element.AddAttribute ("fId", fId);
@@ -2616,7 +3090,7 @@ AnimationInterface::WriteXmlP (std::string pktType, uint32_t fId, double fbTx, d
   element.AddAttribute ("tId", tId);
   element.AddAttribute ("fbRx", fbRx);
   element.AddAttribute ("lbRx", lbRx);
-  WriteN (element.ToString (),  m_f);
+  return element.ToString ();
 }
 
 void
@@ -2663,14 +3137,34 @@ AnimationInterface::WriteXmlUpdateNodeSize (uint32_t nodeId, double width, doubl
 
 void
 AnimationInterface::WriteXmlUpdateNodePosition (uint32_t nodeId, double x, double y)
+{
+  if (m_binaryOutput)
+    {
+      std::pair <int64_t, int64_t> &last = m_binaryPositions[nodeId];
+      int64_t xMm = std::llround (x * 1000);
+      int64_t yMm = std::llround (y * 1000);
+      m_record.assign (1, BINARY_POSITION);
+      AppendDouble (m_record, Simulator::Now ().GetSeconds ());
+      AppendVarint (m_record, nodeId);
+      AppendSignedVarint (m_record, xMm - last.first);
+      AppendSignedVarint (m_record, yMm - last.second);
+      WriteBinaryRecord ();
+      last = std::make_pair (xMm, yMm);
+      return;
+    }
+  WriteN (GetXmlUpdateNodePosition (Simulator::Now ().GetSeconds (), nodeId, x, y), m_f);
+}
+
+std::string
+AnimationInterface::GetXmlUpdateNodePosition (double t, uint32_t nodeId, double x, double y)
 {
   AnimXmlElement element ("nu");
   element.AddAttribute ("p", "p");
-  element.AddAttribute ("t", Simulator::Now ().GetSeconds ());
+  element.AddAttribute ("t", t);
   element.AddAttribute ("id", nodeId);
   element.AddAttribute ("x", x);
   element.AddAttribute ("y", y);
-  WriteN (element.ToString (), m_f);
+  return element.ToString ();
 }
 
 void
@@ -2737,6 +3231,89 @@ AnimationInterface::WriteXmlNonP2pLinkProperties (uint32_t id, std::string ipAdd
 
 
 
+/***** Binary trace file *****/
+
+bool
+AnimationInterface::ConvertBinaryTrace (const std::string &binaryFileName, const std::string &xmlFileName)
+{
+  std::ifstream in (binaryFileName.c_str (), std::ios::binary);
+  char magic[sizeof (BINARY_MAGIC)];
+  if (!in.read (magic, sizeof (magic)) || std::memcmp (magic, BINARY_MAGIC, sizeof (magic)) != 0)
+    {
+      NS_LOG_WARN ("Not a binary trace file:" << binaryFileName);
+      return false;
+    }
+  std::ofstream out (xmlFileName.c_str (), std::ios::binary);
+  if (!out)
+    {
+      NS_LOG_WARN ("Unable to open output file:" << xmlFileName);
+      return false;
+    }
+
+  std::map <uint32_t, std::pair <int64_t, int64_t> > positions;
+  int type;
+  while ((type = in.get ()) != std::char_traits<char>::eof ())
+    {
+      bool ok = true;
+      uint64_t uid, fId, tId;
+      double fbTx, lbTx, fbRx, lbRx, t;
+      int64_t dx, dy;
+      std::string text;
+      switch (type)
+        {
+        case BINARY_XML:
+          ok = ReadString (in, text);
+          break;
+        case BINARY_P:
+          ok = ReadVarint (in, fId) && ReadDouble (in, fbTx) && ReadDouble (in, lbTx)
+            && ReadVarint (in, tId) && ReadDouble (in, fbRx) && ReadDouble (in, lbRx)
+            && ReadString (in, text);
+          if (ok)
+            {
+              text = GetXmlP ("p", fId, fbTx, lbTx, tId, fbRx, lbRx, text);
+            }
+          break;
+        case BINARY_PR:
+          ok = ReadVarint (in, uid) && ReadVarint (in, fId) && ReadDouble (in, fbTx)
+            && ReadString (in, text);
+          if (ok)
+            {
+              text = GetXmlPRef (uid, fId, fbTx, text);
+            }
+          break;
+        case BINARY_WPR:
+          ok = ReadVarint (in, uid) && ReadVarint (in, tId) && ReadDouble (in, fbRx)
+            && ReadDouble (in, lbRx);
+          if (ok)
+            {
+              text = GetXmlP (uid, "wpr", tId, fbRx, lbRx);
+            }
+          break;
+        case BINARY_POSITION:
+          ok = ReadDouble (in, t) && ReadVarint (in, uid)
+            && ReadSignedVarint (in, dx) && ReadSignedVarint (in, dy);
+          if (ok)
+            {
+              std::pair <int64_t, int64_t> &last = positions[uid];
+              last.first += dx;
+              last.second += dy;
+              text = GetXmlUpdateNodePosition (t, uid, last.first / 1000.0, last.second / 1000.0);
+            }
+          break;
+        default:
+          ok = false;
+          break;
+        }
+      if (!ok)
+        {
+          NS_LOG_WARN ("Corrupted binary trace file:" << binaryFileName);
+          return false;
+        }
+      out << text;
+    }
+  return static_cast<bool> (out);
+}
+
 /***** AnimXmlElement  *****/
 
 AnimationInterface::AnimXmlElement::AnimXmlElement (std::string tagName, bool emptyElement)
@@ -223,6 +223,76 @@ public:
    */
   void SetMobilityPollInterval (Time t);
 
+  /**
+   * \brief Enable or disable the periodic polling of the node positions
+   *
+   * The positions are polled every mobility poll interval, which scans
+   * all the nodes.  The nodes whose mobility model notifies its course
+   * changes (e.g., the waypoint and random walk models) are also updated
+   * at each course change; the polling can then be disabled, so that
+   * the cost of the position updates only depends on the moving nodes.
+   *
+   * \param enable true to poll the positions (the default)
+   *
+   * \returns none
+   */
+  void EnableMobilityPolling (bool enable);
+
+  /**
+   * \brief Animate one packet out of n
+   *
+   * The packets whose uid is not a multiple of n are not written to the
+   * trace file: all the hops of a sampled point-to-point packet are
+   * written, and the wireless transmissions are sampled with their
+   * receptions.
+   *
+   * \param n the sampling period, 1 (the default) to animate all the packets
+   *
+   * \returns none
+   */
+  void SetPacketSampling (uint32_t n);
+
+  /**
+   * \brief Write the trace file in the binary format
+   *
+   * The binary trace file is a sequence of records: the packets and
+   * the position updates are written as compact binary records, the
+   * positions being stored in millimeters, relative to the previous
+   * position of the node; the other elements are written as XML text.
+   * The file must be converted to the XML format (see ConvertBinaryTrace
+   * and the convert-binary-anim program) to be loaded by NetAnim.
+   *
+   * The trace file is restarted, so this must be called right after the
+   * construction of the AnimationInterface.
+   *
+   * \returns none
+   */
+  void EnableBinaryOutput (void);
+
+  /**
+   * \brief Set the size of the output buffer
+   *
+   * The trace file is written by blocks of the given size, by a
+   * background thread if threads are supported, so that the simulation
+   * does not wait for the disk.
+   *
+   * \param size the size of the buffer in bytes, 0 (the default) to
+   *        write each element as it is generated
+   *
+   * \returns none
+   */
+  void SetOutputBufferSize (uint32_t size);
+
+  /**
+   * \brief Convert a binary trace file (see EnableBinaryOutput) to the XML format
+   *
+   * \param binaryFileName the name of the binary trace file
+   * \param xmlFileName the name of the XML trace file
+   *
+   * \returns false if the binary trace file cannot be read or is corrupted
+   */
+  static bool ConvertBinaryTrace (const std::string &binaryFileName, const std::string &xmlFileName);
+
   /**
    * \brief Set a callback function to listen to AnimationInterface write events
    *
@@ -606,6 +676,8 @@ private:
 
 
 
+  class Writer;
+
   // ##### State #####
 
   FILE * m_f; ///< File handle for output (0 if none)
@@ -634,6 +706,14 @@ private:
   Time m_wifiPhyCountersPollInterval; ///< wifi Phy counters poll interval
   static Rectangle * userBoundary; ///< user boundary
   bool m_trackPackets; ///< track packets
+  bool m_mobilityPolling; ///< whether the node positions are polled
+  uint32_t m_packetSampling; ///< one packet out of m_packetSampling is animated
+  bool m_binaryOutput; ///< whether the trace file is in the binary format
+  std::string m_record; ///< binary record being serialized
+  std::map <uint32_t, std::pair <int64_t, int64_t> > m_binaryPositions; ///< last position written for each node, in mm
+  uint32_t m_outputBufferSize; ///< size of the output buffer
+  std::string m_outputBuffer; ///< output not yet written to the trace file
+  Writer * m_writer; ///< thread writing the output buffers
 
   // Counter ID
   uint32_t m_remainingEnergyCounterId; ///< remaining energy counter ID
@@ -769,6 +849,21 @@ private:
    * \returns the number of bytes written
    */
   int WriteN (const std::string& st, FILE * f);
+  /**
+   * Write the output buffer to the trace file
+   * \param wait whether to wait until the buffer has been written
+   */
+  void FlushOutputBuffer (bool wait);
+  /**
+   * Write the binary record being serialized to the trace file
+   */
+  void WriteBinaryRecord (void);
+  /**
+   * Is sampled function
+   * \param uid the packet UID or anim UID
+   * \returns true if the packet must be animated
+   */
+  bool IsSampled (uint64_t uid) const;
   /**
    * Get MAC address function
    * \param nd the device
@@ -1431,6 +1526,54 @@ private:
    * \param metaInfo the meta info
    */
   void WriteXmlPRef (uint64_t animUid, uint32_t fId, double fbTx, std::string metaInfo = "");
+  /**
+   * Get XMLP function
+   * \param pktType the packet type
+   * \param fId the FID
+   * \param fbTx the FB transmit
+   * \param lbTx the LB transmit
+   * \param tId the TID
+   * \param fbRx the FB receive
+   * \param lbRx the LB receive
+   * \param metaInfo the meta info
+   * \returns the XML element
+   */
+  static std::string GetXmlP (std::string pktType,
+                              uint32_t fId,
+                              double fbTx,
+                              double lbTx,
+                              uint32_t tId,
+                              double fbRx,
+                              double lbRx,
+                              std::string metaInfo);
+  /**
+   * Get XMLP function
+   * \param animUid the UID
+   * \param pktType the packet type
+   * \param tId the TID
+   * \param fbRx the FB receive
+   * \param lbRx the LB receive
+   * \returns the XML element
+   */
+  static std::string GetXmlP (uint64_t animUid, std::string pktType, uint32_t tId, double fbRx, double lbRx);
+  /**
+   * Get XMLP Ref function
+   * \param animUid the UID
+   * \param fId the FID
+   * \param fbTx the FB transmit
+   * \param metaInfo the meta info
+   * \returns the XML element
+   */
+  static std::string GetXmlPRef (uint64_t animUid, uint32_t fId, double fbTx, std::string metaInfo);
+  /**
+   * Get XML update node position function
+   * \param t the time in seconds
+   * \param nodeId the node ID
+   * \param x the X position
+   * \param y the Y position
+   * \returns the XML element
+   */
+  static std::string GetXmlUpdateNodePosition (double t, uint32_t nodeId, double x, double y);
   /**
    * Write XML close function
    * \param name the name
@@ -17,7 +17,10 @@
  * Contributions: Eugene Kalishenko <ydginster@gmail.com> (Open Source and Linux Laboratory http://dev.osll.ru/)
  */
 
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include "unistd.h"
 
 #include "ns3/core-module.h"
@@ -253,6 +256,120 @@ AnimationRemainingEnergyTestCase::CheckLogic (void)
                             "Wrong remaining energy value was traced");
 }
 
+/**
+ * \ingroup netanim-test
+ * \ingroup tests
+ *
+ * \brief Animation Binary Output Test Case
+ *
+ * Animates one packet out of two in the binary format, and checks the
+ * content of the converted XML trace file.
+ */
+class AnimationBinaryOutputTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor.
+   */
+  AnimationBinaryOutputTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+AnimationBinaryOutputTestCase::AnimationBinaryOutputTestCase () :
+  TestCase ("Verify binary output and packet sampling")
+{
+}
+
+void
+AnimationBinaryOutputTestCase::DoRun (void)
+{
+  std::string binaryFileName = CreateTempDirFilename ("netanim-test.bin");
+  std::string xmlFileName = CreateTempDirFilename ("netanim-test.xml");
+
+  NodeContainer nodes;
+  nodes.Create (2);
+  AnimationInterface::SetConstantPosition (nodes.Get (0), 0 , 10);
+  AnimationInterface::SetConstantPosition (nodes.Get (1), 1 , 10);
+  Ptr<MobilityModel> mobility = nodes.Get (1)->GetObject<MobilityModel> ();
+  Simulator::Schedule (Seconds (3), &MobilityModel::SetPosition, mobility, Vector (2.5, 7.25, 0));
+
+  PointToPointHelper pointToPoint;
+  NetDeviceContainer devices = pointToPoint.Install (nodes);
+  InternetStackHelper stack;
+  stack.Install (nodes);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+
+  UdpEchoServerHelper echoServer (9);
+  ApplicationContainer serverApps = echoServer.Install (nodes.Get (1));
+  serverApps.Start (Seconds (1.0));
+  serverApps.Stop (Seconds (10.0));
+  UdpEchoClientHelper echoClient (interfaces.GetAddress (1), 9);
+  echoClient.SetAttribute ("MaxPackets", UintegerValue (100));
+  echoClient.SetAttribute ("Interval", TimeValue (Seconds (1.0)));
+  ApplicationContainer clientApps = echoClient.Install (nodes.Get (0));
+  clientApps.Start (Seconds (2.0));
+  clientApps.Stop (Seconds (10.0));
+
+  AnimationInterface *anim = new AnimationInterface (binaryFileName);
+  anim->EnableBinaryOutput ();
+  anim->SetOutputBufferSize (256);
+  anim->SetPacketSampling (2);
+  Simulator::Run ();
+  uint64_t nPackets = anim->GetTracePktCount ();
+  delete anim;
+  Simulator::Destroy ();
+
+  // the echo replies are the echo requests, sampled with them
+  NS_TEST_EXPECT_MSG_GT (nPackets, 0, "No packet traced");
+  NS_TEST_EXPECT_MSG_LT (nPackets, 16, "Packets not sampled");
+
+  NS_TEST_ASSERT_MSG_EQ (AnimationInterface::ConvertBinaryTrace (binaryFileName, xmlFileName), true,
+                         "Conversion failed");
+  std::ifstream xmlFile (xmlFileName.c_str ());
+  std::ostringstream oss;
+  oss << xmlFile.rdbuf ();
+  std::string xml = oss.str ();
+  NS_TEST_EXPECT_MSG_EQ (xml.compare (0, 5, "<anim"), 0, "Wrong first element");
+  NS_TEST_EXPECT_MSG_EQ (xml.substr (xml.size () - 8), "</anim>\n", "Wrong last element");
+  uint64_t nXmlPackets = 0;
+  for (std::string::size_type i = xml.find ("<p "); i != std::string::npos; i = xml.find ("<p ", i + 1))
+    {
+      ++nXmlPackets;
+    }
+  NS_TEST_EXPECT_MSG_EQ (nXmlPackets, nPackets, "Wrong number of packets");
+  NS_TEST_EXPECT_MSG_NE (xml.find ("<nu p=\"p\" t=\"3\" id=\"1\" x=\"2.5\" y=\"7.25\" />"), std::string::npos,
+                         "Position update not found");
+
+  // a truncated file is reported, whichever record it ends in
+  std::ifstream binaryFile (binaryFileName.c_str (), std::ios::binary);
+  std::ostringstream binaryOss;
+  binaryOss << binaryFile.rdbuf ();
+  binaryFile.close ();
+  std::string binary = binaryOss.str ();
+  std::string truncatedFileName = CreateTempDirFilename ("netanim-test-truncated.bin");
+  for (std::string::size_type size = binary.size () - 1; size > binary.size () / 2; size -= 7)
+    {
+      std::ofstream truncatedFile (truncatedFileName.c_str (), std::ios::binary);
+      truncatedFile.write (binary.data (), size);
+      truncatedFile.close ();
+      bool converted = AnimationInterface::ConvertBinaryTrace (truncatedFileName, xmlFileName);
+      std::ifstream truncatedXmlFile (xmlFileName.c_str ());
+      std::ostringstream truncatedOss;
+      truncatedOss << truncatedXmlFile.rdbuf ();
+      std::string truncatedXml = truncatedOss.str ();
+      bool complete = truncatedXml.size () >= 8 && truncatedXml.substr (truncatedXml.size () - 8) == "</anim>\n";
+      NS_TEST_EXPECT_MSG_EQ (converted && complete, false, "File truncated to " << size << " bytes converted");
+    }
+
+  std::remove (binaryFileName.c_str ());
+  std::remove (xmlFileName.c_str ());
+  std::remove (truncatedFileName.c_str ());
+}
+
 /**
  * \ingroup netanim-test
  * \ingroup tests
@@ -267,5 +384,6 @@ public:
   {
     AddTestCase (new AnimationInterfaceTestCase (), TestCase::QUICK);
     AddTestCase (new AnimationRemainingEnergyTestCase (), TestCase::QUICK);
+    AddTestCase (new AnimationBinaryOutputTestCase (), TestCase::QUICK);
   }
 } g_animationInterfaceTestSuite; ///< the test suite
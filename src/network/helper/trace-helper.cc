@@ -18,6 +18,7 @@
 
 #include <stdint.h>
 #include <string>
+#include <cstring>
 #include <fstream>
 
 #include "ns3/abort.h"
@@ -28,6 +29,8 @@
 #include "ns3/names.h"
 #include "ns3/net-device.h"
 #include "ns3/pcap-file-wrapper.h"
+#include "ns3/packet.h"
+#include "ns3/binary-trace-file.h"
 
 #include "trace-helper.h"
 
@@ -397,6 +400,146 @@ AsciiTraceHelper::DefaultReceiveSinkWithContext (Ptr<OutputStreamWrapper> stream
   *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
 }
 
+BinaryTraceHelper::BinaryTraceHelper ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+BinaryTraceHelper::~BinaryTraceHelper ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+Ptr<BinaryTraceFile>
+BinaryTraceHelper::CreateFile (std::string filename)
+{
+  NS_LOG_FUNCTION (filename);
+
+  Ptr<BinaryTraceFile> file = Create<BinaryTraceFile> ();
+  file->Open (filename, std::ios::out);
+  NS_ABORT_MSG_IF (file->Fail (), "Unable to Open " << filename << " for writing");
+
+  //
+  // As for the pcap files, the trace sinks hooked to the file keep it
+  // alive, and the file is closed when the last of them is destroyed.
+  //
+  return file;
+}
+
+void
+BinaryTraceHelper::ParseFlow (const uint8_t *data, uint32_t size, uint32_t dataLinkType,
+                              BinaryTraceFile::Record &record)
+{
+  record.protocol = 0;
+  record.srcPort = 0;
+  record.dstPort = 0;
+  std::memset (record.src, 0, sizeof (record.src));
+  std::memset (record.dst, 0, sizeof (record.dst));
+
+  //
+  // Find the IP header behind the link layer header, if any.
+  //
+  uint32_t offset = 0;
+  uint8_t version = 0;
+  switch (dataLinkType)
+    {
+    case PcapHelper::DLT_EN10MB:
+      {
+        if (size < 14)
+          {
+            return;
+          }
+        uint16_t etherType = (data[12] << 8) | data[13];
+        offset = 14;
+        if (etherType <= 1500)
+          {
+            // 802.3 length field, followed by a LLC/SNAP header
+            if (size < 22 || data[14] != 0xaa || data[15] != 0xaa)
+              {
+                return;
+              }
+            etherType = (data[20] << 8) | data[21];
+            offset = 22;
+          }
+        version = etherType == 0x0800 ? 4 : (etherType == 0x86dd ? 6 : 0);
+        break;
+      }
+    case PcapHelper::DLT_PPP:
+      {
+        if (size < 2)
+          {
+            return;
+          }
+        uint16_t protocol = (data[0] << 8) | data[1];
+        offset = 2;
+        version = protocol == 0x0021 ? 4 : (protocol == 0x0057 ? 6 : 0);
+        break;
+      }
+    case PcapHelper::DLT_RAW:
+      if (size > 0)
+        {
+          version = data[0] >> 4;
+        }
+      break;
+    default:
+      return;
+    }
+
+  const uint8_t *ip = data + offset;
+  uint32_t ipSize = size - offset;
+  uint32_t l4Offset = 0;
+  if (version == 4 && ipSize >= 20)
+    {
+      record.protocol = ip[9];
+      // IPv4-mapped IPv6 addresses
+      record.src[10] = record.src[11] = 0xff;
+      record.dst[10] = record.dst[11] = 0xff;
+      std::memcpy (record.src + 12, ip + 12, 4);
+      std::memcpy (record.dst + 12, ip + 16, 4);
+      uint16_t fragmentOffset = ((ip[6] & 0x1f) << 8) | ip[7];
+      if (fragmentOffset == 0)
+        {
+          l4Offset = (ip[0] & 0x0f) * 4;
+        }
+    }
+  else if (version == 6 && ipSize >= 40)
+    {
+      // extension headers are not followed
+      record.protocol = ip[6];
+      std::memcpy (record.src, ip + 8, 16);
+      std::memcpy (record.dst, ip + 24, 16);
+      l4Offset = 40;
+    }
+
+  if ((record.protocol == 6 || record.protocol == 17) && l4Offset > 0 && ipSize >= l4Offset + 4)
+    {
+      record.srcPort = (ip[l4Offset] << 8) | ip[l4Offset + 1];
+      record.dstPort = (ip[l4Offset + 2] << 8) | ip[l4Offset + 3];
+    }
+}
+
+void
+BinaryTraceHelper::DefaultSink (Ptr<Source> source, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (source << p);
+  BinaryTraceFile::Record record;
+  record.time = Simulator::Now ().GetNanoSeconds ();
+  record.uid = p->GetUid ();
+  record.node = source->node;
+  record.device = source->device;
+  record.size = p->GetSize ();
+  record.event = source->event;
+
+  //
+  // Only the headers are needed to find the 5-tuple: link layer header,
+  // IPv6 header and ports.
+  //
+  uint8_t data[80];
+  uint32_t size = p->CopyData (data, sizeof (data));
+  ParseFlow (data, size, source->dataLinkType, record);
+  source->file->Write (record);
+}
+
 void 
 PcapHelperForDevice::EnablePcap (std::string prefix, Ptr<NetDevice> nd, bool promiscuous, bool explicitFilename)
 {
@@ -650,5 +793,40 @@ AsciiTraceHelperForDevice::EnableAsciiImpl (
     }
 }
 
-} // namespace ns3
+void
+BinaryTraceHelperForDevice::EnableBinaryTrace (Ptr<BinaryTraceFile> file, Ptr<NetDevice> nd)
+{
+  EnableBinaryTraceInternal (file, nd);
+}
+
+void
+BinaryTraceHelperForDevice::EnableBinaryTrace (Ptr<BinaryTraceFile> file, NetDeviceContainer d)
+{
+  for (NetDeviceContainer::Iterator i = d.Begin (); i != d.End (); ++i)
+    {
+      EnableBinaryTrace (file, *i);
+    }
+}
 
+void
+BinaryTraceHelperForDevice::EnableBinaryTrace (Ptr<BinaryTraceFile> file, NodeContainer n)
+{
+  NetDeviceContainer devs;
+  for (NodeContainer::Iterator i = n.Begin (); i != n.End (); ++i)
+    {
+      Ptr<Node> node = *i;
+      for (uint32_t j = 0; j < node->GetNDevices (); ++j)
+        {
+          devs.Add (node->GetDevice (j));
+        }
+    }
+  EnableBinaryTrace (file, devs);
+}
+
+void
+BinaryTraceHelperForDevice::EnableBinaryTraceAll (Ptr<BinaryTraceFile> file)
+{
+  EnableBinaryTrace (file, NodeContainer::GetGlobal ());
+}
+
+} // namespace ns3
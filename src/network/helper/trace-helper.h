@@ -25,6 +25,7 @@
 #include "ns3/simulator.h"
 #include "ns3/pcap-file-wrapper.h"
 #include "ns3/output-stream-wrapper.h"
+#include "ns3/binary-trace-file.h"
 
 namespace ns3 {
 
@@ -546,6 +547,106 @@ AsciiTraceHelper::HookDefaultReceiveSinkWithContext (
                  << tracename << "\"");
 }
 
+/**
+ * \brief Manage binary trace files for device models
+ *
+ * The binary traces record the same events as the ascii traces, without
+ * printing the packets: each event is a fixed-width BinaryTraceFile
+ * record holding the time, the node and device, the packet uid and size,
+ * and the IP 5-tuple read from the first bytes of the packet. Since the
+ * records identify the device, a single file usually holds the events
+ * of all the devices of a simulation.
+ */
+class BinaryTraceHelper
+{
+public:
+  /**
+   * @brief Create a binary trace helper.
+   */
+  BinaryTraceHelper ();
+
+  /**
+   * @brief Destroy a binary trace helper.
+   */
+  ~BinaryTraceHelper ();
+
+  /**
+   * @brief Create a binary trace file, writing its header.
+   *
+   * @param filename file name
+   * @returns a smart pointer to the trace file
+   */
+  Ptr<BinaryTraceFile> CreateFile (std::string filename);
+
+  /**
+   * @brief Hook a trace source of a device to the default trace sink,
+   * which writes a record for each packet traced.
+   *
+   * @param object object providing the trace source, the device or its queue
+   * @param traceName trace source name
+   * @param file the trace file
+   * @param device the device the packets are traced at
+   * @param event event type of the records ('+', '-', 'd' or 'r')
+   * @param dataLinkType data link type (as in PcapHelper::DataLinkType) of the
+   *        packets, used to find their IP header
+   */
+  template <typename T>
+  void HookDefaultSink (Ptr<T> object, std::string traceName, Ptr<BinaryTraceFile> file,
+                        Ptr<NetDevice> device, char event, uint32_t dataLinkType);
+
+  /**
+   * @brief Fill the 5-tuple of a record from the first bytes of a packet.
+   *
+   * Ethernet (with or without LLC/SNAP), PPP and raw IP packets carrying
+   * IPv4 or IPv6 are handled; the ports are filled for the TCP and UDP
+   * packets which are not fragments. The fields which cannot be found are
+   * set to zero.
+   *
+   * @param data the first bytes of the packet
+   * @param size the number of bytes available
+   * @param dataLinkType data link type of the packet
+   * @param record the record to fill
+   */
+  static void ParseFlow (const uint8_t *data, uint32_t size, uint32_t dataLinkType,
+                         BinaryTraceFile::Record &record);
+
+private:
+  /**
+   * @brief The trace source hooked to the default sink.
+   */
+  struct Source : public SimpleRefCount<Source>
+  {
+    Ptr<BinaryTraceFile> file;  //!< the trace file
+    uint32_t node;              //!< node id
+    uint32_t device;            //!< device index
+    uint8_t event;              //!< event type
+    uint32_t dataLinkType;      //!< data link type of the packets
+  };
+
+  /**
+   * @brief The default trace sink, writing a record for a packet.
+   *
+   * @param source the trace source
+   * @param p the packet
+   */
+  static void DefaultSink (Ptr<Source> source, Ptr<const Packet> p);
+};
+
+template <typename T> void
+BinaryTraceHelper::HookDefaultSink (Ptr<T> object, std::string tracename, Ptr<BinaryTraceFile> file,
+                                    Ptr<NetDevice> device, char event, uint32_t dataLinkType)
+{
+  Ptr<Source> source = Create<Source> ();
+  source->file = file;
+  source->node = device->GetNode ()->GetId ();
+  source->device = device->GetIfIndex ();
+  source->event = event;
+  source->dataLinkType = dataLinkType;
+  bool result =
+    object->TraceConnectWithoutContext (tracename.c_str (), MakeBoundCallback (&DefaultSink, source));
+  NS_ASSERT_MSG (result == true, "BinaryTraceHelper::HookDefaultSink():  Unable to hook \"" << tracename << "\"");
+}
+
 /**
  * \brief Base class providing common user-level pcap operations for helpers
  * representing net devices.
@@ -866,6 +967,66 @@ private:
   void EnableAsciiImpl (Ptr<OutputStreamWrapper> stream, std::string prefix, Ptr<NetDevice> nd, bool explicitFilename);
 };
 
+/**
+ * \brief Base class providing common user-level binary trace operations for
+ * helpers representing net devices.
+ */
+class BinaryTraceHelperForDevice
+{
+public:
+  /**
+   * @brief Construct a BinaryTraceHelperForDevice.
+   */
+  BinaryTraceHelperForDevice () {}
+
+  /**
+   * @brief Destroy a BinaryTraceHelperForDevice.
+   */
+  virtual ~BinaryTraceHelperForDevice () {}
+
+  /**
+   * @brief Enable binary trace output on the indicated net device.
+   *
+   * @param file The binary trace file to write the records to.
+   * @param nd Net device for which you want to enable tracing.
+   */
+  virtual void EnableBinaryTraceInternal (Ptr<BinaryTraceFile> file, Ptr<NetDevice> nd) = 0;
+
+  /**
+   * @brief Enable binary trace output on the indicated net device.
+   *
+   * @param file The binary trace file to write the records to.
+   * @param nd Net device for which you want to enable tracing.
+   */
+  void EnableBinaryTrace (Ptr<BinaryTraceFile> file, Ptr<NetDevice> nd);
+
+  /**
+   * @brief Enable binary trace output on each device in the container which is
+   * of the appropriate type.
+   *
+   * @param file The binary trace file to write the records to.
+   * @param d container of devices
+   */
+  void EnableBinaryTrace (Ptr<BinaryTraceFile> file, NetDeviceContainer d);
+
+  /**
+   * @brief Enable binary trace output on each device (which is of the
+   * appropriate type) in the nodes provided in the container.
+   *
+   * @param file The binary trace file to write the records to.
+   * @param n container of nodes.
+   */
+  void EnableBinaryTrace (Ptr<BinaryTraceFile> file, NodeContainer n);
+
+  /**
+   * @brief Enable binary trace output on each device (which is of the
+   * appropriate type) in the set of all nodes created in the simulation.
+   *
+   * @param file The binary trace file to write the records to.
+   */
+  void EnableBinaryTraceAll (Ptr<BinaryTraceFile> file);
+};
+
 } // namespace ns3
 
 #endif /* TRACE_HELPER_H */
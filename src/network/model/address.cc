@@ -284,6 +284,19 @@ std::istream& operator>> (std::istream& is, Address & address)
   return is;
 }
 
+size_t
+AddressHash::operator() (Address const &x) const
+{
+  uint8_t buffer[Address::MAX_SIZE];
+  uint32_t len = x.CopyTo (buffer);
+  uint32_t hash = 2166136261U ^ len;
+  for (uint32_t i = 0; i < len; i++)
+    {
+      hash ^= buffer[i];
+      hash *= 16777619U;
+    }
+  return hash;
+}
 
 
 } // namespace ns3
@@ -283,6 +283,28 @@ bool operator < (const Address &a, const Address &b);
 std::ostream& operator<< (std::ostream& os, const Address & address);
 std::istream& operator>> (std::istream& is, Address & address);
 
+/**
+ * \ingroup address
+ *
+ * \brief Class providing an hash for addresses
+ *
+ * Only the address length and bytes are hashed: two addresses
+ * compare equal when one of them has a zero type, so the type
+ * can not be part of the hash.
+ */
+class AddressHash {
+public:
+  /**
+   * \brief Returns the hash of an address.
+   * \param x the address
+   * \return the hash
+   *
+   * This method uses a FNV-1a loop rather than class Hash
+   * as speed is more important than cryptographic robustness.
+   */
+  size_t operator() (Address const &x) const;
+};
+
 
 } // namespace ns3
 
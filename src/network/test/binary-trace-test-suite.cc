@@ -0,0 +1,223 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "ns3/test.h"
+#include "ns3/binary-trace-file.h"
+#include "ns3/trace-helper.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check that the records written to a BinaryTraceFile are read back.
+ */
+class BinaryTraceFileTestCase : public TestCase
+{
+public:
+  BinaryTraceFileTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+BinaryTraceFileTestCase::BinaryTraceFileTestCase ()
+  : TestCase ("Check that BinaryTraceFile records are written and read back")
+{
+}
+
+void
+BinaryTraceFileTestCase::DoRun (void)
+{
+  uint32_t recordSize = 0;
+  const std::vector<BinaryTraceFile::Field> &schema = BinaryTraceFile::GetSchema ();
+  for (std::vector<BinaryTraceFile::Field>::const_iterator i = schema.begin (); i != schema.end (); ++i)
+    {
+      recordSize += i->size;
+    }
+  NS_TEST_ASSERT_MSG_EQ (recordSize, BinaryTraceFile::RECORD_SIZE, "The schema does not match the record size");
+
+  std::string filename = CreateTempDirFilename ("binary-trace.btr");
+  const uint32_t nRecords = 100;
+  BinaryTraceFile out;
+  out.Open (filename, std::ios::out);
+  NS_TEST_ASSERT_MSG_EQ (out.Fail (), false, "Open (" << filename << ", \"std::ios::out\") returns error");
+  for (uint32_t i = 0; i < nRecords; ++i)
+    {
+      BinaryTraceFile::Record record;
+      record.time = -1 + 1000000007LL * i;
+      record.uid = 0x100000000ULL + i;
+      record.node = i / 4;
+      record.device = i % 4;
+      record.size = 1500 - i;
+      record.event = "+-dr"[i % 4];
+      record.protocol = i % 2 ? 6 : 17;
+      record.srcPort = 49153 + i;
+      record.dstPort = 9;
+      for (uint32_t j = 0; j < 16; ++j)
+        {
+          record.src[j] = i + j;
+          record.dst[j] = 255 - i - j;
+        }
+      out.Write (record);
+    }
+  out.Close ();
+
+  BinaryTraceFile in;
+  in.Open (filename, std::ios::in);
+  NS_TEST_ASSERT_MSG_EQ (in.Fail (), false, "Open (" << filename << ", \"std::ios::in\") returns error");
+  BinaryTraceFile::Record record;
+  uint32_t n = 0;
+  while (in.Read (record))
+    {
+      NS_TEST_EXPECT_MSG_EQ (record.time, -1 + 1000000007LL * n, "Wrong time read back");
+      NS_TEST_EXPECT_MSG_EQ (record.uid, 0x100000000ULL + n, "Wrong uid read back");
+      NS_TEST_EXPECT_MSG_EQ (record.node, n / 4, "Wrong node read back");
+      NS_TEST_EXPECT_MSG_EQ (record.device, n % 4, "Wrong device read back");
+      NS_TEST_EXPECT_MSG_EQ (record.size, 1500 - n, "Wrong size read back");
+      NS_TEST_EXPECT_MSG_EQ (record.event, "+-dr"[n % 4], "Wrong event read back");
+      NS_TEST_EXPECT_MSG_EQ (static_cast<uint32_t> (record.protocol), n % 2 ? 6 : 17, "Wrong protocol read back");
+      NS_TEST_EXPECT_MSG_EQ (record.srcPort, 49153 + n, "Wrong source port read back");
+      NS_TEST_EXPECT_MSG_EQ (record.dstPort, 9, "Wrong destination port read back");
+      NS_TEST_EXPECT_MSG_EQ (static_cast<uint32_t> (record.src[15]), n + 15, "Wrong source address read back");
+      NS_TEST_EXPECT_MSG_EQ (static_cast<uint32_t> (record.dst[0]), 255 - n, "Wrong destination address read back");
+      ++n;
+    }
+  NS_TEST_EXPECT_MSG_EQ (n, nRecords, "Wrong number of records read back");
+  in.Close ();
+
+  //
+  // A pcap file is not a binary trace file
+  //
+  std::string pcap = CreateDataDirFilename ("known.pcap");
+  BinaryTraceFile bad;
+  bad.Open (pcap, std::ios::in);
+  NS_TEST_EXPECT_MSG_EQ (bad.Fail (), true, "A file without the binary trace header must be rejected");
+
+  std::remove (filename.c_str ());
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check that BinaryTraceHelper::ParseFlow finds the 5-tuple of packets.
+ */
+class BinaryTraceParseFlowTestCase : public TestCase
+{
+public:
+  BinaryTraceParseFlowTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+BinaryTraceParseFlowTestCase::BinaryTraceParseFlowTestCase ()
+  : TestCase ("Check that BinaryTraceHelper::ParseFlow finds the 5-tuple of packets")
+{
+}
+
+void
+BinaryTraceParseFlowTestCase::DoRun (void)
+{
+  BinaryTraceFile::Record record;
+
+  // Ethernet, IPv4 10.1.1.1 -> 10.1.1.2, UDP 49153 -> 9
+  uint8_t ethernet[14 + 20 + 8] = {0};
+  ethernet[12] = 0x08;
+  uint8_t *ip = ethernet + 14;
+  ip[0] = 0x45;
+  ip[9] = 17;
+  const uint8_t src4[4] = {10, 1, 1, 1};
+  const uint8_t dst4[4] = {10, 1, 1, 2};
+  std::memcpy (ip + 12, src4, 4);
+  std::memcpy (ip + 16, dst4, 4);
+  ip[20] = 0xc0;
+  ip[21] = 0x01;
+  ip[23] = 9;
+  BinaryTraceHelper::ParseFlow (ethernet, sizeof (ethernet), PcapHelper::DLT_EN10MB, record);
+  NS_TEST_EXPECT_MSG_EQ (static_cast<uint32_t> (record.protocol), 17, "Wrong protocol");
+  NS_TEST_EXPECT_MSG_EQ (record.srcPort, 49153, "Wrong source port");
+  NS_TEST_EXPECT_MSG_EQ (record.dstPort, 9, "Wrong destination port");
+  NS_TEST_EXPECT_MSG_EQ (static_cast<uint32_t> (record.src[11]), 0xff, "IPv4 addresses are IPv4-mapped");
+  NS_TEST_EXPECT_MSG_EQ (std::memcmp (record.src + 12, src4, 4), 0, "Wrong source address");
+  NS_TEST_EXPECT_MSG_EQ (std::memcmp (record.dst + 12, dst4, 4), 0, "Wrong destination address");
+
+  // a fragment has no ports
+  ip[7] = 0x10;
+  BinaryTraceHelper::ParseFlow (ethernet, sizeof (ethernet), PcapHelper::DLT_EN10MB, record);
+  NS_TEST_EXPECT_MSG_EQ (static_cast<uint32_t> (record.protocol), 17, "Wrong protocol");
+  NS_TEST_EXPECT_MSG_EQ (record.srcPort, 0, "A fragment has no ports");
+
+  // truncated packet: the ports are unknown
+  ip[7] = 0;
+  BinaryTraceHelper::ParseFlow (ethernet, 14 + 20 + 2, PcapHelper::DLT_EN10MB, record);
+  NS_TEST_EXPECT_MSG_EQ (record.srcPort, 0, "The ports of a truncated packet are unknown");
+
+  // PPP, IPv6, TCP 80 -> 1025
+  uint8_t ppp[2 + 40 + 20] = {0};
+  ppp[1] = 0x57;
+  ip = ppp + 2;
+  ip[0] = 0x60;
+  ip[6] = 6;
+  ip[8] = 0x20;
+  ip[23] = 1;
+  ip[24] = 0x20;
+  ip[39] = 2;
+  ip[41] = 80;
+  ip[42] = 0x04;
+  ip[43] = 0x01;
+  BinaryTraceHelper::ParseFlow (ppp, sizeof (ppp), PcapHelper::DLT_PPP, record);
+  NS_TEST_EXPECT_MSG_EQ (static_cast<uint32_t> (record.protocol), 6, "Wrong protocol");
+  NS_TEST_EXPECT_MSG_EQ (record.srcPort, 80, "Wrong source port");
+  NS_TEST_EXPECT_MSG_EQ (record.dstPort, 1025, "Wrong destination port");
+  NS_TEST_EXPECT_MSG_EQ (static_cast<uint32_t> (record.src[0]), 0x20, "Wrong source address");
+  NS_TEST_EXPECT_MSG_EQ (static_cast<uint32_t> (record.src[15]), 1, "Wrong source address");
+  NS_TEST_EXPECT_MSG_EQ (static_cast<uint32_t> (record.dst[15]), 2, "Wrong destination address");
+
+  // not IP
+  ppp[1] = 0x21;
+  ppp[0] = 0xc0;
+  BinaryTraceHelper::ParseFlow (ppp, sizeof (ppp), PcapHelper::DLT_PPP, record);
+  NS_TEST_EXPECT_MSG_EQ (static_cast<uint32_t> (record.protocol), 0, "Not an IP packet");
+  NS_TEST_EXPECT_MSG_EQ (static_cast<uint32_t> (record.src[15]), 0, "Not an IP packet");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Binary trace TestSuite
+ */
+class BinaryTraceTestSuite : public TestSuite
+{
+public:
+  BinaryTraceTestSuite ();
+};
+
+BinaryTraceTestSuite::BinaryTraceTestSuite ()
+  : TestSuite ("binary-trace", UNIT)
+{
+  SetDataDir (NS_TEST_SOURCEDIR);
+  AddTestCase (new BinaryTraceFileTestCase, TestCase::QUICK);
+  AddTestCase (new BinaryTraceParseFlowTestCase, TestCase::QUICK);
+}
+
+static BinaryTraceTestSuite binaryTraceTestSuite; //!< Static variable for test initialization
@@ -66,6 +66,16 @@ void BitSerializerTest::DoRun ()
   result = testBitSerializer2.GetBytes ();
   NS_TEST_EXPECT_MSG_EQ ((result[0] == 0x0a) && (result[1] == 0xbc), true,
                          "Incorrect serialization " << std::hex << +result[0] << +result[1] << " instead of " << 0x0a << " " << 0xbc << std::dec);
+
+  BitSerializer testBitSerializer3;
+
+  testBitSerializer3.PushBits (0xabc, 12);
+  testBitSerializer3.PushBits (0xd, 4);
+
+  result = testBitSerializer3.GetBytes ();
+  NS_TEST_EXPECT_MSG_EQ (result.size (), 2, "Padding added to a blob of whole bytes");
+  NS_TEST_EXPECT_MSG_EQ ((result[0] == 0xab) && (result[1] == 0xcd), true,
+                         "Incorrect serialization " << std::hex << +result[0] << +result[1] << " instead of " << 0xab << " " << 0xcd << std::dec);
 }
 
 /**
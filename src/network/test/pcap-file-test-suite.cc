@@ -24,6 +24,7 @@
 
 #include "ns3/log.h"
 #include "ns3/test.h"
+#include "ns3/packet.h"
 #include "ns3/pcap-file.h"
 
 using namespace ns3;
@@ -1144,6 +1145,89 @@ DiffTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that the buffered PcapFile writes
+ * the same file as the unbuffered one.
+ */
+class WriteBufferTestCase : public TestCase
+{
+public:
+  WriteBufferTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+WriteBufferTestCase::WriteBufferTestCase ()
+  : TestCase ("Check that PcapFile::SetWriteBufferSize does not change the file written")
+{
+}
+
+void
+WriteBufferTestCase::DoRun (void)
+{
+  const uint32_t nPackets = 500;
+  const uint32_t snapLen = 100;
+  std::string filenames[2] = {CreateTempDirFilename ("unbuffered.pcap"),
+                              CreateTempDirFilename ("buffered.pcap")};
+  PcapFile files[2];
+
+  for (uint32_t i = 0; i < 2; ++i)
+    {
+      files[i].Open (filenames[i], std::ios::out);
+      NS_TEST_ASSERT_MSG_EQ (files[i].Fail (), false, "Open (" << filenames[i] << ", \"std::ios::out\") returns error");
+      files[i].Init (1, snapLen);
+    }
+  // a small buffer, so that the writer thread gets many of them
+  files[1].SetWriteBufferSize (1000);
+
+  uint8_t data[2 * snapLen];
+  for (uint32_t i = 0; i < sizeof (data); ++i)
+    {
+      data[i] = i & 0xff;
+    }
+  for (uint32_t i = 0; i < nPackets; ++i)
+    {
+      // sizes below and above the snap length
+      uint32_t size = (i * 7) % sizeof (data);
+      Ptr<Packet> p = Create<Packet> (data, size);
+      for (uint32_t j = 0; j < 2; ++j)
+        {
+          if (i % 2)
+            {
+              files[j].Write (i, 0, p);
+            }
+          else
+            {
+              files[j].Write (i, 0, data, size);
+            }
+        }
+    }
+  files[1].Flush ();
+  NS_TEST_EXPECT_MSG_EQ (files[1].Fail (), false, "Buffered writes must not fail");
+  files[0].Close ();
+  files[1].Close ();
+
+  uint32_t sec (0), usec (0), packets (0);
+  bool diff = PcapFile::Diff (filenames[0], filenames[1], sec, usec, packets, snapLen);
+  NS_TEST_EXPECT_MSG_EQ (diff, false, "Buffered and unbuffered files differ at packet " << packets);
+  NS_TEST_EXPECT_MSG_EQ (packets, nPackets, "Not all the packets were written");
+
+  uint64_t expectedLength = 0;
+  FILE *p = std::fopen (filenames[0].c_str (), "rb");
+  if (p != 0)
+    {
+      std::fseek (p, 0, SEEK_END);
+      expectedLength = std::ftell (p);
+      std::fclose (p);
+    }
+  NS_TEST_EXPECT_MSG_EQ (CheckFileLength (filenames[1], expectedLength), true,
+                         "Buffered and unbuffered files have different lengths");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1167,6 +1251,7 @@ PcapFileTestSuite::PcapFileTestSuite ()
   AddTestCase (new RecordHeaderTestCase, TestCase::QUICK);
   AddTestCase (new ReadFileTestCase, TestCase::QUICK);
   AddTestCase (new DiffTestCase, TestCase::QUICK);
+  AddTestCase (new WriteBufferTestCase, TestCase::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,244 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstring>
+#include "ns3/assert.h"
+#include "ns3/fatal-impl.h"
+#include "ns3/log.h"
+#include "binary-trace-file.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("BinaryTraceFile");
+
+namespace {
+
+const char MAGIC[4] = {'n', 's', '3', 'T'}; //!< Magic number of the trace files
+
+/**
+ * \brief Store an integer in little endian order
+ * \param buffer the destination
+ * \param value the value
+ * \param size the number of bytes to store
+ * \returns the byte following the value
+ */
+uint8_t *
+WriteLe (uint8_t *buffer, uint64_t value, uint32_t size)
+{
+  for (uint32_t i = 0; i < size; ++i)
+    {
+      buffer[i] = (value >> (8 * i)) & 0xff;
+    }
+  return buffer + size;
+}
+
+/**
+ * \brief Load an integer stored in little endian order
+ * \param buffer [in,out] the source, moved past the value
+ * \param size the number of bytes to load
+ * \returns the value
+ */
+uint64_t
+ReadLe (const uint8_t *&buffer, uint32_t size)
+{
+  uint64_t value = 0;
+  for (uint32_t i = 0; i < size; ++i)
+    {
+      value |= static_cast<uint64_t> (buffer[i]) << (8 * i);
+    }
+  buffer += size;
+  return value;
+}
+
+} // unnamed namespace
+
+BinaryTraceFile::BinaryTraceFile ()
+{
+  NS_LOG_FUNCTION (this);
+  FatalImpl::RegisterStream (&m_file);
+}
+
+BinaryTraceFile::~BinaryTraceFile ()
+{
+  NS_LOG_FUNCTION (this);
+  FatalImpl::UnregisterStream (&m_file);
+  Close ();
+}
+
+const std::vector<BinaryTraceFile::Field> &
+BinaryTraceFile::GetSchema (void)
+{
+  static const std::vector<Field> schema = {
+    {"time", 'i', 8},
+    {"uid", 'u', 8},
+    {"node", 'u', 4},
+    {"device", 'u', 4},
+    {"size", 'u', 4},
+    {"event", 'u', 1},
+    {"protocol", 'u', 1},
+    {"srcPort", 'u', 2},
+    {"dstPort", 'u', 2},
+    {"src", 'a', 16},
+    {"dst", 'a', 16}
+  };
+  return schema;
+}
+
+void
+BinaryTraceFile::Open (std::string const &filename, std::ios::openmode mode)
+{
+  NS_LOG_FUNCTION (this << filename << mode);
+  NS_ASSERT ((mode & std::ios::app) == 0);
+  m_filename = filename;
+  m_file.open (filename.c_str (), mode | std::ios::binary);
+  if (mode & std::ios::in)
+    {
+      // will set the fail bit if the file header is invalid.
+      ReadAndVerifyFileHeader ();
+    }
+  else
+    {
+      WriteFileHeader ();
+    }
+}
+
+void
+BinaryTraceFile::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_file.close ();
+}
+
+bool
+BinaryTraceFile::Fail (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_file.fail ();
+}
+
+bool
+BinaryTraceFile::Eof (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_file.eof ();
+}
+
+void
+BinaryTraceFile::WriteFileHeader (void)
+{
+  NS_LOG_FUNCTION (this);
+  const std::vector<Field> &schema = GetSchema ();
+  uint8_t buffer[10];
+  std::memcpy (buffer, MAGIC, sizeof (MAGIC));
+  uint8_t *end = WriteLe (buffer + sizeof (MAGIC), VERSION, 2);
+  end = WriteLe (end, RECORD_SIZE, 2);
+  WriteLe (end, schema.size (), 2);
+  m_file.write ((const char *)buffer, sizeof (buffer));
+  for (std::vector<Field>::const_iterator i = schema.begin (); i != schema.end (); ++i)
+    {
+      m_file.put (static_cast<char> (i->name.size ()));
+      m_file.write (i->name.c_str (), i->name.size ());
+      m_file.put (i->type);
+      m_file.put (static_cast<char> (i->size));
+    }
+}
+
+void
+BinaryTraceFile::ReadAndVerifyFileHeader (void)
+{
+  NS_LOG_FUNCTION (this);
+  uint8_t buffer[10];
+  m_file.read ((char *)buffer, sizeof (buffer));
+  if (m_file.fail ())
+    {
+      return;
+    }
+  const uint8_t *p = buffer + sizeof (MAGIC);
+  uint16_t version = ReadLe (p, 2);
+  uint16_t recordSize = ReadLe (p, 2);
+  uint16_t nFields = ReadLe (p, 2);
+
+  //
+  // We only deal with the current version of the format.
+  //
+  const std::vector<Field> &schema = GetSchema ();
+  if (std::memcmp (buffer, MAGIC, sizeof (MAGIC)) != 0 || version != VERSION
+      || recordSize != RECORD_SIZE || nFields != schema.size ())
+    {
+      m_file.setstate (std::ios::failbit);
+      return;
+    }
+  for (std::vector<Field>::const_iterator i = schema.begin (); i != schema.end (); ++i)
+    {
+      char name[256];
+      uint8_t length = m_file.get ();
+      m_file.read (name, length);
+      char type = m_file.get ();
+      uint8_t size = m_file.get ();
+      if (m_file.fail () || i->name != std::string (name, length) || i->type != type || i->size != size)
+        {
+          m_file.setstate (std::ios::failbit);
+          return;
+        }
+    }
+}
+
+void
+BinaryTraceFile::Write (const Record &record)
+{
+  NS_LOG_FUNCTION (this << record.time << record.uid);
+  uint8_t buffer[RECORD_SIZE];
+  uint8_t *p = WriteLe (buffer, record.time, 8);
+  p = WriteLe (p, record.uid, 8);
+  p = WriteLe (p, record.node, 4);
+  p = WriteLe (p, record.device, 4);
+  p = WriteLe (p, record.size, 4);
+  p = WriteLe (p, record.event, 1);
+  p = WriteLe (p, record.protocol, 1);
+  p = WriteLe (p, record.srcPort, 2);
+  p = WriteLe (p, record.dstPort, 2);
+  std::memcpy (p, record.src, 16);
+  std::memcpy (p + 16, record.dst, 16);
+  NS_ASSERT (p + 32 == buffer + RECORD_SIZE);
+  m_file.write ((const char *)buffer, RECORD_SIZE);
+}
+
+bool
+BinaryTraceFile::Read (Record &record)
+{
+  NS_LOG_FUNCTION (this);
+  uint8_t buffer[RECORD_SIZE];
+  m_file.read ((char *)buffer, RECORD_SIZE);
+  if (m_file.fail ())
+    {
+      return false;
+    }
+  const uint8_t *p = buffer;
+  record.time = ReadLe (p, 8);
+  record.uid = ReadLe (p, 8);
+  record.node = ReadLe (p, 4);
+  record.device = ReadLe (p, 4);
+  record.size = ReadLe (p, 4);
+  record.event = ReadLe (p, 1);
+  record.protocol = ReadLe (p, 1);
+  record.srcPort = ReadLe (p, 2);
+  record.dstPort = ReadLe (p, 2);
+  std::memcpy (record.src, p, 16);
+  std::memcpy (record.dst, p + 16, 16);
+  return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BINARY_TRACE_FILE_H
+#define BINARY_TRACE_FILE_H
+
+#include <string>
+#include <fstream>
+#include <vector>
+#include <stdint.h>
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+
+/**
+ * \brief A file of fixed-width binary packet trace records
+ *
+ * A compact alternative to the ascii traces: each traced event is stored
+ * as a record of RECORD_SIZE bytes, without printing the packet. The file
+ * starts with a header describing the fields of the records (the schema),
+ * so that the file can be read by other tools, e.g., with the
+ * convert-binary-trace program of utils/, which writes it as csv or as
+ * one raw file per column.
+ *
+ * The file format is:
+ *  - the magic number "ns3T" (4 bytes), the format version (2 bytes),
+ *    the size of the records (2 bytes) and the number of fields (2 bytes);
+ *  - for each field, the length of its name (1 byte), its name, its type
+ *    ('i' for signed integers, 'u' for unsigned integers, 'a' for byte
+ *    arrays) (1 byte) and its size (1 byte);
+ *  - the records, whose fields are stored in the schema order, without
+ *    padding.
+ *
+ * All the integers are little endian.
+ */
+class BinaryTraceFile : public SimpleRefCount<BinaryTraceFile>
+{
+public:
+  /**
+   * \brief A trace record
+   */
+  struct Record
+  {
+    int64_t  time;      //!< time of the event, in nanoseconds
+    uint64_t uid;       //!< packet uid
+    uint32_t node;      //!< node id
+    uint32_t device;    //!< device index in the node
+    uint32_t size;      //!< packet size
+    uint8_t  event;     //!< event type, as in the ascii traces ('+', '-', 'd', 'r')
+    uint8_t  protocol;  //!< IP protocol number, 0 if the packet is not IP
+    uint16_t srcPort;   //!< TCP or UDP source port, 0 if unknown
+    uint16_t dstPort;   //!< TCP or UDP destination port, 0 if unknown
+    uint8_t  src[16];   //!< IPv6 or IPv4-mapped source address, 0 if unknown
+    uint8_t  dst[16];   //!< IPv6 or IPv4-mapped destination address, 0 if unknown
+  };
+
+  /**
+   * \brief The description of a field of the records
+   */
+  struct Field
+  {
+    std::string name;   //!< field name
+    char type;          //!< 'i' (signed), 'u' (unsigned) or 'a' (byte array)
+    uint8_t size;       //!< field size in bytes
+  };
+
+  static const uint16_t VERSION = 1;      //!< Version of the file format
+  static const uint16_t RECORD_SIZE = 66; //!< Size of the serialized records
+
+  BinaryTraceFile ();
+  ~BinaryTraceFile ();
+
+  /**
+   * \returns the fields of the records, in file order
+   */
+  static const std::vector<Field> &GetSchema (void);
+
+  /**
+   * Create a new trace file, writing the file header, or open an existing
+   * trace file, reading and checking its header.
+   *
+   * \param filename the name of the file
+   * \param mode the access mode, std::ios::out or std::ios::in
+   */
+  void Open (std::string const &filename, std::ios::openmode mode);
+
+  /**
+   * Close the underlying file.
+   */
+  void Close (void);
+
+  /**
+   * \return true if the 'fail' bit is set in the underlying iostream, false otherwise.
+   */
+  bool Fail (void) const;
+
+  /**
+   * \return true if the 'eof' bit is set in the underlying iostream, false otherwise.
+   */
+  bool Eof (void) const;
+
+  /**
+   * \brief Write a record to the file
+   * \param record the record
+   */
+  void Write (const Record &record);
+
+  /**
+   * \brief Read the next record of the file
+   * \param record [out] the record
+   * \returns false at the end of the file or on error
+   */
+  bool Read (Record &record);
+
+private:
+  /**
+   * \brief Write the file header
+   */
+  void WriteFileHeader (void);
+  /**
+   * \brief Read and verify the file header
+   */
+  void ReadAndVerifyFileHeader (void);
+
+  std::string  m_filename;  //!< file name
+  std::fstream m_file;      //!< file stream
+};
+
+} // namespace ns3
+
+#endif /* BINARY_TRACE_FILE_H */
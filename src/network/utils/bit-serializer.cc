@@ -18,6 +18,7 @@
  * Author: Tommaso Pecorella <tommaso.pecorella@unifi.it>
  */
 
+#include <algorithm>
 #include <iostream>
 #include "bit-serializer.h"
 #include "ns3/log.h"
@@ -31,6 +32,7 @@ NS_LOG_COMPONENT_DEFINE ("BitSerializer");
 BitSerializer::BitSerializer ()
 {
   NS_LOG_FUNCTION (this);
+  m_numBits = 0;
   m_padAtEnd = true;
 }
 
@@ -44,36 +46,44 @@ void BitSerializer::PadAtStart ()
 {
   NS_LOG_FUNCTION (this);
 
-  uint8_t padding = 8 - (m_blob.size () % 8);
+  uint8_t padding = (8 - (m_numBits % 8)) % 8;
 
-  m_blob.insert (m_blob.begin (), padding, false);
+  // shift the whole blob right, the last byte has room for the padding
+  if (padding > 0)
+    {
+      for (size_t index = m_blob.size () - 1; index > 0; index--)
+        {
+          m_blob[index] = (m_blob[index] >> padding) | (m_blob[index - 1] << (8 - padding));
+        }
+      m_blob[0] >>= padding;
+    }
+  m_numBits = m_blob.size () * 8;
 }
 
 void BitSerializer::PadAtEnd ()
 {
-  uint8_t padding = 8 - (m_blob.size () % 8);
-
-  m_blob.insert (m_blob.end (), padding, false);
+  // the unused bits of the last byte are already zero
+  m_numBits = m_blob.size () * 8;
 }
 
 void BitSerializer::PushBits (uint64_t value, uint8_t significantBits)
 {
   NS_LOG_FUNCTION (this << value << +significantBits);
+  NS_ASSERT_MSG (significantBits <= 64, "Number of pushed bits exceeds 64");
 
-  uint64_t mask = 1;
-  mask <<= significantBits - 1;
-
-  for (uint8_t i = 0; i < significantBits; i++)
+  // fill the free bits of the last byte, then add a byte at a time
+  while (significantBits > 0)
     {
-      if (value & mask)
-        {
-          m_blob.push_back (true);
-        }
-      else
+      uint8_t usedBits = m_numBits % 8;
+      if (usedBits == 0)
         {
-          m_blob.push_back (false);
+          m_blob.push_back (0);
         }
-      mask >>= 1;
+      uint8_t bits = std::min<uint8_t> (8 - usedBits, significantBits);
+      uint8_t chunk = (value >> (significantBits - bits)) & ((1 << bits) - 1);
+      m_blob.back () |= chunk << (8 - usedBits - bits);
+      significantBits -= bits;
+      m_numBits += bits;
     }
 }
 
@@ -81,22 +91,12 @@ std::vector<uint8_t> BitSerializer::GetBytes ()
 {
   NS_LOG_FUNCTION (this);
 
-  std::vector<uint8_t> result;
-
   m_padAtEnd ? PadAtEnd () : PadAtStart ();
 
-  for (auto it = m_blob.begin (); it != m_blob.end ();)
-    {
-      uint8_t tmp = 0;
-      for (uint8_t i = 0; i < 8; ++i)
-        {
-          tmp <<= 1;
-          tmp |= (*it & 1);
-          it++;
-        }
-      result.push_back (tmp);
-    }
+  // the blob keeps its capacity, to be reused by the next serialization
+  std::vector<uint8_t> result (m_blob);
   m_blob.clear ();
+  m_numBits = 0;
   return result;
 }
 
@@ -104,26 +104,14 @@ uint8_t BitSerializer::GetBytes (uint8_t *buffer, uint32_t size)
 {
   NS_LOG_FUNCTION (this << buffer << size);
 
-  uint8_t resultLen = 0;
-
   m_padAtEnd ? PadAtEnd () : PadAtStart ();
 
-  NS_ABORT_MSG_IF (m_blob.size () <= 8 * size, "Target buffer is too short, " << m_blob.size () / 8 << " bytes needed" );
+  NS_ABORT_MSG_IF (m_blob.size () > size, "Target buffer is too short, " << m_blob.size () << " bytes needed" );
 
-  for (auto it = m_blob.begin (); it != m_blob.end ();)
-    {
-      uint8_t tmp = 0;
-      for (uint8_t i = 0; i < 8; ++i)
-        {
-          tmp <<= 1;
-          tmp |= (*it & 1);
-          it++;
-        }
-      buffer[resultLen] = tmp;
-      resultLen++;
-
-    }
+  uint8_t resultLen = m_blob.size ();
+  std::copy (m_blob.begin (), m_blob.end (), buffer);
   m_blob.clear ();
+  m_numBits = 0;
   return resultLen;
 }
 
@@ -108,7 +108,8 @@ private:
    */
   void PadAtEnd ();
 
-  std::vector<bool> m_blob; //!< Blob of serialized bits.
+  std::vector<uint8_t> m_blob; //!< Blob of serialized bits, starting from the most significant bit of the first byte.
+  uint32_t m_numBits; //!< Number of bits in the blob.
   bool m_padAtEnd; //!< True if the padding must be added at the end of the blob.
 };
 
@@ -46,6 +46,13 @@ PcapFileWrapper::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&PcapFileWrapper::m_nanosecMode),
                    MakeBooleanChecker())
+    .AddAttribute ("WriteBufferSize",
+                   "Size in bytes of the buffers in which the packets are serialized "
+                   "before being written to the file by a background thread. "
+                   "Zero writes each packet to the file synchronously.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&PcapFileWrapper::m_writeBufferSize),
+                   MakeUintegerChecker<uint32_t> ())
   ;
   return tid;
 }
@@ -89,11 +96,22 @@ PcapFileWrapper::Close (void)
   m_file.Close ();
 }
 
+void
+PcapFileWrapper::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_file.Flush ();
+}
+
 void
 PcapFileWrapper::Open (std::string const &filename, std::ios::openmode mode)
 {
   NS_LOG_FUNCTION (this << filename << mode);
   m_file.Open (filename, mode);
+  if (mode & std::ios::out)
+    {
+      m_file.SetWriteBufferSize (m_writeBufferSize);
+    }
 }
 
 void
@@ -29,6 +29,14 @@
 #include "pcap-file.h"
 #include "ns3/log.h"
 #include "ns3/build-profile.h"
+#include "ns3/core-config.h"
+
+#ifdef HAVE_PTHREAD_H
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#endif
 //
 // This file is used as part of the ns-3 test framework, so please refrain from 
 // adding any ns-3 specific constructs such as Packet to this file.
@@ -47,10 +55,104 @@ const uint32_t NS_SWAPPED_MAGIC = 0x4d3cb2a1; /**< Looks this way if byte swappi
 const uint16_t VERSION_MAJOR = 2;             /**< Major version of supported pcap file format */
 const uint16_t VERSION_MINOR = 4;             /**< Minor version of supported pcap file format */
 
+#ifdef HAVE_PTHREAD_H
+/**
+ * \brief The thread writing the buffers of the buffered pcap files
+ *
+ * A file hands its full write buffer over by swapping it with its spare
+ * buffer and queuing itself; the thread writes the spare buffer to the
+ * file stream, then clears PcapFile::m_writing. Until then, the file
+ * does not touch its stream nor its spare buffer.
+ */
+class PcapFile::Writer
+{
+public:
+  /**
+   * \returns the writer thread shared by all the files
+   */
+  static Writer &Get (void)
+  {
+    static Writer writer;
+    return writer;
+  }
+
+  /**
+   * \brief Queue the spare buffer of a file
+   * \param file the file
+   */
+  void Submit (PcapFile *file)
+  {
+    std::unique_lock<std::mutex> lock (m_mutex);
+    file->m_writing = true;
+    m_queue.push_back (file);
+    m_work.notify_one ();
+  }
+
+  /**
+   * \brief Wait until the spare buffer of a file has been written
+   * \param file the file
+   */
+  void Wait (const PcapFile *file)
+  {
+    std::unique_lock<std::mutex> lock (m_mutex);
+    m_done.wait (lock, [file] { return !file->m_writing; });
+  }
+
+private:
+  Writer ()
+    : m_stop (false),
+      m_thread (&Writer::Run, this)
+  {}
+
+  ~Writer ()
+  {
+    {
+      std::unique_lock<std::mutex> lock (m_mutex);
+      m_stop = true;
+      m_work.notify_one ();
+    }
+    m_thread.join ();
+  }
+
+  /**
+   * \brief Write the queued buffers until the writer is destroyed
+   */
+  void Run (void)
+  {
+    std::unique_lock<std::mutex> lock (m_mutex);
+    while (true)
+      {
+        m_work.wait (lock, [this] { return m_stop || !m_queue.empty (); });
+        if (m_queue.empty ())
+          {
+            return;
+          }
+        PcapFile *file = m_queue.front ();
+        m_queue.pop_front ();
+        lock.unlock ();
+        file->m_file.write ((const char *)file->m_spareBuffer.data (), file->m_spareBuffer.size ());
+        file->m_spareBuffer.clear ();
+        lock.lock ();
+        file->m_writing = false;
+        m_done.notify_all ();
+      }
+  }
+
+  std::mutex m_mutex;               //!< protects the queue and PcapFile::m_writing
+  std::condition_variable m_work;   //!< signaled when a buffer is queued
+  std::condition_variable m_done;   //!< signaled when a buffer has been written
+  std::deque<PcapFile *> m_queue;   //!< files whose spare buffer must be written
+  bool m_stop;                      //!< whether the thread must exit
+  std::thread m_thread;             //!< the writer thread
+};
+#endif /* HAVE_PTHREAD_H */
+
 PcapFile::PcapFile ()
   : m_file (),
     m_swapMode (false),
-    m_nanosecMode (false)
+    m_nanosecMode (false),
+    m_writeBufferSize (0),
+    m_writing (false)
 {
   NS_LOG_FUNCTION (this);
   FatalImpl::RegisterStream (&m_file); 
@@ -68,18 +170,21 @@ bool
 PcapFile::Fail (void) const
 {
   NS_LOG_FUNCTION (this);
+  WaitWriter ();
   return m_file.fail ();
 }
 bool 
 PcapFile::Eof (void) const
 {
   NS_LOG_FUNCTION (this);
+  WaitWriter ();
   return m_file.eof ();
 }
 void 
 PcapFile::Clear (void)
 {
   NS_LOG_FUNCTION (this);
+  WaitWriter ();
   m_file.clear ();
 }
 
@@ -88,9 +193,79 @@ void
 PcapFile::Close (void)
 {
   NS_LOG_FUNCTION (this);
+  Flush ();
   m_file.close ();
 }
 
+void
+PcapFile::SetWriteBufferSize (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  Flush ();
+  m_writeBufferSize = size;
+  m_writeBuffer.reserve (size);
+}
+
+void
+PcapFile::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_writeBuffer.empty ())
+    {
+      SubmitWriteBuffer ();
+    }
+  WaitWriter ();
+  if (m_file.is_open ())
+    {
+      m_file.flush ();
+    }
+}
+
+void
+PcapFile::WaitWriter (void) const
+{
+#ifdef HAVE_PTHREAD_H
+  if (m_writeBufferSize > 0)
+    {
+      Writer::Get ().Wait (this);
+    }
+#endif
+}
+
+void
+PcapFile::SubmitWriteBuffer (void)
+{
+  NS_LOG_FUNCTION (this << m_writeBuffer.size ());
+#ifdef HAVE_PTHREAD_H
+  //
+  // Wait for the previous buffer to be written: the simulation only
+  // blocks if the disk cannot keep up.
+  //
+  WaitWriter ();
+  NS_ASSERT (m_file.good ());
+  m_writeBuffer.swap (m_spareBuffer);
+  Writer::Get ().Submit (this);
+#else
+  m_file.write ((const char *)m_writeBuffer.data (), m_writeBuffer.size ());
+  m_writeBuffer.clear ();
+#endif
+}
+
+void
+PcapFile::CheckWriteBuffer (void)
+{
+  if (m_writeBuffer.size () >= m_writeBufferSize)
+    {
+      SubmitWriteBuffer ();
+    }
+}
+
+uint8_t *
+PcapFile::GetRecordData (uint32_t inclLen)
+{
+  return m_writeBuffer.data () + m_writeBuffer.size () - inclLen;
+}
+
 uint32_t
 PcapFile::GetMagic (void)
 {
@@ -369,6 +544,11 @@ PcapFile::Init (uint32_t dataLinkType, uint32_t snapLen, int32_t timeZoneCorrect
   m_fileHeader.m_snapLen = snapLen;
   m_fileHeader.m_type = dataLinkType;
 
+  //
+  // The records already written, if any, are overwritten.
+  //
+  Flush ();
+
   //
   // We use pcap files for regression testing.  We do byte-for-byte comparisons
   // in those tests to determine pass or fail.  If we allow big endian systems
@@ -403,7 +583,6 @@ uint32_t
 PcapFile::WritePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
 {
   NS_LOG_FUNCTION (this << tsSec << tsUsec << totalLen);
-  NS_ASSERT (m_file.good ());
 
   uint32_t inclLen = totalLen > m_fileHeader.m_snapLen ? m_fileHeader.m_snapLen : totalLen;
 
@@ -422,6 +601,23 @@ PcapFile::WritePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
   // Watch out for memory alignment differences between machines, so write
   // them all individually.
   //
+  if (m_writeBufferSize > 0)
+    {
+      //
+      // Serialize the record header in the write buffer, followed by the
+      // space for the packet data (see GetRecordData).
+      //
+      std::size_t offset = m_writeBuffer.size ();
+      m_writeBuffer.resize (offset + 4 * sizeof (uint32_t) + inclLen);
+      uint8_t *record = &m_writeBuffer[offset];
+      std::memcpy (record, &header.m_tsSec, sizeof(header.m_tsSec));
+      std::memcpy (record + 4, &header.m_tsUsec, sizeof(header.m_tsUsec));
+      std::memcpy (record + 8, &header.m_inclLen, sizeof(header.m_inclLen));
+      std::memcpy (record + 12, &header.m_origLen, sizeof(header.m_origLen));
+      return inclLen;
+    }
+
+  NS_ASSERT (m_file.good ());
   m_file.write ((const char *)&header.m_tsSec, sizeof(header.m_tsSec));
   m_file.write ((const char *)&header.m_tsUsec, sizeof(header.m_tsUsec));
   m_file.write ((const char *)&header.m_inclLen, sizeof(header.m_inclLen));
@@ -435,6 +631,12 @@ PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, uint8_t const * const data, ui
 {
   NS_LOG_FUNCTION (this << tsSec << tsUsec << &data << totalLen);
   uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, totalLen);
+  if (m_writeBufferSize > 0)
+    {
+      std::memcpy (GetRecordData (inclLen), data, inclLen);
+      CheckWriteBuffer ();
+      return;
+    }
   m_file.write ((const char *)data, inclLen);
   NS_BUILD_DEBUG(m_file.flush());
 }
@@ -444,6 +646,12 @@ PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << tsSec << tsUsec << p);
   uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, p->GetSize ());
+  if (m_writeBufferSize > 0)
+    {
+      p->CopyData (GetRecordData (inclLen), inclLen);
+      CheckWriteBuffer ();
+      return;
+    }
   p->CopyData (&m_file, inclLen);
   NS_BUILD_DEBUG(m_file.flush());
 }
@@ -460,6 +668,14 @@ PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, const Header &header, Ptr<cons
   headerBuffer.AddAtStart (headerSize);
   header.Serialize (headerBuffer.Begin ());
   uint32_t toCopy = std::min (headerSize, inclLen);
+  if (m_writeBufferSize > 0)
+    {
+      uint8_t *data = GetRecordData (inclLen);
+      headerBuffer.CopyData (data, toCopy);
+      p->CopyData (data + toCopy, inclLen - toCopy);
+      CheckWriteBuffer ();
+      return;
+    }
   headerBuffer.CopyData (&m_file, toCopy);
   inclLen -= toCopy;
   p->CopyData (&m_file, inclLen);
@@ -23,6 +23,7 @@
 
 #include <string>
 #include <fstream>
+#include <vector>
 #include <stdint.h>
 #include "ns3/ptr.h"
 
@@ -85,6 +86,34 @@ public:
    */
   void Close (void);
 
+  /**
+   * \brief Buffer the records written to the file.
+   *
+   * The records are serialized in a buffer in memory, and the full
+   * buffers are handed to a background thread which writes them to the
+   * file. Each file has two buffers, filled and written alternately, so
+   * the simulation only waits for the disk when the background thread
+   * is a whole buffer behind. The background thread is shared by all
+   * the files.
+   *
+   * When buffering is enabled, errors happening while writing to the
+   * file are reported by Fail once the records have been written, i.e.,
+   * after a call to Flush or Close.
+   *
+   * Without threading support, the buffers are written to the file
+   * by the simulation thread.
+   *
+   * \param size The size of the buffers, in bytes. Zero (the default)
+   * writes each record to the file synchronously.
+   */
+  void SetWriteBufferSize (uint32_t size);
+
+  /**
+   * \brief Write the buffered records to the file and wait until
+   * they have been written.
+   */
+  void Flush (void);
+
   /**
    * Initialize the pcap file associated with this object.  This file must have
    * been previously opened with write permissions.
@@ -364,11 +393,36 @@ private:
    */
   void ReadAndVerifyFileHeader (void);
 
+  /**
+   * \brief Get the space of the data of the last record in the write buffer
+   * \param inclLen the length of the packet data of the record
+   * \returns the start of the space for the packet data
+   */
+  uint8_t *GetRecordData (uint32_t inclLen);
+  /**
+   * \brief Hand the write buffer to the writer thread if it is full
+   */
+  void CheckWriteBuffer (void);
+  /**
+   * \brief Hand the write buffer to the writer thread
+   */
+  void SubmitWriteBuffer (void);
+  /**
+   * \brief Wait until the writer thread has written the buffer handed to it
+   */
+  void WaitWriter (void) const;
+
+  class Writer;
+
   std::string    m_filename;    //!< file name
   std::fstream   m_file;        //!< file stream
   PcapFileHeader m_fileHeader;  //!< file header
   bool m_swapMode;              //!< swap mode
   bool m_nanosecMode;           //!< nanosecond timestamp mode
+  uint32_t m_writeBufferSize;   //!< size of the write buffers, zero if unbuffered
+  std::vector<uint8_t> m_writeBuffer; //!< records not yet handed to the writer thread
+  std::vector<uint8_t> m_spareBuffer; //!< buffer returned by the writer thread
+  bool m_writing;               //!< whether the writer thread holds a buffer of this file
 };
 
 } // namespace ns3
@@ -218,6 +218,34 @@ PointToPointHelper::EnableAsciiInternal (
   Config::Connect (oss.str (), MakeBoundCallback (&AsciiTraceHelper::DefaultDropSinkWithContext, stream));
 }
 
+void
+PointToPointHelper::EnableBinaryTraceInternal (Ptr<BinaryTraceFile> file, Ptr<NetDevice> nd)
+{
+  //
+  // All of the binary trace enable functions vector through here.  We can
+  // only deal with devices of type PointToPointNetDevice.
+  //
+  Ptr<PointToPointNetDevice> device = nd->GetObject<PointToPointNetDevice> ();
+  if (device == 0)
+    {
+      NS_LOG_INFO ("PointToPointHelper::EnableBinaryTraceInternal(): Device " << device << " not of type ns3::PointToPointNetDevice");
+      return;
+    }
+
+  //
+  // The same events as the ascii traces: MacRx provides the "r" event, and
+  // the "+", '-', and 'd' events are driven by the transmit queue.  All the
+  // packets carry the link layer header.
+  //
+  BinaryTraceHelper binaryTraceHelper;
+  binaryTraceHelper.HookDefaultSink<PointToPointNetDevice> (device, "MacRx", file, device, 'r', PcapHelper::DLT_PPP);
+  Ptr<Queue<Packet> > queue = device->GetQueue ();
+  binaryTraceHelper.HookDefaultSink<Queue<Packet> > (queue, "Enqueue", file, device, '+', PcapHelper::DLT_PPP);
+  binaryTraceHelper.HookDefaultSink<Queue<Packet> > (queue, "Drop", file, device, 'd', PcapHelper::DLT_PPP);
+  binaryTraceHelper.HookDefaultSink<Queue<Packet> > (queue, "Dequeue", file, device, '-', PcapHelper::DLT_PPP);
+  binaryTraceHelper.HookDefaultSink<PointToPointNetDevice> (device, "PhyRxDrop", file, device, 'd', PcapHelper::DLT_PPP);
+}
+
 NetDeviceContainer 
 PointToPointHelper::Install (NodeContainer c)
 {
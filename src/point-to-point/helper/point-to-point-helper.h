@@ -41,7 +41,8 @@ class Node;
  * "mixins".
  */
 class PointToPointHelper : public PcapHelperForDevice,
-	                   public AsciiTraceHelperForDevice
+	                   public AsciiTraceHelperForDevice,
+	                   public BinaryTraceHelperForDevice
 {
 public:
   /**
@@ -181,6 +182,17 @@ private:
     Ptr<NetDevice> nd,
     bool explicitFilename);
 
+  /**
+   * \brief Enable binary trace output on the indicated net device.
+   *
+   * NetDevice-specific implementation mechanism for hooking the trace and
+   * writing to the trace file.
+   *
+   * \param file The binary trace file to write the records to.
+   * \param nd Net device for which you want to enable tracing.
+   */
+  virtual void EnableBinaryTraceInternal (Ptr<BinaryTraceFile> file, Ptr<NetDevice> nd);
+
   ObjectFactory m_queueFactory;         //!< Queue Factory
   ObjectFactory m_channelFactory;       //!< Channel Factory
   ObjectFactory m_deviceFactory;        //!< Device Factory
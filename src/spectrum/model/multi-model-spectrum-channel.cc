@@ -29,6 +29,7 @@
 #include <ns3/net-device.h>
 #include <ns3/node.h>
 #include <ns3/double.h>
+#include <ns3/boolean.h>
 #include <ns3/mobility-model.h>
 #include <ns3/spectrum-phy.h>
 #include <ns3/spectrum-converter.h>
@@ -79,7 +80,8 @@ RxSpectrumModelInfo::RxSpectrumModelInfo (Ptr<const SpectrumModel> rxSpectrumMod
 }
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel ()
-  : m_numDevices {0}
+  : m_numDevices {0},
+    m_linkCache (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -90,6 +92,13 @@ MultiModelSpectrumChannel::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_txSpectrumModelInfoMap.clear ();
   m_rxSpectrumModelInfoMap.clear ();
+  for (const auto &mobility : m_trackedMobility)
+    {
+      mobility->TraceDisconnectWithoutContext ("CourseChange",
+                                               MakeCallback (&MultiModelSpectrumChannel::NotifyCourseChange, this));
+    }
+  m_trackedMobility.clear ();
+  m_linkStates.clear ();
   SpectrumChannel::DoDispose ();
 }
 
@@ -100,7 +109,16 @@ MultiModelSpectrumChannel::GetTypeId (void)
     .SetParent<SpectrumChannel> ()
     .SetGroupName ("Spectrum")
     .AddConstructor<MultiModelSpectrumChannel> ()
-
+    .AddAttribute ("LinkCache",
+                   "If true, the antenna gains, the propagation loss and the "
+                   "propagation delay of the links between static SpectrumPhy "
+                   "instances are computed once and reused until one end of "
+                   "the link changes course. Enable it only if the "
+                   "PropagationLossModel, the PropagationDelayModel and the "
+                   "antenna models are deterministic.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MultiModelSpectrumChannel::m_linkCache),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -269,62 +287,53 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 
           if ((*rxPhyIterator) != txParams->txPhy)
             {
-              NS_LOG_LOGIC ("copying signal parameters " << txParams);
-              Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
-              rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
               Time delay = MicroSeconds (0);
+              double pathGainLinear = 1;
 
               Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
 
               if (txMobility && receiverMobility)
                 {
-                  double txAntennaGain = 0;
-                  double rxAntennaGain = 0;
-                  double propagationGainDb = 0;
-                  double pathLossDb = 0;
-                  if (rxParams->txAntenna != 0)
-                    {
-                      Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
-                      txAntennaGain = rxParams->txAntenna->GetGainDb (txAngles);
-                      NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
-                      pathLossDb -= txAntennaGain;
-                    }
                   Ptr<AntennaModel> rxAntenna = (*rxPhyIterator)->GetRxAntenna ();
-                  if (rxAntenna != 0)
+                  LinkState computedLink;
+                  const LinkState *link = &computedLink;
+                  if (m_linkCache)
                     {
-                      Angles rxAngles (txMobility->GetPosition (), receiverMobility->GetPosition ());
-                      rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
-                      NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
-                      pathLossDb -= rxAntennaGain;
+                      link = &GetLinkState (txParams, *rxPhyIterator, txMobility, receiverMobility, rxAntenna, computedLink);
                     }
-                  if (m_propagationLoss)
+                  else
                     {
-                      propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, receiverMobility);
-                      NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
-                      pathLossDb -= propagationGainDb;
-                    }                    
+                      CalcLinkState (txParams, txMobility, receiverMobility, rxAntenna, computedLink);
+                    }
+                  // the cached link may be invalidated by the trace sinks
+                  double pathLossDb = link->pathLossDb;
+                  pathGainLinear = link->pathGainLinear;
+                  delay = link->delay;
                   NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");
                   // Gain trace
-                  m_gainTrace (txMobility, receiverMobility, txAntennaGain, rxAntennaGain, propagationGainDb, pathLossDb);
+                  m_gainTrace (txMobility, receiverMobility, link->txAntennaGain, link->rxAntennaGain,
+                               link->propagationGainDb, pathLossDb);
                   // Pathloss trace
                   m_pathLossTrace (txParams->txPhy, *rxPhyIterator, pathLossDb);
                   if (pathLossDb > m_maxLossDb)
                     {
-                      // beyond range
+                      // beyond range, the signal parameters are not even copied
                       continue;
                     }
-                  double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
-                  *(rxParams->psd) *= pathGainLinear;              
+                }
+
+              NS_LOG_LOGIC ("copying signal parameters " << txParams);
+              Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
+              rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
+
+              if (txMobility && receiverMobility)
+                {
+                  *(rxParams->psd) *= pathGainLinear;
 
                   if (m_spectrumPropagationLoss)
                     {
                       rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->psd, txMobility, receiverMobility);
                     }
-
-                  if (m_propagationDelay)
-                    {
-                      delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
-                    }
                 }
 
               Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
@@ -348,6 +357,108 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 
 }
 
+void
+MultiModelSpectrumChannel::CalcLinkState (Ptr<const SpectrumSignalParameters> txParams,
+                                          Ptr<MobilityModel> txMobility, Ptr<MobilityModel> rxMobility,
+                                          Ptr<AntennaModel> rxAntenna, LinkState &link) const
+{
+  NS_LOG_FUNCTION (this << txParams << txMobility << rxMobility << rxAntenna);
+  link.txMobility = txMobility;
+  link.rxMobility = rxMobility;
+  link.txAntenna = txParams->txAntenna;
+  link.rxAntenna = rxAntenna;
+  link.txAntennaGain = 0;
+  link.rxAntennaGain = 0;
+  link.propagationGainDb = 0;
+  link.pathLossDb = 0;
+  if (txParams->txAntenna != 0)
+    {
+      Angles txAngles (rxMobility->GetPosition (), txMobility->GetPosition ());
+      link.txAntennaGain = txParams->txAntenna->GetGainDb (txAngles);
+      NS_LOG_LOGIC ("txAntennaGain = " << link.txAntennaGain << " dB");
+      link.pathLossDb -= link.txAntennaGain;
+    }
+  if (rxAntenna != 0)
+    {
+      Angles rxAngles (txMobility->GetPosition (), rxMobility->GetPosition ());
+      link.rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
+      NS_LOG_LOGIC ("rxAntennaGain = " << link.rxAntennaGain << " dB");
+      link.pathLossDb -= link.rxAntennaGain;
+    }
+  if (m_propagationLoss)
+    {
+      link.propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, rxMobility);
+      NS_LOG_LOGIC ("propagationGainDb = " << link.propagationGainDb << " dB");
+      link.pathLossDb -= link.propagationGainDb;
+    }
+  link.pathGainLinear = std::pow (10.0, (-link.pathLossDb) / 10.0);
+  link.delay = MicroSeconds (0);
+  if (m_propagationDelay && link.pathLossDb <= m_maxLossDb)
+    {
+      link.delay = m_propagationDelay->GetDelay (txMobility, rxMobility);
+    }
+}
+
+const MultiModelSpectrumChannel::LinkState &
+MultiModelSpectrumChannel::GetLinkState (Ptr<const SpectrumSignalParameters> txParams, Ptr<SpectrumPhy> rxPhy,
+                                         Ptr<MobilityModel> txMobility, Ptr<MobilityModel> rxMobility,
+                                         Ptr<AntennaModel> rxAntenna, LinkState &link)
+{
+  LinkStateMap_t::iterator it = m_linkStates.find (std::make_pair (txParams->txPhy, rxPhy));
+  if (it != m_linkStates.end ()
+      && it->second.txMobility == txMobility && it->second.rxMobility == rxMobility
+      && it->second.txAntenna == txParams->txAntenna && it->second.rxAntenna == rxAntenna)
+    {
+      NS_LOG_LOGIC ("using the cached link " << txParams->txPhy << " --> " << rxPhy);
+      return it->second;
+    }
+
+  CalcLinkState (txParams, txMobility, rxMobility, rxAntenna, link);
+  if (txMobility->GetVelocity ().GetLengthSquared () != 0
+      || rxMobility->GetVelocity ().GetLengthSquared () != 0)
+    {
+      // a moving node does not notify a course change at each position
+      if (it != m_linkStates.end ())
+        {
+          m_linkStates.erase (it);
+        }
+      return link;
+    }
+
+  NS_LOG_LOGIC ("caching the link " << txParams->txPhy << " --> " << rxPhy);
+  for (const auto &mobility : {txMobility, rxMobility})
+    {
+      if (m_trackedMobility.insert (mobility).second)
+        {
+          mobility->TraceConnectWithoutContext ("CourseChange",
+                                                MakeCallback (&MultiModelSpectrumChannel::NotifyCourseChange, this));
+        }
+    }
+  if (it != m_linkStates.end ())
+    {
+      it->second = link;
+      return it->second;
+    }
+  return m_linkStates.insert (std::make_pair (std::make_pair (txParams->txPhy, rxPhy), link)).first->second;
+}
+
+void
+MultiModelSpectrumChannel::NotifyCourseChange (Ptr<const MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+  for (LinkStateMap_t::iterator it = m_linkStates.begin (); it != m_linkStates.end (); )
+    {
+      if (it->second.txMobility == mobility || it->second.rxMobility == mobility)
+        {
+          it = m_linkStates.erase (it);
+        }
+      else
+        {
+          ++it;
+        }
+    }
+}
+
 void
 MultiModelSpectrumChannel::StartRx (Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver)
 {
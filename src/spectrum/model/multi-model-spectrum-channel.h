@@ -27,8 +27,10 @@
 #include <ns3/spectrum-channel.h>
 #include <ns3/spectrum-propagation-loss-model.h>
 #include <ns3/propagation-delay-model.h>
+#include <ns3/nstime.h>
 #include <map>
 #include <set>
+#include <utility>
 
 namespace ns3 {
 
@@ -102,6 +104,18 @@ typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap
  * for this to work is that, after the SpectrumPhy switched its
  * SpectrumModel,  MultiModelSpectrumChannel::AddRx () is
  * called again passing the pointer to that SpectrumPhy.
+ *
+ * The antenna gains, the propagation loss and the propagation delay of
+ * each link can be cached between transmissions with the attribute
+ * LinkCache, so that they are not computed again at each transmission
+ * when both ends of the link are static. A cached link is invalidated
+ * when one of its ends notifies a course change, or when the transmit
+ * antenna, the receive antenna or the mobility model of one of its
+ * SpectrumPhy changes. The cache must only be enabled when the
+ * PropagationLossModel, the PropagationDelayModel and the antenna
+ * models are deterministic and do not change over time; the
+ * SpectrumPropagationLossModel is not cached and is evaluated at each
+ * transmission.
  */
 class MultiModelSpectrumChannel : public SpectrumChannel
 {
@@ -149,6 +163,66 @@ private:
    */
   virtual void StartRx (Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
 
+  /**
+   * The gains of a link between a transmitting and a receiving SpectrumPhy.
+   */
+  struct LinkState
+  {
+    Ptr<MobilityModel> txMobility;  //!< Mobility model of the transmitter.
+    Ptr<MobilityModel> rxMobility;  //!< Mobility model of the receiver.
+    Ptr<AntennaModel> txAntenna;    //!< Antenna of the transmitter.
+    Ptr<AntennaModel> rxAntenna;    //!< Antenna of the receiver.
+    double txAntennaGain;           //!< Tx antenna gain [dB].
+    double rxAntennaGain;           //!< Rx antenna gain [dB].
+    double propagationGainDb;       //!< Propagation gain [dB].
+    double pathLossDb;              //!< Total path loss [dB].
+    double pathGainLinear;          //!< Total path gain, linear.
+    Time delay;                     //!< Propagation delay.
+  };
+
+  /**
+   * Container: (tx SpectrumPhy, rx SpectrumPhy), LinkState
+   */
+  typedef std::map<std::pair<Ptr<SpectrumPhy>, Ptr<SpectrumPhy> >, LinkState> LinkStateMap_t;
+
+  /**
+   * Compute the gains of a link. The propagation delay is only computed
+   * if the receiver is within range.
+   *
+   * \param txParams The signal parameters of the transmission.
+   * \param txMobility The mobility model of the transmitter.
+   * \param rxMobility The mobility model of the receiver.
+   * \param rxAntenna The antenna of the receiver.
+   * \param [out] link The gains of the link.
+   */
+  void CalcLinkState (Ptr<const SpectrumSignalParameters> txParams,
+                      Ptr<MobilityModel> txMobility, Ptr<MobilityModel> rxMobility,
+                      Ptr<AntennaModel> rxAntenna, LinkState &link) const;
+
+  /**
+   * Get the gains of a link from the cache, computing them if they
+   * are not cached. The gains are cached only if both ends of the
+   * link are static.
+   *
+   * \param txParams The signal parameters of the transmission.
+   * \param rxPhy The receiving SpectrumPhy.
+   * \param txMobility The mobility model of the transmitter.
+   * \param rxMobility The mobility model of the receiver.
+   * \param rxAntenna The antenna of the receiver.
+   * \param [out] link The gains of the link, when they are not cached.
+   * \return The gains of the link.
+   */
+  const LinkState & GetLinkState (Ptr<const SpectrumSignalParameters> txParams, Ptr<SpectrumPhy> rxPhy,
+                                  Ptr<MobilityModel> txMobility, Ptr<MobilityModel> rxMobility,
+                                  Ptr<AntennaModel> rxAntenna, LinkState &link);
+
+  /**
+   * Invalidate the cached links of a mobility model.
+   *
+   * \param mobility The mobility model that changed course.
+   */
+  void NotifyCourseChange (Ptr<const MobilityModel> mobility);
+
   /**
    * Data structure holding, for each TX SpectrumModel,  all the
    * converters to any RX SpectrumModel, and all the corresponding
@@ -169,6 +243,10 @@ private:
    */
   std::size_t m_numDevices;
 
+  bool m_linkCache;                                 //!< Whether the gains of the links are cached.
+  LinkStateMap_t m_linkStates;                      //!< The cached links.
+  std::set<Ptr<MobilityModel> > m_trackedMobility;  //!< The mobility models whose course changes are tracked.
+
 };
 
 
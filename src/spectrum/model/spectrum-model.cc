@@ -31,6 +31,9 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("SpectrumModel");
 
+/// Maximum number of buffers recycled by a SpectrumModel
+static const std::size_t MAX_POOLED_VALUES = 16;
+
 bool operator== (const SpectrumModel& lhs, const SpectrumModel& rhs)
 {
   return (lhs.m_uid == rhs.m_uid);
@@ -128,5 +131,27 @@ SpectrumModel::IsOrthogonal (const SpectrumModel &other) const
   return true;
 }
 
+std::vector<double>
+SpectrumModel::AcquireValues () const
+{
+  if (m_valuesPool.empty ())
+    {
+      return std::vector<double> (m_bands.size ());
+    }
+  std::vector<double> values = std::move (m_valuesPool.back ());
+  m_valuesPool.pop_back ();
+  return values;
+}
+
+void
+SpectrumModel::ReleaseValues (std::vector<double>&& values) const
+{
+  // a few buffers are enough for the temporaries of the SpectrumValue
+  // operators: do not keep the buffers of a peak of allocations
+  if (values.size () == m_bands.size () && m_valuesPool.size () < MAX_POOLED_VALUES)
+    {
+      m_valuesPool.push_back (std::move (values));
+    }
+}
 
 } // namespace ns3
@@ -138,9 +138,26 @@ public:
   bool IsOrthogonal (const SpectrumModel &other) const;
 
 private:
+  friend class SpectrumValue;
+
+  /**
+   * Get a buffer for the values of a SpectrumValue of this model.
+   *
+   * \return a buffer of GetNumBands () values, recycled if possible,
+   * in which case the values are not initialized
+   */
+  std::vector<double> AcquireValues () const;
+  /**
+   * Recycle the buffer of the values of a SpectrumValue of this model.
+   *
+   * \param values the buffer
+   */
+  void ReleaseValues (std::vector<double>&& values) const;
+
   Bands m_bands;         //!< Actual definition of frequency bands within this SpectrumModel
   SpectrumModelUid_t m_uid;        //!< unique id for a given set of frequencies
   static SpectrumModelUid_t m_uidCount;    //!< counter to assign m_uids
+  mutable std::vector<std::vector<double> > m_valuesPool; //!< buffers released by the SpectrumValues of this model
 };
 
 
@@ -19,6 +19,7 @@
  * Author: Nicola Baldo <nbaldo@cttc.es>
  */
 
+#include <algorithm>
 #include <ns3/spectrum-value.h>
 #include <ns3/math.h>
 #include <ns3/log.h>
@@ -33,9 +34,57 @@ SpectrumValue::SpectrumValue ()
 
 SpectrumValue::SpectrumValue (Ptr<const SpectrumModel> sof)
   : m_spectrumModel (sof),
-    m_values (sof->GetNumBands ())
+    m_values (sof->AcquireValues ())
 {
+  std::fill (m_values.begin (), m_values.end (), 0.0);
+}
+
+SpectrumValue::SpectrumValue (const SpectrumValue& other)
+  : SimpleRefCount<SpectrumValue> (other),
+    m_spectrumModel (other.m_spectrumModel)
+{
+  if (m_spectrumModel)
+    {
+      m_values = m_spectrumModel->AcquireValues ();
+    }
+  m_values.assign (other.m_values.begin (), other.m_values.end ());
+}
+
+SpectrumValue::SpectrumValue (SpectrumValue&& other)
+  : SimpleRefCount<SpectrumValue> (other),
+    m_spectrumModel (other.m_spectrumModel),
+    m_values (std::move (other.m_values))
+{
+  other.m_spectrumModel = 0;
+  other.m_values.clear ();
+}
+
+SpectrumValue::~SpectrumValue ()
+{
+  if (m_spectrumModel)
+    {
+      m_spectrumModel->ReleaseValues (std::move (m_values));
+    }
+}
+
+SpectrumValue&
+SpectrumValue::operator= (const SpectrumValue& other)
+{
+  if (this != &other)
+    {
+      m_spectrumModel = other.m_spectrumModel;
+      m_values.assign (other.m_values.begin (), other.m_values.end ());
+    }
+  return *this;
+}
 
+SpectrumValue&
+SpectrumValue::operator= (SpectrumValue&& other)
+{
+  // the buffer of *this is released by other
+  std::swap (m_spectrumModel, other.m_spectrumModel);
+  m_values.swap (other.m_values);
+  return *this;
 }
 
 double&
@@ -103,20 +152,22 @@ SpectrumValue::ConstBandsEnd () const
 }
 
 
+// The element by element operations loop on the raw arrays, so that
+// the compiler vectorizes them (with AVX2 in the optimized builds on
+// hosts supporting it, since they use -march=native).
+
 void
 SpectrumValue::Add (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
   NS_ASSERT (m_values.size () == x.m_values.size ());
 
-  while (it1 != m_values.end ())
+  double *v = m_values.data ();
+  const double *xv = x.m_values.data ();
+  const std::size_t n = m_values.size ();
+  for (std::size_t i = 0; i < n; ++i)
     {
-      *it1 += *it2;
-      ++it1;
-      ++it2;
+      v[i] += xv[i];
     }
 }
 
@@ -124,12 +175,11 @@ SpectrumValue::Add (const SpectrumValue& x)
 void
 SpectrumValue::Add (double s)
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  double *v = m_values.data ();
+  const std::size_t n = m_values.size ();
+  for (std::size_t i = 0; i < n; ++i)
     {
-      *it1 += s;
-      ++it1;
+      v[i] += s;
     }
 }
 
@@ -138,17 +188,15 @@ SpectrumValue::Add (double s)
 void
 SpectrumValue::Subtract (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
   NS_ASSERT (m_values.size () == x.m_values.size ());
 
-  while (it1 != m_values.end ())
+  double *v = m_values.data ();
+  const double *xv = x.m_values.data ();
+  const std::size_t n = m_values.size ();
+  for (std::size_t i = 0; i < n; ++i)
     {
-      *it1 -= *it2;
-      ++it1;
-      ++it2;
+      v[i] -= xv[i];
     }
 }
 
@@ -160,21 +208,34 @@ SpectrumValue::Subtract (double s)
 }
 
 
+void
+SpectrumValue::ReverseSubtract (const SpectrumValue& x)
+{
+  NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
+  NS_ASSERT (m_values.size () == x.m_values.size ());
+
+  double *v = m_values.data ();
+  const double *xv = x.m_values.data ();
+  const std::size_t n = m_values.size ();
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      v[i] = xv[i] - v[i];
+    }
+}
+
 
 void
 SpectrumValue::Multiply (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
   NS_ASSERT (m_values.size () == x.m_values.size ());
 
-  while (it1 != m_values.end ())
+  double *v = m_values.data ();
+  const double *xv = x.m_values.data ();
+  const std::size_t n = m_values.size ();
+  for (std::size_t i = 0; i < n; ++i)
     {
-      *it1 *= *it2;
-      ++it1;
-      ++it2;
+      v[i] *= xv[i];
     }
 }
 
@@ -182,12 +243,11 @@ SpectrumValue::Multiply (const SpectrumValue& x)
 void
 SpectrumValue::Multiply (double s)
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  double *v = m_values.data ();
+  const std::size_t n = m_values.size ();
+  for (std::size_t i = 0; i < n; ++i)
     {
-      *it1 *= s;
-      ++it1;
+      v[i] *= s;
     }
 }
 
@@ -197,17 +257,15 @@ SpectrumValue::Multiply (double s)
 void
 SpectrumValue::Divide (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
   NS_ASSERT (m_values.size () == x.m_values.size ());
 
-  while (it1 != m_values.end ())
+  double *v = m_values.data ();
+  const double *xv = x.m_values.data ();
+  const std::size_t n = m_values.size ();
+  for (std::size_t i = 0; i < n; ++i)
     {
-      *it1 /= *it2;
-      ++it1;
-      ++it2;
+      v[i] /= xv[i];
     }
 }
 
@@ -216,27 +274,74 @@ void
 SpectrumValue::Divide (double s)
 {
   NS_LOG_FUNCTION (this << s);
-  Values::iterator it1 = m_values.begin ();
+  double *v = m_values.data ();
+  const std::size_t n = m_values.size ();
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      v[i] /= s;
+    }
+}
 
-  while (it1 != m_values.end ())
+
+void
+SpectrumValue::ReverseDivide (const SpectrumValue& x)
+{
+  NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
+  NS_ASSERT (m_values.size () == x.m_values.size ());
+
+  double *v = m_values.data ();
+  const double *xv = x.m_values.data ();
+  const std::size_t n = m_values.size ();
+  for (std::size_t i = 0; i < n; ++i)
     {
-      *it1 /= s;
-      ++it1;
+      v[i] = xv[i] / v[i];
+    }
+}
+
+
+void
+SpectrumValue::AddScaled (const SpectrumValue& x, double s)
+{
+  NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
+  NS_ASSERT (m_values.size () == x.m_values.size ());
+
+  double *v = m_values.data ();
+  const double *xv = x.m_values.data ();
+  const std::size_t n = m_values.size ();
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      v[i] += s * xv[i];
     }
 }
 
 
+void
+SpectrumValue::AddProduct (const SpectrumValue& x, const SpectrumValue& y)
+{
+  NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
+  NS_ASSERT (m_spectrumModel == y.m_spectrumModel);
+  NS_ASSERT (m_values.size () == x.m_values.size ());
+  NS_ASSERT (m_values.size () == y.m_values.size ());
+
+  double *v = m_values.data ();
+  const double *xv = x.m_values.data ();
+  const double *yv = y.m_values.data ();
+  const std::size_t n = m_values.size ();
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      v[i] += xv[i] * yv[i];
+    }
+}
 
 
 void
 SpectrumValue::ChangeSign ()
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  double *v = m_values.data ();
+  const std::size_t n = m_values.size ();
+  for (std::size_t i = 0; i < n; ++i)
     {
-      *it1 = -(*it1);
-      ++it1;
+      v[i] = -v[i];
     }
 }
 
@@ -348,11 +453,11 @@ double
 Norm (const SpectrumValue& x)
 {
   double s = 0;
-  Values::const_iterator it1 = x.ConstValuesBegin ();
-  while (it1 != x.ConstValuesEnd ())
+  const double *v = x.m_values.data ();
+  const std::size_t n = x.m_values.size ();
+  for (std::size_t i = 0; i < n; ++i)
     {
-      s += (*it1) * (*it1);
-      ++it1;
+      s += v[i] * v[i];
     }
   return std::sqrt (s);
 }
@@ -362,11 +467,11 @@ double
 Sum (const SpectrumValue& x)
 {
   double s = 0;
-  Values::const_iterator it1 = x.ConstValuesBegin ();
-  while (it1 != x.ConstValuesEnd ())
+  const double *v = x.m_values.data ();
+  const std::size_t n = x.m_values.size ();
+  for (std::size_t i = 0; i < n; ++i)
     {
-      s += (*it1);
-      ++it1;
+      s += v[i];
     }
   return s;
 }
@@ -438,111 +543,130 @@ operator << (std::ostream& os, const SpectrumValue& pvf)
 
 
 SpectrumValue
-operator+ (const SpectrumValue& lhs, const SpectrumValue& rhs)
+operator+ (SpectrumValue lhs, const SpectrumValue& rhs)
 {
-  SpectrumValue res = lhs;
-  res.Add (rhs);
-  return res;
+  lhs.Add (rhs);
+  return lhs;
 }
 
 
 SpectrumValue
-operator+ (const SpectrumValue& lhs, double rhs)
+operator+ (const SpectrumValue& lhs, SpectrumValue&& rhs)
 {
-  SpectrumValue res = lhs;
-  res.Add (rhs);
-  return res;
+  rhs.Add (lhs);
+  return std::move (rhs);
 }
 
 
 SpectrumValue
-operator+ (double lhs, const SpectrumValue& rhs)
+operator+ (SpectrumValue lhs, double rhs)
 {
-  SpectrumValue res = rhs;
-  res.Add (lhs);
-  return res;
+  lhs.Add (rhs);
+  return lhs;
 }
 
 
 SpectrumValue
-operator- (const SpectrumValue& lhs, const SpectrumValue& rhs)
+operator+ (double lhs, SpectrumValue rhs)
 {
-  SpectrumValue res = rhs;
-  res.ChangeSign ();
-  res.Add (lhs);
-  return res;
+  rhs.Add (lhs);
+  return rhs;
 }
 
 
+SpectrumValue
+operator- (SpectrumValue lhs, const SpectrumValue& rhs)
+{
+  lhs.Subtract (rhs);
+  return lhs;
+}
+
 
 SpectrumValue
-operator- (const SpectrumValue& lhs, double rhs)
+operator- (const SpectrumValue& lhs, SpectrumValue&& rhs)
 {
-  SpectrumValue res = lhs;
-  res.Subtract (rhs);
-  return res;
+  rhs.ReverseSubtract (lhs);
+  return std::move (rhs);
 }
 
 
+
 SpectrumValue
-operator- (double lhs, const SpectrumValue& rhs)
+operator- (SpectrumValue lhs, double rhs)
 {
-  SpectrumValue res = rhs;
-  res.Subtract (lhs);
-  return res;
+  lhs.Subtract (rhs);
+  return lhs;
 }
 
+
 SpectrumValue
-operator* (const SpectrumValue& lhs, const SpectrumValue& rhs)
+operator- (double lhs, SpectrumValue rhs)
 {
-  SpectrumValue res = lhs;
-  res.Multiply (rhs);
-  return res;
+  rhs.Subtract (lhs);
+  return rhs;
+}
+
+SpectrumValue
+operator* (SpectrumValue lhs, const SpectrumValue& rhs)
+{
+  lhs.Multiply (rhs);
+  return lhs;
 }
 
 
 SpectrumValue
-operator* (const SpectrumValue& lhs, double rhs)
+operator* (const SpectrumValue& lhs, SpectrumValue&& rhs)
 {
-  SpectrumValue res = lhs;
-  res.Multiply (rhs);
-  return res;
+  rhs.Multiply (lhs);
+  return std::move (rhs);
 }
 
 
 SpectrumValue
-operator* (double lhs, const SpectrumValue& rhs)
+operator* (SpectrumValue lhs, double rhs)
 {
-  SpectrumValue res = rhs;
-  res.Multiply (lhs);
-  return res;
+  lhs.Multiply (rhs);
+  return lhs;
 }
 
 
 SpectrumValue
-operator/ (const SpectrumValue& lhs, const SpectrumValue& rhs)
+operator* (double lhs, SpectrumValue rhs)
 {
-  SpectrumValue res = lhs;
-  res.Divide (rhs);
-  return res;
+  rhs.Multiply (lhs);
+  return rhs;
 }
 
 
 SpectrumValue
-operator/ (const SpectrumValue& lhs, double rhs)
+operator/ (SpectrumValue lhs, const SpectrumValue& rhs)
 {
-  SpectrumValue res = lhs;
-  res.Divide (rhs);
-  return res;
+  lhs.Divide (rhs);
+  return lhs;
 }
 
 
 SpectrumValue
-operator/ (double lhs, const SpectrumValue& rhs)
+operator/ (const SpectrumValue& lhs, SpectrumValue&& rhs)
 {
-  SpectrumValue res = rhs;
-  res.Divide (lhs);
-  return res;
+  rhs.ReverseDivide (lhs);
+  return std::move (rhs);
+}
+
+
+SpectrumValue
+operator/ (SpectrumValue lhs, double rhs)
+{
+  lhs.Divide (rhs);
+  return lhs;
+}
+
+
+SpectrumValue
+operator/ (double lhs, SpectrumValue rhs)
+{
+  rhs.Divide (lhs);
+  return rhs;
 }
 
 
@@ -553,54 +677,48 @@ operator+ (const SpectrumValue& rhs)
 }
 
 SpectrumValue
-operator- (const SpectrumValue& rhs)
+operator- (SpectrumValue rhs)
 {
-  SpectrumValue res = rhs;
-  res.ChangeSign ();
-  return res;
+  rhs.ChangeSign ();
+  return rhs;
 }
 
 
 SpectrumValue
-Pow (double lhs, const SpectrumValue& rhs)
+Pow (double lhs, SpectrumValue rhs)
 {
-  SpectrumValue res = rhs;
-  res.Exp (lhs);
-  return res;
+  rhs.Exp (lhs);
+  return rhs;
 }
 
 
 SpectrumValue
-Pow (const SpectrumValue& lhs, double rhs)
+Pow (SpectrumValue lhs, double rhs)
 {
-  SpectrumValue res = lhs;
-  res.Pow (rhs);
-  return res;
+  lhs.Pow (rhs);
+  return lhs;
 }
 
 
 SpectrumValue
-Log10 (const SpectrumValue& arg)
+Log10 (SpectrumValue arg)
 {
-  SpectrumValue res = arg;
-  res.Log10 ();
-  return res;
+  arg.Log10 ();
+  return arg;
 }
 
 SpectrumValue
-Log2 (const SpectrumValue& arg)
+Log2 (SpectrumValue arg)
 {
-  SpectrumValue res = arg;
-  res.Log2 ();
-  return res;
+  arg.Log2 ();
+  return arg;
 }
 
 SpectrumValue
-Log (const SpectrumValue& arg)
+Log (SpectrumValue arg)
 {
-  SpectrumValue res = arg;
-  res.Log ();
-  return res;
+  arg.Log ();
+  return arg;
 }
 
 SpectrumValue&
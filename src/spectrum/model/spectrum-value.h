@@ -80,6 +80,42 @@ public:
 
   SpectrumValue ();
 
+  /**
+   * @brief copy constructor
+   *
+   * @param other the SpectrumValue to copy
+   */
+  SpectrumValue (const SpectrumValue& other);
+
+  /**
+   * @brief move constructor
+   *
+   * @param other the SpectrumValue whose values are taken over
+   */
+  SpectrumValue (SpectrumValue&& other);
+
+  /**
+   * The buffer of the values is recycled by the SpectrumModel, for
+   * the next SpectrumValue of the same model.
+   */
+  ~SpectrumValue ();
+
+  /**
+   * @brief copy assignment operator
+   *
+   * @param other the SpectrumValue to copy
+   * @return a reference to *this
+   */
+  SpectrumValue& operator= (const SpectrumValue& other);
+
+  /**
+   * @brief move assignment operator
+   *
+   * @param other the SpectrumValue whose values are taken over
+   * @return a reference to *this
+   */
+  SpectrumValue& operator= (SpectrumValue&& other);
+
 
   /**
    * Access value at given frequency index
@@ -178,7 +214,16 @@ public:
    *
    * @return the value of lhs + rhs
    */
-  friend SpectrumValue operator+ (const SpectrumValue& lhs, const SpectrumValue& rhs);
+  friend SpectrumValue operator+ (SpectrumValue lhs, const SpectrumValue& rhs);
+  /**
+   * Same as above, computed in the values of rhs, which is a temporary
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the value of lhs + rhs
+   */
+  friend SpectrumValue operator+ (const SpectrumValue& lhs, SpectrumValue&& rhs);
 
 
   /**
@@ -189,7 +234,7 @@ public:
    *
    * @return the value of lhs + rhs
    */
-  friend SpectrumValue operator+ (const SpectrumValue& lhs, double rhs);
+  friend SpectrumValue operator+ (SpectrumValue lhs, double rhs);
 
   /**
    *  addition operator
@@ -199,7 +244,7 @@ public:
    *
    * @return the value of lhs + rhs
    */
-  friend SpectrumValue operator+ (double lhs, const SpectrumValue& rhs);
+  friend SpectrumValue operator+ (double lhs, SpectrumValue rhs);
 
 
   /**
@@ -210,7 +255,16 @@ public:
    *
    * @return the value of lhs - rhs
    */
-  friend SpectrumValue operator- (const SpectrumValue& lhs, const SpectrumValue& rhs);
+  friend SpectrumValue operator- (SpectrumValue lhs, const SpectrumValue& rhs);
+  /**
+   * Same as above, computed in the values of rhs, which is a temporary
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the value of lhs - rhs
+   */
+  friend SpectrumValue operator- (const SpectrumValue& lhs, SpectrumValue&& rhs);
 
   /**
    *  subtraction operator
@@ -220,7 +274,7 @@ public:
    *
    * @return the value of lhs - rhs
    */
-  friend SpectrumValue operator- (const SpectrumValue& lhs, double rhs);
+  friend SpectrumValue operator- (SpectrumValue lhs, double rhs);
 
   /**
    *  subtraction operator
@@ -230,7 +284,7 @@ public:
    *
    * @return the value of lhs - rhs
    */
-  friend SpectrumValue operator- (double lhs, const SpectrumValue& rhs);
+  friend SpectrumValue operator- (double lhs, SpectrumValue rhs);
 
   /**
    *  multiplication component-by-component (Schur product)
@@ -240,7 +294,16 @@ public:
    *
    * @return the value of lhs * rhs
    */
-  friend SpectrumValue operator* (const SpectrumValue& lhs, const SpectrumValue& rhs);
+  friend SpectrumValue operator* (SpectrumValue lhs, const SpectrumValue& rhs);
+  /**
+   * Same as above, computed in the values of rhs, which is a temporary
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the value of lhs * rhs
+   */
+  friend SpectrumValue operator* (const SpectrumValue& lhs, SpectrumValue&& rhs);
 
   /**
    *  multiplication by a scalar
@@ -250,7 +313,7 @@ public:
    *
    * @return the value of lhs * rhs
    */
-  friend SpectrumValue operator* (const SpectrumValue& lhs, double rhs);
+  friend SpectrumValue operator* (SpectrumValue lhs, double rhs);
 
   /**
    *  multiplication of a scalar
@@ -260,7 +323,7 @@ public:
    *
    * @return the value of lhs * rhs
    */
-  friend SpectrumValue operator* (double lhs, const SpectrumValue& rhs);
+  friend SpectrumValue operator* (double lhs, SpectrumValue rhs);
 
   /**
    *  division component-by-component
@@ -270,7 +333,16 @@ public:
    *
    * @return the value of lhs / rhs
    */
-  friend SpectrumValue operator/ (const SpectrumValue& lhs, const SpectrumValue& rhs);
+  friend SpectrumValue operator/ (SpectrumValue lhs, const SpectrumValue& rhs);
+  /**
+   * Same as above, computed in the values of rhs, which is a temporary
+   *
+   * @param lhs Left Hand Side of the operator
+   * @param rhs Right Hand Side of the operator
+   *
+   * @return the value of lhs / rhs
+   */
+  friend SpectrumValue operator/ (const SpectrumValue& lhs, SpectrumValue&& rhs);
 
   /**
    * division by a scalar
@@ -280,7 +352,7 @@ public:
    *
    * @return the value of *this / rhs
    */
-  friend SpectrumValue operator/ (const SpectrumValue& lhs, double rhs);
+  friend SpectrumValue operator/ (SpectrumValue lhs, double rhs);
 
   /**
    * division of a scalar
@@ -290,7 +362,7 @@ public:
    *
    * @return the value of *this / rhs
    */
-  friend SpectrumValue operator/ (double lhs, const SpectrumValue& rhs);
+  friend SpectrumValue operator/ (double lhs, SpectrumValue rhs);
 
   /**
    * unary plus operator
@@ -306,7 +378,7 @@ public:
    * @param rhs Right Hand Side of the operator
    * @return the value of - *this
    */
-  friend SpectrumValue operator- (const SpectrumValue& rhs);
+  friend SpectrumValue operator- (SpectrumValue rhs);
 
 
   /**
@@ -420,6 +492,24 @@ public:
    */
   SpectrumValue& operator= (double rhs);
 
+  /**
+   * Add the Right Hand Side multiplied by a scalar to *this, component
+   * by component, without temporary SpectrumValue
+   *
+   * @param x the Right Hand Side
+   * @param s the scalar
+   */
+  void AddScaled (const SpectrumValue& x, double s);
+
+  /**
+   * Add the product of two SpectrumValues to *this, component by
+   * component, without temporary SpectrumValue
+   *
+   * @param x the first factor
+   * @param y the second factor
+   */
+  void AddProduct (const SpectrumValue& x, const SpectrumValue& y);
+
 
 
   /**
@@ -459,7 +549,7 @@ public:
    *
    * @return each value in base raised to the exponent
    */
-  friend SpectrumValue Pow (const SpectrumValue& lhs, double rhs);
+  friend SpectrumValue Pow (SpectrumValue lhs, double rhs);
 
 
   /**
@@ -469,7 +559,7 @@ public:
    *
    * @return the value in base raised to each value in the exponent
    */
-  friend SpectrumValue Pow (double lhs, const SpectrumValue& rhs);
+  friend SpectrumValue Pow (double lhs, SpectrumValue rhs);
 
   /**
    *
@@ -478,7 +568,7 @@ public:
    *
    * @return the logarithm in base 10 of all values in the argument
    */
-  friend SpectrumValue Log10 (const SpectrumValue&  arg);
+  friend SpectrumValue Log10 (SpectrumValue arg);
 
 
   /**
@@ -488,7 +578,7 @@ public:
    *
    * @return the logarithm in base 2 of all values in the argument
    */
-  friend SpectrumValue Log2 (const SpectrumValue&  arg);
+  friend SpectrumValue Log2 (SpectrumValue arg);
 
   /**
    *
@@ -497,7 +587,7 @@ public:
    *
    * @return the logarithm in base e of all values in the argument
    */
-  friend SpectrumValue Log (const SpectrumValue&  arg);
+  friend SpectrumValue Log (SpectrumValue arg);
 
   /**
    *
@@ -566,6 +656,16 @@ private:
    * \param s flat value
    */
   void Divide (double s);
+  /**
+   * Subtracts the current elements from a SpectrumValue (element by element subtraction)
+   * \param x SpectrumValue
+   */
+  void ReverseSubtract (const SpectrumValue& x);
+  /**
+   * Divides a SpectrumValue by the current elements (element by element division)
+   * \param x SpectrumValue
+   */
+  void ReverseDivide (const SpectrumValue& x);
   /**
    * Change the values sign
    */
@@ -624,11 +724,11 @@ std::ostream& operator << (std::ostream& os, const SpectrumValue& pvf);
 double Norm (const SpectrumValue& x);
 double Sum (const SpectrumValue& x);
 double Prod (const SpectrumValue& x);
-SpectrumValue Pow (const SpectrumValue& lhs, double rhs);
-SpectrumValue Pow (double lhs, const SpectrumValue& rhs);
-SpectrumValue Log10 (const SpectrumValue& arg);
-SpectrumValue Log2 (const SpectrumValue& arg);
-SpectrumValue Log (const SpectrumValue& arg);
+SpectrumValue Pow (SpectrumValue lhs, double rhs);
+SpectrumValue Pow (double lhs, SpectrumValue rhs);
+SpectrumValue Log10 (SpectrumValue arg);
+SpectrumValue Log2 (SpectrumValue arg);
+SpectrumValue Log (SpectrumValue arg);
 double Integral (const SpectrumValue& arg);
 
 
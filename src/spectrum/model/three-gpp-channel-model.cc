@@ -33,11 +33,19 @@
 #include <ns3/simulator.h>
 #include "ns3/mobility-model.h"
 #include "ns3/pointer.h"
+#include "ns3/uinteger.h"
+#include "ns3/core-config.h"
+#ifdef HAVE_PTHREAD_H
+#include <thread>
+#endif
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("ThreeGppChannelModel");
 
+/// The minimum number of ray coefficients computed by each thread
+static const uint64_t MIN_RAYS_PER_THREAD = 65536;
+
 NS_OBJECT_ENSURE_REGISTERED (ThreeGppChannelModel);
 
 //Table 7.5-3: Ray offset angles within a cluster, given for rms angle spread normalized to 1.
@@ -240,6 +248,12 @@ ThreeGppChannelModel::GetTypeId (void)
                    DoubleValue (1),
                    MakeDoubleAccessor (&ThreeGppChannelModel::m_blockerSpeed),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("NumThreads",
+                   "The number of threads computing the coefficients of a "
+                   "channel matrix. The realizations do not depend on it.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&ThreeGppChannelModel::m_numThreads),
+                   MakeUintegerChecker<uint32_t> (1))
   ;
   return tid;
 }
@@ -1502,7 +1516,7 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, Ptr<const ChannelCondition> c
   //Step 11: Generate channel coefficients for each cluster n and each receiver
   // and transmitter element pair u,s.
 
-  Complex3DVector H_NLOS; // channel coefficients H_NLOS [u][s][n],
+  // channel coefficients H_NLOS [u][s][n],
   // where u and s are receive and transmit antenna element, n is cluster index.
   uint64_t uSize = uAntenna->GetNumberOfElements ();
   uint64_t sSize = sAntenna->GetNumberOfElements ();
@@ -1529,6 +1543,97 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, Ptr<const ChannelCondition> c
 
   NS_LOG_INFO ("1st strongest cluster:" << (int)cluster1st << ", 2nd strongest cluster:" << (int)cluster2nd);
 
+  // The field patterns and the polarization of a ray only depend on the
+  // ray, and the phase of a ray at an antenna element only depends on the
+  // ray and on the element: they are computed once per ray and once per
+  // ray and element, and the coefficient of a ray for a pair of elements
+  // is the product of the three terms. The terms are stored contiguously,
+  // indexed by nIndex * raysPerCluster + mIndex.
+  uint32_t numRays = numReducedCluster * raysPerCluster;
+  PhasedArrayModel::ComplexVector rayPolarization (numRays);
+  for (uint8_t nIndex = 0; nIndex < numReducedCluster; nIndex++)
+    {
+      for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
+        {
+          const DoubleVector &initialPhase = clusterPhase[nIndex][mIndex];
+          double k = crossPolarizationPowerRatios[nIndex][mIndex];
+          double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
+          std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern (Angles (rayAoa_radian[nIndex][mIndex], rayZoa_radian[nIndex][mIndex]));
+          std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern (Angles (rayAod_radian[nIndex][mIndex], rayZod_radian[nIndex][mIndex]));
+          rayPolarization[nIndex * raysPerCluster + mIndex] =
+            exp (std::complex<double> (0, initialPhase[0])) * rxFieldPatternTheta * txFieldPatternTheta +
+            +exp (std::complex<double> (0, initialPhase[1])) * std::sqrt (1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
+            +exp (std::complex<double> (0, initialPhase[2])) * std::sqrt (1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
+            +exp (std::complex<double> (0, initialPhase[3])) * rxFieldPatternPhi * txFieldPatternPhi;
+        }
+    }
+
+  Complex2DVector uRayPhases (uSize, PhasedArrayModel::ComplexVector (numRays)); // uRayPhases[u][ray]
+  for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
+    {
+      //lambda_0 is accounted in the antenna spacing uLoc and sLoc.
+      Vector uLoc = uAntenna->GetElementLocation (uIndex);
+      for (uint8_t nIndex = 0; nIndex < numReducedCluster; nIndex++)
+        {
+          for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
+            {
+              double rxPhaseDiff = 2 * M_PI * (sin (rayZoa_radian[nIndex][mIndex]) * cos (rayAoa_radian[nIndex][mIndex]) * uLoc.x
+                                               + sin (rayZoa_radian[nIndex][mIndex]) * sin (rayAoa_radian[nIndex][mIndex]) * uLoc.y
+                                               + cos (rayZoa_radian[nIndex][mIndex]) * uLoc.z);
+              uRayPhases[uIndex][nIndex * raysPerCluster + mIndex] = exp (std::complex<double> (0, rxPhaseDiff));
+            }
+        }
+    }
+  Complex2DVector sRayPhases (sSize, PhasedArrayModel::ComplexVector (numRays)); // sRayPhases[s][ray]
+  for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
+    {
+      Vector sLoc = sAntenna->GetElementLocation (sIndex);
+      for (uint8_t nIndex = 0; nIndex < numReducedCluster; nIndex++)
+        {
+          for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
+            {
+              double txPhaseDiff = 2 * M_PI * (sin (rayZod_radian[nIndex][mIndex]) * cos (rayAod_radian[nIndex][mIndex]) * sLoc.x
+                                               + sin (rayZod_radian[nIndex][mIndex]) * sin (rayAod_radian[nIndex][mIndex]) * sLoc.y
+                                               + cos (rayZod_radian[nIndex][mIndex]) * sLoc.z);
+              sRayPhases[sIndex][nIndex * raysPerCluster + mIndex] = exp (std::complex<double> (0, txPhaseDiff));
+            }
+        }
+    }
+  // NOTE Doppler is computed in the CalcBeamformingGain function and is simplified to only account for the center anngle of each cluster.
+
+  // the same terms for the LOS path (7.5-29)
+  std::complex<double> losRay (0, 0);
+  PhasedArrayModel::ComplexVector uLosPhases;
+  PhasedArrayModel::ComplexVector sLosPhases;
+  double K_linear = pow (10,K_factor / 10);
+  if (los)
+    {
+      double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
+      std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern (Angles (uAngle.GetAzimuth (), uAngle.GetInclination ()));
+      std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern (Angles (sAngle.GetAzimuth (), sAngle.GetInclination ()));
+
+      double lambda = 3e8 / m_frequency; // the wavelength of the carrier frequency
+
+      losRay = (rxFieldPatternTheta * txFieldPatternTheta - rxFieldPatternPhi * txFieldPatternPhi)
+        * exp (std::complex<double> (0, -2 * M_PI * dis3D / lambda));
+      for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
+        {
+          Vector uLoc = uAntenna->GetElementLocation (uIndex);
+          double rxPhaseDiff = 2 * M_PI * (sin (uAngle.GetInclination ()) * cos (uAngle.GetAzimuth ()) * uLoc.x
+                                           + sin (uAngle.GetInclination ()) * sin (uAngle.GetAzimuth ()) * uLoc.y
+                                           + cos (uAngle.GetInclination ()) * uLoc.z);
+          uLosPhases.push_back (exp (std::complex<double> (0, rxPhaseDiff)));
+        }
+      for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
+        {
+          Vector sLoc = sAntenna->GetElementLocation (sIndex);
+          double txPhaseDiff = 2 * M_PI * (sin (sAngle.GetInclination ()) * cos (sAngle.GetAzimuth ()) * sLoc.x
+                                           + sin (sAngle.GetInclination ()) * sin (sAngle.GetAzimuth ()) * sLoc.y
+                                           + cos (sAngle.GetInclination ()) * sLoc.z);
+          sLosPhases.push_back (exp (std::complex<double> (0, txPhaseDiff)));
+        }
+    }
+
   Complex3DVector H_usn;  //channel coffecient H_usn[u][s][n];
   // NOTE Since each of the strongest 2 clusters are divided into 3 sub-clusters,
   // the total cluster will be numReducedCLuster + 4.
@@ -1543,152 +1648,108 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, Ptr<const ChannelCondition> c
         }
     }
 
-  // The following for loops computes the channel coefficients
-  for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
+  // computes the channel coefficients of the receive elements in [uFirst, uLast)
+  auto computeCoefficients = [&] (uint64_t uFirst, uint64_t uLast)
     {
-      Vector uLoc = uAntenna->GetElementLocation (uIndex);
-
-      for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
+      for (uint64_t uIndex = uFirst; uIndex < uLast; uIndex++)
         {
-
-          Vector sLoc = sAntenna->GetElementLocation (sIndex);
-
-          for (uint8_t nIndex = 0; nIndex < numReducedCluster; nIndex++)
+          const std::complex<double> *uPhases = uRayPhases[uIndex].data ();
+          for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
             {
-              //Compute the N-2 weakest cluster, assuming 0 slant angle and a
-              //polarization slant angle configured in the array (7.5-22)
-              if (nIndex != cluster1st && nIndex != cluster2nd)
+              const std::complex<double> *sPhases = sRayPhases[sIndex].data ();
+              for (uint8_t nIndex = 0; nIndex < numReducedCluster; nIndex++)
                 {
-                  std::complex<double> rays (0,0);
-                  for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
+                  uint32_t first = nIndex * raysPerCluster;
+                  //Compute the N-2 weakest cluster, assuming 0 slant angle and a
+                  //polarization slant angle configured in the array (7.5-22)
+                  if (nIndex != cluster1st && nIndex != cluster2nd)
                     {
-                      DoubleVector initialPhase = clusterPhase[nIndex][mIndex];
-                      double k = crossPolarizationPowerRatios[nIndex][mIndex];
-                      //lambda_0 is accounted in the antenna spacing uLoc and sLoc.
-                      double rxPhaseDiff = 2 * M_PI * (sin (rayZoa_radian[nIndex][mIndex]) * cos (rayAoa_radian[nIndex][mIndex]) * uLoc.x
-                                                       + sin (rayZoa_radian[nIndex][mIndex]) * sin (rayAoa_radian[nIndex][mIndex]) * uLoc.y
-                                                       + cos (rayZoa_radian[nIndex][mIndex]) * uLoc.z);
-
-                      double txPhaseDiff = 2 * M_PI * (sin (rayZod_radian[nIndex][mIndex]) * cos (rayAod_radian[nIndex][mIndex]) * sLoc.x
-                                                       + sin (rayZod_radian[nIndex][mIndex]) * sin (rayAod_radian[nIndex][mIndex]) * sLoc.y
-                                                       + cos (rayZod_radian[nIndex][mIndex]) * sLoc.z);
-                      // NOTE Doppler is computed in the CalcBeamformingGain function and is simplified to only account for the center anngle of each cluster.
-
-                      double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
-                      std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern (Angles (rayAoa_radian[nIndex][mIndex], rayZoa_radian[nIndex][mIndex]));
-                      std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern (Angles (rayAod_radian[nIndex][mIndex], rayZod_radian[nIndex][mIndex]));
-
-                      rays += (exp (std::complex<double> (0, initialPhase[0])) * rxFieldPatternTheta * txFieldPatternTheta +
-                               +exp (std::complex<double> (0, initialPhase[1])) * std::sqrt (1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
-                               +exp (std::complex<double> (0, initialPhase[2])) * std::sqrt (1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
-                               +exp (std::complex<double> (0, initialPhase[3])) * rxFieldPatternPhi * txFieldPatternPhi)
-                        * exp (std::complex<double> (0, rxPhaseDiff))
-                        * exp (std::complex<double> (0, txPhaseDiff));
+                      std::complex<double> rays (0,0);
+                      for (uint32_t r = first; r < first + raysPerCluster; r++)
+                        {
+                          rays += rayPolarization[r] * uPhases[r] * sPhases[r];
+                        }
+                      rays *= sqrt (clusterPower[nIndex] / raysPerCluster);
+                      H_usn[uIndex][sIndex][nIndex] = rays;
                     }
-                  rays *= sqrt (clusterPower[nIndex] / raysPerCluster);
-                  H_usn[uIndex][sIndex][nIndex] = rays;
-                }
-              else  //(7.5-28)
-                {
-                  std::complex<double> raysSub1 (0,0);
-                  std::complex<double> raysSub2 (0,0);
-                  std::complex<double> raysSub3 (0,0);
-
-                  for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
+                  else  //(7.5-28)
                     {
-                      double k = crossPolarizationPowerRatios[nIndex][mIndex];
+                      std::complex<double> raysSub1 (0,0);
+                      std::complex<double> raysSub2 (0,0);
+                      std::complex<double> raysSub3 (0,0);
 
                       //ZML:Just remind me that the angle offsets for the 3 subclusters were not generated correctly.
-
-                      DoubleVector initialPhase = clusterPhase[nIndex][mIndex];
-                      double rxPhaseDiff = 2 * M_PI * (sin (rayZoa_radian[nIndex][mIndex]) * cos (rayAoa_radian[nIndex][mIndex]) * uLoc.x
-                                                       + sin (rayZoa_radian[nIndex][mIndex]) * sin (rayAoa_radian[nIndex][mIndex]) * uLoc.y
-                                                       + cos (rayZoa_radian[nIndex][mIndex]) * uLoc.z);
-                      double txPhaseDiff = 2 * M_PI * (sin (rayZod_radian[nIndex][mIndex]) * cos (rayAod_radian[nIndex][mIndex]) * sLoc.x
-                                                       + sin (rayZod_radian[nIndex][mIndex]) * sin (rayAod_radian[nIndex][mIndex]) * sLoc.y
-                                                       + cos (rayZod_radian[nIndex][mIndex]) * sLoc.z);
-
-                      double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
-                      std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern (Angles (rayAoa_radian[nIndex][mIndex], rayZoa_radian[nIndex][mIndex]));
-                      std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern (Angles (rayAod_radian[nIndex][mIndex], rayZod_radian[nIndex][mIndex]));
-
-                      switch (mIndex)
+                      for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
                         {
-                          case 9:
-                          case 10:
-                          case 11:
-                          case 12:
-                          case 17:
-                          case 18:
-                            raysSub2 += (exp (std::complex<double> (0, initialPhase[0])) * rxFieldPatternTheta * txFieldPatternTheta +
-                                         +exp (std::complex<double> (0, initialPhase[1])) * std::sqrt (1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
-                                         +exp (std::complex<double> (0, initialPhase[2])) * std::sqrt (1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
-                                         +exp (std::complex<double> (0, initialPhase[3])) * rxFieldPatternPhi * txFieldPatternPhi)
-                              * exp (std::complex<double> (0, rxPhaseDiff))
-                              * exp (std::complex<double> (0, txPhaseDiff));
-                            break;
-                          case 13:
-                          case 14:
-                          case 15:
-                          case 16:
-                            raysSub3 += (exp (std::complex<double> (0, initialPhase[0])) * rxFieldPatternTheta * txFieldPatternTheta +
-                                         +exp (std::complex<double> (0, initialPhase[1])) * std::sqrt (1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
-                                         +exp (std::complex<double> (0, initialPhase[2])) * std::sqrt (1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
-                                         +exp (std::complex<double> (0, initialPhase[3])) * rxFieldPatternPhi * txFieldPatternPhi)
-                              * exp (std::complex<double> (0, rxPhaseDiff))
-                              * exp (std::complex<double> (0, txPhaseDiff));
-                            break;
-                          default:                      //case 1,2,3,4,5,6,7,8,19,20
-                            raysSub1 += (exp (std::complex<double> (0, initialPhase[0])) * rxFieldPatternTheta * txFieldPatternTheta +
-                                         +exp (std::complex<double> (0, initialPhase[1])) * std::sqrt (1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
-                                         +exp (std::complex<double> (0, initialPhase[2])) * std::sqrt (1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
-                                         +exp (std::complex<double> (0, initialPhase[3])) * rxFieldPatternPhi * txFieldPatternPhi)
-                              * exp (std::complex<double> (0, rxPhaseDiff))
-                              * exp (std::complex<double> (0, txPhaseDiff));
-                            break;
+                          uint32_t r = first + mIndex;
+                          switch (mIndex)
+                            {
+                              case 9:
+                              case 10:
+                              case 11:
+                              case 12:
+                              case 17:
+                              case 18:
+                                raysSub2 += rayPolarization[r] * uPhases[r] * sPhases[r];
+                                break;
+                              case 13:
+                              case 14:
+                              case 15:
+                              case 16:
+                                raysSub3 += rayPolarization[r] * uPhases[r] * sPhases[r];
+                                break;
+                              default:                      //case 1,2,3,4,5,6,7,8,19,20
+                                raysSub1 += rayPolarization[r] * uPhases[r] * sPhases[r];
+                                break;
+                            }
                         }
+                      raysSub1 *= sqrt (clusterPower[nIndex] / raysPerCluster);
+                      raysSub2 *= sqrt (clusterPower[nIndex] / raysPerCluster);
+                      raysSub3 *= sqrt (clusterPower[nIndex] / raysPerCluster);
+                      H_usn[uIndex][sIndex][nIndex] = raysSub1;
+                      H_usn[uIndex][sIndex].push_back (raysSub2);
+                      H_usn[uIndex][sIndex].push_back (raysSub3);
                     }
-                  raysSub1 *= sqrt (clusterPower[nIndex] / raysPerCluster);
-                  raysSub2 *= sqrt (clusterPower[nIndex] / raysPerCluster);
-                  raysSub3 *= sqrt (clusterPower[nIndex] / raysPerCluster);
-                  H_usn[uIndex][sIndex][nIndex] = raysSub1;
-                  H_usn[uIndex][sIndex].push_back (raysSub2);
-                  H_usn[uIndex][sIndex].push_back (raysSub3);
-
                 }
-            }
-          if (los) //(7.5-29) && (7.5-30)
-            {
-              std::complex<double> ray (0,0);
-              double rxPhaseDiff = 2 * M_PI * (sin (uAngle.GetInclination ()) * cos (uAngle.GetAzimuth ()) * uLoc.x
-                                               + sin (uAngle.GetInclination ()) * sin (uAngle.GetAzimuth ()) * uLoc.y
-                                               + cos (uAngle.GetInclination ()) * uLoc.z);
-              double txPhaseDiff = 2 * M_PI * (sin (sAngle.GetInclination ()) * cos (sAngle.GetAzimuth ()) * sLoc.x
-                                               + sin (sAngle.GetInclination ()) * sin (sAngle.GetAzimuth ()) * sLoc.y
-                                               + cos (sAngle.GetInclination ()) * sLoc.z);
-
-              double rxFieldPatternPhi, rxFieldPatternTheta, txFieldPatternPhi, txFieldPatternTheta;
-              std::tie (rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern (Angles (uAngle.GetAzimuth (), uAngle.GetInclination ()));
-              std::tie (txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern (Angles (sAngle.GetAzimuth (), sAngle.GetInclination ()));
-
-              double lambda = 3e8 / m_frequency; // the wavelength of the carrier frequency
-
-              ray = (rxFieldPatternTheta * txFieldPatternTheta - rxFieldPatternPhi * txFieldPatternPhi)
-                * exp (std::complex<double> (0, -2 * M_PI * dis3D / lambda))
-                * exp (std::complex<double> (0, rxPhaseDiff))
-                * exp (std::complex<double> (0, txPhaseDiff));
-
-              double K_linear = pow (10,K_factor / 10);
-              // the LOS path should be attenuated if blockage is enabled.
-              H_usn[uIndex][sIndex][0] = sqrt (1 / (K_linear + 1)) * H_usn[uIndex][sIndex][0] + sqrt (K_linear / (1 + K_linear)) * ray / pow (10,attenuation_dB[0] / 10);           //(7.5-30) for tau = tau1
-              double tempSize = H_usn[uIndex][sIndex].size ();
-              for (uint8_t nIndex = 1; nIndex < tempSize; nIndex++)
+              if (los) //(7.5-29) && (7.5-30)
                 {
-                  H_usn[uIndex][sIndex][nIndex] *= sqrt (1 / (K_linear + 1)); //(7.5-30) for tau = tau2...taunN
-                }
+                  std::complex<double> ray = losRay * uLosPhases[uIndex] * sLosPhases[sIndex];
 
+                  // the LOS path should be attenuated if blockage is enabled.
+                  H_usn[uIndex][sIndex][0] = sqrt (1 / (K_linear + 1)) * H_usn[uIndex][sIndex][0] + sqrt (K_linear / (1 + K_linear)) * ray / pow (10,attenuation_dB[0] / 10);           //(7.5-30) for tau = tau1
+                  double tempSize = H_usn[uIndex][sIndex].size ();
+                  for (uint8_t nIndex = 1; nIndex < tempSize; nIndex++)
+                    {
+                      H_usn[uIndex][sIndex][nIndex] *= sqrt (1 / (K_linear + 1)); //(7.5-30) for tau = tau2...taunN
+                    }
+                }
             }
         }
+    };
+
+  // the receive elements are split among the threads; all the random
+  // values have been drawn, so that the realization does not depend on
+  // the number of threads
+  uint64_t numThreads = std::min<uint64_t> (m_numThreads, uSize);
+#ifdef HAVE_PTHREAD_H
+  if (numThreads > 1 && uSize * sSize * numRays >= MIN_RAYS_PER_THREAD * numThreads)
+    {
+      NS_LOG_DEBUG ("Computing the coefficients with " << numThreads << " threads");
+      std::vector<std::thread> threads;
+      for (uint64_t t = 1; t < numThreads; t++)
+        {
+          threads.emplace_back (computeCoefficients, uSize * t / numThreads, uSize * (t + 1) / numThreads);
+        }
+      computeCoefficients (0, uSize / numThreads);
+      for (auto &thread : threads)
+        {
+          thread.join ();
+        }
+    }
+  else
+#endif /* HAVE_PTHREAD_H */
+    {
+      computeCoefficients (0, uSize);
     }
 
   // store the delays and the angles for the subclusters
@@ -270,6 +270,8 @@ private:
   bool m_portraitMode; //!< true if potrait mode, false if landscape
   double m_blockerSpeed; //!< the blocker speed
 
+  uint32_t m_numThreads; //!< the number of threads computing the channel coefficients
+
   static const uint8_t PHI_INDEX = 0; //!< index of the PHI value in the m_nonSelfBlocking array
   static const uint8_t X_INDEX = 1; //!< index of the X value in the m_nonSelfBlocking array
   static const uint8_t THETA_INDEX = 2; //!< index of the THETA value in the m_nonSelfBlocking array
@@ -30,6 +30,8 @@
 #include "ns3/string.h"
 #include "ns3/simulator.h"
 #include "ns3/pointer.h"
+#include "ns3/uinteger.h"
+#include <algorithm>
 #include <map>
 
 namespace ns3 {
@@ -54,6 +56,7 @@ ThreeGppSpectrumPropagationLossModel::DoDispose ()
 {
   m_deviceAntennaMap.clear ();
   m_longTermMap.clear ();
+  m_delayPhasesMap.clear ();
   m_channelModel->Dispose ();
   m_channelModel = nullptr;
 }
@@ -78,6 +81,12 @@ ThreeGppSpectrumPropagationLossModel::GetTypeId (void)
                    DoubleValue (0.0),
                    MakeDoubleAccessor (&ThreeGppSpectrumPropagationLossModel::m_vScatt),
                    MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("LongTermCacheSize",
+                   "The maximum number of long term components cached for each "
+                   "link, one for each pair of beamforming vectors",
+                   UintegerValue (4),
+                   MakeUintegerAccessor (&ThreeGppSpectrumPropagationLossModel::m_longTermCacheSize),
+                   MakeUintegerChecker<uint32_t> (1))
     ;
   return tid;
 }
@@ -134,29 +143,35 @@ ThreeGppSpectrumPropagationLossModel::CalcLongTerm (Ptr<const MatrixBasedChannel
   NS_LOG_DEBUG ("CalcLongTerm with sAntenna " << sAntenna << " uAntenna " << uAntenna);
   //store the long term part to reduce computation load
   //only the small scale fading needs to be updated if the large scale parameters and antenna weights remain unchanged.
-  PhasedArrayModel::ComplexVector longTerm;
+  // the clusters are the innermost dimension of the channel matrix: the
+  // sums over the antenna elements are computed for all the clusters at once
   uint8_t numCluster = static_cast<uint8_t> (params->m_channel[0][0].size ());
+  PhasedArrayModel::ComplexVector longTerm (numCluster, std::complex<double> (0, 0));
+  PhasedArrayModel::ComplexVector rxSum (numCluster);
 
-  for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
+  for (uint16_t sIndex = 0; sIndex < sAntenna; sIndex++)
     {
-      std::complex<double> txSum (0,0);
-      for (uint16_t sIndex = 0; sIndex < sAntenna; sIndex++)
+      std::fill (rxSum.begin (), rxSum.end (), std::complex<double> (0, 0));
+      for (uint16_t uIndex = 0; uIndex < uAntenna; uIndex++)
         {
-          std::complex<double> rxSum (0,0);
-          for (uint16_t uIndex = 0; uIndex < uAntenna; uIndex++)
+          const std::complex<double> *h = params->m_channel[uIndex][sIndex].data ();
+          for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
             {
-              rxSum = rxSum + uW[uIndex] * params->m_channel[uIndex][sIndex][cIndex];
+              rxSum[cIndex] = rxSum[cIndex] + uW[uIndex] * h[cIndex];
             }
-          txSum = txSum + sW[sIndex] * rxSum;
         }
-      longTerm.push_back (txSum);
+      for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
+        {
+          longTerm[cIndex] = longTerm[cIndex] + sW[sIndex] * rxSum[cIndex];
+        }
     }
   return longTerm;
 }
 
 Ptr<SpectrumValue>
-ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain (Ptr<SpectrumValue> txPsd,
-                                                           PhasedArrayModel::ComplexVector longTerm,
+ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain (Ptr<const SpectrumValue> txPsd,
+                                                           const PhasedArrayModel::ComplexVector &longTerm,
+                                                           const PhasedArrayModel::ComplexVector &delayPhases,
                                                            Ptr<const MatrixBasedChannelModel::ChannelMatrix> params,
                                                            const ns3::Vector &sSpeed, const ns3::Vector &uSpeed) const
 {
@@ -171,6 +186,7 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain (Ptr<SpectrumValue> tx
   // NOTE the update of Doppler is simplified by only taking the center angle of
   // each cluster in to consideration.
   double slotTime = Simulator::Now ().GetSeconds ();
+  double frequency = GetFrequency ();
   PhasedArrayModel::ComplexVector doppler;
   for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
     {
@@ -199,100 +215,119 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain (Ptr<SpectrumValue> tx
                                          + (sin (params->m_angle[MatrixBasedChannelModel::ZOD_INDEX][cIndex] * M_PI / 180) * cos (params->m_angle[MatrixBasedChannelModel::AOD_INDEX][cIndex] * M_PI / 180) * sSpeed.x
                                          + sin (params->m_angle[MatrixBasedChannelModel::ZOD_INDEX][cIndex] * M_PI / 180) * sin (params->m_angle[MatrixBasedChannelModel::AOD_INDEX][cIndex] * M_PI / 180) * sSpeed.y
                                          + cos (params->m_angle[MatrixBasedChannelModel::ZOD_INDEX][cIndex] * M_PI / 180) * sSpeed.z) + 2 * alpha * D)
-                           * slotTime * GetFrequency () / 3e8;
+                           * slotTime * frequency / 3e8;
       doppler.push_back (exp (std::complex<double> (0, temp_doppler)));
     }
 
   // apply the doppler term and the propagation delay to the long term component
   // to obtain the beamforming gain
-  auto vit = tempPsd->ValuesBegin (); // psd iterator
-  auto sbit = tempPsd->ConstBandsBegin(); // band iterator
-  while (vit != tempPsd->ValuesEnd ())
+  PhasedArrayModel::ComplexVector clusterGain (numCluster);
+  for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
+    {
+      clusterGain[cIndex] = longTerm[cIndex] * doppler[cIndex];
+    }
+  const std::complex<double> *phases = delayPhases.data (); // phase shifts of the sub-band
+  for (auto vit = tempPsd->ValuesBegin (); vit != tempPsd->ValuesEnd (); ++vit, phases += numCluster)
     {
-      std::complex<double> subsbandGain (0.0,0.0);
       if ((*vit) != 0.00)
         {
-          double fsb = (*sbit).fc; // center frequency of the sub-band
+          std::complex<double> subsbandGain (0.0,0.0);
           for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
             {
-              double delay = -2 * M_PI * fsb * (params->m_delay[cIndex]);
-              subsbandGain = subsbandGain + longTerm[cIndex] * doppler[cIndex] * exp (std::complex<double> (0, delay));
+              subsbandGain = subsbandGain + clusterGain[cIndex] * phases[cIndex];
             }
           *vit = (*vit) * (norm (subsbandGain));
         }
-      vit++;
-      sbit++;
     }
   return tempPsd;
 }
 
-PhasedArrayModel::ComplexVector
+Ptr<const ThreeGppSpectrumPropagationLossModel::LongTerm>
 ThreeGppSpectrumPropagationLossModel::GetLongTerm (uint32_t aId, uint32_t bId,
                                                    Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
                                                    const PhasedArrayModel::ComplexVector &aW,
                                                    const PhasedArrayModel::ComplexVector &bW) const
 {
-  PhasedArrayModel::ComplexVector longTerm; // vector containing the long term component for each cluster
-
   // check if the channel matrix was generated considering a as the s-node and
   // b as the u-node or viceversa
-  PhasedArrayModel::ComplexVector sW, uW;
-  if (!channelMatrix->IsReverse (aId, bId))
-  {
-    sW = aW;
-    uW = bW;
-  }
-  else
-  {
-    sW = bW;
-    uW = aW;
-  }
+  bool reverse = channelMatrix->IsReverse (aId, bId);
+  const PhasedArrayModel::ComplexVector &sW = reverse ? bW : aW;
+  const PhasedArrayModel::ComplexVector &uW = reverse ? aW : bW;
 
   // compute the long term key, the key is unique for each tx-rx pair
   uint32_t x1 = std::min (aId, bId);
   uint32_t x2 = std::max (aId, bId);
   uint32_t longTermId = MatrixBasedChannelModel::GetKey (x1, x2);
 
-  bool update = false; // indicates whether the long term has to be updated
-  bool notFound = false; // indicates if the long term has not been computed yet
-
-  // look for the long term in the map and check if it is valid
-  if (m_longTermMap.find (longTermId) != m_longTermMap.end ())
-  {
-    NS_LOG_DEBUG ("found the long term component in the map");
-    longTerm = m_longTermMap[longTermId]->m_longTerm;
-
-    // check if the channel matrix has been updated
-    // or the s beam has been changed
-    // or the u beam has been changed
-    update = (m_longTermMap[longTermId]->m_channel->m_generatedTime != channelMatrix->m_generatedTime
-              || m_longTermMap[longTermId]->m_sW != sW
-              || m_longTermMap[longTermId]->m_uW != uW);
-
-  }
-  else
-  {
-    NS_LOG_DEBUG ("long term component NOT found");
-    notFound = true;
-  }
-
-  if (update || notFound)
+  // look for the long term of these beams in the map; the long terms of
+  // a previous channel realization are not valid anymore
+  std::vector<Ptr<const LongTerm> > &longTerms = m_longTermMap[longTermId];
+  for (auto it = longTerms.begin (); it != longTerms.end (); ++it)
     {
-      NS_LOG_DEBUG ("compute the long term");
-      // compute the long term component
-      longTerm = CalcLongTerm (channelMatrix, sW, uW);
-
-      // store the long term
-      Ptr<LongTerm> longTermItem = Create<LongTerm> ();
-      longTermItem->m_longTerm = longTerm;
-      longTermItem->m_channel = channelMatrix;
-      longTermItem->m_sW = sW;
-      longTermItem->m_uW = uW;
-
-      m_longTermMap[longTermId] = longTermItem;
+      if ((*it)->m_channel->m_generatedTime != channelMatrix->m_generatedTime)
+        {
+          NS_LOG_DEBUG ("the channel matrix has been updated");
+          longTerms.erase (it, longTerms.end ());
+          break;
+        }
+      if ((*it)->m_sW == sW && (*it)->m_uW == uW)
+        {
+          NS_LOG_DEBUG ("found the long term component in the map");
+          // move it to the front, the least recently used is dropped first
+          std::rotate (longTerms.begin (), it, it + 1);
+          return longTerms.front ();
+        }
     }
 
-  return longTerm;
+  NS_LOG_DEBUG ("compute the long term");
+  Ptr<LongTerm> longTermItem = Create<LongTerm> ();
+  longTermItem->m_longTerm = CalcLongTerm (channelMatrix, sW, uW);
+  longTermItem->m_channel = channelMatrix;
+  longTermItem->m_sW = sW;
+  longTermItem->m_uW = uW;
+
+  if (longTerms.size () >= m_longTermCacheSize)
+    {
+      longTerms.resize (m_longTermCacheSize - 1);
+    }
+  longTerms.insert (longTerms.begin (), longTermItem);
+  return longTermItem;
+}
+
+Ptr<const ThreeGppSpectrumPropagationLossModel::DelayPhases>
+ThreeGppSpectrumPropagationLossModel::GetDelayPhases (uint32_t aId, uint32_t bId,
+                                                      Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
+                                                      Ptr<const SpectrumModel> spectrumModel) const
+{
+  uint32_t x1 = std::min (aId, bId);
+  uint32_t x2 = std::max (aId, bId);
+  uint32_t linkId = MatrixBasedChannelModel::GetKey (x1, x2);
+
+  Ptr<const DelayPhases> &delayPhases = m_delayPhasesMap[linkId];
+  if (delayPhases
+      && delayPhases->m_channel->m_generatedTime == channelMatrix->m_generatedTime
+      && delayPhases->m_spectrumModelUid == spectrumModel->GetUid ())
+    {
+      return delayPhases;
+    }
+
+  NS_LOG_DEBUG ("compute the delay phase shifts");
+  uint8_t numCluster = static_cast<uint8_t> (channelMatrix->m_channel[0][0].size ());
+  Ptr<DelayPhases> item = Create<DelayPhases> ();
+  item->m_channel = channelMatrix;
+  item->m_spectrumModelUid = spectrumModel->GetUid ();
+  item->m_phases.reserve (spectrumModel->GetNumBands () * numCluster);
+  for (auto sbit = spectrumModel->Begin (); sbit != spectrumModel->End (); ++sbit)
+    {
+      double fsb = (*sbit).fc; // center frequency of the sub-band
+      for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
+        {
+          double delay = -2 * M_PI * fsb * (channelMatrix->m_delay[cIndex]);
+          item->m_phases.push_back (exp (std::complex<double> (0, delay)));
+        }
+    }
+  delayPhases = item;
+  return item;
 }
 
 Ptr<SpectrumValue>
@@ -307,8 +342,6 @@ ThreeGppSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity (Ptr<const Sp
   NS_ASSERT (aId != bId);
   NS_ASSERT_MSG (a->GetDistanceFrom (b) > 0.0, "The position of a and b devices cannot be the same");
 
-  Ptr<SpectrumValue> rxPsd = Copy<SpectrumValue> (txPsd);
-
   // retrieve the antenna of device a
   NS_ASSERT_MSG (m_deviceAntennaMap.find (aId) != m_deviceAntennaMap.end (), "Antenna not found for node " << aId);
   Ptr<const PhasedArrayModel> aAntenna = m_deviceAntennaMap.at (aId);
@@ -326,10 +359,14 @@ ThreeGppSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity (Ptr<const Sp
   PhasedArrayModel::ComplexVector bW = bAntenna->GetBeamformingVector ();
 
   // retrieve the long term component
-  PhasedArrayModel::ComplexVector longTerm = GetLongTerm (aId, bId, channelMatrix, aW, bW);
+  Ptr<const LongTerm> longTerm = GetLongTerm (aId, bId, channelMatrix, aW, bW);
+
+  // retrieve the phase shifts due to the cluster delays
+  Ptr<const DelayPhases> delayPhases = GetDelayPhases (aId, bId, channelMatrix, txPsd->GetSpectrumModel ());
 
   // apply the beamforming gain
-  rxPsd = CalcBeamformingGain (rxPsd, longTerm, channelMatrix, a->GetVelocity (), b->GetVelocity ());
+  Ptr<SpectrumValue> rxPsd = CalcBeamformingGain (txPsd, longTerm->m_longTerm, delayPhases->m_phases,
+                                                  channelMatrix, a->GetVelocity (), b->GetVelocity ());
 
   return rxPsd;
 }
@@ -118,7 +118,11 @@ public:
    * the propagation delay.
    * To reduce the computational load, the long term component associated with
    * a certain channel is cached and recomputed only when the channel realization
-   * is updated, or when the beamforming vectors change.
+   * is updated, or when the beamforming vectors change. Several long term
+   * components can be cached for each channel, one for each pair of beamforming
+   * vectors (see the attribute LongTermCacheSize), so that switching between a
+   * few beams does not compute them again. The phase shifts due to the delays
+   * of the clusters in each sub-band are also cached for each channel.
    *
    * \param txPsd tx PSD
    * \param a first node mobility model
@@ -142,6 +146,17 @@ private:
     PhasedArrayModel::ComplexVector m_uW; //!< the beamforming vector for the node u used to compute the long term
   };
 
+  /**
+   * Data structure that stores the phase shifts due to the cluster delays
+   * in each sub-band of a spectrum model, for a tx-rx pair
+   */
+  struct DelayPhases : public SimpleRefCount<DelayPhases>
+  {
+    Ptr<const MatrixBasedChannelModel::ChannelMatrix> m_channel; //!< pointer to the channel matrix used to compute the phases
+    SpectrumModelUid_t m_spectrumModelUid; //!< the uid of the spectrum model of the sub-bands
+    PhasedArrayModel::ComplexVector m_phases; //!< the phase shifts, indexed by subBand * numCluster + cluster
+  };
+
   /**
    * Get the operating frequency
    * \return the operating frequency in Hz
@@ -157,12 +172,25 @@ private:
    * \param channelMatrix the channel matrix
    * \param aW the beamforming vector of the first device
    * \param bW the beamforming vector of the second device
-   * \return vector containing the long term compoenent for each cluster
+   * \return the long term component for each cluster
+   */
+  Ptr<const LongTerm> GetLongTerm (uint32_t aId, uint32_t bId,
+                                   Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
+                                   const PhasedArrayModel::ComplexVector &aW,
+                                   const PhasedArrayModel::ComplexVector &bW) const;
+
+  /**
+   * Looks for the delay phase shifts in m_delayPhasesMap, and computes them
+   * if they are not found or if the channel or the spectrum model changed.
+   * \param aId id of the first node
+   * \param bId id of the second node
+   * \param channelMatrix the channel matrix
+   * \param spectrumModel the spectrum model of the PSD
+   * \return the phase shifts of each cluster in each sub-band
    */
-  PhasedArrayModel::ComplexVector GetLongTerm (uint32_t aId, uint32_t bId,
-                                                        Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
-                                                        const PhasedArrayModel::ComplexVector &aW,
-                                                        const PhasedArrayModel::ComplexVector &bW) const;
+  Ptr<const DelayPhases> GetDelayPhases (uint32_t aId, uint32_t bId,
+                                         Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
+                                         Ptr<const SpectrumModel> spectrumModel) const;
   /**
    * Computes the long term component
    * \param channelMatrix the channel matrix H
@@ -178,18 +206,22 @@ private:
    * Computes the beamforming gain and applies it to the tx PSD
    * \param txPsd the tx PSD
    * \param longTerm the long term component
+   * \param delayPhases the phase shifts of each cluster in each sub-band
    * \param params The channel matrix
    * \param sSpeed speed of the first node
    * \param uSpeed speed of the second node
    * \return the rx PSD
    */
-  Ptr<SpectrumValue> CalcBeamformingGain (Ptr<SpectrumValue> txPsd,
-                                          PhasedArrayModel::ComplexVector longTerm,
+  Ptr<SpectrumValue> CalcBeamformingGain (Ptr<const SpectrumValue> txPsd,
+                                          const PhasedArrayModel::ComplexVector &longTerm,
+                                          const PhasedArrayModel::ComplexVector &delayPhases,
                                           Ptr<const MatrixBasedChannelModel::ChannelMatrix> params,
                                           const Vector &sSpeed, const Vector &uSpeed) const;
 
   std::unordered_map <uint32_t, Ptr<const PhasedArrayModel> > m_deviceAntennaMap; //!< map containig the <node, antenna> associations
-  mutable std::unordered_map < uint32_t, Ptr<const LongTerm> > m_longTermMap; //!< map containing the long term components
+  mutable std::unordered_map < uint32_t, std::vector<Ptr<const LongTerm> > > m_longTermMap; //!< map containing the long term components of each link, most recently used first
+  mutable std::unordered_map < uint32_t, Ptr<const DelayPhases> > m_delayPhasesMap; //!< map containing the delay phase shifts of each link
+  uint32_t m_longTermCacheSize; //!< the maximum number of long term components cached for each link
   Ptr<MatrixBasedChannelModel> m_channelModel; //!< the model to generate the channel matrix
   
   // Variable used to compute the additional Doppler contribution for the delayed 
@@ -27,15 +27,218 @@
 #include <ns3/string.h>
 #include <ns3/double.h>
 #include "ns3/uinteger.h"
+#include <ns3/abort.h>
+#include <ns3/core-config.h>
 #include <fstream>
+#include <sstream>
+#include <cstring>
+#include <cmath>
 #include <ns3/simulator.h>
 
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("TraceFadingLossModel");
 
 NS_OBJECT_ENSURE_REGISTERED (TraceFadingLossModel);
-  
+
+
+/// Header of the binary fading traces
+struct FadingTraceHeader
+{
+  char     magic[8];     //!< FADING_TRACE_MAGIC
+  uint32_t version;      //!< FADING_TRACE_VERSION
+  uint32_t rbNum;        //!< number of RBs
+  uint32_t samplesNum;   //!< number of samples
+  uint32_t reserved[3];  //!< zero
+};
+
+/// Magic string starting the binary fading traces
+static const char FADING_TRACE_MAGIC[8] = { 'n', 's', '3', 'f', 'a', 'd', 'e', '\0' };
+/// Version of the binary fading traces
+static const uint32_t FADING_TRACE_VERSION = 1;
+
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief The samples of a fading trace, shared by the
+ * TraceFadingLossModel instances loading the same file.
+ *
+ * The samples are linear power gains, stored by sample then by RB, so
+ * the gains applied to a PSD are contiguous.
+ */
+class SharedFadingTrace : public SimpleRefCount<SharedFadingTrace>
+{
+public:
+  SharedFadingTrace ();
+  ~SharedFadingTrace ();
+
+  /**
+   * Map a binary trace in memory
+   * \param fileName the trace file
+   * \return false if the file is not a binary trace
+   */
+  bool LoadBinary (std::string fileName);
+  /**
+   * Read a text trace
+   * \param fileName the trace file
+   * \param rbNum the number of RBs of the trace
+   * \param samplesNum the number of samples of the trace
+   */
+  void LoadText (std::string fileName, uint32_t rbNum, uint32_t samplesNum);
+  /**
+   * Write the trace in the binary format
+   * \param fileName the trace file
+   */
+  void WriteBinary (std::string fileName) const;
+
+  /// \return the number of RBs
+  uint32_t GetRbNum (void) const
+  {
+    return m_rbNum;
+  }
+  /// \return the number of samples
+  uint32_t GetSamplesNum (void) const
+  {
+    return m_samplesNum;
+  }
+  /**
+   * \param sample the index of a sample
+   * \return the gains of the RBs of the sample
+   */
+  const float * GetGains (uint32_t sample) const
+  {
+    NS_ASSERT (sample < m_samplesNum);
+    return m_gains + static_cast<size_t> (sample) * m_rbNum;
+  }
+
+private:
+  uint32_t m_rbNum;            //!< number of RBs
+  uint32_t m_samplesNum;       //!< number of samples
+  const float *m_gains;        //!< the gains, in m_buffer or in the mapped file
+  std::vector<float> m_buffer; //!< the gains, if the file is not mapped
+  void *m_map;                 //!< the mapped file
+  size_t m_mapSize;            //!< the size of the mapped file
+};
+
+SharedFadingTrace::SharedFadingTrace ()
+  : m_rbNum (0),
+    m_samplesNum (0),
+    m_gains (0),
+    m_map (0),
+    m_mapSize (0)
+{
+}
+
+SharedFadingTrace::~SharedFadingTrace ()
+{
+#ifdef HAVE_SYS_MMAN_H
+  if (m_map != 0)
+    {
+      munmap (m_map, m_mapSize);
+    }
+#endif
+}
+
+bool
+SharedFadingTrace::LoadBinary (std::string fileName)
+{
+  std::ifstream file (fileName.c_str (), std::ifstream::in | std::ifstream::binary);
+  NS_ABORT_MSG_UNLESS (file.good (), "Fading trace file " << fileName << " not found");
+  FadingTraceHeader header;
+  if (!file.read (reinterpret_cast<char *> (&header), sizeof (header))
+      || std::memcmp (header.magic, FADING_TRACE_MAGIC, sizeof (header.magic)) != 0)
+    {
+      return false;
+    }
+  NS_ABORT_MSG_UNLESS (header.version == FADING_TRACE_VERSION,
+                       "Unsupported version " << header.version << " of fading trace " << fileName);
+  m_rbNum = header.rbNum;
+  m_samplesNum = header.samplesNum;
+  size_t dataSize = static_cast<size_t> (m_rbNum) * m_samplesNum * sizeof (float);
+  file.seekg (0, std::ifstream::end);
+  NS_ABORT_MSG_UNLESS (static_cast<size_t> (file.tellg ()) == sizeof (header) + dataSize,
+                       "Wrong size of fading trace " << fileName);
+
+#ifdef HAVE_SYS_MMAN_H
+  int fd = open (fileName.c_str (), O_RDONLY);
+  if (fd >= 0)
+    {
+      m_mapSize = sizeof (header) + dataSize;
+      void *map = mmap (0, m_mapSize, PROT_READ, MAP_SHARED, fd, 0);
+      close (fd);
+      if (map != MAP_FAILED)
+        {
+          m_map = map;
+          m_gains = reinterpret_cast<const float *> (static_cast<const char *> (map) + sizeof (header));
+          return true;
+        }
+    }
+  NS_LOG_WARN ("Cannot map fading trace " << fileName << ", reading it");
+#endif
+
+  m_buffer.resize (static_cast<size_t> (m_rbNum) * m_samplesNum);
+  file.seekg (sizeof (header));
+  file.read (reinterpret_cast<char *> (m_buffer.data ()), dataSize);
+  NS_ABORT_MSG_UNLESS (file.good (), "Cannot read fading trace " << fileName);
+  m_gains = m_buffer.data ();
+  return true;
+}
+
+void
+SharedFadingTrace::LoadText (std::string fileName, uint32_t rbNum, uint32_t samplesNum)
+{
+  std::ifstream file (fileName.c_str (), std::ifstream::in);
+  NS_ABORT_MSG_UNLESS (file.good (), "Fading trace file " << fileName << " not found");
+  m_rbNum = rbNum;
+  m_samplesNum = samplesNum;
+  m_buffer.resize (static_cast<size_t> (rbNum) * samplesNum);
+  // the text traces are stored by RB then by sample
+  for (uint32_t i = 0; i < rbNum; i++)
+    {
+      for (uint32_t j = 0; j < samplesNum; j++)
+        {
+          double sample;
+          file >> sample;
+          m_buffer[static_cast<size_t> (j) * rbNum + i] = std::pow (10., sample / 10);
+        }
+    }
+  m_gains = m_buffer.data ();
+}
+
+void
+SharedFadingTrace::WriteBinary (std::string fileName) const
+{
+  FadingTraceHeader header;
+  std::memset (&header, 0, sizeof (header));
+  std::memcpy (header.magic, FADING_TRACE_MAGIC, sizeof (header.magic));
+  header.version = FADING_TRACE_VERSION;
+  header.rbNum = m_rbNum;
+  header.samplesNum = m_samplesNum;
+  std::ofstream file (fileName.c_str (), std::ofstream::out | std::ofstream::binary);
+  file.write (reinterpret_cast<const char *> (&header), sizeof (header));
+  file.write (reinterpret_cast<const char *> (m_gains),
+              static_cast<size_t> (m_rbNum) * m_samplesNum * sizeof (float));
+  NS_ABORT_MSG_UNLESS (file.good (), "Cannot write fading trace " << fileName);
+}
+
+/**
+ * \return the traces loaded by the TraceFadingLossModel instances, by
+ * file name, number of RBs and number of samples
+ */
+static std::map<std::string, Ptr<SharedFadingTrace> > &
+GetSharedFadingTraces (void)
+{
+  static std::map<std::string, Ptr<SharedFadingTrace> > traces;
+  return traces;
+}
+
 
 
 TraceFadingLossModel::TraceFadingLossModel ()
@@ -48,9 +251,22 @@ TraceFadingLossModel::TraceFadingLossModel ()
 
 TraceFadingLossModel::~TraceFadingLossModel ()
 {
-  m_fadingTrace.clear ();
+  m_trace = 0;
   m_windowOffsetsMap.clear ();
   m_startVariableMap.clear ();
+  // release the traces which are not used by any model anymore
+  std::map<std::string, Ptr<SharedFadingTrace> > &traces = GetSharedFadingTraces ();
+  for (std::map<std::string, Ptr<SharedFadingTrace> >::iterator it = traces.begin (); it != traces.end (); )
+    {
+      if (it->second->GetReferenceCount () == 1)
+        {
+          traces.erase (it++);
+        }
+      else
+        {
+          ++it;
+        }
+    }
 }
 
 
@@ -120,28 +336,27 @@ void
 TraceFadingLossModel::LoadTrace ()
 {
   NS_LOG_FUNCTION (this << "Loading Fading Trace " << m_traceFile);
-  std::ifstream ifTraceFile;
-  ifTraceFile.open (m_traceFile.c_str (), std::ifstream::in);
-  m_fadingTrace.clear ();
-  if (!ifTraceFile.good ())
+  std::ostringstream key;
+  key << m_traceFile << " " << (uint32_t) m_rbNum << " " << m_samplesNum;
+  std::map<std::string, Ptr<SharedFadingTrace> > &traces = GetSharedFadingTraces ();
+  std::map<std::string, Ptr<SharedFadingTrace> >::iterator it = traces.find (key.str ());
+  if (it != traces.end ())
     {
-      NS_LOG_INFO (this << " File: " << m_traceFile);
-      NS_ASSERT_MSG(ifTraceFile.good (), " Fading trace file not found");
+      NS_LOG_INFO (this << " File: " << m_traceFile << " already loaded");
+      m_trace = it->second;
     }
-
-//   NS_LOG_INFO (this << " length " << m_traceLength.GetSeconds ());
-//   NS_LOG_INFO (this << " RB " << (uint32_t)m_rbNum << " samples " << m_samplesNum);
-  for (uint32_t i = 0; i < m_rbNum; i++)
+  else
     {
-      FadingTraceSample rbTimeFadingTrace;
-      for (uint32_t j = 0; j < m_samplesNum; j++)
+      NS_LOG_INFO (this << " File: " << m_traceFile);
+      m_trace = Create<SharedFadingTrace> ();
+      if (!m_trace->LoadBinary (m_traceFile))
         {
-          double sample;
-          ifTraceFile >> sample;
-          rbTimeFadingTrace.push_back (sample);
+          m_trace->LoadText (m_traceFile, m_rbNum, m_samplesNum);
         }
-      m_fadingTrace.push_back (rbTimeFadingTrace);
+      traces[key.str ()] = m_trace;
     }
+  // the binary traces give their own number of samples
+  m_samplesNum = m_trace->GetSamplesNum ();
   m_timeGranularity = m_traceLength.GetMilliSeconds () / m_samplesNum;
   m_lastWindowUpdate = Simulator::Now ();
 }
@@ -201,38 +416,35 @@ TraceFadingLossModel::DoCalcRxPowerSpectralDensity (
   //double speed = std::sqrt (std::pow (aSpeedVector.x-bSpeedVector.x,2) + std::pow (aSpeedVector.y-bSpeedVector.y,2));
 
   NS_LOG_LOGIC (this << *rxPsd);
-  NS_ASSERT (!m_fadingTrace.empty ());
+  NS_ASSERT (m_trace);
   int now_ms = static_cast<int> (Simulator::Now ().GetMilliSeconds () * m_timeGranularity);
   int lastUpdate_ms = static_cast<int> (m_lastWindowUpdate.GetMilliSeconds () * m_timeGranularity);
   int index = ((*itOff).second + now_ms - lastUpdate_ms) % m_samplesNum;
-  int subChannel = 0;
-  while (vit != rxPsd->ValuesEnd ())
-    {
-      NS_ASSERT (subChannel < 100);
-      if (*vit != 0.)
-        {
-          double fading = m_fadingTrace.at (subChannel).at (index);
-          NS_LOG_INFO (this << " FADING now " << now_ms << " offset " << (*itOff).second << " id " << index << " fading " << fading);
-          double power = *vit; // in Watt/Hz
-          power = 10 * std::log10 (180000 * power); // in dB
-
-          NS_LOG_LOGIC (this << subChannel << *vit  << power << fading);
-
-          *vit = std::pow (10., ((power + fading) / 10)) / 180000; // in Watt
-
-          NS_LOG_LOGIC (this << subChannel << *vit);
-
-        }
-
-      ++vit;
-      ++subChannel;
+  NS_LOG_INFO (this << " FADING now " << now_ms << " offset " << (*itOff).second << " id " << index);
+  NS_ASSERT_MSG (rxPsd->GetValuesN () <= m_trace->GetRbNum (), "The fading trace has less RBs than the PSD");
 
+  // adding the fading in dB to the power in dB is multiplying the power
+  // by the linear gain, which is a loop the compiler can vectorize
+  const float *gains = m_trace->GetGains (index);
+  for (uint32_t subChannel = 0; vit != rxPsd->ValuesEnd (); ++vit, ++subChannel)
+    {
+      *vit *= gains[subChannel];
     }
 
   NS_LOG_LOGIC (this << *rxPsd);
   return rxPsd;
 }
 
+void
+TraceFadingLossModel::ConvertTrace (std::string textFile, std::string binaryFile,
+                                    uint32_t rbNum, uint32_t samplesNum)
+{
+  NS_LOG_FUNCTION (textFile << binaryFile << rbNum << samplesNum);
+  SharedFadingTrace trace;
+  trace.LoadText (textFile, rbNum, samplesNum);
+  trace.WriteBinary (binaryFile);
+}
+
 int64_t
 TraceFadingLossModel::AssignStreams (int64_t stream)
 {
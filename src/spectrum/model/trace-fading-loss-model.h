@@ -34,12 +34,20 @@ namespace ns3 {
 
 
 class MobilityModel;
+class SharedFadingTrace;
 
 
 /**
  * \ingroup spectrum
  *
  * \brief fading loss model based on precalculated fading traces
+ *
+ * The trace file is either a text file, with the SamplesNum fading
+ * values in dB of each of the RbNum RBs, or a binary file written by
+ * ConvertTrace.  A binary trace is mapped in memory, so its pages are
+ * read on demand and shared by all the processes using it.  In both
+ * cases, the models of a process loading the same file share one copy
+ * of the trace.
  */
 class TraceFadingLossModel : public SpectrumPropagationLossModel
 {
@@ -70,6 +78,22 @@ public:
   */
   int64_t AssignStreams (int64_t stream);
 
+  /**
+   * \brief Convert a text fading trace to the binary format.
+   *
+   * The binary file has a header with the number of RBs and of samples,
+   * followed by the linear power gains of the samples in float, the
+   * gains of all the RBs of a sample being contiguous.  It is written in
+   * the byte order of the machine.
+   *
+   * \param textFile the text trace, as read by the TraceFilename attribute
+   * \param binaryFile the binary trace to write
+   * \param rbNum the number of RBs of the trace
+   * \param samplesNum the number of samples of the trace
+   */
+  static void ConvertTrace (std::string textFile, std::string binaryFile,
+                            uint32_t rbNum, uint32_t samplesNum);
+
   
 private:
   /**
@@ -103,7 +127,7 @@ private:
   */
   void SetTraceLength (Time t);
   
-  /// Load trace function
+  /// Load trace function, or get the trace already loaded by another model
   void LoadTrace ();
 
 
@@ -112,20 +136,9 @@ private:
   
   mutable std::map <ChannelRealizationId_t, Ptr<UniformRandomVariable> > m_startVariableMap; ///< start variable map
   
-  /**
-   * Vector with fading samples in time domain (for a fixed RB)
-   */
-  typedef std::vector<double> FadingTraceSample;
-  /**
-   * Vector collecting the time fading traces in the frequency domain (per RB)
-   */
-  typedef std::vector<FadingTraceSample> FadingTrace;
-
-
-  
   std::string m_traceFile; ///< the trace file name
   
-  FadingTrace m_fadingTrace; ///< fading trace
+  Ptr<SharedFadingTrace> m_trace; ///< fading trace
 
   
   Time m_traceLength; ///< the trace time
@@ -0,0 +1,269 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/simulator.h>
+#include <ns3/double.h>
+#include <ns3/boolean.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/constant-velocity-mobility-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/antenna-model.h>
+#include <ns3/net-device.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/multi-model-spectrum-channel.h>
+
+using namespace ns3;
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief A SpectrumPhy recording the power it receives.
+ */
+class LinkCacheTestPhy : public SpectrumPhy
+{
+public:
+  /**
+   * Constructor.
+   * \param model the spectrum model of the receiver
+   */
+  LinkCacheTestPhy (Ptr<const SpectrumModel> model);
+
+  virtual void SetDevice (Ptr<NetDevice> d);
+  virtual Ptr<NetDevice> GetDevice () const;
+  virtual void SetMobility (Ptr<MobilityModel> m);
+  virtual Ptr<MobilityModel> GetMobility () const;
+  virtual void SetChannel (Ptr<SpectrumChannel> c);
+  virtual Ptr<const SpectrumModel> GetRxSpectrumModel () const;
+  virtual Ptr<AntennaModel> GetRxAntenna () const;
+  virtual void StartRx (Ptr<SpectrumSignalParameters> params);
+
+  uint32_t m_rxCount;   //!< number of received signals
+  double m_rxPower;     //!< power of the last received signal
+  Time m_rxTime;        //!< reception time of the last received signal
+
+private:
+  Ptr<const SpectrumModel> m_model;  //!< spectrum model
+  Ptr<MobilityModel> m_mobility;     //!< mobility model
+};
+
+LinkCacheTestPhy::LinkCacheTestPhy (Ptr<const SpectrumModel> model)
+  : m_rxCount (0),
+    m_rxPower (0),
+    m_model (model)
+{
+}
+
+void
+LinkCacheTestPhy::SetDevice (Ptr<NetDevice> d)
+{
+}
+
+Ptr<NetDevice>
+LinkCacheTestPhy::GetDevice () const
+{
+  return 0;
+}
+
+void
+LinkCacheTestPhy::SetMobility (Ptr<MobilityModel> m)
+{
+  m_mobility = m;
+}
+
+Ptr<MobilityModel>
+LinkCacheTestPhy::GetMobility () const
+{
+  return m_mobility;
+}
+
+void
+LinkCacheTestPhy::SetChannel (Ptr<SpectrumChannel> c)
+{
+}
+
+Ptr<const SpectrumModel>
+LinkCacheTestPhy::GetRxSpectrumModel () const
+{
+  return m_model;
+}
+
+Ptr<AntennaModel>
+LinkCacheTestPhy::GetRxAntenna () const
+{
+  return 0;
+}
+
+void
+LinkCacheTestPhy::StartRx (Ptr<SpectrumSignalParameters> params)
+{
+  m_rxCount++;
+  m_rxPower = Integral (*params->psd);
+  m_rxTime = Simulator::Now ();
+}
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief A propagation loss of 1 dB every 10 m, counting its evaluations.
+ */
+class LinkCacheTestPropagationLossModel : public PropagationLossModel
+{
+public:
+  LinkCacheTestPropagationLossModel ();
+
+  uint32_t m_count;  //!< number of evaluations
+
+private:
+  virtual double DoCalcRxPower (double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+  virtual int64_t DoAssignStreams (int64_t stream);
+};
+
+LinkCacheTestPropagationLossModel::LinkCacheTestPropagationLossModel ()
+  : m_count (0)
+{
+}
+
+double
+LinkCacheTestPropagationLossModel::DoCalcRxPower (double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+{
+  const_cast<LinkCacheTestPropagationLossModel *> (this)->m_count++;
+  return txPowerDbm - a->GetDistanceFrom (b) / 10;
+}
+
+int64_t
+LinkCacheTestPropagationLossModel::DoAssignStreams (int64_t stream)
+{
+  return 0;
+}
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief Check that the link cache of the MultiModelSpectrumChannel gives
+ * the same received signals, and is invalidated when a node moves.
+ */
+class MultiModelSpectrumChannelLinkCacheTestCase : public TestCase
+{
+public:
+  MultiModelSpectrumChannelLinkCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Transmit a signal of 1 W from the transmitter.
+   */
+  void Transmit (void);
+
+  Ptr<MultiModelSpectrumChannel> m_channel;  //!< the channel
+  Ptr<LinkCacheTestPhy> m_tx;                //!< the transmitter
+  Ptr<const SpectrumModel> m_model;          //!< the spectrum model
+};
+
+MultiModelSpectrumChannelLinkCacheTestCase::MultiModelSpectrumChannelLinkCacheTestCase ()
+  : TestCase ("Check the link cache of the MultiModelSpectrumChannel")
+{
+}
+
+void
+MultiModelSpectrumChannelLinkCacheTestCase::Transmit (void)
+{
+  Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters> ();
+  params->txPhy = m_tx;
+  params->duration = MilliSeconds (1);
+  params->psd = Create<SpectrumValue> (m_model);
+  (*params->psd) = 0.5e-6;
+  m_channel->StartTx (params);
+}
+
+void
+MultiModelSpectrumChannelLinkCacheTestCase::DoRun (void)
+{
+  m_model = Create<SpectrumModel> (std::vector<double> {2.4e9, 2.401e9});
+  Ptr<LinkCacheTestPropagationLossModel> loss = CreateObject<LinkCacheTestPropagationLossModel> ();
+  m_channel = CreateObject<MultiModelSpectrumChannel> ();
+  m_channel->SetAttribute ("LinkCache", BooleanValue (true));
+  m_channel->SetAttribute ("MaxLossDb", DoubleValue (50));
+  m_channel->AddPropagationLossModel (loss);
+  m_channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+
+  m_tx = Create<LinkCacheTestPhy> (m_model);
+  Ptr<ConstantPositionMobilityModel> txMobility = CreateObject<ConstantPositionMobilityModel> ();
+  m_tx->SetMobility (txMobility);
+  Ptr<LinkCacheTestPhy> near = Create<LinkCacheTestPhy> (m_model);
+  Ptr<ConstantVelocityMobilityModel> nearMobility = CreateObject<ConstantVelocityMobilityModel> ();
+  nearMobility->SetPosition (Vector (300, 0, 0));
+  near->SetMobility (nearMobility);
+  Ptr<LinkCacheTestPhy> far = Create<LinkCacheTestPhy> (m_model);
+  Ptr<ConstantPositionMobilityModel> farMobility = CreateObject<ConstantPositionMobilityModel> ();
+  farMobility->SetPosition (Vector (1000, 0, 0));
+  far->SetMobility (farMobility);
+  m_channel->AddRx (m_tx);
+  m_channel->AddRx (near);
+  m_channel->AddRx (far);
+
+  Simulator::Schedule (Seconds (1), &MultiModelSpectrumChannelLinkCacheTestCase::Transmit, this);
+  Simulator::Schedule (Seconds (2), &MultiModelSpectrumChannelLinkCacheTestCase::Transmit, this);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (near->m_rxCount, 2, "The near receiver should receive both signals");
+  NS_TEST_EXPECT_MSG_EQ_TOL (near->m_rxPower, 1e-3, 1e-9, "Wrong received power");
+  NS_TEST_EXPECT_MSG_EQ_TOL (near->m_rxTime, Seconds (2) + NanoSeconds (1000), NanoSeconds (1), "Wrong propagation delay");
+  NS_TEST_EXPECT_MSG_EQ (far->m_rxCount, 0, "The far receiver is beyond range");
+  NS_TEST_EXPECT_MSG_EQ (loss->m_count, 2, "The static links should be computed once");
+
+  // a course change invalidates the links of the node
+  nearMobility->SetPosition (Vector (200, 0, 0));
+  Simulator::Schedule (Seconds (1), &MultiModelSpectrumChannelLinkCacheTestCase::Transmit, this);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ_TOL (near->m_rxPower, 1e-2, 1e-8, "The moved receiver should be updated");
+  NS_TEST_EXPECT_MSG_EQ (loss->m_count, 3, "Only the link of the moved node should be computed again");
+
+  // the links of the moving nodes are not cached
+  nearMobility->SetVelocity (Vector (-10, 0, 0));
+  Simulator::Schedule (Seconds (1), &MultiModelSpectrumChannelLinkCacheTestCase::Transmit, this);
+  Simulator::Schedule (Seconds (2), &MultiModelSpectrumChannelLinkCacheTestCase::Transmit, this);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ_TOL (near->m_rxPower, std::pow (10, -1.8), 1e-6, "The moving receiver should be updated");
+  NS_TEST_EXPECT_MSG_EQ (loss->m_count, 5, "The links of a moving node should not be cached");
+
+  Simulator::Destroy ();
+  m_channel->Dispose ();
+  m_channel = 0;
+  m_tx = 0;
+}
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief MultiModelSpectrumChannel TestSuite
+ */
+class MultiModelSpectrumChannelTestSuite : public TestSuite
+{
+public:
+  MultiModelSpectrumChannelTestSuite ();
+};
+
+MultiModelSpectrumChannelTestSuite::MultiModelSpectrumChannelTestSuite ()
+  : TestSuite ("multi-model-spectrum-channel", UNIT)
+{
+  AddTestCase (new MultiModelSpectrumChannelLinkCacheTestCase, TestCase::QUICK);
+}
+
+static MultiModelSpectrumChannelTestSuite g_multiModelSpectrumChannelTestSuite; //!< Static variable for test initialization
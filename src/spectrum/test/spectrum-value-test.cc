@@ -241,6 +241,36 @@ SpectrumValueTestSuite::SpectrumValueTestSuite ()
   tv1rs3 = v1 >> 3;
   AddTestCase (new SpectrumValueTestCase (tv1rs3, v1rs3, "tv1rs3 = v1 >> 3"), TestCase::QUICK);
 
+  SpectrumValue v11 (f), v12 (f), v13 (f), v14 (f);
+  for (int i = 0; i < 5; i++)
+    {
+      v11[i] = v1[i] - v2[i] * doubleValue;
+      v12[i] = (v1[i] + v2[i]) / (v1[i] - v2[i]);
+      v13[i] = v1[i] + v2[i] * doubleValue;
+      v14[i] = v1[i] + v1[i] * v2[i];
+    }
+
+  // the temporaries are reused for the results
+  SpectrumValue tv11 = v1 - v2 * doubleValue;
+  SpectrumValue tv12 = (v1 + v2) / (v1 - v2);
+  AddTestCase (new SpectrumValueTestCase (tv11, v11, "tv11 = v1 - v2 * doubleValue"), TestCase::QUICK);
+  AddTestCase (new SpectrumValueTestCase (tv12, v12, "tv12 = (v1 + v2) div (v1 - v2)"), TestCase::QUICK);
+
+  SpectrumValue tv13 = v1;
+  SpectrumValue tv14 = v1;
+  tv13.AddScaled (v2, doubleValue);
+  tv14.AddProduct (v1, v2);
+  AddTestCase (new SpectrumValueTestCase (tv13, v13, "tv13.AddScaled (v2, doubleValue)"), TestCase::QUICK);
+  AddTestCase (new SpectrumValueTestCase (tv14, v14, "tv14.AddProduct (v1, v2)"), TestCase::QUICK);
+
+  // a recycled buffer is zeroed
+  {
+    SpectrumValue recycled (f);
+    recycled = doubleValue;
+  }
+  SpectrumValue tv15 (f);
+  AddTestCase (new SpectrumValueTestCase (tv15, v1 - v1, "tv15 = 0 from a recycled buffer"), TestCase::QUICK);
+
 
 }
 
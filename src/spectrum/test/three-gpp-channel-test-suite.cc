@@ -345,6 +345,90 @@ ThreeGppChannelMatrixUpdateTest::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * Test case for the ThreeGppChannelModel class.
+ * It checks that the channel matrices computed by several threads are
+ * the same as the ones computed by a single thread.
+ */
+class ThreeGppChannelMatrixThreadsTest : public TestCase
+{
+public:
+  /**
+   * Constructor
+   */
+  ThreeGppChannelMatrixThreadsTest ();
+
+private:
+  /**
+   * Build the test scenario
+   */
+  virtual void DoRun (void);
+};
+
+ThreeGppChannelMatrixThreadsTest::ThreeGppChannelMatrixThreadsTest ()
+  : TestCase ("Check that the channel matrices do not depend on the number of threads")
+{
+}
+
+void
+ThreeGppChannelMatrixThreadsTest::DoRun (void)
+{
+  // create the tx and rx nodes, with large arrays so that several threads are used
+  NodeContainer nodes;
+  nodes.Create (2);
+  Ptr<MobilityModel> txMob = CreateObject<ConstantPositionMobilityModel> ();
+  txMob->SetPosition (Vector (0.0,0.0,25.0));
+  Ptr<MobilityModel> rxMob = CreateObject<ConstantPositionMobilityModel> ();
+  rxMob->SetPosition (Vector (100.0,10.0,1.5));
+  nodes.Get (0)->AggregateObject (txMob);
+  nodes.Get (1)->AggregateObject (rxMob);
+  Ptr<PhasedArrayModel> txAntenna = CreateObjectWithAttributes<UniformPlanarArray> ("NumColumns", UintegerValue (8),
+                                                                                    "NumRows", UintegerValue (8),
+                                                                                    "AntennaElement", PointerValue(CreateObject<IsotropicAntennaModel> ()));
+  Ptr<PhasedArrayModel> rxAntenna = CreateObjectWithAttributes<UniformPlanarArray> ("NumColumns", UintegerValue (8),
+                                                                                    "NumRows", UintegerValue (4),
+                                                                                    "AntennaElement", PointerValue(CreateObject<IsotropicAntennaModel> ()));
+
+  // generate the same realization with one and with four threads,
+  // in LOS and NLOS conditions
+  for (bool los : {false, true})
+    {
+      Ptr<const ThreeGppChannelModel::ChannelMatrix> channelMatrix[2];
+      for (uint32_t i = 0; i < 2; i++)
+        {
+          Ptr<ChannelConditionModel> channelConditionModel;
+          if (los)
+            {
+              channelConditionModel = CreateObject<AlwaysLosChannelConditionModel> ();
+            }
+          else
+            {
+              channelConditionModel = CreateObject<NeverLosChannelConditionModel> ();
+            }
+          Ptr<ThreeGppChannelModel> channelModel = CreateObject<ThreeGppChannelModel> ();
+          channelModel->SetAttribute ("Frequency", DoubleValue (28.0e9));
+          channelModel->SetAttribute ("Scenario", StringValue ("UMa"));
+          channelModel->SetAttribute ("ChannelConditionModel", PointerValue (channelConditionModel));
+          channelModel->SetAttribute ("NumThreads", UintegerValue (i == 0 ? 1 : 4));
+          channelModel->AssignStreams (1);
+          channelMatrix[i] = channelModel->GetChannel (txMob, rxMob, txAntenna, rxAntenna);
+        }
+
+      NS_TEST_ASSERT_MSG_EQ (channelMatrix[1]->m_channel.size (), channelMatrix[0]->m_channel.size (), "Wrong number of rx antenna elements");
+      for (uint32_t u = 0; u < channelMatrix[0]->m_channel.size (); u++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (channelMatrix[1]->m_channel[u].size (), channelMatrix[0]->m_channel[u].size (), "Wrong number of tx antenna elements");
+          for (uint32_t s = 0; s < channelMatrix[0]->m_channel[u].size (); s++)
+            {
+              NS_TEST_ASSERT_MSG_EQ ((channelMatrix[1]->m_channel[u][s] == channelMatrix[0]->m_channel[u][s]), true,
+                                     "The coefficients differ for the elements " << u << ", " << s << " (LOS " << los << ")");
+            }
+        }
+    }
+
+  Simulator::Destroy ();
+}
+
 /**
  * Test case for the ThreeGppSpectrumPropagationLossModelTest class.
  * 1) checks if the long term components for the direct and the reverse link
@@ -559,6 +643,7 @@ ThreeGppChannelTestSuite::ThreeGppChannelTestSuite ()
 {
   AddTestCase (new ThreeGppChannelMatrixComputationTest, TestCase::QUICK);
   AddTestCase (new ThreeGppChannelMatrixUpdateTest, TestCase::QUICK);
+  AddTestCase (new ThreeGppChannelMatrixThreadsTest, TestCase::QUICK);
   AddTestCase (new ThreeGppSpectrumPropagationLossModelTest, TestCase::QUICK);
 }
 
@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <fstream>
+
+#include <ns3/test.h>
+#include <ns3/simulator.h>
+#include <ns3/nstime.h>
+#include <ns3/string.h>
+#include <ns3/uinteger.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/trace-fading-loss-model.h>
+
+using namespace ns3;
+
+/**
+ * \ingroup spectrum
+ * \ingroup tests
+ *
+ * \brief Check that the TraceFadingLossModel applies the fading of a
+ * text trace and of the same trace converted to the binary format.
+ */
+class TraceFadingLossModelTestCase : public TestCase
+{
+public:
+  TraceFadingLossModelTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Create a fading model
+   * \param fileName the trace file
+   * \return the fading model
+   */
+  Ptr<TraceFadingLossModel> CreateModel (std::string fileName);
+  /**
+   * Check the fading applied by the models at the current time
+   * \param models the fading models
+   */
+  void CheckFading (std::vector<Ptr<TraceFadingLossModel> > models);
+
+  Ptr<SpectrumModel> m_spectrumModel;  //!< the spectrum model of the PSDs
+  Ptr<MobilityModel> m_a;              //!< the sender mobility
+  Ptr<MobilityModel> m_b;              //!< the receiver mobility
+};
+
+/// number of RBs of the trace
+static const uint32_t TRACE_RB_NUM = 4;
+/// number of samples of the trace
+static const uint32_t TRACE_SAMPLES_NUM = 100;
+
+TraceFadingLossModelTestCase::TraceFadingLossModelTestCase ()
+  : TestCase ("Check the TraceFadingLossModel with text and binary traces")
+{
+}
+
+Ptr<TraceFadingLossModel>
+TraceFadingLossModelTestCase::CreateModel (std::string fileName)
+{
+  Ptr<TraceFadingLossModel> model = CreateObject<TraceFadingLossModel> ();
+  model->SetAttribute ("TraceFilename", StringValue (fileName));
+  model->SetAttribute ("TraceLength", TimeValue (Seconds (1)));
+  model->SetAttribute ("SamplesNum", UintegerValue (TRACE_SAMPLES_NUM));
+  model->SetAttribute ("WindowSize", TimeValue (MilliSeconds (500)));
+  model->SetAttribute ("RbNum", UintegerValue (TRACE_RB_NUM));
+  model->Initialize ();
+  model->AssignStreams (1);
+  return model;
+}
+
+void
+TraceFadingLossModelTestCase::CheckFading (std::vector<Ptr<TraceFadingLossModel> > models)
+{
+  Ptr<SpectrumValue> txPsd = Create<SpectrumValue> (m_spectrumModel);
+  for (uint32_t rb = 0; rb < TRACE_RB_NUM; rb++)
+    {
+      (*txPsd)[rb] = rb + 1;
+    }
+  Ptr<SpectrumValue> ref = models[0]->CalcRxPowerSpectralDensity (txPsd, m_a, m_b);
+  for (uint32_t rb = 0; rb < TRACE_RB_NUM; rb++)
+    {
+      // the fading of the trace only depends on the RB, and is between -10 and +10 dB
+      double fadingDb = 10.0 * std::log10 ((*ref)[rb] / (*txPsd)[rb]);
+      NS_TEST_EXPECT_MSG_EQ_TOL (fadingDb, rb * 5.0 - 10.0, 1e-4, "Wrong fading of RB " << rb);
+    }
+  for (uint32_t i = 1; i < models.size (); i++)
+    {
+      Ptr<SpectrumValue> rxPsd = models[i]->CalcRxPowerSpectralDensity (txPsd, m_a, m_b);
+      for (uint32_t rb = 0; rb < TRACE_RB_NUM; rb++)
+        {
+          NS_TEST_EXPECT_MSG_EQ ((*rxPsd)[rb], (*ref)[rb], "Different fading of model " << i << " RB " << rb);
+        }
+    }
+}
+
+void
+TraceFadingLossModelTestCase::DoRun (void)
+{
+  std::vector<double> rbs;
+  for (uint32_t rb = 0; rb < TRACE_RB_NUM; rb++)
+    {
+      rbs.push_back (rb * 180000.0);
+    }
+  m_spectrumModel = Create<SpectrumModel> (rbs);
+  m_a = CreateObject<ConstantPositionMobilityModel> ();
+  m_b = CreateObject<ConstantPositionMobilityModel> ();
+
+  // a text trace with the values of each RB on a line
+  std::string textFile = CreateTempDirFilename ("fading-trace.fad");
+  std::string binaryFile = CreateTempDirFilename ("fading-trace.bin");
+  std::ofstream text (textFile.c_str ());
+  for (uint32_t rb = 0; rb < TRACE_RB_NUM; rb++)
+    {
+      for (uint32_t sample = 0; sample < TRACE_SAMPLES_NUM; sample++)
+        {
+          text << rb * 5.0 - 10.0 << " ";
+        }
+      text << std::endl;
+    }
+  text.close ();
+  TraceFadingLossModel::ConvertTrace (textFile, binaryFile, TRACE_RB_NUM, TRACE_SAMPLES_NUM);
+
+  std::vector<Ptr<TraceFadingLossModel> > models;
+  models.push_back (CreateModel (textFile));
+  models.push_back (CreateModel (binaryFile));
+  // this model shares the trace loaded by the previous one
+  models.push_back (CreateModel (binaryFile));
+
+  Simulator::Schedule (MilliSeconds (3), &TraceFadingLossModelTestCase::CheckFading, this, models);
+  Simulator::Schedule (MilliSeconds (700), &TraceFadingLossModelTestCase::CheckFading, this, models);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup spectrum
+ * \ingroup tests
+ *
+ * \brief TraceFadingLossModel TestSuite
+ */
+class TraceFadingLossModelTestSuite : public TestSuite
+{
+public:
+  TraceFadingLossModelTestSuite ();
+};
+
+TraceFadingLossModelTestSuite::TraceFadingLossModelTestSuite ()
+  : TestSuite ("trace-fading-loss-model", UNIT)
+{
+  AddTestCase (new TraceFadingLossModelTestCase, TestCase::QUICK);
+}
+
+static TraceFadingLossModelTestSuite g_traceFadingLossModelTestSuite; //!< Static variable for test initialization
@@ -27,6 +27,7 @@
 #include <fstream>
 #include <map>
 #include <string>
+#include <vector>
 #include "ns3/data-collection-object.h"
 
 namespace ns3 {
@@ -167,6 +168,14 @@ public:
    */
   void Set10dFormat (const std::string &format);
 
+  /**
+   * \brief Write the buffered values to the file.
+   *
+   * The values are buffered, and written to the file when the buffer
+   * is full or when the aggregator is destroyed.
+   */
+  void Flush (void);
+
   // Below are hooked to connectors exporting data
   // They are not overloaded since it confuses the compiler when made
   // into callbacks
@@ -355,6 +364,9 @@ private:
   /// The file name.
   std::string m_outputFileName;
 
+  /// Buffer of the file, so that the values are not written one by one.
+  std::vector<char> m_buffer;
+
   /// Used to write values to the file.
   std::ofstream m_file;
 
@@ -0,0 +1,409 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "quantile-sketch.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#define DEFAULT_RELATIVE_ACCURACY 0.01
+#define DEFAULT_MAX_BINS          2048
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("QuantileSketch");
+
+namespace {
+
+/// Size of the serialized sketch, without the buckets
+const uint32_t HEADER_SIZE = 8 + 4 + 8 + 8 + 8 + 8 + 8 + 4 + 4;
+
+/**
+ * \brief Store an integer in little endian order
+ * \param buffer the destination
+ * \param value the value
+ * \param size the number of bytes to store
+ * \returns the byte following the value
+ */
+uint8_t *
+WriteLe (uint8_t *buffer, uint64_t value, uint32_t size)
+{
+  for (uint32_t i = 0; i < size; ++i)
+    {
+      buffer[i] = (value >> (8 * i)) & 0xff;
+    }
+  return buffer + size;
+}
+
+/**
+ * \brief Store a double in little endian order
+ * \param buffer the destination
+ * \param value the value
+ * \returns the byte following the value
+ */
+uint8_t *
+WriteDouble (uint8_t *buffer, double value)
+{
+  uint64_t bits;
+  std::memcpy (&bits, &value, sizeof (bits));
+  return WriteLe (buffer, bits, 8);
+}
+
+/**
+ * \brief Load an integer stored in little endian order
+ * \param buffer [in,out] the source, moved past the value
+ * \param size the number of bytes to load
+ * \returns the value
+ */
+uint64_t
+ReadLe (const uint8_t *&buffer, uint32_t size)
+{
+  uint64_t value = 0;
+  for (uint32_t i = 0; i < size; ++i)
+    {
+      value |= static_cast<uint64_t> (buffer[i]) << (8 * i);
+    }
+  buffer += size;
+  return value;
+}
+
+/**
+ * \brief Load a double stored in little endian order
+ * \param buffer [in,out] the source, moved past the value
+ * \returns the value
+ */
+double
+ReadDouble (const uint8_t *&buffer)
+{
+  uint64_t bits = ReadLe (buffer, 8);
+  double value;
+  std::memcpy (&value, &bits, sizeof (value));
+  return value;
+}
+
+} // unnamed namespace
+
+QuantileSketch::QuantileSketch (double relativeAccuracy, uint32_t maxBins)
+  : m_maxBins (maxBins)
+{
+  SetRelativeAccuracy (relativeAccuracy);
+  Clear ();
+}
+
+QuantileSketch::QuantileSketch ()
+  : m_maxBins (DEFAULT_MAX_BINS)
+{
+  SetRelativeAccuracy (DEFAULT_RELATIVE_ACCURACY);
+  Clear ();
+}
+
+void
+QuantileSketch::SetRelativeAccuracy (double relativeAccuracy)
+{
+  NS_ASSERT (relativeAccuracy > 0 && relativeAccuracy < 1);
+  NS_ASSERT (m_bins.size () == 0); //we can only change the accuracy if no values were added
+  m_relativeAccuracy = relativeAccuracy;
+  m_logGamma = std::log ((1 + relativeAccuracy) / (1 - relativeAccuracy));
+}
+
+double
+QuantileSketch::GetRelativeAccuracy (void) const
+{
+  return m_relativeAccuracy;
+}
+
+void
+QuantileSketch::SetMaxBins (uint32_t maxBins)
+{
+  NS_ASSERT (maxBins > 0);
+  NS_ASSERT (m_bins.size () == 0);
+  m_maxBins = maxBins;
+}
+
+int32_t
+QuantileSketch::GetIndex (double value) const
+{
+  return static_cast<int32_t> (std::ceil (std::log (value) / m_logGamma));
+}
+
+double
+QuantileSketch::GetValue (int32_t index) const
+{
+  // the value with the same relative distance to both bucket bounds,
+  // gamma^(index-1) and gamma^index
+  double gamma = std::exp (m_logGamma);
+  return 2 * std::exp (index * m_logGamma) / (gamma + 1);
+}
+
+void
+QuantileSketch::AddToBin (int32_t index, uint64_t count)
+{
+  if (m_bins.empty ())
+    {
+      m_offset = index;
+      m_bins.push_back (count);
+      return;
+    }
+  int32_t last = m_offset + static_cast<int32_t> (m_bins.size ()) - 1;
+  if (index < m_offset)
+    {
+      // grow downwards, as far as allowed; lower values go to the lowest bucket
+      int32_t first = std::max (index, last - static_cast<int32_t> (m_maxBins) + 1);
+      if (first < m_offset)
+        {
+          m_bins.insert (m_bins.begin (), m_offset - first, 0);
+          m_offset = first;
+        }
+      m_bins[0] += count;
+    }
+  else if (index > last)
+    {
+      // grow upwards, collapsing the lowest buckets if needed
+      m_bins.resize (index - m_offset + 1, 0);
+      if (m_bins.size () > m_maxBins)
+        {
+          uint32_t n = m_bins.size () - m_maxBins;
+          uint64_t collapsed = 0;
+          for (uint32_t i = 0; i < n; i++)
+            {
+              collapsed += m_bins[i];
+            }
+          NS_LOG_DEBUG ("Collapsing " << n << " buckets");
+          m_bins.erase (m_bins.begin (), m_bins.begin () + n);
+          m_bins[0] += collapsed;
+          m_offset += n;
+        }
+      m_bins.back () += count;
+    }
+  else
+    {
+      m_bins[index - m_offset] += count;
+    }
+}
+
+void
+QuantileSketch::AddValue (double value, uint64_t count)
+{
+  if (count == 0)
+    {
+      return;
+    }
+  if (m_count == 0)
+    {
+      m_min = value;
+      m_max = value;
+    }
+  else
+    {
+      m_min = std::min (m_min, value);
+      m_max = std::max (m_max, value);
+    }
+  m_count += count;
+  m_sum += value * count;
+  if (value > 0)
+    {
+      AddToBin (GetIndex (value), count);
+    }
+  else
+    {
+      m_zeroCount += count;
+    }
+}
+
+void
+QuantileSketch::Merge (const QuantileSketch &other)
+{
+  NS_ASSERT_MSG (other.m_relativeAccuracy == m_relativeAccuracy,
+                 "Only sketches with the same relative accuracy can be merged");
+  if (other.m_count == 0)
+    {
+      return;
+    }
+  if (m_count == 0)
+    {
+      m_min = other.m_min;
+      m_max = other.m_max;
+    }
+  else
+    {
+      m_min = std::min (m_min, other.m_min);
+      m_max = std::max (m_max, other.m_max);
+    }
+  m_count += other.m_count;
+  m_sum += other.m_sum;
+  m_zeroCount += other.m_zeroCount;
+  // add the highest buckets first, so that the buckets grow downwards
+  // and the lowest ones are collapsed if needed
+  for (uint32_t i = other.m_bins.size (); i > 0; i--)
+    {
+      if (other.m_bins[i - 1] > 0)
+        {
+          AddToBin (other.m_offset + static_cast<int32_t> (i) - 1, other.m_bins[i - 1]);
+        }
+    }
+}
+
+void
+QuantileSketch::Clear (void)
+{
+  m_bins.clear ();
+  m_offset = 0;
+  m_zeroCount = 0;
+  m_count = 0;
+  m_sum = 0;
+  m_min = 0;
+  m_max = 0;
+}
+
+double
+QuantileSketch::GetQuantile (double q) const
+{
+  NS_ASSERT (q >= 0 && q <= 1);
+  if (m_count == 0)
+    {
+      return 0;
+    }
+  double rank = q * (m_count - 1);
+  uint64_t n = m_zeroCount;
+  if (n > rank)
+    {
+      return std::max (m_min, 0.0);
+    }
+  for (uint32_t i = 0; i < m_bins.size (); i++)
+    {
+      n += m_bins[i];
+      if (n > rank)
+        {
+          double value = GetValue (m_offset + static_cast<int32_t> (i));
+          return std::min (std::max (value, m_min), m_max);
+        }
+    }
+  return m_max;
+}
+
+uint64_t
+QuantileSketch::GetCount (void) const
+{
+  return m_count;
+}
+
+double
+QuantileSketch::GetSum (void) const
+{
+  return m_sum;
+}
+
+double
+QuantileSketch::GetMin (void) const
+{
+  return m_min;
+}
+
+double
+QuantileSketch::GetMax (void) const
+{
+  return m_max;
+}
+
+uint32_t
+QuantileSketch::GetNBins (void) const
+{
+  return m_bins.size ();
+}
+
+uint32_t
+QuantileSketch::GetSerializedSize (void) const
+{
+  return HEADER_SIZE + 8 * m_bins.size ();
+}
+
+void
+QuantileSketch::Serialize (uint8_t *buffer) const
+{
+  uint8_t *p = WriteDouble (buffer, m_relativeAccuracy);
+  p = WriteLe (p, m_maxBins, 4);
+  p = WriteLe (p, m_zeroCount, 8);
+  p = WriteLe (p, m_count, 8);
+  p = WriteDouble (p, m_sum);
+  p = WriteDouble (p, m_min);
+  p = WriteDouble (p, m_max);
+  p = WriteLe (p, static_cast<uint32_t> (m_offset), 4);
+  p = WriteLe (p, m_bins.size (), 4);
+  for (uint32_t i = 0; i < m_bins.size (); i++)
+    {
+      p = WriteLe (p, m_bins[i], 8);
+    }
+  NS_ASSERT (p == buffer + GetSerializedSize ());
+}
+
+bool
+QuantileSketch::Deserialize (const uint8_t *buffer, uint32_t size)
+{
+  if (size < HEADER_SIZE)
+    {
+      return false;
+    }
+  const uint8_t *p = buffer;
+  double relativeAccuracy = ReadDouble (p);
+  uint32_t maxBins = ReadLe (p, 4);
+  uint64_t zeroCount = ReadLe (p, 8);
+  uint64_t count = ReadLe (p, 8);
+  double sum = ReadDouble (p);
+  double min = ReadDouble (p);
+  double max = ReadDouble (p);
+  int32_t offset = static_cast<int32_t> (ReadLe (p, 4));
+  uint32_t nBins = ReadLe (p, 4);
+  if (!(relativeAccuracy > 0 && relativeAccuracy < 1) || maxBins == 0 || nBins > maxBins
+      || size != HEADER_SIZE + 8 * nBins)
+    {
+      return false;
+    }
+
+  Clear ();
+  m_maxBins = maxBins;
+  SetRelativeAccuracy (relativeAccuracy);
+  m_bins.resize (nBins);
+  for (uint32_t i = 0; i < nBins; i++)
+    {
+      m_bins[i] = ReadLe (p, 8);
+    }
+  m_offset = offset;
+  m_zeroCount = zeroCount;
+  m_count = count;
+  m_sum = sum;
+  m_min = min;
+  m_max = max;
+  return true;
+}
+
+void
+QuantileSketch::SerializeToXmlStream (std::ostream &os, uint16_t indent, std::string elementName) const
+{
+  os << std::string (indent, ' ') << "<" << elementName
+     << " count=\"" << m_count << "\""
+     << " min=\"" << m_min << "\""
+     << " max=\"" << m_max << "\""
+     << " p50=\"" << GetQuantile (0.5) << "\""
+     << " p90=\"" << GetQuantile (0.9) << "\""
+     << " p99=\"" << GetQuantile (0.99) << "\""
+     << " p999=\"" << GetQuantile (0.999) << "\""
+     << " />\n";
+}
+
+} // namespace ns3
@@ -0,0 +1,182 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_QUANTILE_SKETCH_H
+#define NS3_QUANTILE_SKETCH_H
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup stats
+ *
+ * \brief Mergeable sketch of a distribution, estimating its quantiles
+ * with a bounded relative error.
+ *
+ * This is a DDSketch (Masson, Rim and Lee, VLDB 2019): the positive values
+ * are counted in buckets whose bounds grow geometrically by a factor
+ * gamma = (1 + a) / (1 - a), where \a a is the relative accuracy, so that
+ * any quantile is estimated within a relative error \a a of the exact
+ * value, whatever the range of the data.  Unlike Histogram, the memory
+ * only depends on the ratio between the largest and the smallest values
+ * (about log(max / min) / log(gamma) buckets), and it is bounded by the
+ * maximum number of buckets: when it is reached, the lowest buckets are
+ * collapsed, which only degrades the accuracy of the lowest quantiles.
+ *
+ * Sketches with the same relative accuracy can be merged, e.g., to get
+ * the distribution of several flows, and serialized to a byte buffer, e.g.,
+ * to merge the sketches of several MPI ranks.
+ *
+ * Like Histogram, this class does not handle negative data: the values
+ * which are not positive are counted as zeros.
+ */
+class QuantileSketch
+{
+public:
+  /**
+   * \brief Constructor
+   * \param relativeAccuracy the relative accuracy of the quantiles, in (0, 1)
+   * \param maxBins the maximum number of buckets
+   */
+  QuantileSketch (double relativeAccuracy, uint32_t maxBins = 2048);
+  QuantileSketch ();
+
+  /**
+   * \brief Set the relative accuracy.
+   *
+   * Note that you can change the accuracy only if the sketch is empty.
+   *
+   * \param relativeAccuracy the relative accuracy of the quantiles, in (0, 1)
+   */
+  void SetRelativeAccuracy (double relativeAccuracy);
+  /**
+   * \return the relative accuracy of the quantiles
+   */
+  double GetRelativeAccuracy (void) const;
+  /**
+   * \brief Set the maximum number of buckets.
+   *
+   * Note that you can change the maximum only if the sketch is empty.
+   *
+   * \param maxBins the maximum number of buckets
+   */
+  void SetMaxBins (uint32_t maxBins);
+
+  /**
+   * \brief Add a value to the sketch
+   * \param value the value to add
+   * \param count the number of times the value is added
+   */
+  void AddValue (double value, uint64_t count = 1);
+  /**
+   * \brief Add the values of another sketch to this sketch
+   * \param other a sketch with the same relative accuracy
+   */
+  void Merge (const QuantileSketch &other);
+  /**
+   * \brief Remove all the values
+   */
+  void Clear (void);
+
+  /**
+   * \brief Estimate a quantile
+   * \param q the quantile, in [0, 1], e.g., 0.99 for the 99th percentile
+   * \return the estimated quantile, 0 if the sketch is empty
+   */
+  double GetQuantile (double q) const;
+  /**
+   * \return the number of values added
+   */
+  uint64_t GetCount (void) const;
+  /**
+   * \return the sum of the values added
+   */
+  double GetSum (void) const;
+  /**
+   * \return the smallest value added, 0 if the sketch is empty
+   */
+  double GetMin (void) const;
+  /**
+   * \return the largest value added, 0 if the sketch is empty
+   */
+  double GetMax (void) const;
+  /**
+   * \return the number of buckets in use
+   */
+  uint32_t GetNBins (void) const;
+
+  /**
+   * \return the size of the serialized sketch, in bytes
+   */
+  uint32_t GetSerializedSize (void) const;
+  /**
+   * \brief Serialize the sketch, in a portable format
+   * \param buffer the destination, at least GetSerializedSize () bytes
+   */
+  void Serialize (uint8_t *buffer) const;
+  /**
+   * \brief Replace the sketch with a serialized sketch
+   * \param buffer the serialized sketch
+   * \param size the size of the buffer
+   * \return false if the buffer does not hold a valid sketch
+   */
+  bool Deserialize (const uint8_t *buffer, uint32_t size);
+
+  /**
+   * \brief Serializes the main quantiles to an std::ostream in XML format.
+   * \param os the output stream
+   * \param indent number of spaces to use as base indentation level
+   * \param elementName name of the element to serialize.
+   */
+  void SerializeToXmlStream (std::ostream &os, uint16_t indent, std::string elementName) const;
+
+private:
+  /**
+   * \param value a positive value
+   * \return the index of the bucket of the value
+   */
+  int32_t GetIndex (double value) const;
+  /**
+   * \param index the index of a bucket
+   * \return the value representing the bucket
+   */
+  double GetValue (int32_t index) const;
+  /**
+   * \brief Add a count to a bucket, growing (or collapsing) the buckets as needed
+   * \param index the index of the bucket
+   * \param count the count
+   */
+  void AddToBin (int32_t index, uint64_t count);
+
+  double m_relativeAccuracy; //!< Relative accuracy
+  double m_logGamma;         //!< Logarithm of the bucket growth factor
+  uint32_t m_maxBins;        //!< Maximum number of buckets
+  std::vector<uint64_t> m_bins; //!< Bucket counts
+  int32_t m_offset;          //!< Index of the first bucket in m_bins
+  uint64_t m_zeroCount;      //!< Number of values which are not positive
+  uint64_t m_count;          //!< Number of values
+  double m_sum;              //!< Sum of the values
+  double m_min;              //!< Smallest value
+  double m_max;              //!< Largest value
+};
+
+} // namespace ns3
+
+#endif /* NS3_QUANTILE_SKETCH_H */
@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "sqlite-aggregator.h"
+#include "sqlite-output.h"
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SqliteAggregator");
+
+NS_OBJECT_ENSURE_REGISTERED (SqliteAggregator);
+
+TypeId
+SqliteAggregator::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::SqliteAggregator")
+    .SetParent<DataCollectionObject> ()
+    .SetGroupName ("Stats")
+  ;
+
+  return tid;
+}
+
+SqliteAggregator::SqliteAggregator (const std::string &dbFileName,
+                                    const std::string &tableName)
+  : m_tableName         (tableName),
+    m_batchSize         (4096),
+    m_insertValue       (nullptr),
+    m_insertContext     (nullptr),
+    m_nextContextId     (0)
+{
+  NS_LOG_FUNCTION (this << dbFileName << tableName);
+
+  m_db = Create<SQLiteOutput> (dbFileName, "ns-3-sqlite-aggregator-sem");
+  m_db->SetWalMode ();
+
+  bool res = m_db->SpinExec ("CREATE TABLE IF NOT EXISTS " + m_tableName
+                             + "Contexts (id INTEGER PRIMARY KEY, name TEXT)");
+  NS_ABORT_MSG_UNLESS (res, "Failed to create the table " << m_tableName << "Contexts");
+  res = m_db->SpinExec ("CREATE TABLE IF NOT EXISTS " + m_tableName
+                        + " (context INTEGER, x REAL, y REAL)");
+  NS_ABORT_MSG_UNLESS (res, "Failed to create the table " << m_tableName);
+
+  // the values already in the table refer to the existing contexts: keep
+  // their ids, and give the new contexts the following ones
+  sqlite3_stmt *selectContexts;
+  res = m_db->SpinPrepare (&selectContexts, "SELECT id, name FROM " + m_tableName + "Contexts");
+  NS_ABORT_MSG_UNLESS (res, "Failed to prepare the context selection");
+  int rc;
+  while ((rc = SQLiteOutput::SpinStep (selectContexts)) == SQLITE_ROW)
+    {
+      uint32_t id = m_db->RetrieveColumn<uint32_t> (selectContexts, 0);
+      const unsigned char *name = sqlite3_column_text (selectContexts, 1);
+      m_contextIds[name ? reinterpret_cast<const char *> (name) : ""] = id;
+      m_nextContextId = std::max (m_nextContextId, id + 1);
+    }
+  NS_ABORT_MSG_UNLESS (rc == SQLITE_DONE, "Failed to select the contexts");
+  SQLiteOutput::SpinFinalize (selectContexts);
+  NS_LOG_DEBUG ("Found " << m_contextIds.size () << " contexts in " << m_tableName << "Contexts");
+
+  // a plain insertion, so that an aggregator writing the same table at the
+  // same time is detected instead of overwriting the contexts
+  res = m_db->SpinPrepare (&m_insertContext, "INSERT INTO " + m_tableName
+                           + "Contexts (id, name) VALUES (?, ?)");
+  NS_ABORT_MSG_UNLESS (res, "Failed to prepare the context insertion");
+  res = m_db->SpinPrepare (&m_insertValue, "INSERT INTO " + m_tableName
+                           + " (context, x, y) VALUES (?, ?, ?)");
+  NS_ABORT_MSG_UNLESS (res, "Failed to prepare the value insertion");
+}
+
+SqliteAggregator::~SqliteAggregator ()
+{
+  NS_LOG_FUNCTION (this);
+  Flush ();
+  SQLiteOutput::SpinFinalize (m_insertValue);
+  SQLiteOutput::SpinFinalize (m_insertContext);
+}
+
+void
+SqliteAggregator::SetBatchSize (uint32_t batchSize)
+{
+  NS_LOG_FUNCTION (this << batchSize);
+  NS_ASSERT (batchSize > 0);
+  m_batchSize = batchSize;
+  if (m_xColumn.size () >= m_batchSize)
+    {
+      Flush ();
+    }
+}
+
+uint32_t
+SqliteAggregator::GetContextId (const std::string &context)
+{
+  std::unordered_map<std::string, uint32_t>::const_iterator it = m_contextIds.find (context);
+  if (it != m_contextIds.end ())
+    {
+      return it->second;
+    }
+  uint32_t id = m_nextContextId++;
+  m_contextIds[context] = id;
+  m_newContexts.push_back (std::make_pair (id, context));
+  return id;
+}
+
+void
+SqliteAggregator::Write1d (std::string context,
+                           double v1)
+{
+  NS_LOG_FUNCTION (this << context << v1);
+
+  if (m_enabled)
+    {
+      m_contextColumn.push_back (GetContextId (context));
+      m_xColumn.push_back (v1);
+      m_yColumn.push_back (0);
+      m_is2d.push_back (false);
+      if (m_xColumn.size () >= m_batchSize)
+        {
+          Flush ();
+        }
+    }
+}
+
+void
+SqliteAggregator::Write2d (std::string context,
+                           double v1,
+                           double v2)
+{
+  NS_LOG_FUNCTION (this << context << v1 << v2);
+
+  if (m_enabled)
+    {
+      m_contextColumn.push_back (GetContextId (context));
+      m_xColumn.push_back (v1);
+      m_yColumn.push_back (v2);
+      m_is2d.push_back (true);
+      if (m_xColumn.size () >= m_batchSize)
+        {
+          Flush ();
+        }
+    }
+}
+
+void
+SqliteAggregator::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_xColumn.empty () && m_newContexts.empty ())
+    {
+      return;
+    }
+  NS_LOG_DEBUG ("Inserting " << m_xColumn.size () << " values");
+
+  m_db->SpinExec ("BEGIN");
+  for (uint32_t i = 0; i < m_newContexts.size (); i++)
+    {
+      SQLiteOutput::SpinReset (m_insertContext);
+      m_db->Bind (m_insertContext, 1, m_newContexts[i].first);
+      m_db->Bind (m_insertContext, 2, m_newContexts[i].second);
+      int rc = SQLiteOutput::SpinStep (m_insertContext);
+      NS_ABORT_MSG_UNLESS (rc == SQLITE_DONE, "Failed to insert the context " << m_newContexts[i].second
+                           << ": is another aggregator writing the table " << m_tableName << "?");
+    }
+  m_newContexts.clear ();
+  for (uint32_t i = 0; i < m_xColumn.size (); i++)
+    {
+      SQLiteOutput::SpinReset (m_insertValue);
+      m_db->Bind (m_insertValue, 1, m_contextColumn[i]);
+      m_db->Bind (m_insertValue, 2, m_xColumn[i]);
+      if (m_is2d[i])
+        {
+          m_db->Bind (m_insertValue, 3, m_yColumn[i]);
+        }
+      else
+        {
+          sqlite3_bind_null (m_insertValue, 3);
+        }
+      int rc = SQLiteOutput::SpinStep (m_insertValue);
+      NS_ABORT_MSG_UNLESS (rc == SQLITE_DONE, "Failed to insert a value");
+    }
+  m_db->SpinExec ("COMMIT");
+
+  m_contextColumn.clear ();
+  m_xColumn.clear ();
+  m_yColumn.clear ();
+  m_is2d.clear ();
+}
+
+} // namespace ns3
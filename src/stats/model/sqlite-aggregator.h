@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SQLITE_AGGREGATOR_H
+#define SQLITE_AGGREGATOR_H
+
+#include <string>
+#include <utility>
+#include <vector>
+#include <unordered_map>
+#include "ns3/data-collection-object.h"
+
+struct sqlite3_stmt;
+
+namespace ns3 {
+
+class SQLiteOutput;
+
+/**
+ * \ingroup aggregator
+ *
+ * This aggregator stores the values it receives in an SQLite database.
+ *
+ * The values are staged in memory, one array per column, and inserted
+ * in batches, each batch in a single transaction with a prepared
+ * statement, in a database in write-ahead log mode: the high frequency
+ * probes do not wait for the disk at each sample.
+ *
+ * The values are stored in the table \c tableName, with the columns
+ * (context, x, y), where context is the id of the context string in the
+ * table \c tableName + "Contexts", with the columns (id, name).  The
+ * 1D values are stored in x, y being NULL.
+ *
+ * Unlike FileAggregator, which truncates its file, the values are
+ * appended to the tables if they already exist: the contexts found in
+ * the table of the contexts keep their ids, and the new contexts get the
+ * following ones.  Two aggregators must not write the same tables at
+ * the same time.
+ **/
+class SqliteAggregator : public DataCollectionObject
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \param dbFileName name of the database file
+   * \param tableName name of the table of the values
+   *
+   * Constructs an aggregator that stores the values in the table
+   * tableName of the database dbFileName, created if needed, after the
+   * values already in the table.
+   */
+  SqliteAggregator (const std::string &dbFileName,
+                    const std::string &tableName = "Samples");
+
+  virtual ~SqliteAggregator ();
+
+  /**
+   * \param batchSize the number of values staged in memory before
+   * they are inserted in the database.
+   *
+   * \brief Set the size of the batches.
+   */
+  void SetBatchSize (uint32_t batchSize);
+
+  /**
+   * \brief Insert the staged values in the database.
+   */
+  void Flush (void);
+
+  // Below are hooked to connectors exporting data
+  // They are not overloaded since it confuses the compiler when made
+  // into callbacks
+
+  /**
+   * \param context specifies the 1D dataset these values came from.
+   * \param v1 value for the new data point.
+   *
+   * \brief Stores 1 value.
+   */
+  void Write1d (std::string context,
+                double v1);
+
+  /**
+   * \param context specifies the 2D dataset these values came from.
+   * \param v1 first value for the new data point.
+   * \param v2 second value for the new data point.
+   *
+   * \brief Stores 2 values.
+   */
+  void Write2d (std::string context,
+                double v1,
+                double v2);
+
+private:
+  /**
+   * \param context a context
+   * \return the id of the context
+   */
+  uint32_t GetContextId (const std::string &context);
+
+  /// The database.
+  Ptr<SQLiteOutput> m_db;
+
+  /// The name of the table of the values.
+  std::string m_tableName;
+
+  /// The number of values staged before they are inserted.
+  uint32_t m_batchSize;
+
+  /// Statement inserting a value.
+  sqlite3_stmt *m_insertValue;
+
+  /// Statement inserting a context.
+  sqlite3_stmt *m_insertContext;
+
+  /// Context name --> context id
+  std::unordered_map<std::string, uint32_t> m_contextIds;
+
+  /// The id of the next new context.
+  uint32_t m_nextContextId;
+
+  /// The new contexts (id, name), not inserted in the database yet.
+  std::vector<std::pair<uint32_t, std::string> > m_newContexts;
+
+  std::vector<uint32_t> m_contextColumn; //!< Staged contexts.
+  std::vector<double> m_xColumn;         //!< Staged first values.
+  std::vector<double> m_yColumn;         //!< Staged second values.
+  std::vector<bool> m_is2d;              //!< Whether the staged values have a second value.
+
+}; // class SqliteAggregator
+
+
+} // namespace ns3
+
+#endif // SQLITE_AGGREGATOR_H
@@ -102,6 +102,8 @@ SqliteDataOutput::Output (DataCollector &dc)
                                   "values (?, ?, ?)");
   NS_ASSERT (res);
 
+  // a single transaction for all the rows, instead of one per row
+  m_sqliteOut->SpinExec ("BEGIN");
   for (MetadataList::iterator i = dc.MetadataBegin ();
        i != dc.MetadataEnd (); i++)
     {
@@ -115,7 +117,6 @@ SqliteDataOutput::Output (DataCollector &dc)
 
   m_sqliteOut->SpinFinalize (stmt);
 
-  m_sqliteOut->SpinExec ("BEGIN");
   SqliteOutputCallback callback (m_sqliteOut, run);
   for (DataCalculatorList::iterator i = dc.DataCalculatorBegin ();
        i != dc.DataCalculatorEnd (); i++)
@@ -50,6 +50,20 @@ SQLiteOutput::SetJournalInMemory ()
   SpinExec ("PRAGMA journal_mode = MEMORY");
 }
 
+void
+SQLiteOutput::SetWalMode ()
+{
+  NS_LOG_FUNCTION (this);
+  // this pragma returns the new journal mode as a row
+  sqlite3_stmt *stmt;
+  int rc = SpinPrepare (m_db, &stmt, "PRAGMA journal_mode = WAL");
+  NS_ABORT_MSG_UNLESS (rc == SQLITE_OK, "Failed to prepare the journal mode: " << sqlite3_errmsg (m_db));
+  rc = SpinStep (stmt);
+  NS_ABORT_MSG_UNLESS (rc == SQLITE_ROW || rc == SQLITE_DONE, "Failed to set the journal mode: " << sqlite3_errmsg (m_db));
+  SpinFinalize (stmt);
+  SpinExec ("PRAGMA synchronous = NORMAL");
+}
+
 bool
 SQLiteOutput::SpinExec (const std::string &cmd) const
 {
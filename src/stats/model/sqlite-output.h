@@ -62,6 +62,13 @@ public:
    */
   void SetJournalInMemory ();
 
+  /**
+   * \brief Instruct SQLite to use a write-ahead log, and to synchronize it only
+   * at checkpoints. The inserts are much faster, in particular when they are
+   * grouped in transactions, and readers do not block the writer.
+   */
+  void SetWalMode ();
+
   /**
    * \brief Execute a command until the return value is OK or an ERROR
    *
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "ns3/quantile-sketch.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-test
+ * \ingroup tests
+ *
+ * \brief QuantileSketch Test
+ */
+class QuantileSketchTestCase : public ns3::TestCase
+{
+public:
+  QuantileSketchTestCase ();
+  virtual void DoRun (void);
+};
+
+QuantileSketchTestCase::QuantileSketchTestCase ()
+  : ns3::TestCase ("QuantileSketch")
+{
+}
+
+void
+QuantileSketchTestCase::DoRun (void)
+{
+  const double accuracy = 0.01;
+
+  // values spread over 6 orders of magnitude, from 1 us to 1 s
+  std::vector<double> values;
+  for (int i = 0; i < 10000; i++)
+    {
+      values.push_back (1e-6 * std::pow (10.0, 6.0 * ((i * 7919) % 10000) / 10000));
+    }
+  QuantileSketch a (accuracy);
+  QuantileSketch b (accuracy);
+  for (uint32_t i = 0; i < values.size (); i++)
+    {
+      (i % 3 ? a : b).AddValue (values[i]);
+    }
+  a.Merge (b);
+  std::sort (values.begin (), values.end ());
+
+  NS_TEST_EXPECT_MSG_EQ (a.GetCount (), values.size (), "Wrong count");
+  NS_TEST_EXPECT_MSG_EQ (a.GetMin (), values.front (), "Wrong min");
+  NS_TEST_EXPECT_MSG_EQ (a.GetMax (), values.back (), "Wrong max");
+  NS_TEST_EXPECT_MSG_LT (a.GetNBins (), 750, "Too many buckets");
+  double quantiles[] = {0, 0.5, 0.9, 0.99, 0.999, 1};
+  for (double q : quantiles)
+    {
+      double exact = values[static_cast<uint32_t> (q * (values.size () - 1))];
+      NS_TEST_EXPECT_MSG_EQ_TOL (a.GetQuantile (q), exact, exact * accuracy, "Wrong quantile " << q);
+    }
+
+  // serialization round trip
+  std::vector<uint8_t> buffer (a.GetSerializedSize ());
+  a.Serialize (buffer.data ());
+  QuantileSketch c;
+  NS_TEST_ASSERT_MSG_EQ (c.Deserialize (buffer.data (), buffer.size ()), true, "Deserialize failed");
+  NS_TEST_EXPECT_MSG_EQ (c.GetCount (), a.GetCount (), "Wrong count after deserialization");
+  NS_TEST_EXPECT_MSG_EQ (c.GetQuantile (0.99), a.GetQuantile (0.99), "Wrong quantile after deserialization");
+  NS_TEST_EXPECT_MSG_EQ (c.Deserialize (buffer.data (), buffer.size () - 1), false, "Truncated buffer accepted");
+
+  // bounded number of buckets: only the lowest quantiles lose accuracy
+  QuantileSketch d (accuracy, 100);
+  for (uint32_t i = 0; i < values.size (); i++)
+    {
+      d.AddValue (values[i]);
+    }
+  NS_TEST_EXPECT_MSG_EQ (d.GetNBins (), 100, "Wrong number of buckets");
+  double exact = values[static_cast<uint32_t> (0.99 * (values.size () - 1))];
+  NS_TEST_EXPECT_MSG_EQ_TOL (d.GetQuantile (0.99), exact, exact * accuracy, "Wrong 99th percentile");
+
+  // zeros
+  QuantileSketch e;
+  e.AddValue (0, 90);
+  e.AddValue (1, 10);
+  NS_TEST_EXPECT_MSG_EQ (e.GetQuantile (0.5), 0, "Wrong median");
+  NS_TEST_EXPECT_MSG_EQ_TOL (e.GetQuantile (0.95), 1, 0.01, "Wrong 95th percentile");
+}
+
+/**
+ * \ingroup stats-test
+ * \ingroup tests
+ *
+ * \brief QuantileSketch TestSuite
+ */
+class QuantileSketchTestSuite : public TestSuite
+{
+public:
+  QuantileSketchTestSuite ();
+};
+
+QuantileSketchTestSuite::QuantileSketchTestSuite ()
+  : TestSuite ("quantile-sketch", UNIT)
+{
+  AddTestCase (new QuantileSketchTestCase, TestCase::QUICK);
+}
+
+static QuantileSketchTestSuite g_quantileSketchTestSuite; //!< Static variable for test initialization
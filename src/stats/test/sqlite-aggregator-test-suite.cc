@@ -0,0 +1,193 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstdio>
+
+#include "ns3/sqlite-aggregator.h"
+#include "ns3/sqlite-output.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-test
+ * \ingroup tests
+ *
+ * \brief Check that the values written to a SqliteAggregator are stored.
+ */
+class SqliteAggregatorTestCase : public ns3::TestCase
+{
+public:
+  SqliteAggregatorTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SqliteAggregatorTestCase::SqliteAggregatorTestCase ()
+  : ns3::TestCase ("Check that the values written to a SqliteAggregator are stored")
+{
+}
+
+void
+SqliteAggregatorTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("sqlite-aggregator.db");
+  std::remove (filename.c_str ());
+
+  const uint32_t nValues = 10000;
+  {
+    Ptr<SqliteAggregator> aggregator = CreateObject<SqliteAggregator> (filename, "Samples");
+    aggregator->SetBatchSize (1000);
+    aggregator->Enable ();
+    for (uint32_t i = 0; i < nValues; i++)
+      {
+        aggregator->Write2d (i % 2 ? "odd" : "even", i, 2.0 * i);
+      }
+    aggregator->Write1d ("single", 42);
+    aggregator->Disable ();
+    aggregator->Write1d ("single", 43);
+  }
+
+  Ptr<SQLiteOutput> db = Create<SQLiteOutput> (filename, "ns-3-sqlite-aggregator-test-sem");
+  sqlite3_stmt *stmt;
+  NS_TEST_ASSERT_MSG_EQ (db->SpinPrepare (&stmt, "SELECT COUNT(*), SUM(y) FROM Samples "
+                                          "JOIN SamplesContexts ON context = id WHERE name = 'odd'"),
+                         true, "Failed to prepare the query");
+  NS_TEST_ASSERT_MSG_EQ (SQLiteOutput::SpinStep (stmt), SQLITE_ROW, "No result");
+  NS_TEST_EXPECT_MSG_EQ (db->RetrieveColumn<uint32_t> (stmt, 0), nValues / 2, "Wrong number of values");
+  NS_TEST_EXPECT_MSG_EQ (db->RetrieveColumn<double> (stmt, 1), 1.0 * nValues * nValues / 2, "Wrong values");
+  SQLiteOutput::SpinFinalize (stmt);
+
+  NS_TEST_ASSERT_MSG_EQ (db->SpinPrepare (&stmt, "SELECT COUNT(*), SUM(x), COUNT(y) FROM Samples "
+                                          "JOIN SamplesContexts ON context = id WHERE name = 'single'"),
+                         true, "Failed to prepare the query");
+  NS_TEST_ASSERT_MSG_EQ (SQLiteOutput::SpinStep (stmt), SQLITE_ROW, "No result");
+  NS_TEST_EXPECT_MSG_EQ (db->RetrieveColumn<uint32_t> (stmt, 0), 1, "The values are stored only when enabled");
+  NS_TEST_EXPECT_MSG_EQ (db->RetrieveColumn<double> (stmt, 1), 42, "Wrong 1D value");
+  NS_TEST_EXPECT_MSG_EQ (db->RetrieveColumn<uint32_t> (stmt, 2), 0, "1D values have no second value");
+  SQLiteOutput::SpinFinalize (stmt);
+  db = 0;
+
+  std::remove (filename.c_str ());
+}
+
+/**
+ * \ingroup stats-test
+ * \ingroup tests
+ *
+ * \brief Check that a SqliteAggregator appends its values to an existing
+ * database without changing the contexts of the values already stored.
+ */
+class SqliteAggregatorReopenTestCase : public ns3::TestCase
+{
+public:
+  SqliteAggregatorReopenTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Count the values of a context, and sum their first value
+   * \param db the database
+   * \param context the context
+   * \param [out] sum the sum of the first values
+   * \return the number of values
+   */
+  uint32_t CountValues (Ptr<SQLiteOutput> db, const std::string &context, double *sum);
+};
+
+SqliteAggregatorReopenTestCase::SqliteAggregatorReopenTestCase ()
+  : ns3::TestCase ("Check that a SqliteAggregator appends to an existing database")
+{
+}
+
+uint32_t
+SqliteAggregatorReopenTestCase::CountValues (Ptr<SQLiteOutput> db, const std::string &context, double *sum)
+{
+  sqlite3_stmt *stmt;
+  NS_TEST_EXPECT_MSG_EQ (db->SpinPrepare (&stmt, "SELECT COUNT(*), TOTAL(x) FROM Samples "
+                                          "JOIN SamplesContexts ON context = id WHERE name = ?"),
+                         true, "Failed to prepare the query");
+  db->Bind (stmt, 1, context);
+  NS_TEST_EXPECT_MSG_EQ (SQLiteOutput::SpinStep (stmt), SQLITE_ROW, "No result");
+  uint32_t count = db->RetrieveColumn<uint32_t> (stmt, 0);
+  *sum = db->RetrieveColumn<double> (stmt, 1);
+  SQLiteOutput::SpinFinalize (stmt);
+  return count;
+}
+
+void
+SqliteAggregatorReopenTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("sqlite-aggregator-reopen.db");
+  std::remove (filename.c_str ());
+
+  {
+    Ptr<SqliteAggregator> aggregator = CreateObject<SqliteAggregator> (filename, "Samples");
+    aggregator->Enable ();
+    aggregator->Write1d ("first", 1);
+    aggregator->Write1d ("second", 2);
+  }
+  {
+    // the new contexts of the second run must not take the ids of the
+    // contexts of the first one
+    Ptr<SqliteAggregator> aggregator = CreateObject<SqliteAggregator> (filename, "Samples");
+    aggregator->Enable ();
+    aggregator->Write1d ("third", 30);
+    aggregator->Write1d ("second", 20);
+  }
+
+  Ptr<SQLiteOutput> db = Create<SQLiteOutput> (filename, "ns-3-sqlite-aggregator-test-sem");
+  double sum;
+  NS_TEST_EXPECT_MSG_EQ (CountValues (db, "first", &sum), 1, "Wrong number of values of the first context");
+  NS_TEST_EXPECT_MSG_EQ (sum, 1, "Wrong values of the first context");
+  NS_TEST_EXPECT_MSG_EQ (CountValues (db, "second", &sum), 2, "Wrong number of values of the second context");
+  NS_TEST_EXPECT_MSG_EQ (sum, 22, "Wrong values of the second context");
+  NS_TEST_EXPECT_MSG_EQ (CountValues (db, "third", &sum), 1, "Wrong number of values of the third context");
+  NS_TEST_EXPECT_MSG_EQ (sum, 30, "Wrong values of the third context");
+
+  sqlite3_stmt *stmt;
+  NS_TEST_ASSERT_MSG_EQ (db->SpinPrepare (&stmt, "SELECT COUNT(*) FROM SamplesContexts"),
+                         true, "Failed to prepare the query");
+  NS_TEST_ASSERT_MSG_EQ (SQLiteOutput::SpinStep (stmt), SQLITE_ROW, "No result");
+  NS_TEST_EXPECT_MSG_EQ (db->RetrieveColumn<uint32_t> (stmt, 0), 3, "A context is stored twice");
+  SQLiteOutput::SpinFinalize (stmt);
+  db = 0;
+
+  std::remove (filename.c_str ());
+}
+
+/**
+ * \ingroup stats-test
+ * \ingroup tests
+ *
+ * \brief SqliteAggregator TestSuite
+ */
+class SqliteAggregatorTestSuite : public TestSuite
+{
+public:
+  SqliteAggregatorTestSuite ();
+};
+
+SqliteAggregatorTestSuite::SqliteAggregatorTestSuite ()
+  : TestSuite ("sqlite-aggregator", UNIT)
+{
+  AddTestCase (new SqliteAggregatorTestCase, TestCase::QUICK);
+  AddTestCase (new SqliteAggregatorReopenTestCase, TestCase::QUICK);
+}
+
+static SqliteAggregatorTestSuite g_sqliteAggregatorTestSuite; //!< Static variable for test initialization
@@ -30,8 +30,7 @@
 
 #include "ns3/queue-disc.h"
 #include "ns3/object-factory.h"
-#include <list>
-#include <map>
+#include "fq-flow-table.h"
 
 namespace ns3 {
 
@@ -102,11 +101,22 @@ public:
    * \return the index of this flow
    */
   uint32_t GetIndex (void) const;
+  /**
+   * \brief Set the flow following this one in the list of new or old flows
+   * \param next the next flow
+   */
+  void SetNext (Ptr<FqCobaltFlow> next);
+  /**
+   * \brief Get the flow following this one in the list of new or old flows
+   * \return the next flow
+   */
+  Ptr<FqCobaltFlow> GetNext (void) const;
 
 private:
   int32_t m_deficit;    //!< the deficit for this flow
   FlowStatus m_status;  //!< the status of this flow
   uint32_t m_index;     //!< the index for this flow
+  Ptr<FqCobaltFlow> m_next;  //!< the next flow in the list of new or old flows
 };
 
 
@@ -161,14 +171,6 @@ private:
    */
   uint32_t FqCobaltDrop (void);
 
-  /**
-   * Compute the index of the queue for the flow having the given flowHash,
-   * according to the set associative hash approach.
-   *
-   * \param flowHash the hash of the flow 5-tuple
-   * \return the index of the queue for the given flow
-   */
-  uint32_t SetAssociativeHash (uint32_t flowHash);
 
   std::string m_interval;    //!< CoDel interval attribute
   std::string m_target;      //!< CoDel target attribute
@@ -186,11 +188,10 @@ private:
   double m_Pdrop;            //!< Drop Probability
   Time m_blueThreshold;      //!< Threshold to enable blue enhancement
 
-  std::list<Ptr<FqCobaltFlow> > m_newFlows;    //!< The list of new flows
-  std::list<Ptr<FqCobaltFlow> > m_oldFlows;    //!< The list of old flows
+  FqFlowList<FqCobaltFlow> m_newFlows;    //!< The list of new flows
+  FqFlowList<FqCobaltFlow> m_oldFlows;    //!< The list of old flows
 
-  std::map<uint32_t, uint32_t> m_flowsIndices;    //!< Map with the index of class for each flow
-  std::map<uint32_t, uint32_t> m_tags;            //!< Tags used by set associative hash
+  FqFlowTable<FqCobaltFlow> m_flowTable;  //!< The flow queue for each index
 
   ObjectFactory m_flowFactory;         //!< Factory to create a new flow
   ObjectFactory m_queueDiscFactory;    //!< Factory to create a new queue
@@ -24,8 +24,7 @@
 
 #include "ns3/queue-disc.h"
 #include "ns3/object-factory.h"
-#include <list>
-#include <map>
+#include "fq-flow-table.h"
 
 namespace ns3 {
 
@@ -95,11 +94,22 @@ public:
    * \return the index of this flow
    */
   uint32_t GetIndex (void) const;
+  /**
+   * \brief Set the flow following this one in the list of new or old flows
+   * \param next the next flow
+   */
+  void SetNext (Ptr<FqCoDelFlow> next);
+  /**
+   * \brief Get the flow following this one in the list of new or old flows
+   * \return the next flow
+   */
+  Ptr<FqCoDelFlow> GetNext (void) const;
 
 private:
   int32_t m_deficit;    //!< the deficit for this flow
   FlowStatus m_status;  //!< the status of this flow
   uint32_t m_index;     //!< the index for this flow
+  Ptr<FqCoDelFlow> m_next;  //!< the next flow in the list of new or old flows
 };
 
 
@@ -154,14 +164,6 @@ private:
   uint32_t FqCoDelDrop (void);
 
   bool m_useEcn;             //!< True if ECN is used (packets are marked instead of being dropped)
-  /**
-   * Compute the index of the queue for the flow having the given flowHash,
-   * according to the set associative hash approach.
-   *
-   * \param flowHash the hash of the flow 5-tuple
-   * \return the index of the queue for the given flow
-   */
-  uint32_t SetAssociativeHash (uint32_t flowHash);
 
   std::string m_interval;    //!< CoDel interval attribute
   std::string m_target;      //!< CoDel target attribute
@@ -174,11 +176,10 @@ private:
   bool m_enableSetAssociativeHash; //!< whether to enable set associative hash
   bool m_useL4s;             //!< True if L4S is used (ECT1 packets are marked at CE threshold)
 
-  std::list<Ptr<FqCoDelFlow> > m_newFlows;    //!< The list of new flows
-  std::list<Ptr<FqCoDelFlow> > m_oldFlows;    //!< The list of old flows
+  FqFlowList<FqCoDelFlow> m_newFlows;    //!< The list of new flows
+  FqFlowList<FqCoDelFlow> m_oldFlows;    //!< The list of old flows
 
-  std::map<uint32_t, uint32_t> m_flowsIndices;    //!< Map with the index of class for each flow
-  std::map<uint32_t, uint32_t> m_tags;            //!< Tags used by set associative hash
+  FqFlowTable<FqCoDelFlow> m_flowTable;  //!< The flow queue for each index
 
   ObjectFactory m_flowFactory;         //!< Factory to create a new flow
   ObjectFactory m_queueDiscFactory;    //!< Factory to create a new queue
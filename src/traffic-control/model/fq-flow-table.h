@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FQ_FLOW_TABLE_H
+#define FQ_FLOW_TABLE_H
+
+#include "ns3/ptr.h"
+#include "ns3/assert.h"
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief Intrusive FIFO list of flow queues used by the DRR scheduler of
+ * the FqCoDel, FqCobalt and FqPie queue discs
+ *
+ * The link to the next flow is stored in the flow itself, hence moving a
+ * flow between the list of new flows and the list of old flows (which
+ * happens at every round of the scheduler) does not allocate memory.
+ * A flow can belong to a single list at a time. The Flow class must
+ * provide the SetNext and GetNext methods.
+ */
+template <typename Flow>
+class FqFlowList
+{
+public:
+  FqFlowList ()
+    : m_head (0),
+      m_tail (0)
+  {
+  }
+
+  /**
+   * \return true if the list contains no flows
+   */
+  bool IsEmpty (void) const
+  {
+    return m_head == 0;
+  }
+
+  /**
+   * \return the flow at the head of the list
+   */
+  Ptr<Flow> Front (void) const
+  {
+    NS_ASSERT (m_head != 0);
+    return m_head;
+  }
+
+  /**
+   * \brief Append a flow to the tail of the list
+   * \param flow the flow, which must not belong to any list
+   */
+  void PushBack (Ptr<Flow> flow)
+  {
+    NS_ASSERT (flow->GetNext () == 0);
+    if (m_tail == 0)
+      {
+        m_head = flow;
+      }
+    else
+      {
+        m_tail->SetNext (flow);
+      }
+    m_tail = flow;
+  }
+
+  /**
+   * \brief Remove the flow at the head of the list
+   */
+  void PopFront (void)
+  {
+    NS_ASSERT (m_head != 0);
+    Ptr<Flow> next = m_head->GetNext ();
+    m_head->SetNext (0);
+    m_head = next;
+    if (m_head == 0)
+      {
+        m_tail = 0;
+      }
+  }
+
+  /**
+   * \brief Move the flow at the head of the list to its tail
+   */
+  void Rotate (void)
+  {
+    NS_ASSERT (m_head != 0);
+    if (m_head != m_tail)
+      {
+        Ptr<Flow> flow = m_head;
+        PopFront ();
+        PushBack (flow);
+      }
+  }
+
+private:
+  Ptr<Flow> m_head;  //!< first flow of the list
+  Ptr<Flow> m_tail;  //!< last flow of the list
+};
+
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief Flat table mapping flow queue indices to flow queues
+ *
+ * The table has one slot per flow queue, so finding the flow queue of a
+ * packet is a vector access instead of a search in a map. The table also
+ * implements the set associative hash, which stores the tag of the flow
+ * owning each slot. The Flow class must provide the GetStatus method and
+ * the INACTIVE status.
+ */
+template <typename Flow>
+class FqFlowTable
+{
+public:
+  FqFlowTable ()
+    : m_setWays (1)
+  {
+  }
+
+  /**
+   * \brief Allocate the table
+   * \param flows the number of flow queues
+   * \param setWays the size of a set of queues (used by set associative hash)
+   */
+  void Resize (uint32_t flows, uint32_t setWays)
+  {
+    m_flows.assign (flows, 0);
+    m_tags.assign (flows, 0);
+    m_tagged.assign (flows, false);
+    m_setWays = setWays;
+  }
+
+  /**
+   * \param index the index of the flow queue
+   * \return the flow queue with the given index, or 0 if not created yet
+   */
+  Ptr<Flow> Get (uint32_t index) const
+  {
+    NS_ASSERT (index < m_flows.size ());
+    return m_flows[index];
+  }
+
+  /**
+   * \brief Store the flow queue with the given index
+   * \param index the index of the flow queue
+   * \param flow the flow queue
+   */
+  void Set (uint32_t index, Ptr<Flow> flow)
+  {
+    NS_ASSERT (index < m_flows.size ());
+    m_flows[index] = flow;
+  }
+
+  /**
+   * Compute the index of the queue for the flow having the given flowHash,
+   * according to the set associative hash approach.
+   *
+   * \param flowHash the hash of the flow 5-tuple
+   * \return the index of the queue for the given flow
+   */
+  uint32_t SetAssociativeHash (uint32_t flowHash)
+  {
+    uint32_t h = (flowHash % m_flows.size ());
+    uint32_t innerHash = h % m_setWays;
+    uint32_t outerHash = h - innerHash;
+
+    for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
+      {
+        if (m_flows[i] == 0
+            || (m_tagged[i] && m_tags[i] == flowHash)
+            || m_flows[i]->GetStatus () == Flow::INACTIVE)
+          {
+            // this queue has not been created yet or is associated with this flow
+            // or is inactive, hence we can use it
+            m_tags[i] = flowHash;
+            m_tagged[i] = true;
+            return i;
+          }
+      }
+
+    // all the queues of the set are used. Use the first queue of the set
+    m_tags[outerHash] = flowHash;
+    m_tagged[outerHash] = true;
+    return outerHash;
+  }
+
+private:
+  std::vector<Ptr<Flow> > m_flows;  //!< flow queue of each slot (0 if not created)
+  std::vector<uint32_t> m_tags;     //!< tags used by set associative hash
+  std::vector<bool> m_tagged;       //!< whether a slot has a tag
+  uint32_t m_setWays;               //!< size of a set of queues
+};
+
+} // namespace ns3
+
+#endif /* FQ_FLOW_TABLE_H */
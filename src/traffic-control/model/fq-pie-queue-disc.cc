@@ -109,6 +109,18 @@ FqPieFlow::GetIndex (void) const
   return m_index;
 }
 
+void
+FqPieFlow::SetNext (Ptr<FqPieFlow> next)
+{
+  m_next = next;
+}
+
+Ptr<FqPieFlow>
+FqPieFlow::GetNext (void) const
+{
+  return m_next;
+}
+
 
 NS_OBJECT_ENSURE_REGISTERED (FqPieQueueDisc);
 
@@ -253,35 +265,6 @@ FqPieQueueDisc::GetQuantum (void) const
   return m_quantum;
 }
 
-uint32_t
-FqPieQueueDisc::SetAssociativeHash (uint32_t flowHash)
-{
-  NS_LOG_FUNCTION (this << flowHash);
-
-  uint32_t h = (flowHash % m_flows);
-  uint32_t innerHash = h % m_setWays;
-  uint32_t outerHash = h - innerHash;
-
-  for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
-    {
-      auto it = m_flowsIndices.find (i);
-
-      if (it == m_flowsIndices.end ()
-          || (m_tags.find (i) != m_tags.end () && m_tags[i] == flowHash)
-          || StaticCast<FqPieFlow> (GetQueueDiscClass (it->second))->GetStatus () == FqPieFlow::INACTIVE)
-        {
-          // this queue has not been created yet or is associated with this flow
-          // or is inactive, hence we can use it
-          m_tags[i] = flowHash;
-          return i;
-        }
-    }
-
-  // all the queues of the set are used. Use the first queue of the set
-  m_tags[outerHash] = flowHash;
-  return outerHash;
-}
-
 bool
 FqPieQueueDisc::DoEnqueue (Ptr<QueueDiscItem> item)
 {
@@ -311,15 +294,15 @@ FqPieQueueDisc::DoEnqueue (Ptr<QueueDiscItem> item)
 
   if (m_enableSetAssociativeHash)
     {
-      h = SetAssociativeHash (flowHash);
+      h = m_flowTable.SetAssociativeHash (flowHash);
     }
   else
     {
       h = flowHash % m_flows;
     }
 
-  Ptr<FqPieFlow> flow;
-  if (m_flowsIndices.find (h) == m_flowsIndices.end ())
+  Ptr<FqPieFlow> flow = m_flowTable.Get (h);
+  if (flow == 0)
     {
       NS_LOG_DEBUG ("Creating a new flow queue with index " << h);
       flow = m_flowFactory.Create<FqPieFlow> ();
@@ -337,23 +320,19 @@ FqPieQueueDisc::DoEnqueue (Ptr<QueueDiscItem> item)
       flow->SetIndex (h);
       AddQueueDiscClass (flow);
 
-      m_flowsIndices[h] = GetNQueueDiscClasses () - 1;
-    }
-  else
-    {
-      flow = StaticCast<FqPieFlow> (GetQueueDiscClass (m_flowsIndices[h]));
+      m_flowTable.Set (h, flow);
     }
 
   if (flow->GetStatus () == FqPieFlow::INACTIVE)
     {
       flow->SetStatus (FqPieFlow::NEW_FLOW);
       flow->SetDeficit (m_quantum);
-      m_newFlows.push_back (flow);
+      m_newFlows.PushBack (flow);
     }
 
   flow->GetQueueDisc ()->Enqueue (item);
 
-  NS_LOG_DEBUG ("Packet enqueued into flow " << h << "; flow index " << m_flowsIndices[h]);
+  NS_LOG_DEBUG ("Packet enqueued into flow " << h);
 
   if (GetCurrentSize () > GetMaxSize ())
     {
@@ -376,17 +355,17 @@ FqPieQueueDisc::DoDequeue (void)
     {
       bool found = false;
 
-      while (!found && !m_newFlows.empty ())
+      while (!found && !m_newFlows.IsEmpty ())
         {
-          flow = m_newFlows.front ();
+          flow = m_newFlows.Front ();
 
           if (flow->GetDeficit () <= 0)
             {
               NS_LOG_DEBUG ("Increase deficit for new flow index " << flow->GetIndex ());
               flow->IncreaseDeficit (m_quantum);
               flow->SetStatus (FqPieFlow::OLD_FLOW);
-              m_oldFlows.push_back (flow);
-              m_newFlows.pop_front ();
+              m_newFlows.PopFront ();
+              m_oldFlows.PushBack (flow);
             }
           else
             {
@@ -395,16 +374,15 @@ FqPieQueueDisc::DoDequeue (void)
             }
         }
 
-      while (!found && !m_oldFlows.empty ())
+      while (!found && !m_oldFlows.IsEmpty ())
         {
-          flow = m_oldFlows.front ();
+          flow = m_oldFlows.Front ();
 
           if (flow->GetDeficit () <= 0)
             {
               NS_LOG_DEBUG ("Increase deficit for old flow index " << flow->GetIndex ());
               flow->IncreaseDeficit (m_quantum);
-              m_oldFlows.push_back (flow);
-              m_oldFlows.pop_front ();
+              m_oldFlows.Rotate ();
             }
           else
             {
@@ -424,16 +402,16 @@ FqPieQueueDisc::DoDequeue (void)
       if (!item)
         {
           NS_LOG_DEBUG ("Could not get a packet from the selected flow queue");
-          if (!m_newFlows.empty ())
+          if (!m_newFlows.IsEmpty ())
             {
               flow->SetStatus (FqPieFlow::OLD_FLOW);
-              m_oldFlows.push_back (flow);
-              m_newFlows.pop_front ();
+              m_newFlows.PopFront ();
+              m_oldFlows.PushBack (flow);
             }
           else
             {
               flow->SetStatus (FqPieFlow::INACTIVE);
-              m_oldFlows.pop_front ();
+              m_oldFlows.PopFront ();
             }
         }
       else
@@ -509,6 +487,7 @@ FqPieQueueDisc::InitializeParams (void)
   NS_LOG_FUNCTION (this);
 
   m_flowFactory.SetTypeId ("ns3::FqPieFlow");
+  m_flowTable.Resize (m_flows, m_setWays);
 
   m_queueDiscFactory.SetTypeId ("ns3::PieQueueDisc");
   m_queueDiscFactory.Set ("MaxSize", QueueSizeValue (GetMaxSize ()));
@@ -29,8 +29,7 @@
 
 #include "ns3/queue-disc.h"
 #include "ns3/object-factory.h"
-#include <list>
-#include <map>
+#include "fq-flow-table.h"
 
 namespace ns3 {
 
@@ -101,11 +100,22 @@ public:
    * \return the index of this flow
    */
   uint32_t GetIndex (void) const;
+  /**
+   * \brief Set the flow following this one in the list of new or old flows
+   * \param next the next flow
+   */
+  void SetNext (Ptr<FqPieFlow> next);
+  /**
+   * \brief Get the flow following this one in the list of new or old flows
+   * \return the next flow
+   */
+  Ptr<FqPieFlow> GetNext (void) const;
 
 private:
   int32_t m_deficit;    //!< the deficit for this flow
   FlowStatus m_status;  //!< the status of this flow
   uint32_t m_index;     //!< the index for this flow
+  Ptr<FqPieFlow> m_next;  //!< the next flow in the list of new or old flows
 };
 
 
@@ -160,14 +170,6 @@ private:
    */
   uint32_t FqPieDrop (void);
 
-  /**
-   * Compute the index of the queue for the flow having the given flowHash,
-   * according to the set associative hash approach.
-   *
-   * \param flowHash the hash of the flow 5-tuple
-   * \return the index of the queue for the given flow
-   */
-  uint32_t SetAssociativeHash (uint32_t flowHash);
 
   // PIE queue disc parameter
   bool m_useEcn;             //!< True if ECN is used (packets are marked instead of being dropped)
@@ -194,11 +196,10 @@ private:
   uint32_t m_perturbation;   //!< hash perturbation value
   bool m_enableSetAssociativeHash; //!< whether to enable set associative hash
 
-  std::list<Ptr<FqPieFlow> > m_newFlows;    //!< The list of new flows
-  std::list<Ptr<FqPieFlow> > m_oldFlows;    //!< The list of old flows
+  FqFlowList<FqPieFlow> m_newFlows;    //!< The list of new flows
+  FqFlowList<FqPieFlow> m_oldFlows;    //!< The list of old flows
 
-  std::map<uint32_t, uint32_t> m_flowsIndices;    //!< Map with the index of class for each flow
-  std::map<uint32_t, uint32_t> m_tags;            //!< Tags used by set associative hash
+  FqFlowTable<FqPieFlow> m_flowTable;  //!< The flow queue for each index
 
   ObjectFactory m_flowFactory;         //!< Factory to create a new flow
   ObjectFactory m_queueDiscFactory;    //!< Factory to create a new queue
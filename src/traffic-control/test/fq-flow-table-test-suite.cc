@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/fq-codel-queue-disc.h"
+#include "ns3/fq-flow-table.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Test the intrusive list of flows used by the DRR scheduler
+ */
+class FqFlowListTestCase : public TestCase
+{
+public:
+  FqFlowListTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+FqFlowListTestCase::FqFlowListTestCase ()
+  : TestCase ("Check the intrusive list of flow queues")
+{
+}
+
+void
+FqFlowListTestCase::DoRun (void)
+{
+  FqFlowList<FqCoDelFlow> newFlows;
+  FqFlowList<FqCoDelFlow> oldFlows;
+  Ptr<FqCoDelFlow> a = CreateObject<FqCoDelFlow> ();
+  Ptr<FqCoDelFlow> b = CreateObject<FqCoDelFlow> ();
+  Ptr<FqCoDelFlow> c = CreateObject<FqCoDelFlow> ();
+
+  NS_TEST_EXPECT_MSG_EQ (newFlows.IsEmpty (), true, "a new list is empty");
+  newFlows.PushBack (a);
+  newFlows.PushBack (b);
+  newFlows.PushBack (c);
+  NS_TEST_EXPECT_MSG_EQ (newFlows.Front (), a, "flows are kept in FIFO order");
+
+  newFlows.Rotate ();
+  NS_TEST_EXPECT_MSG_EQ (newFlows.Front (), b, "rotation moves the head to the tail");
+
+  // move the head of the new flows to the old flows
+  Ptr<FqCoDelFlow> flow = newFlows.Front ();
+  newFlows.PopFront ();
+  oldFlows.PushBack (flow);
+  NS_TEST_EXPECT_MSG_EQ (newFlows.Front (), c, "next new flow");
+  NS_TEST_EXPECT_MSG_EQ (oldFlows.Front (), b, "moved flow is in the old flows");
+  NS_TEST_EXPECT_MSG_EQ (b->GetNext (), 0, "moved flow is unlinked from the new flows");
+
+  oldFlows.Rotate ();
+  NS_TEST_EXPECT_MSG_EQ (oldFlows.Front (), b, "rotating a single flow list is a no-op");
+
+  newFlows.PopFront ();
+  NS_TEST_EXPECT_MSG_EQ (newFlows.Front (), a, "rotated flow is back at the head");
+  newFlows.PopFront ();
+  NS_TEST_EXPECT_MSG_EQ (newFlows.IsEmpty (), true, "all the flows have been removed");
+  newFlows.PushBack (c);
+  NS_TEST_EXPECT_MSG_EQ (newFlows.Front (), c, "an emptied list can be reused");
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Test the set associative hash of the flow table
+ */
+class FqFlowTableTestCase : public TestCase
+{
+public:
+  FqFlowTableTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+FqFlowTableTestCase::FqFlowTableTestCase ()
+  : TestCase ("Check the set associative hash of the flow table")
+{
+}
+
+void
+FqFlowTableTestCase::DoRun (void)
+{
+  FqFlowTable<FqCoDelFlow> table;
+  table.Resize (16, 8);
+
+  // the slots of a set are taken in order while flows are not created
+  NS_TEST_EXPECT_MSG_EQ (table.SetAssociativeHash (3), 0, "first slot of the set");
+  Ptr<FqCoDelFlow> first = CreateObject<FqCoDelFlow> ();
+  first->SetStatus (FqCoDelFlow::NEW_FLOW);
+  table.Set (0, first);
+  NS_TEST_EXPECT_MSG_EQ (table.SetAssociativeHash (3), 0, "same flow gets the same slot");
+  NS_TEST_EXPECT_MSG_EQ (table.SetAssociativeHash (19), 1, "another flow gets the next slot");
+  NS_TEST_EXPECT_MSG_EQ (table.SetAssociativeHash (11), 8, "flows of the second set");
+  NS_TEST_EXPECT_MSG_EQ (table.Get (0), first, "created flow is stored");
+  NS_TEST_EXPECT_MSG_EQ (table.Get (1), 0, "flow not created yet");
+
+  // fill the first set with active flows
+  for (uint32_t i = 1; i < 8; i++)
+    {
+      Ptr<FqCoDelFlow> flow = CreateObject<FqCoDelFlow> ();
+      flow->SetStatus (FqCoDelFlow::OLD_FLOW);
+      table.Set (i, flow);
+    }
+  NS_TEST_EXPECT_MSG_EQ (table.SetAssociativeHash (35), 0, "full set uses its first slot");
+
+  // an inactive flow frees its slot
+  table.Get (5)->SetStatus (FqCoDelFlow::INACTIVE);
+  NS_TEST_EXPECT_MSG_EQ (table.SetAssociativeHash (51), 5, "inactive slot is reused");
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Fq flow table TestSuite
+ */
+static class FqFlowTableTestSuite : public TestSuite
+{
+public:
+  FqFlowTableTestSuite ()
+    : TestSuite ("fq-flow-table", UNIT)
+  {
+    AddTestCase (new FqFlowListTestCase (), TestCase::QUICK);
+    AddTestCase (new FqFlowTableTestCase (), TestCase::QUICK);
+  }
+} g_fqFlowTableTestSuite; ///< the test suite
@@ -230,6 +230,18 @@ VisualSimulatorImpl::GetEventCount (void) const
   return m_simulator->GetEventCount ();
 }
 
+uint32_t
+VisualSimulatorImpl::GetPendingEventCount (void) const
+{
+  return m_simulator->GetPendingEventCount ();
+}
+
+uint32_t
+VisualSimulatorImpl::GetCancelledEventCount (void) const
+{
+  return m_simulator->GetCancelledEventCount ();
+}
+
 void
 VisualSimulatorImpl::RunRealSimulator (void)
 {
@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/csma-module.h"
+
+using namespace ns3;
+
+/**
+ * \file
+ * Benchmark the ARP cache on a large broadcast LAN.
+ *
+ * Two phases are timed:
+ *  - a micro benchmark doing Lookup and LookupInverse on a cache
+ *    populated with \c hosts entries;
+ *  - a full simulation where \c hosts nodes share one CsmaChannel and
+ *    each node sends \c flows UDP packets to random peers, so every
+ *    packet goes through ARP resolution on a very large segment.
+ */
+
+/// Time a number of lookups on a standalone, populated cache.
+static void
+BenchCache (uint32_t hosts, uint32_t iterations)
+{
+  Ptr<ArpCache> cache = CreateObject<ArpCache> ();
+  std::vector<Ipv4Address> ips;
+  std::vector<Address> macs;
+  for (uint32_t i = 0; i < hosts; ++i)
+    {
+      Ipv4Address ip (0x0a000000 + i + 1);
+      Mac48Address mac = Mac48Address::Allocate ();
+      ArpCache::Entry *entry = cache->Add (ip);
+      entry->SetMacAddress (mac);
+      entry->MarkPermanent ();
+      ips.push_back (ip);
+      macs.push_back (mac);
+    }
+
+  SystemWallClockMs clock;
+  uint32_t found = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < iterations; ++i)
+    {
+      if (cache->Lookup (ips[i % hosts]) != 0)
+        {
+          found++;
+        }
+    }
+  int64_t lookupMs = clock.End ();
+
+  clock.Start ();
+  for (uint32_t i = 0; i < iterations; ++i)
+    {
+      found += cache->LookupInverse (macs[i % hosts]).size ();
+    }
+  int64_t inverseMs = clock.End ();
+
+  std::cout << "cache:  hosts " << hosts
+            << ", " << iterations << " lookups " << lookupMs << " ms"
+            << ", " << iterations << " inverse lookups " << inverseMs << " ms"
+            << " (" << found << " hits)" << std::endl;
+  cache->Dispose ();
+}
+
+/// Send one packet from a socket to a random peer of the LAN.
+static void
+SendRandom (Ptr<Socket> socket, Ptr<UniformRandomVariable> peer,
+            Ipv4InterfaceContainer *interfaces, uint32_t size)
+{
+  uint32_t index = peer->GetInteger (0, interfaces->GetN () - 1);
+  socket->SendTo (Create<Packet> (size), 0,
+                  InetSocketAddress (interfaces->GetAddress (index), 9));
+}
+
+/// Run a LAN scenario where every host resolves a few random peers.
+static void
+BenchLan (uint32_t hosts, uint32_t flows, uint32_t size)
+{
+  NodeContainer nodes;
+  nodes.Create (hosts);
+
+  CsmaHelper csma;
+  csma.SetChannelAttribute ("DataRate", StringValue ("10Gbps"));
+  csma.SetChannelAttribute ("Delay", TimeValue (MicroSeconds (1)));
+  NetDeviceContainer devices = csma.Install (nodes);
+
+  InternetStackHelper stack;
+  stack.Install (nodes);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.0.0.0", "255.0.0.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+
+  Ptr<UniformRandomVariable> peer = CreateObject<UniformRandomVariable> ();
+  Ptr<UniformRandomVariable> start = CreateObject<UniformRandomVariable> ();
+  for (uint32_t i = 0; i < hosts; ++i)
+    {
+      Ptr<Socket> sink = Socket::CreateSocket (nodes.Get (i), UdpSocketFactory::GetTypeId ());
+      sink->Bind (InetSocketAddress (Ipv4Address::GetAny (), 9));
+      Ptr<Socket> source = Socket::CreateSocket (nodes.Get (i), UdpSocketFactory::GetTypeId ());
+      source->Bind ();
+      for (uint32_t f = 0; f < flows; ++f)
+        {
+          Simulator::Schedule (Seconds (start->GetValue (0.0, 1.0)),
+                               &SendRandom, source, peer, &interfaces, size);
+        }
+    }
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Stop (Seconds (5));
+  Simulator::Run ();
+  int64_t runMs = clock.End ();
+  std::cout << "lan:    hosts " << hosts << ", flows/host " << flows
+            << ", events " << Simulator::GetEventCount ()
+            << ", run " << runMs << " ms" << std::endl;
+  Simulator::Destroy ();
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t hosts = 1000;
+  uint32_t flows = 2;
+  uint32_t size = 100;
+  uint32_t iterations = 10000000;
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Benchmark the ARP cache on a large broadcast LAN.");
+  cmd.AddValue ("hosts", "number of hosts on the CSMA channel", hosts);
+  cmd.AddValue ("flows", "number of packets each host sends to random peers", flows);
+  cmd.AddValue ("size", "packet size in bytes", size);
+  cmd.AddValue ("iterations", "number of lookups in the cache micro benchmark", iterations);
+  cmd.Parse (argc, argv);
+
+  BenchCache (hosts, iterations);
+  BenchLan (hosts, flows, size);
+  return 0;
+}
@@ -0,0 +1,212 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iostream>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/csma-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/lte-module.h"
+
+using namespace ns3;
+
+/**
+ * \file
+ * Benchmark the user plane of the EPC.
+ *
+ * The eNBs are attached to a PointToPointEpcHelper without the LTE
+ * radio: as in the epc-s1u-downlink and epc-s1u-uplink tests, each cell
+ * is a CSMA segment and the eNB sends and receives the user packets on
+ * a raw socket of its CSMA device.  Every UE exchanges UDP packets with
+ * a remote host in both directions, so each packet goes through the
+ * PGW, the SGW and the eNB applications.
+ *
+ * The scenario is run twice, with the GTP-U packets going through the
+ * UDP sockets and the S1-U and S5 links, then with the direct GTP-U
+ * forwarding between the EPC applications.
+ */
+
+/// Number of user packets received by the UEs and by the remote host
+static uint64_t g_received = 0;
+
+/// Stub of the eNB RRC, which accepts all the bearers.
+class BenchEnbRrc : public EpcEnbS1SapUser
+{
+public:
+  // inherited from EpcEnbS1SapUser
+  virtual void InitialContextSetupRequest (InitialContextSetupRequestParameters params)
+  {
+  }
+  virtual void DataRadioBearerSetupRequest (DataRadioBearerSetupRequestParameters params)
+  {
+  }
+  virtual void PathSwitchRequestAcknowledge (PathSwitchRequestAcknowledgeParameters params)
+  {
+  }
+};
+
+/// Count the packets received on a socket.
+static void
+Receive (Ptr<Socket> socket)
+{
+  while (socket->Recv ())
+    {
+      g_received++;
+    }
+}
+
+/// Send a downlink packet from the remote host to a UE.
+static void
+SendDownlink (Ptr<Socket> socket, Ipv4Address ueAddr, uint32_t size)
+{
+  socket->SendTo (Create<Packet> (size), 0, InetSocketAddress (ueAddr, 9));
+}
+
+/// Send an uplink packet from a UE to the remote host, on the default bearer.
+static void
+SendUplink (Ptr<Socket> socket, Ipv4Address remoteAddr, uint16_t rnti, uint32_t size)
+{
+  Ptr<Packet> p = Create<Packet> (size);
+  EpsBearerTag tag (rnti, 1);
+  p->AddPacketTag (tag);
+  socket->SendTo (p, 0, InetSocketAddress (remoteAddr, 9));
+}
+
+/// Run the scenario and report the forwarding rate.
+static void
+BenchEpc (bool direct, uint32_t enbs, uint32_t ues, uint32_t packets, uint32_t size, Time interval)
+{
+  g_received = 0;
+  Ptr<PointToPointEpcHelper> epcHelper = CreateObject<PointToPointEpcHelper> ();
+  epcHelper->SetAttribute ("GtpuDirectForwarding", BooleanValue (direct));
+  Ptr<Node> pgw = epcHelper->GetPgwNode ();
+
+  NodeContainer remoteHostContainer;
+  remoteHostContainer.Create (1);
+  Ptr<Node> remoteHost = remoteHostContainer.Get (0);
+  InternetStackHelper internet;
+  internet.Install (remoteHostContainer);
+
+  PointToPointHelper p2ph;
+  p2ph.SetDeviceAttribute ("DataRate", DataRateValue (DataRate ("100Gb/s")));
+  NetDeviceContainer internetDevices = p2ph.Install (pgw, remoteHost);
+  Ipv4AddressHelper ipv4h;
+  ipv4h.SetBase ("1.0.0.0", "255.0.0.0");
+  Ipv4InterfaceContainer internetIpIfaces = ipv4h.Assign (internetDevices);
+  Ipv4Address remoteAddr = internetIpIfaces.GetAddress (1);
+
+  Ipv4StaticRoutingHelper ipv4RoutingHelper;
+  Ptr<Ipv4StaticRouting> remoteHostStaticRouting = ipv4RoutingHelper.GetStaticRouting (remoteHost->GetObject<Ipv4> ());
+  remoteHostStaticRouting->AddNetworkRouteTo (Ipv4Address ("7.0.0.0"), Ipv4Mask ("255.0.0.0"), 1);
+
+  Ptr<Socket> remoteSocket = Socket::CreateSocket (remoteHost, UdpSocketFactory::GetTypeId ());
+  remoteSocket->Bind (InetSocketAddress (Ipv4Address::GetAny (), 9));
+  remoteSocket->SetRecvCallback (MakeCallback (&Receive));
+
+  std::vector<BenchEnbRrc> rrcs (enbs);
+  uint64_t imsi = 0;
+  for (uint32_t e = 0; e < enbs; ++e)
+    {
+      Ptr<Node> enb = CreateObject<Node> ();
+      NodeContainer ueNodes;
+      ueNodes.Create (ues);
+      NodeContainer cell;
+      cell.Add (ueNodes);
+      cell.Add (enb);
+      CsmaHelper csmaCell;
+      csmaCell.SetChannelAttribute ("DataRate", DataRateValue (DataRate ("100Gb/s")));
+      NetDeviceContainer cellDevices = csmaCell.Install (cell);
+
+      epcHelper->AddEnb (enb, cellDevices.Get (ues), e + 1);
+      Ptr<EpcEnbApplication> enbApp = enb->GetApplication (0)->GetObject<EpcEnbApplication> ();
+      enbApp->SetS1SapUser (&rrcs[e]);
+
+      internet.Install (ueNodes);
+      for (uint32_t u = 0; u < ues; ++u)
+        {
+          Ptr<NetDevice> ueDevice = cellDevices.Get (u);
+          Ipv4Address ueAddr = epcHelper->AssignUeIpv4Address (NetDeviceContainer (ueDevice)).GetAddress (0);
+          Ptr<Node> ue = ueNodes.Get (u);
+          Ptr<Ipv4> ueIpv4 = ue->GetObject<Ipv4> ();
+          ueIpv4->SetAttribute ("IpForward", BooleanValue (false));
+
+          // route the uplink to the eNB, which gets the CSMA broadcast packets
+          Ipv4Address gwAddr = epcHelper->GetUeDefaultGatewayAddress ();
+          ipv4RoutingHelper.GetStaticRouting (ueIpv4)->SetDefaultRoute (gwAddr, 1);
+          Ptr<Ipv4L3Protocol> ueIpv4L3Protocol = ue->GetObject<Ipv4L3Protocol> ();
+          Ptr<ArpCache> ueArpCache = ueIpv4L3Protocol->GetInterface (ueIpv4->GetInterfaceForDevice (ueDevice))->GetArpCache ();
+          ArpCache::Entry *arpCacheEntry = ueArpCache->Add (gwAddr);
+          arpCacheEntry->SetMacAddress (Mac48Address::GetBroadcast ());
+          arpCacheEntry->MarkPermanent ();
+
+          Ptr<Socket> ueSocket = Socket::CreateSocket (ue, UdpSocketFactory::GetTypeId ());
+          ueSocket->Bind (InetSocketAddress (Ipv4Address::GetAny (), 9));
+          ueSocket->SetRecvCallback (MakeCallback (&Receive));
+
+          uint16_t rnti = u + 1;
+          epcHelper->AddUe (ueDevice, ++imsi);
+          epcHelper->ActivateEpsBearer (ueDevice, imsi, EpcTft::Default (), EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+          Simulator::Schedule (MilliSeconds (10), &EpcEnbS1SapProvider::InitialUeMessage,
+                               enbApp->GetS1SapProvider (), imsi, rnti);
+
+          for (uint32_t p = 0; p < packets; ++p)
+            {
+              Time t = Seconds (1) + interval * p;
+              Simulator::Schedule (t, &SendDownlink, remoteSocket, ueAddr, size);
+              Simulator::Schedule (t, &SendUplink, ueSocket, remoteAddr, rnti, size);
+            }
+        }
+    }
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Stop (Seconds (2) + interval * packets);
+  Simulator::Run ();
+  int64_t runMs = clock.End ();
+  uint64_t sent = 2ULL * enbs * ues * packets;
+  std::cout << (direct ? "direct: " : "socket: ")
+            << "eNBs " << enbs << ", UEs/eNB " << ues
+            << ", packets " << g_received << "/" << sent
+            << ", events " << Simulator::GetEventCount ()
+            << ", run " << runMs << " ms, "
+            << (runMs > 0 ? g_received * 1000 / runMs : 0) << " packets/s" << std::endl;
+  Simulator::Destroy ();
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t enbs = 10;
+  uint32_t ues = 10;
+  uint32_t packets = 1000;
+  uint32_t size = 100;
+  Time interval = MilliSeconds (1);
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Benchmark the user plane of the EPC, with and without the direct GTP-U forwarding.");
+  cmd.AddValue ("enbs", "number of eNBs", enbs);
+  cmd.AddValue ("ues", "number of UEs per eNB", ues);
+  cmd.AddValue ("packets", "number of packets sent by each UE and to each UE", packets);
+  cmd.AddValue ("size", "packet size in bytes", size);
+  cmd.AddValue ("interval", "interval between the packets of a UE", interval);
+  cmd.Parse (argc, argv);
+
+  BenchEpc (false, enbs, ues, packets, size, interval);
+  BenchEpc (true, enbs, ues, packets, size, interval);
+  return 0;
+}
@@ -0,0 +1,599 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/lte-module.h"
+
+using namespace ns3;
+
+/**
+ * \file
+ * Benchmark the DL scheduling of a FF MAC scheduler.
+ *
+ * The scheduler, of any FfMacScheduler TypeId, is driven directly
+ * through its SAPs, without PHY, RRC or simulator.  The cell has \c ues
+ * UEs with one data bearer each.  Every TTI, the harness:
+ *  - reports the CQIs and the buffer status of the UEs,
+ *  - reports the HARQ feedback of the transmissions of 4 TTIs ago,
+ *    each TB being lost with the probability \c bler,
+ *  - triggers the DL scheduling, and applies the allocations to the
+ *    buffers of the UEs.
+ *
+ * The CQIs and the buffer status are either generated or read from a
+ * trace.  The generated CQIs are reported every \c cqiPeriod TTIs: each
+ * UE has a mean CQI, and the CQI of each RBG varies around it.  The
+ * generated traffic adds \c load bytes per TTI to the buffer of each
+ * UE, or keeps the buffers full when \c load is 0.  A trace file has
+ * one report per line, sorted by TTI:
+ *
+ *     <tti> cqi <rnti> <cqi of RBG 0> <cqi of RBG 1> ...
+ *     <tti> bsr <rnti> <bytes added to the buffer>
+ *
+ * The time spent in the scheduler is reported as TTIs and allocations
+ * per second, and the quality of the allocations as the cell throughput,
+ * the 5th percentile of the UE throughput, and the Jain's fairness index
+ * of the UE throughputs.
+ */
+
+/// The delay of the HARQ feedback, in TTIs
+static const uint32_t HARQ_FEEDBACK_DELAY = 4;
+
+/**
+ * Harness driving a FF MAC scheduler.
+ */
+class FfMacSchedulerBench
+{
+public:
+  /**
+   * Create the scheduler and configure the cell.
+   *
+   * \param scheduler the TypeId of the scheduler
+   * \param ues the number of UEs
+   * \param bandwidth the DL and UL bandwidth, in RBs
+   * \param harq whether HARQ is enabled
+   * \param bitrate the maximum and guaranteed bit rate of the bearers
+   */
+  FfMacSchedulerBench (std::string scheduler, uint16_t ues, uint16_t bandwidth, bool harq, uint64_t bitrate);
+  ~FfMacSchedulerBench ();
+
+  /**
+   * Generate the CQI reports and the traffic.
+   *
+   * \param cqiPeriod the period of the CQI reports, in TTIs
+   * \param load the bytes added per TTI to the buffer of each UE, 0
+   * for full buffers
+   */
+  void Generate (uint32_t cqiPeriod, uint32_t load);
+
+  /**
+   * Read the CQI reports and the traffic from a trace.
+   *
+   * \param filename the name of the trace file
+   */
+  void ReadTrace (std::string filename);
+
+  /**
+   * Schedule the TTIs.
+   *
+   * \param ttis the number of TTIs
+   * \param bler the probability of loss of a TB
+   */
+  void Run (uint32_t ttis, double bler);
+
+  /**
+   * Print the results.
+   *
+   * \param os the output stream
+   */
+  void Report (std::ostream &os) const;
+
+private:
+  /// Sched SAP user forwarding the DL allocations to the harness
+  class SchedSapUser : public FfMacSchedSapUser
+  {
+  public:
+    /**
+     * \param bench the harness
+     */
+    SchedSapUser (FfMacSchedulerBench *bench)
+      : m_bench (bench)
+    {
+    }
+    virtual void SchedDlConfigInd (const struct SchedDlConfigIndParameters& params)
+    {
+      m_bench->DlConfigInd (params);
+    }
+    virtual void SchedUlConfigInd (const struct SchedUlConfigIndParameters& params)
+    {
+    }
+  private:
+    FfMacSchedulerBench *m_bench; //!< the harness
+  };
+
+  /// Csched SAP user ignoring the confirmations
+  class CschedSapUser : public FfMacCschedSapUser
+  {
+  public:
+    virtual void CschedCellConfigCnf (const struct CschedCellConfigCnfParameters& params)
+    {
+    }
+    virtual void CschedUeConfigCnf (const struct CschedUeConfigCnfParameters& params)
+    {
+    }
+    virtual void CschedLcConfigCnf (const struct CschedLcConfigCnfParameters& params)
+    {
+    }
+    virtual void CschedLcReleaseCnf (const struct CschedLcReleaseCnfParameters& params)
+    {
+    }
+    virtual void CschedUeReleaseCnf (const struct CschedUeReleaseCnfParameters& params)
+    {
+    }
+    virtual void CschedUeConfigUpdateInd (const struct CschedUeConfigUpdateIndParameters& params)
+    {
+    }
+    virtual void CschedCellConfigUpdateInd (const struct CschedCellConfigUpdateIndParameters& params)
+    {
+    }
+  };
+
+  /// A CQI report or traffic of a trace
+  struct TraceEntry
+  {
+    uint32_t tti;             //!< the TTI of the entry
+    uint16_t rnti;            //!< the RNTI of the UE
+    bool isCqi;               //!< whether the entry is a CQI report
+    std::vector<uint8_t> cqi; //!< the CQI of each RBG
+    uint32_t bytes;           //!< the bytes added to the buffer
+  };
+
+  /// A transmission waiting for its HARQ feedback
+  struct Transmission
+  {
+    uint32_t tti;          //!< the TTI of the transmission
+    uint16_t rnti;         //!< the RNTI of the UE
+    uint8_t harqProcess;   //!< the HARQ process
+    std::vector<uint16_t> tbBytes; //!< the bytes of each TB
+  };
+
+  /**
+   * Process the DL allocations of a TTI.
+   * \param params the allocations
+   */
+  void DlConfigInd (const struct FfMacSchedSapUser::SchedDlConfigIndParameters& params);
+
+  /**
+   * Report the buffer status of a UE.
+   * \param rnti the RNTI of the UE
+   */
+  void SendBsr (uint16_t rnti);
+
+  Ptr<FfMacScheduler> m_scheduler;        //!< the scheduler
+  Ptr<LteFfrAlgorithm> m_ffr;             //!< the FFR algorithm, which does nothing
+  SchedSapUser m_schedSapUser;            //!< the Sched SAP user
+  CschedSapUser m_cschedSapUser;          //!< the Csched SAP user
+  FfMacSchedSapProvider *m_schedSap;      //!< the Sched SAP provider
+  uint16_t m_ues;                         //!< the number of UEs
+  uint16_t m_rbgs;                        //!< the number of RBGs
+  bool m_harq;                            //!< whether HARQ is enabled
+  std::vector<TraceEntry> m_trace;        //!< the CQI reports and traffic
+  bool m_fullBuffer;                      //!< whether the buffers are always full
+  uint32_t m_tti;                         //!< the current TTI
+  std::vector<uint64_t> m_buffer;         //!< the buffer of each UE, by RNTI
+  std::vector<bool> m_bufferChanged;      //!< whether the buffer of each UE must be reported, by RNTI
+  std::vector<Transmission> m_pending;    //!< the transmissions waiting for feedback
+  std::vector<uint64_t> m_delivered;      //!< the bytes delivered to each UE, by RNTI
+  uint64_t m_allocations;                 //!< the number of DL allocations
+  uint64_t m_retransmissions;             //!< the number of DL retransmissions
+  double m_seconds;                       //!< the time spent in the scheduler
+  uint32_t m_ttis;                        //!< the number of scheduled TTIs
+};
+
+FfMacSchedulerBench::FfMacSchedulerBench (std::string scheduler, uint16_t ues, uint16_t bandwidth, bool harq, uint64_t bitrate)
+  : m_schedSapUser (this),
+    m_ues (ues),
+    m_harq (harq),
+    m_fullBuffer (false),
+    m_tti (0),
+    m_buffer (ues + 1, 0),
+    m_bufferChanged (ues + 1, false),
+    m_delivered (ues + 1, 0),
+    m_allocations (0),
+    m_retransmissions (0),
+    m_seconds (0),
+    m_ttis (0)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (scheduler);
+  factory.Set ("HarqEnabled", BooleanValue (harq));
+  m_scheduler = factory.Create<FfMacScheduler> ();
+  m_ffr = CreateObject<LteFrNoOpAlgorithm> ();
+  m_ffr->SetDlBandwidth (bandwidth);
+  m_ffr->SetUlBandwidth (bandwidth);
+  m_scheduler->SetLteFfrSapProvider (m_ffr->GetLteFfrSapProvider ());
+  m_ffr->SetLteFfrSapUser (m_scheduler->GetLteFfrSapUser ());
+  m_scheduler->SetFfMacSchedSapUser (&m_schedSapUser);
+  m_scheduler->SetFfMacCschedSapUser (&m_cschedSapUser);
+  m_schedSap = m_scheduler->GetFfMacSchedSapProvider ();
+  FfMacCschedSapProvider *cschedSap = m_scheduler->GetFfMacCschedSapProvider ();
+
+  // RBG size of the resource allocation type 0 (see table 7.1.6.1-1 of 36.213)
+  uint16_t rbgSize = bandwidth < 10 ? 1 : bandwidth < 26 ? 2 : bandwidth < 63 ? 3 : 4;
+  m_rbgs = bandwidth / rbgSize;
+
+  FfMacCschedSapProvider::CschedCellConfigReqParameters cellConfig;
+  cellConfig.m_dlBandwidth = bandwidth;
+  cellConfig.m_ulBandwidth = bandwidth;
+  cschedSap->CschedCellConfigReq (cellConfig);
+
+  for (uint16_t rnti = 1; rnti <= ues; rnti++)
+    {
+      FfMacCschedSapProvider::CschedUeConfigReqParameters ueConfig;
+      ueConfig.m_rnti = rnti;
+      ueConfig.m_transmissionMode = 0;
+      ueConfig.m_reconfigureFlag = false;
+      cschedSap->CschedUeConfigReq (ueConfig);
+
+      LogicalChannelConfigListElement_s lc;
+      lc.m_logicalChannelIdentity = 3;
+      lc.m_logicalChannelGroup = 1;
+      lc.m_direction = LogicalChannelConfigListElement_s::DIR_BOTH;
+      lc.m_qosBearerType = LogicalChannelConfigListElement_s::QBT_NON_GBR;
+      lc.m_qci = EpsBearer::NGBR_VIDEO_TCP_DEFAULT;
+      lc.m_eRabMaximulBitrateUl = bitrate;
+      lc.m_eRabMaximulBitrateDl = bitrate;
+      lc.m_eRabGuaranteedBitrateUl = bitrate;
+      lc.m_eRabGuaranteedBitrateDl = bitrate;
+      FfMacCschedSapProvider::CschedLcConfigReqParameters lcConfig;
+      lcConfig.m_rnti = rnti;
+      lcConfig.m_reconfigureFlag = false;
+      lcConfig.m_logicalChannelConfigList.push_back (lc);
+      cschedSap->CschedLcConfigReq (lcConfig);
+    }
+}
+
+FfMacSchedulerBench::~FfMacSchedulerBench ()
+{
+  m_scheduler->Dispose ();
+  m_ffr->Dispose ();
+}
+
+void
+FfMacSchedulerBench::Generate (uint32_t cqiPeriod, uint32_t load)
+{
+  m_trace.clear ();
+  m_fullBuffer = (load == 0);
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  std::vector<double> meanCqi (m_ues + 1);
+  for (uint16_t rnti = 1; rnti <= m_ues; rnti++)
+    {
+      meanCqi[rnti] = rng->GetValue (1, 15);
+    }
+  // the traces are generated for a fixed number of TTIs, then repeated
+  for (uint32_t tti = 0; tti < 1000; tti++)
+    {
+      for (uint16_t rnti = 1; rnti <= m_ues; rnti++)
+        {
+          if (tti % cqiPeriod == 0)
+            {
+              TraceEntry cqi;
+              cqi.tti = tti;
+              cqi.rnti = rnti;
+              cqi.isCqi = true;
+              cqi.bytes = 0;
+              for (uint16_t rbg = 0; rbg < m_rbgs; rbg++)
+                {
+                  double value = meanCqi[rnti] + rng->GetValue (-3, 3);
+                  cqi.cqi.push_back (std::lround (std::min (15.0, std::max (1.0, value))));
+                }
+              m_trace.push_back (cqi);
+            }
+          if (load > 0)
+            {
+              TraceEntry bsr;
+              bsr.tti = tti;
+              bsr.rnti = rnti;
+              bsr.isCqi = false;
+              bsr.bytes = load;
+              m_trace.push_back (bsr);
+            }
+        }
+    }
+}
+
+void
+FfMacSchedulerBench::ReadTrace (std::string filename)
+{
+  std::ifstream is (filename.c_str ());
+  NS_ABORT_MSG_UNLESS (is.is_open (), "Can't open the trace " << filename);
+  m_trace.clear ();
+  m_fullBuffer = false;
+  std::string line;
+  while (std::getline (is, line))
+    {
+      std::istringstream iss (line);
+      TraceEntry entry;
+      std::string type;
+      if (!(iss >> entry.tti >> type >> entry.rnti))
+        {
+          continue;
+        }
+      NS_ABORT_MSG_UNLESS (entry.rnti >= 1 && entry.rnti <= m_ues, "Invalid RNTI in " << line);
+      NS_ABORT_MSG_UNLESS (m_trace.empty () || m_trace.back ().tti <= entry.tti, "The trace is not sorted at " << line);
+      entry.isCqi = (type == "cqi");
+      entry.bytes = 0;
+      if (entry.isCqi)
+        {
+          uint32_t cqi;
+          while (iss >> cqi)
+            {
+              entry.cqi.push_back (cqi);
+            }
+          NS_ABORT_MSG_UNLESS (entry.cqi.size () == m_rbgs, "Expected " << m_rbgs << " CQIs in " << line);
+        }
+      else
+        {
+          NS_ABORT_MSG_UNLESS (type == "bsr" && (iss >> entry.bytes), "Invalid entry " << line);
+        }
+      m_trace.push_back (entry);
+    }
+  NS_ABORT_MSG_IF (m_trace.empty (), "Empty trace " << filename);
+}
+
+void
+FfMacSchedulerBench::SendBsr (uint16_t rnti)
+{
+  FfMacSchedSapProvider::SchedDlRlcBufferReqParameters bsr;
+  bsr.m_rnti = rnti;
+  bsr.m_logicalChannelIdentity = 3;
+  bsr.m_rlcTransmissionQueueSize = std::min<uint64_t> (m_buffer[rnti], 0xffffffff);
+  bsr.m_rlcTransmissionQueueHolDelay = 0;
+  bsr.m_rlcRetransmissionQueueSize = 0;
+  bsr.m_rlcRetransmissionHolDelay = 0;
+  bsr.m_rlcStatusPduSize = 0;
+  m_schedSap->SchedDlRlcBufferReq (bsr);
+}
+
+void
+FfMacSchedulerBench::DlConfigInd (const struct FfMacSchedSapUser::SchedDlConfigIndParameters& params)
+{
+  for (std::vector<BuildDataListElement_s>::const_iterator it = params.m_buildDataList.begin ();
+       it != params.m_buildDataList.end (); ++it)
+    {
+      m_allocations++;
+      Transmission tx;
+      tx.tti = m_tti;
+      tx.rnti = it->m_rnti;
+      tx.harqProcess = it->m_dci.m_harqProcess;
+      bool retransmission = false;
+      for (uint8_t tb = 0; tb < it->m_dci.m_tbsSize.size (); tb++)
+        {
+          retransmission |= (it->m_dci.m_ndi.at (tb) == 0);
+          tx.tbBytes.push_back (it->m_dci.m_tbsSize.at (tb));
+        }
+      if (retransmission)
+        {
+          m_retransmissions++;
+        }
+      else
+        {
+          // the new data leaves the buffer of the UE
+          uint64_t bytes = 0;
+          for (uint32_t tb = 0; tb < it->m_rlcPduList.size (); tb++)
+            {
+              for (uint32_t pdu = 0; pdu < it->m_rlcPduList[tb].size (); pdu++)
+                {
+                  bytes += it->m_rlcPduList[tb][pdu].m_size;
+                }
+            }
+          if (!m_fullBuffer)
+            {
+              m_buffer[tx.rnti] -= std::min (bytes, m_buffer[tx.rnti]);
+              m_bufferChanged[tx.rnti] = true;
+            }
+        }
+      m_pending.push_back (tx);
+    }
+}
+
+void
+FfMacSchedulerBench::Run (uint32_t ttis, double bler)
+{
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  uint32_t period = m_trace.back ().tti + 1;
+  std::vector<TraceEntry>::const_iterator next = m_trace.begin ();
+  std::chrono::steady_clock::duration elapsed (0);
+
+  if (m_fullBuffer)
+    {
+      for (uint16_t rnti = 1; rnti <= m_ues; rnti++)
+        {
+          m_buffer[rnti] = 0xffffffff;
+          SendBsr (rnti);
+        }
+    }
+
+  for (uint32_t i = 0; i < ttis; i++, m_tti++)
+    {
+      uint16_t sfnSf = (((m_tti / 10) & 0x3ff) << 4) | (m_tti % 10);
+
+      // CQI reports and traffic of this TTI
+      FfMacSchedSapProvider::SchedDlCqiInfoReqParameters cqiInfo;
+      cqiInfo.m_sfnSf = sfnSf;
+      if (next == m_trace.end ())
+        {
+          next = m_trace.begin ();
+        }
+      for (; next != m_trace.end () && next->tti == m_tti % period; ++next)
+        {
+          if (next->isCqi)
+            {
+              // the wideband CQI, used by some schedulers, is the mean CQI
+              CqiListElement_s wbCqi;
+              wbCqi.m_rnti = next->rnti;
+              wbCqi.m_cqiType = CqiListElement_s::P10;
+              uint32_t sum = 0;
+              for (uint16_t rbg = 0; rbg < m_rbgs; rbg++)
+                {
+                  sum += next->cqi[rbg];
+                }
+              wbCqi.m_wbCqi.push_back (sum / m_rbgs);
+              cqiInfo.m_cqiList.push_back (wbCqi);
+
+              CqiListElement_s cqi;
+              cqi.m_rnti = next->rnti;
+              cqi.m_cqiType = CqiListElement_s::A30;
+              cqi.m_wbCqi.push_back (sum / m_rbgs);
+              for (uint16_t rbg = 0; rbg < m_rbgs; rbg++)
+                {
+                  HigherLayerSelected_s sb;
+                  sb.m_sbCqi.push_back (next->cqi[rbg]);
+                  cqi.m_sbMeasResult.m_higherLayerSelected.push_back (sb);
+                }
+              cqiInfo.m_cqiList.push_back (cqi);
+            }
+          else
+            {
+              m_buffer[next->rnti] += next->bytes;
+              m_bufferChanged[next->rnti] = true;
+            }
+        }
+
+      // HARQ feedback of the transmissions of HARQ_FEEDBACK_DELAY TTIs ago
+      FfMacSchedSapProvider::SchedDlTriggerReqParameters trigger;
+      trigger.m_sfnSf = sfnSf;
+      std::vector<Transmission>::iterator tx = m_pending.begin ();
+      for (; tx != m_pending.end () && tx->tti + HARQ_FEEDBACK_DELAY <= m_tti; ++tx)
+        {
+          DlInfoListElement_s info;
+          info.m_rnti = tx->rnti;
+          info.m_harqProcessId = tx->harqProcess;
+          for (uint32_t tb = 0; tb < tx->tbBytes.size (); tb++)
+            {
+              if (m_harq && rng->GetValue () < bler)
+                {
+                  info.m_harqStatus.push_back (DlInfoListElement_s::NACK);
+                }
+              else
+                {
+                  info.m_harqStatus.push_back (DlInfoListElement_s::ACK);
+                  m_delivered[tx->rnti] += tx->tbBytes[tb];
+                }
+            }
+          if (m_harq)
+            {
+              trigger.m_dlInfoList.push_back (info);
+            }
+        }
+      m_pending.erase (m_pending.begin (), tx);
+
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+      if (!cqiInfo.m_cqiList.empty ())
+        {
+          m_schedSap->SchedDlCqiInfoReq (cqiInfo);
+        }
+      for (uint16_t rnti = 1; rnti <= m_ues; rnti++)
+        {
+          if (m_bufferChanged[rnti])
+            {
+              SendBsr (rnti);
+              m_bufferChanged[rnti] = false;
+            }
+        }
+      m_schedSap->SchedDlTriggerReq (trigger);
+      // the buffers changed by the allocations are reported next TTI
+      elapsed += std::chrono::steady_clock::now () - start;
+    }
+  m_seconds += std::chrono::duration<double> (elapsed).count ();
+  m_ttis += ttis;
+}
+
+void
+FfMacSchedulerBench::Report (std::ostream &os) const
+{
+  std::vector<double> throughput;
+  double sum = 0;
+  double sumSquares = 0;
+  for (uint16_t rnti = 1; rnti <= m_ues; rnti++)
+    {
+      double mbps = m_delivered[rnti] * 8 / (m_ttis * 1e-3) / 1e6;
+      throughput.push_back (mbps);
+      sum += mbps;
+      sumSquares += mbps * mbps;
+    }
+  std::sort (throughput.begin (), throughput.end ());
+  double fairness = sumSquares > 0 ? sum * sum / (m_ues * sumSquares) : 0;
+
+  os << m_ttis << " TTIs in " << m_seconds << " s: "
+     << m_ttis / m_seconds << " TTIs/s, "
+     << m_allocations / m_seconds << " allocations/s" << std::endl
+     << m_allocations << " allocations, "
+     << m_retransmissions << " retransmissions" << std::endl
+     << "cell throughput " << sum << " Mbps, "
+     << "5th percentile UE throughput " << throughput[throughput.size () / 20] << " Mbps, "
+     << "fairness index " << fairness << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  std::string scheduler = "ns3::PfFfMacScheduler";
+  uint32_t ues = 1000;
+  uint32_t bandwidth = 100;
+  uint32_t ttis = 1000;
+  uint32_t cqiPeriod = 10;
+  uint32_t load = 0;
+  bool harq = true;
+  double bler = 0.1;
+  uint64_t bitrate = 1000000;
+  std::string trace;
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Benchmark the DL scheduling of a FF MAC scheduler.");
+  cmd.AddValue ("scheduler", "TypeId of the scheduler", scheduler);
+  cmd.AddValue ("ues", "number of UEs of the cell", ues);
+  cmd.AddValue ("bandwidth", "DL and UL bandwidth, in RBs", bandwidth);
+  cmd.AddValue ("ttis", "number of scheduled TTIs", ttis);
+  cmd.AddValue ("cqiPeriod", "period of the generated CQI reports, in TTIs", cqiPeriod);
+  cmd.AddValue ("load", "generated bytes per TTI and UE, 0 for full buffers", load);
+  cmd.AddValue ("harq", "whether HARQ is enabled", harq);
+  cmd.AddValue ("bler", "probability of loss of a TB", bler);
+  cmd.AddValue ("bitrate", "maximum and guaranteed bit rate of the bearers, used by the QoS schedulers", bitrate);
+  cmd.AddValue ("trace", "file of CQI reports and traffic, instead of the generated ones", trace);
+  cmd.Parse (argc, argv);
+
+  FfMacSchedulerBench bench (scheduler, ues, bandwidth, harq, bitrate);
+  if (trace.empty ())
+    {
+      bench.Generate (cqiPeriod, load);
+    }
+  else
+    {
+      bench.ReadTrace (trace);
+    }
+  bench.Run (ttis, bler);
+
+  std::cout << scheduler << ": " << ues << " UEs, " << bandwidth << " RBs" << std::endl;
+  bench.Report (std::cout);
+  return 0;
+}
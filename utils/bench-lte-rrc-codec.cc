@@ -0,0 +1,227 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/lte-module.h"
+
+using namespace ns3;
+
+/**
+ * \file
+ * Benchmark the ASN.1 encoding and decoding of the RRC messages.
+ *
+ * The messages exchanged by LteRrcProtocolReal for the connection
+ * setup, the RRC connection reconfiguration of a handover with a
+ * measurement configuration, and the measurement reports are added to
+ * a packet and removed from it, as the RRC protocol does for each
+ * message it sends.  The time spent in each direction is reported as
+ * messages per second.
+ */
+
+/// \return the radio resource configuration of a UE with one data radio bearer
+static LteRrcSap::RadioResourceConfigDedicated
+CreateRadioResourceConfigDedicated (void)
+{
+  LteRrcSap::RadioResourceConfigDedicated rrcd;
+
+  LteRrcSap::SrbToAddMod srb;
+  srb.srbIdentity = 1;
+  srb.logicalChannelConfig.priority = 1;
+  srb.logicalChannelConfig.prioritizedBitRateKbps = 65535;
+  srb.logicalChannelConfig.bucketSizeDurationMs = 1000;
+  srb.logicalChannelConfig.logicalChannelGroup = 0;
+  rrcd.srbToAddModList.push_back (srb);
+
+  LteRrcSap::DrbToAddMod drb;
+  drb.epsBearerIdentity = 1;
+  drb.drbIdentity = 1;
+  drb.logicalChannelIdentity = 3;
+  drb.rlcConfig.choice = LteRrcSap::RlcConfig::AM;
+  drb.logicalChannelConfig.priority = 9;
+  drb.logicalChannelConfig.prioritizedBitRateKbps = 8;
+  drb.logicalChannelConfig.bucketSizeDurationMs = 100;
+  drb.logicalChannelConfig.logicalChannelGroup = 1;
+  rrcd.drbToAddModList.push_back (drb);
+
+  rrcd.havePhysicalConfigDedicated = true;
+  rrcd.physicalConfigDedicated.haveSoundingRsUlConfigDedicated = true;
+  rrcd.physicalConfigDedicated.soundingRsUlConfigDedicated.type = LteRrcSap::SoundingRsUlConfigDedicated::SETUP;
+  rrcd.physicalConfigDedicated.soundingRsUlConfigDedicated.srsBandwidth = 0;
+  rrcd.physicalConfigDedicated.soundingRsUlConfigDedicated.srsConfigIndex = 17;
+  rrcd.physicalConfigDedicated.haveAntennaInfoDedicated = true;
+  rrcd.physicalConfigDedicated.antennaInfo.transmissionMode = 1;
+  rrcd.physicalConfigDedicated.havePdschConfigDedicated = true;
+  rrcd.physicalConfigDedicated.pdschConfigDedicated.pa = LteRrcSap::PdschConfigDedicated::dB0;
+  return rrcd;
+}
+
+/// \return the RRC connection setup message
+static LteRrcSap::RrcConnectionSetup
+CreateRrcConnectionSetup (void)
+{
+  LteRrcSap::RrcConnectionSetup msg;
+  msg.rrcTransactionIdentifier = 1;
+  msg.radioResourceConfigDedicated = CreateRadioResourceConfigDedicated ();
+  return msg;
+}
+
+/// \return the RRC connection reconfiguration of a handover, with a measurement configuration
+static LteRrcSap::RrcConnectionReconfiguration
+CreateRrcConnectionReconfiguration (void)
+{
+  LteRrcSap::RrcConnectionReconfiguration msg;
+  msg.rrcTransactionIdentifier = 2;
+
+  msg.haveMeasConfig = true;
+  msg.measConfig.haveQuantityConfig = true;
+  msg.measConfig.quantityConfig.filterCoefficientRSRP = 4;
+  msg.measConfig.quantityConfig.filterCoefficientRSRQ = 4;
+  msg.measConfig.haveMeasGapConfig = false;
+  msg.measConfig.haveSmeasure = false;
+  msg.measConfig.haveSpeedStatePars = false;
+
+  LteRrcSap::MeasObjectToAddMod measObject;
+  measObject.measObjectId = 1;
+  measObject.measObjectEutra.carrierFreq = 100;
+  measObject.measObjectEutra.allowedMeasBandwidth = 25;
+  measObject.measObjectEutra.presenceAntennaPort1 = false;
+  measObject.measObjectEutra.neighCellConfig = 0;
+  measObject.measObjectEutra.offsetFreq = 0;
+  measObject.measObjectEutra.haveCellForWhichToReportCGI = false;
+  msg.measConfig.measObjectToAddModList.push_back (measObject);
+
+  LteRrcSap::ReportConfigToAddMod reportConfig;
+  reportConfig.reportConfigId = 1;
+  reportConfig.reportConfigEutra.triggerType = LteRrcSap::ReportConfigEutra::EVENT;
+  reportConfig.reportConfigEutra.eventId = LteRrcSap::ReportConfigEutra::EVENT_A3;
+  reportConfig.reportConfigEutra.a3Offset = 6;
+  reportConfig.reportConfigEutra.hysteresis = 2;
+  reportConfig.reportConfigEutra.timeToTrigger = 256;
+  reportConfig.reportConfigEutra.reportOnLeave = false;
+  reportConfig.reportConfigEutra.triggerQuantity = LteRrcSap::ReportConfigEutra::RSRP;
+  reportConfig.reportConfigEutra.reportQuantity = LteRrcSap::ReportConfigEutra::BOTH;
+  reportConfig.reportConfigEutra.maxReportCells = 8;
+  reportConfig.reportConfigEutra.reportInterval = LteRrcSap::ReportConfigEutra::MS480;
+  reportConfig.reportConfigEutra.reportAmount = 255;
+  msg.measConfig.reportConfigToAddModList.push_back (reportConfig);
+
+  LteRrcSap::MeasIdToAddMod measId;
+  measId.measId = 1;
+  measId.measObjectId = 1;
+  measId.reportConfigId = 1;
+  msg.measConfig.measIdToAddModList.push_back (measId);
+
+  msg.haveMobilityControlInfo = true;
+  msg.mobilityControlInfo.targetPhysCellId = 2;
+  msg.mobilityControlInfo.haveCarrierFreq = true;
+  msg.mobilityControlInfo.carrierFreq.dlCarrierFreq = 100;
+  msg.mobilityControlInfo.carrierFreq.ulCarrierFreq = 18100;
+  msg.mobilityControlInfo.haveCarrierBandwidth = true;
+  msg.mobilityControlInfo.carrierBandwidth.dlBandwidth = 25;
+  msg.mobilityControlInfo.carrierBandwidth.ulBandwidth = 25;
+  msg.mobilityControlInfo.newUeIdentity = 3;
+  msg.mobilityControlInfo.haveRachConfigDedicated = true;
+  msg.mobilityControlInfo.rachConfigDedicated.raPreambleIndex = 52;
+  msg.mobilityControlInfo.rachConfigDedicated.raPrachMaskIndex = 0;
+  msg.mobilityControlInfo.radioResourceConfigCommon.rachConfigCommon.preambleInfo.numberOfRaPreambles = 52;
+  msg.mobilityControlInfo.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.preambleTransMax = 50;
+  msg.mobilityControlInfo.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.raResponseWindowSize = 3;
+
+  msg.haveRadioResourceConfigDedicated = true;
+  msg.radioResourceConfigDedicated = CreateRadioResourceConfigDedicated ();
+  msg.haveNonCriticalExtension = false;
+  return msg;
+}
+
+/// \return a measurement report with two neighbour cells
+static LteRrcSap::MeasurementReport
+CreateMeasurementReport (void)
+{
+  LteRrcSap::MeasurementReport msg;
+  msg.measResults.measId = 1;
+  msg.measResults.rsrpResult = 40;
+  msg.measResults.rsrqResult = 20;
+  msg.measResults.haveMeasResultNeighCells = true;
+  for (uint16_t cellId = 2; cellId <= 3; cellId++)
+    {
+      LteRrcSap::MeasResultEutra neighbour;
+      neighbour.physCellId = cellId;
+      neighbour.haveCgiInfo = false;
+      neighbour.haveRsrpResult = true;
+      neighbour.rsrpResult = 45 + cellId;
+      neighbour.haveRsrqResult = true;
+      neighbour.rsrqResult = 18 + cellId;
+      msg.measResults.measResultListEutra.push_back (neighbour);
+    }
+  msg.measResults.haveScellsMeas = false;
+  return msg;
+}
+
+/**
+ * Encode and decode a message, as LteRrcProtocolReal does.
+ *
+ * \param name the name of the message
+ * \param msg the message
+ * \param iterations the number of messages
+ */
+template <class HEADER, class MSG>
+static void
+BenchMessage (std::string name, MSG msg, uint32_t iterations)
+{
+  std::chrono::steady_clock::duration encoding (0);
+  std::chrono::steady_clock::duration decoding (0);
+  uint32_t size = 0;
+  for (uint32_t i = 0; i < iterations; i++)
+    {
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+      Ptr<Packet> packet = Create<Packet> ();
+      HEADER source;
+      source.SetMessage (msg);
+      packet->AddHeader (source);
+      std::chrono::steady_clock::time_point encoded = std::chrono::steady_clock::now ();
+      size = packet->GetSize ();
+      HEADER destination;
+      packet->RemoveHeader (destination);
+      encoding += encoded - start;
+      decoding += std::chrono::steady_clock::now () - encoded;
+      NS_ABORT_MSG_IF (packet->GetSize () != 0, "The decoding of " << name << " left " << packet->GetSize () << " bytes");
+    }
+  double encodingSeconds = std::chrono::duration<double> (encoding).count ();
+  double decodingSeconds = std::chrono::duration<double> (decoding).count ();
+  std::cout << name << " (" << size << " bytes): "
+            << "encoding " << (uint64_t) (iterations / encodingSeconds) << " messages/s, "
+            << "decoding " << (uint64_t) (iterations / decodingSeconds) << " messages/s" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t iterations = 100000;
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Benchmark the ASN.1 encoding and decoding of the RRC messages.");
+  cmd.AddValue ("iterations", "number of messages of each type", iterations);
+  cmd.Parse (argc, argv);
+
+  BenchMessage<RrcConnectionSetupHeader> ("RrcConnectionSetup", CreateRrcConnectionSetup (), iterations);
+  BenchMessage<RrcConnectionReconfigurationHeader> ("RrcConnectionReconfiguration", CreateRrcConnectionReconfiguration (), iterations);
+  BenchMessage<MeasurementReportHeader> ("MeasurementReport", CreateMeasurementReport (), iterations);
+  return 0;
+}
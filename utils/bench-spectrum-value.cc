@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iostream>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/spectrum-module.h"
+
+using namespace ns3;
+
+/**
+ * \file
+ * Benchmark the SpectrumValue arithmetic on typical spectrum models.
+ *
+ * Two models are used: an LTE model with one band per resource block
+ * (\c rbs bands of 180 kHz) and a wifi model with one band per OFDM
+ * subcarrier (\c subcarriers bands of 312.5 kHz). For each of them,
+ * the operations done per transmission by the interference models are
+ * timed: accumulating the received signals, computing the SINR from
+ * the signal, interference and noise, and copying a PSD.
+ */
+
+/**
+ * Build a model of adjacent bands.
+ *
+ * \param fc the center frequency of the first band
+ * \param width the width of the bands
+ * \param n the number of bands
+ * \returns the model
+ */
+static Ptr<SpectrumModel>
+MakeModel (double fc, double width, uint32_t n)
+{
+  std::vector<double> freqs;
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      freqs.push_back (fc + i * width);
+    }
+  return Create<SpectrumModel> (freqs);
+}
+
+/**
+ * Time the operations on a spectrum model.
+ *
+ * \param name the name of the model
+ * \param model the model
+ * \param iterations the number of iterations of each operation
+ */
+static void
+BenchModel (std::string name, Ptr<const SpectrumModel> model, uint32_t iterations)
+{
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  SpectrumValue rx (model);
+  SpectrumValue noise (model);
+  SpectrumValue allSignals (model);
+  for (uint32_t i = 0; i < model->GetNumBands (); ++i)
+    {
+      rx[i] = rng->GetValue (1e-16, 1e-15);
+      noise[i] = 1e-19;
+    }
+  allSignals += rx;
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < iterations; ++i)
+    {
+      allSignals += rx;
+      allSignals -= rx;
+    }
+  int64_t accumulateMs = clock.End ();
+
+  double sum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < iterations; ++i)
+    {
+      SpectrumValue sinr = rx / (allSignals - rx + noise);
+      sum += Sum (sinr);
+    }
+  int64_t sinrMs = clock.End ();
+
+  clock.Start ();
+  for (uint32_t i = 0; i < iterations; ++i)
+    {
+      allSignals.AddScaled (rx, 1e-3);
+    }
+  int64_t addScaledMs = clock.End ();
+
+  clock.Start ();
+  for (uint32_t i = 0; i < iterations; ++i)
+    {
+      Ptr<SpectrumValue> copy = rx.Copy ();
+      sum += (*copy)[0];
+    }
+  int64_t copyMs = clock.End ();
+
+  clock.Start ();
+  for (uint32_t i = 0; i < iterations; ++i)
+    {
+      sum += Integral (rx);
+    }
+  int64_t integralMs = clock.End ();
+
+  std::cout << name << ": " << model->GetNumBands () << " bands, "
+            << iterations << " iterations: "
+            << "accumulate " << accumulateMs << " ms, "
+            << "sinr " << sinrMs << " ms, "
+            << "add scaled " << addScaledMs << " ms, "
+            << "copy " << copyMs << " ms, "
+            << "integral " << integralMs << " ms"
+            << " (" << sum << ")" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t rbs = 100;
+  uint32_t subcarriers = 256;
+  uint32_t iterations = 1000000;
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Benchmark the SpectrumValue arithmetic on typical spectrum models.");
+  cmd.AddValue ("rbs", "number of resource blocks of the LTE model", rbs);
+  cmd.AddValue ("subcarriers", "number of subcarriers of the wifi model", subcarriers);
+  cmd.AddValue ("iterations", "number of iterations of each operation", iterations);
+  cmd.Parse (argc, argv);
+
+  BenchModel ("lte", MakeModel (2.12e9, 180e3, rbs), iterations);
+  BenchModel ("wifi", MakeModel (5.13e9, 312.5e3, subcarriers), iterations);
+  return 0;
+}
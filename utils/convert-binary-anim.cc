@@ -0,0 +1,50 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/netanim-module.h"
+
+using namespace ns3;
+
+/**
+ * \file
+ * Convert a binary animation trace file (see
+ * AnimationInterface::EnableBinaryOutput) to the XML format read by
+ * NetAnim.
+ */
+
+int
+main (int argc, char *argv[])
+{
+  std::string input;
+  std::string output;
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Convert a binary animation trace file to the XML format.");
+  cmd.AddValue ("input", "the binary animation trace file", input);
+  cmd.AddValue ("output", "the XML animation trace file (default: the input file name followed by .xml)", output);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (input.empty (), "No input file");
+  if (output.empty ())
+    {
+      output = input + ".xml";
+    }
+
+  NS_ABORT_MSG_UNLESS (AnimationInterface::ConvertBinaryTrace (input, output),
+                       "Unable to convert the binary animation trace file " << input);
+  return 0;
+}
@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+
+using namespace ns3;
+
+/**
+ * \file
+ * Convert a binary trace file (see BinaryTraceFile) for offline analysis.
+ *
+ * Two output formats are supported:
+ *  - \c csv: one line per record, with a header line;
+ *  - \c columns: one raw file per field, named <output>.<field>, holding
+ *    the values of the field of all the records as little endian
+ *    integers (or byte arrays) of the size given by the schema, which
+ *    can be loaded directly as arrays (e.g., numpy.fromfile).
+ */
+
+/**
+ * Print an address of a record: dotted IPv4 for the IPv4-mapped
+ * addresses, IPv6 otherwise, nothing if the address is unknown.
+ *
+ * \param os the output stream
+ * \param address the address
+ */
+static void
+PrintAddress (std::ostream &os, const uint8_t address[16])
+{
+  static const uint8_t zero[16] = {0};
+  static const uint8_t mapped[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+  if (std::memcmp (address, zero, 16) == 0)
+    {
+      return;
+    }
+  if (std::memcmp (address, mapped, 12) == 0)
+    {
+      os << Ipv4Address::Deserialize (address + 12);
+    }
+  else
+    {
+      os << Ipv6Address::Deserialize (address);
+    }
+}
+
+/**
+ * Store an integer in little endian order in a column file.
+ *
+ * \param os the column file
+ * \param value the value
+ * \param size the size of the value
+ */
+static void
+WriteColumn (std::ostream &os, uint64_t value, uint32_t size)
+{
+  for (uint32_t i = 0; i < size; ++i)
+    {
+      os.put (static_cast<char> ((value >> (8 * i)) & 0xff));
+    }
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string input;
+  std::string output;
+  std::string format = "csv";
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Convert a binary trace file to csv or to column files.");
+  cmd.AddValue ("input", "the binary trace file", input);
+  cmd.AddValue ("output", "the csv file, or the prefix of the column files (default: the input file)", output);
+  cmd.AddValue ("format", "the output format: csv or columns", format);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (input.empty (), "No input file");
+  NS_ABORT_MSG_IF (format != "csv" && format != "columns", "Unknown format " << format);
+  if (output.empty ())
+    {
+      output = format == "csv" ? input + ".csv" : input;
+    }
+
+  BinaryTraceFile file;
+  file.Open (input, std::ios::in);
+  NS_ABORT_MSG_IF (file.Fail (), "Unable to read the binary trace file " << input);
+
+  const std::vector<BinaryTraceFile::Field> &schema = BinaryTraceFile::GetSchema ();
+  std::vector<std::ofstream *> columns;
+  std::ofstream csv;
+  if (format == "csv")
+    {
+      csv.open (output.c_str ());
+      for (std::vector<BinaryTraceFile::Field>::const_iterator i = schema.begin (); i != schema.end (); ++i)
+        {
+          csv << (i == schema.begin () ? "" : ",") << i->name;
+        }
+      csv << std::endl;
+    }
+  else
+    {
+      for (std::vector<BinaryTraceFile::Field>::const_iterator i = schema.begin (); i != schema.end (); ++i)
+        {
+          std::string filename = output + "." + i->name;
+          columns.push_back (new std::ofstream (filename.c_str (), std::ios::out | std::ios::binary));
+        }
+    }
+
+  BinaryTraceFile::Record r;
+  uint64_t n = 0;
+  while (file.Read (r))
+    {
+      if (format == "csv")
+        {
+          csv << r.time << "," << r.uid << "," << r.node << "," << r.device << "," << r.size << ","
+              << static_cast<char> (r.event) << "," << static_cast<uint32_t> (r.protocol) << ","
+              << r.srcPort << "," << r.dstPort << ",";
+          PrintAddress (csv, r.src);
+          csv << ",";
+          PrintAddress (csv, r.dst);
+          csv << "\n";
+        }
+      else
+        {
+          // in the schema order
+          WriteColumn (*columns[0], r.time, 8);
+          WriteColumn (*columns[1], r.uid, 8);
+          WriteColumn (*columns[2], r.node, 4);
+          WriteColumn (*columns[3], r.device, 4);
+          WriteColumn (*columns[4], r.size, 4);
+          WriteColumn (*columns[5], r.event, 1);
+          WriteColumn (*columns[6], r.protocol, 1);
+          WriteColumn (*columns[7], r.srcPort, 2);
+          WriteColumn (*columns[8], r.dstPort, 2);
+          columns[9]->write ((const char *)r.src, 16);
+          columns[10]->write ((const char *)r.dst, 16);
+        }
+      ++n;
+    }
+
+  for (std::vector<std::ofstream *>::iterator i = columns.begin (); i != columns.end (); ++i)
+    {
+      delete *i;
+    }
+  std::cout << n << " records converted" << std::endl;
+  return 0;
+}